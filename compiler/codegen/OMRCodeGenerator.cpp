@@ -220,6 +220,7 @@ OMR::CodeGenerator::CodeGenerator() :
      _relocationList(getTypedAllocator<TR::Relocation*>(TR::comp()->allocator())),
      _externalRelocationList(getTypedAllocator<TR::Relocation*>(TR::comp()->allocator())),
      _staticRelocationList(_compilation->allocator()),
+     _patchableGuardSites(_compilation->allocator()),
      _preJitMethodEntrySize(0),
      _jitMethodEntryPaddingSize(0),
      _lastInstructionBeforeCurrentEvaluationTreeTop(NULL),
@@ -958,6 +959,17 @@ OMR::CodeGenerator::getSupportsBitPermute()
    return false;
    }
 
+/**
+ * Query whether fternary and dternary are supported
+ *
+ * \return True if the opcodes are supported in codegen
+ */
+bool
+OMR::CodeGenerator::getSupportsFloatingPointTernary()
+   {
+   return false;
+   }
+
 bool
 OMR::CodeGenerator::getSupportsConstantOffsetInAddressing(int64_t value)
    {
@@ -2950,6 +2962,8 @@ void OMR::CodeGenerator::addRelocation(TR::Relocation *r)
       }
    else
       {
+      if (!r->isPositionIndependent())
+         self()->setHasPositionDependentCode();
       _relocationList.push_front(r);
       }
    }
@@ -2999,6 +3013,32 @@ OMR::CodeGenerator::addStaticRelocation(const TR::StaticRelocation &relocation)
    _staticRelocationList.push_back(relocation);
    }
 
+void
+OMR::CodeGenerator::addPatchableGuardSite(TR::Instruction *instruction, TR::LabelSymbol *destination, void *guardWord)
+   {
+   PatchableGuardSite site = { instruction, destination, guardWord };
+   _patchableGuardSites.push_back(site);
+   }
+
+bool
+OMR::CodeGenerator::isPatchableGuard(TR::Node *node)
+   {
+   if (node->getOpCodeValue() != TR::ificmpne ||
+       node->isTheVirtualGuardForAGuardedInlinedCall() ||
+       self()->comp()->getOption(TR_DisableVirtualGuardNOPing))
+      return false;
+
+   TR::Node *load = node->getFirstChild();
+   TR::Node *zero = node->getSecondChild();
+   return load->getOpCodeValue() == TR::iload &&
+          load->getReferenceCount() == 1 &&
+          load->getSymbolReference()->isSideEffectInfo() &&
+          load->getSymbol()->isStatic() &&
+          load->getSymbol()->isVolatile() &&
+          zero->getOpCodeValue() == TR::iconst &&
+          zero->getInt() == 0;
+   }
+
 intptrj_t OMR::CodeGenerator::hiValue(intptrj_t address)
    {
    if (self()->comp()->compileRelocatableCode()) // We don't want to store values using HI_VALUE at compile time, otherwise, we do this a 2nd time when we relocate (and new value is based on old one)
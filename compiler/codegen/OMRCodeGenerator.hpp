@@ -1118,27 +1118,62 @@ class OMR_EXTENSIBLE CodeGenerator
    void addExternalRelocation(TR::Relocation *r, TR::RelocationDebugInfo *info, TR::ExternalRelocationPositionRequest where = TR::ExternalRelocationAtBack);
    void addStaticRelocation(const TR::StaticRelocation &relocation);
 
+   // --------------------------------------------------------------------------
+   // Patchable guards
+   //
+   /**
+    * A guard compiled to a NOP, which the front end patches into a jump to
+    * the destination once the word tested by the guard becomes nonzero.
+    */
+   struct PatchableGuardSite
+      {
+      TR::Instruction *_instruction; // the NOP
+      TR::LabelSymbol *_destination;
+      void *_guardWord;
+      };
+
+   TR::list<PatchableGuardSite>& getPatchableGuardSites() { return _patchableGuardSites; }
+   void addPatchableGuardSite(TR::Instruction *instruction, TR::LabelSymbol *destination, void *guardWord);
+
+   /**
+    * \brief Determines whether \p node may be compiled to a patchable NOP.
+    *
+    * Such a guard is an ificmpne of a load of a volatile static Int32 marked
+    * as side effect info against 0 that is not a virtual guard.  When the
+    * guard is NOPed the word is only tested by the code the front end runs
+    * when it makes the word nonzero.
+    */
+   bool isPatchableGuard(TR::Node *node);
+
    void addProjectSpecializedRelocation(uint8_t *location,
                                           uint8_t *target,
                                           uint8_t *target2,
                                           TR_ExternalRelocationTargetKind kind,
                                           char *generatingFileName,
                                           uintptr_t generatingLineNumber,
-                                          TR::Node *node) {}
+                                          TR::Node *node) { _flags4.set(HasPositionDependentCode); }
    void addProjectSpecializedPairRelocation(uint8_t *location1,
                                           uint8_t *location2,
                                           uint8_t *target,
                                           TR_ExternalRelocationTargetKind kind,
                                           char *generatingFileName,
                                           uintptr_t generatingLineNumber,
-                                          TR::Node *node) {}
+                                          TR::Node *node) { _flags4.set(HasPositionDependentCode); }
    void addProjectSpecializedRelocation(TR::Instruction *instr,
                                           uint8_t *target,
                                           uint8_t *target2,
                                           TR_ExternalRelocationTargetKind kind,
                                           char *generatingFileName,
                                           uintptr_t generatingLineNumber,
-                                          TR::Node *node) {}
+                                          TR::Node *node) { _flags4.set(HasPositionDependentCode); }
+
+   /**
+    * \brief Whether the binary encoding refers to code outside of the method by
+    *        a PC relative displacement, or to the method itself by an absolute
+    *        address.  Such code can not be moved just by copying it.
+    */
+   bool hasPositionDependentCode() { return _flags4.testAny(HasPositionDependentCode); }
+   void setHasPositionDependentCode() { _flags4.set(HasPositionDependentCode); }
 
    void apply8BitLabelRelativeRelocation(int32_t * cursor, TR::LabelSymbol * label);
    void apply12BitLabelRelativeRelocation(int32_t * cursor, TR::LabelSymbol * label, bool isCheckDisp = true);
@@ -1544,6 +1579,8 @@ class OMR_EXTENSIBLE CodeGenerator
 
    virtual bool getSupportsBitPermute();
 
+   virtual bool getSupportsFloatingPointTernary();
+
    bool getSupportsAutoSIMD() { return _flags4.testAny(SupportsAutoSIMD);}
    void setSupportsAutoSIMD() { _flags4.set(SupportsAutoSIMD);}
 
@@ -1787,7 +1824,7 @@ class OMR_EXTENSIBLE CodeGenerator
 
    enum // flags4
       {
-      // AVAILABLE                                        = 0x00000001,
+      HasPositionDependentCode                            = 0x00000001,
       // AVAILABLE                                        = 0x00000002,
       // AVAILABLE                                        = 0x00000004,
       OptimizationPhaseIsComplete                         = 0x00000008,
@@ -1876,6 +1913,7 @@ class OMR_EXTENSIBLE CodeGenerator
    TR::list<TR::Relocation *> _relocationList;
    TR::list<TR::Relocation *> _externalRelocationList;
    TR::list<TR::StaticRelocation> _staticRelocationList;
+   TR::list<PatchableGuardSite> _patchableGuardSites;
 
    TR::list<TR::SymbolReference*> _variableSizeSymRefPendingFreeList;
    TR::list<TR::SymbolReference*> _variableSizeSymRefFreeList;
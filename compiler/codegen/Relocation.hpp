@@ -104,6 +104,13 @@ class Relocation
 
    virtual bool isExternalRelocation() { return true; }
 
+   /**
+    * Whether the relocated value remains valid when the method's code is
+    * copied elsewhere as a whole, i.e. it only relates two points of the
+    * method to each other.
+    */
+   virtual bool isPositionIndependent() { return false; }
+
    TR::RelocationDebugInfo* getDebugInfo();
 
    void setDebugInfo(TR::RelocationDebugInfo* info);
@@ -136,6 +143,7 @@ class LabelRelative8BitRelocation : public TR::LabelRelocation
    LabelRelative8BitRelocation() : TR::LabelRelocation() {}
    LabelRelative8BitRelocation(uint8_t *p, TR::LabelSymbol *l)
       : TR::LabelRelocation(p, l) {}
+   virtual bool isPositionIndependent() { return true; }
    virtual void apply(TR::CodeGenerator *codeGen);
    };
 
@@ -147,6 +155,7 @@ class LabelRelative12BitRelocation : public TR::LabelRelocation
    LabelRelative12BitRelocation(uint8_t *p, TR::LabelSymbol *l, bool isCheckDisp = true)
       : TR::LabelRelocation(p, l), _isCheckDisp(isCheckDisp) {}
    bool isCheckDisp() {return _isCheckDisp;}
+   virtual bool isPositionIndependent() { return true; }
    virtual void apply(TR::CodeGenerator *codeGen);
    };
 
@@ -173,6 +182,7 @@ class LabelRelative16BitRelocation : public TR::LabelRelocation
    int8_t getAddressDifferenceDivisor()  {return _addressDifferenceDivisor;}
    int8_t setAddressDifferenceDivisor(int8_t d) {return (_addressDifferenceDivisor = d);}
 
+   virtual bool isPositionIndependent() { return true; }
    virtual void apply(TR::CodeGenerator *codeGen);
    };
 
@@ -182,6 +192,7 @@ class LabelRelative24BitRelocation : public TR::LabelRelocation
    LabelRelative24BitRelocation() : TR::LabelRelocation() {}
    LabelRelative24BitRelocation(uint8_t *p, TR::LabelSymbol *l)
       : TR::LabelRelocation(p, l) {}
+   virtual bool isPositionIndependent() { return true; }
    virtual void apply(TR::CodeGenerator *codeGen);
    };
 
@@ -191,6 +202,7 @@ class LabelRelative32BitRelocation : public TR::LabelRelocation
    LabelRelative32BitRelocation() : TR::LabelRelocation() {}
    LabelRelative32BitRelocation(uint8_t *p, TR::LabelSymbol *l)
       : TR::LabelRelocation(p, l) {}
+   virtual bool isPositionIndependent() { return true; }
    virtual void apply(TR::CodeGenerator *codeGen);
    };
 
@@ -222,6 +234,7 @@ class InstructionLabelRelative16BitRelocation : public TR::LabelRelocation
    InstructionLabelRelative16BitRelocation(TR::Instruction* cursor, int32_t offset, TR::LabelSymbol* l, int32_t divisor);
       
    virtual uint8_t* getUpdateLocation();
+   virtual bool isPositionIndependent() { return true; }
    virtual void apply(TR::CodeGenerator* cg);
 
    private:
@@ -259,6 +272,7 @@ class InstructionLabelRelative32BitRelocation : public TR::LabelRelocation
    InstructionLabelRelative32BitRelocation(TR::Instruction* cursor, int32_t offset, TR::LabelSymbol* l, int32_t divisor);
       
    virtual uint8_t* getUpdateLocation();
+   virtual bool isPositionIndependent() { return true; }
    virtual void apply(TR::CodeGenerator* cg);
 
    private:
@@ -32,6 +32,7 @@
 #include "il/Node_inlines.hpp"
 #include "il/SymbolReference.hpp"
 #include "infra/BitVector.hpp"
+#include "infra/ILWalk.hpp"
 
 OMR::AliasBuilder::AliasBuilder(TR::SymbolReferenceTable *symRefTab, size_t sizeHint, TR::Compilation *c) :
      _addressShadowSymRefs(sizeHint, c->trMemory(), heapAlloc, growable),
@@ -133,6 +134,7 @@ OMR::AliasBuilder::createAliasInfo()
    gcSafePointSymRefNumbers().pack();
 
    setCatchLocalUseSymRefs();
+   gatherAddressTakenAutos();
 
    defaultMethodDefAliases().init(symRefTab()->getNumSymRefs(), comp()->trMemory(), heapAlloc, growable);
    defaultMethodDefAliases() |= addressShadowSymRefs();
@@ -145,6 +147,7 @@ OMR::AliasBuilder::createAliasInfo()
    defaultMethodDefAliases() |= nonIntPrimitiveStaticSymRefs();
    defaultMethodDefAliases() |= unsafeSymRefNumbers();
    defaultMethodDefAliases() |= gcSafePointSymRefNumbers();
+   defaultMethodDefAliases() |= addressTakenAutos();
 
    defaultMethodDefAliasesWithoutImmutable().init(symRefTab()->getNumSymRefs(), comp()->trMemory(), heapAlloc, growable);
    defaultMethodDefAliasesWithoutUserField().init(symRefTab()->getNumSymRefs(), comp()->trMemory(), heapAlloc, growable);
@@ -222,6 +225,28 @@ OMR::AliasBuilder::setCatchLocalUseSymRefs()
       }
    }
 
+/**
+ * Add the autos and parms whose address is loaded anywhere in the method to
+ * addressTakenAutos().  Local objects are left out, their storage is only
+ * accessed through shadows.
+ */
+void
+OMR::AliasBuilder::gatherAddressTakenAutos()
+   {
+   for (TR::PreorderNodeIterator iter(comp()->getStartTree(), comp()); iter.currentTree(); ++iter)
+      {
+      TR::Node *node = iter.currentNode();
+      if (node->getOpCodeValue() != TR::loadaddr)
+         continue;
+
+      TR::Symbol *symbol = node->getSymbol();
+      if (symbol->isAutoOrParm() && !symbol->isLocalObject())
+         addressTakenAutos().set(node->getSymbolReference()->getReferenceNumber());
+      }
+
+   addressTakenAutos().pack();
+   }
+
 void
 OMR::AliasBuilder::gatherLocalUseInfo(TR::Block * block, TR_BitVector & storeVector, TR_ScratchList<TR_Pair<TR::Block, TR_BitVector> > *seenBlockInfos, vcount_t visitCount, bool isOSRCatch)
    {
@@ -108,7 +108,8 @@ public:
    TR_BitVector & refinedAddressArrayShadows() { return _refinedAddressArrayShadows; }
    TR_BitVector & refinedIntArrayShadows() { return _refinedIntArrayShadows; }
 
-   // To enable auto variable whose address is taken in alias analysis
+   // Autos and parms whose address is taken, which indirect accesses and
+   // calls may read or write
    TR_BitVector & addressTakenAutos() { return _addressTakenAutos; }
 
    bool litPoolGenericIntShadowHasBeenCreated(){ return _litPoolGenericIntShadowHasBeenCreated; }
@@ -124,6 +125,7 @@ public:
 
    TR_BitVector & notOsrCatchLocalUseSymRefs() { return _notOsrCatchLocalUseSymRefs; }
    void setCatchLocalUseSymRefs();
+   void gatherAddressTakenAutos();
    void gatherLocalUseInfo(TR::Node *, TR_BitVector&, vcount_t, bool);
    void gatherLocalUseInfo(TR::Block *, bool);
    void gatherLocalUseInfo(TR::Block *, TR_BitVector &, TR_ScratchList<TR_Pair<TR::Block, TR_BitVector> > *, vcount_t, bool);
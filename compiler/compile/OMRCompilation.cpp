@@ -1932,7 +1932,7 @@ bool OMR::Compilation::isVirtualGuardNOPingRequired(TR_VirtualGuard *virtualGuar
 
 bool OMR::Compilation::hasBlockFrequencyInfo()
    {
-   return false;
+   return _flags.testAny(HasBlockFrequencyInfo);
    }
 
 void OMR::Compilation::setUsesPreexistence(bool v)
@@ -862,7 +862,12 @@ public:
    bool shouldBeRecompiled();
    bool couldBeRecompiled();
 
+   /**
+    * \brief Whether the block and edge frequencies come from a profile of
+    * the method rather than from its structure.
+    */
    bool hasBlockFrequencyInfo();
+   void setHasBlockFrequencyInfo()              { _flags.set(HasBlockFrequencyInfo); }
    bool usesPreexistence() { return _usesPreexistence; }
    void setUsesPreexistence(bool v);
 
@@ -1105,7 +1110,7 @@ protected:
    enum // flags
       {
       HasUnsafeSymbol                   = 0x0000001,
-      // AVAILABLE                      = 0x0000002,
+      HasBlockFrequencyInfo             = 0x0000002,
       HasNativeCall                     = 0x0000004,
       // AVAILABLE                      = 0x0000008,
       SyncsMarked                       = 0x0000010,
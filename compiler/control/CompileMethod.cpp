@@ -376,10 +376,12 @@ compileMethodFromDetails(
       if (rc == COMPILATION_SUCCEEDED) // success!
          {
 
-         // not ready yet...
-         //OMR::MethodMetaDataPOD *metaData = fe.createMethodMetaData(&compiler);
-
          startPC = compiler.cg()->getCodeStart();
+
+         // Let the front end record where the method's code lives
+         //
+         fe.createMethodMetaData(&compiler);
+
          uint64_t translationTime = TR::Compiler->vm.getUSecClock() - translationStartTime;
 
          if (TR::Options::isAnyVerboseOptionSet(TR_VerboseCompileEnd, TR_VerbosePerformance))
@@ -179,6 +179,8 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"compilationThreads=",   "R<nnn>\tnumber of compilation threads to use",
                                TR::Options::setStaticNumeric, (intptrj_t)&OMR::Options::_numUsableCompilationThreads, 0, "F%d", NOT_IN_SUBSET},
    {"compile",                "D\tCompile these methods immediately. Primarily for use with Compiler.command",  SET_OPTION_BIT(TR_CompileBit),  "F" },
+   {"compileBudget=",         "O<nnn>\tcost, in node visits, of the hot passes a method without loops may use",
+        TR::Options::set32BitNumeric, offsetof(OMR::Options, _compileBudget), 0, " %d" },
    {"compThreadCPUEntitlement=", "M<nnn>\tThreshold for CPU utilization of compilation threads",
                                TR::Options::setStaticNumeric, (intptrj_t)&OMR::Options::_compThreadCPUEntitlement, 0, "F%d", NOT_IN_SUBSET },
    {"concurrentLPQ", "M\tCompilations from low priority queue can go in parallel with compilations from main queue", SET_OPTION_BIT(TR_ConcurrentLPQ), "F", NOT_IN_SUBSET },
@@ -327,6 +329,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"disableGlobalDSE",                   "O\tdisable global dead store elimination",          TR::Options::disableOptimization, globalDeadStoreElimination, 0, "P"},
    {"disableGlobalLiveVariablesForGC",    "O\tdisable global live variables for GC",           TR::Options::disableOptimization, globalLiveVariablesForGC, 0, "P"},
    {"disableGlobalStaticBaseRegister",    "O\tdisable global static base register ",           SET_OPTION_BIT(TR_DisableGlobalStaticBaseRegister), "F"},
+   {"disableGlobalValueNumbering",        "O\tdisable global value numbering",                 TR::Options::disableOptimization, globalValueNumbering, 0, "P"},
    {"disableGlobalVP",                    "O\tdisable global value propagation",               TR::Options::disableOptimization, globalValuePropagation, 0, "P"},
    {"disableGLU",                         "O\tdisable general loop unroller",                  TR::Options::disableOptimization, generalLoopUnroller, 0, "P"},
 
@@ -396,10 +399,12 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"disableJProfilingThread",            "O\tdisable separate thread for JProfiling", SET_OPTION_BIT(TR_DisableJProfilerThread), "F", NOT_IN_SUBSET},
    {"disableKnownObjectTable",            "O\tdisable support for including heap object info in symbol references", SET_OPTION_BIT(TR_DisableKnownObjectTable), "F"},
    {"disableLastITableCache",             "C\tdisable using class lastITable cache for interface dispatches",  SET_OPTION_BIT(TR_DisableLastITableCache), "F"},
+   {"disableLazyDFSets",                  "O\tdisable lazily sized containers for large bit vector dataflow problems", SET_OPTION_BIT(TR_DisableLazyDFSets), "F"},
    {"disableLeafRoutineDetection",        "O\tdisable lleaf routine detection on zlinux", SET_OPTION_BIT(TR_DisableLeafRoutineDetection), "F"},
    {"disableLinkageRegisterAllocation",   "O\tdon't turn parm loads into RegLoads in first basic block",  SET_OPTION_BIT(TR_DisableLinkageRegisterAllocation), "F"},
    {"disableLiveMonitorMetadata",         "O\tdisable the creation of live monitor metadata", SET_OPTION_BIT(TR_DisableLiveMonitorMetadata), "F"},
    {"disableLiveRangeSplitter",          "O\tdisable live range splitter",                    SET_OPTION_BIT(TR_DisableLiveRangeSplitter), "F"},
+   {"disableLocalArrayScalarization",     "O\tdisable scalarization of local arrays",        TR::Options::disableOptimization, localArrayScalarization, 0, "P"},
    {"disableLocalCSE",                    "O\tdisable local common subexpression elimination", TR::Options::disableOptimization, localCSE, 0, "P"},
    {"disableLocalCSEVolatileCommoning",   "O\tdisable local common subexpression elimination volatile commoning", SET_OPTION_BIT(TR_DisableLocalCSEVolatileCommoning), "F"},
    {"disableLocalDSE",                    "O\tdisable local dead store elimination",           TR::Options::disableOptimization, localDeadStoreElimination, 0, "P"},
@@ -641,6 +646,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"enableBranchPreload",                "O\tenable return branch preload for each method (for func testing)",  SET_OPTION_BIT(TR_EnableBranchPreload), "F"},
    {"enableCFGEdgeCounters",              "O\tenable CFG edge counters to keep track of taken and non taken branches in compiled code",      SET_OPTION_BIT(TR_EnableCFGEdgeCounters), "F"},
    {"enableCheapWarmOpts",                "O\tenable cheap warm optimizations", RESET_OPTION_BIT(TR_DisableCheapWarmOpts), "F"},
+   {"enableCodeCacheCompaction",          "M\trecord what is needed to move compiled code when compacting the code cache", SET_OPTION_BIT(TR_EnableCodeCacheCompaction), "F", NOT_IN_SUBSET},
    {"enableCodeCacheConsolidation",       "M\tenable code cache consolidation", SET_OPTION_BIT(TR_EnableCodeCacheConsolidation), "F", NOT_IN_SUBSET},
    {"enableColdCheapTacticalGRA",         "O\tenable cold cheap tactical GRA", SET_OPTION_BIT(TR_EnableColdCheapTacticalGRA), "F"},
    {"enableCompilationSpreading",         "C\tenable adding spreading invocations to methods before compiling", SET_OPTION_BIT(TR_EnableCompilationSpreading), "F", NOT_IN_SUBSET},
@@ -695,6 +701,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"enableLabelTargetNOPs",             "O\tenable inserting NOPs before label targets", SET_OPTION_BIT(TR_EnableLabelTargetNOPs),  "F"},
    {"enableLargeCodePages",              "C\tenable large code pages",  SET_OPTION_BIT(TR_EnableLargeCodePages), "F"},
    {"enableLastRetrialLogging",          "O\tenable fullTrace logging for last compilation attempt. Needs to have a log defined on the command line", SET_OPTION_BIT(TR_EnableLastCompilationRetrialLogging), "F"},
+   {"enableLinearScanRA",                "C\tassign GPRs with a linear scan over the instruction stream before local register assignment", SET_OPTION_BIT(TR_EnableLinearScanRA), "F"},
    {"enableLocalVPSkipLowFreqBlock",     "O\tSkip processing of low frequency blocks in localVP", SET_OPTION_BIT(TR_EnableLocalVPSkipLowFreqBlock), "F" },
    {"enableLoopEntryAlignment",            "O\tenable loop Entry alignment",                          SET_OPTION_BIT(TR_EnableLoopEntryAlignment), "F"},
    {"enableLoopVersionerCountAllocFences", "O\tallow loop versioner to count allocation fence nodes on PPC toward a profiled guard's block total", SET_OPTION_BIT(TR_EnableLoopVersionerCountAllocationFences), "F"},
@@ -1129,6 +1136,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"traceGlobalCopyPropagation",       "L\ttrace global copy propagation",                TR::Options::traceOptimization, globalCopyPropagation, 0, "P"},
    {"traceGlobalDSE",                   "L\ttrace global dead store elimination",          TR::Options::traceOptimization, globalDeadStoreElimination, 0, "P"},
    {"traceGlobalLiveVariablesForGC",    "L\ttrace global live variables for GC",           TR::Options::traceOptimization, globalLiveVariablesForGC, 0, "P"},
+   {"traceGlobalValueNumbering",        "L\ttrace global value numbering",                 TR::Options::traceOptimization, globalValueNumbering, 0, "P"},
    {"traceGlobalVP",                    "L\ttrace global value propagation",               TR::Options::traceOptimization, globalValuePropagation, 0, "P"},
    {"traceGLU",                         "L\ttrace general loop unroller",                  TR::Options::traceOptimization, generalLoopUnroller, 0, "P"},
    {"traceGRA",                         "L\ttrace tree based global register allocator",     TR::Options::traceOptimization, tacticalGlobalRegisterAllocator, 0, "P"},
@@ -1159,6 +1167,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"traceLiveMonitorMetadata",         "L\ttrace live monitor metadata",                  SET_OPTION_BIT(TR_TraceLiveMonitorMetadata), "F" },
    {"traceLiveness",                     "L\ttrace liveness analysis",                     SET_OPTION_BIT(TR_TraceLiveness), "P" },
    {"traceLiveRangeSplitter",           "L\ttrace live-range splitter for global register allocator",     TR::Options::traceOptimization, liveRangeSplitter, 0, "P"},
+   {"traceLocalArrayScalarization",     "L\ttrace scalarization of local arrays",         TR::Options::traceOptimization, localArrayScalarization, 0, "P"},
    {"traceLocalCSE",                    "L\ttrace local common subexpression elimination", TR::Options::traceOptimization, localCSE, 0, "P"},
    {"traceLocalDSE",                    "L\ttrace local dead store elimination",           TR::Options::traceOptimization, localDeadStoreElimination, 0, "P"},
    {"traceLocalLiveRangeReduction",     "L\ttrace local live range reduction",             TR::Options::traceOptimization, localLiveRangeReduction, 0, "P"},
@@ -1203,7 +1212,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
 #endif
    {"traceRA",                          "L\ttrace register assignment (basic)",
         TR::Options::setBitsFromStringSet, offsetof(OMR::Options, _raTrace), TR_TraceRABasic, "F"},
-   {"traceRA=",                         "L{regex}\tlist of additional register assignment traces to enable: deps, details, preRA, states",
+   {"traceRA=",                         "L{regex}\tlist of additional register assignment traces to enable: deps, details, linearScan, preRA, states",
         TR::Options::setBitsFromStringSet, offsetof(OMR::Options, _raTrace), 0, "F"},
    {"traceReachability",                "L\ttrace all analyses based on the reachability engine",     SET_OPTION_BIT(TR_TraceReachability), "P"},
    {"traceRecognizedCallTransformer",   "L\ttrace recognized call transformer",            TR::Options::traceOptimization, recognizedCallTransformer, 0, "P"},
@@ -1746,6 +1755,7 @@ OMR::Options::requiresDebugObject()
    #endif
 
    if (OMR::Options::hasSomeLogFile() ||
+       OMR::Options::isOptionSetForAnyMethod(TR_CountOptTransformations) || // performTransformation reports to the debug object
        OMR::Options::isOptionSetForAnyMethod(TR_EntryBreakPoints) ||
        OMR::Options::isOptionSetForAnyMethod(TR_DebugBeforeCompile) ||
        OMR::Options::isOptionSetForAnyMethod(TR_DebugOnEntry))
@@ -2531,6 +2541,7 @@ OMR::Options::jitPreProcess()
 #endif
    _inlinerVeryLargeCompiledMethodFaninThreshold = 1;
    _maxSzForVPInliningWarm = 8;
+   _compileBudget = 4000000;
    _largeCompiledMethodExemptionFreqCutoff = 10000;
    _inlineCntrCalleeTooBigBucketSize = INT_MAX;
    _inlineCntrColdAndNotTinyBucketSize = INT_MAX;
@@ -4601,6 +4612,7 @@ OMR::Options::TR_OptionStringToBit OMR::Options::_optionStringToBitMapping[] = {
 // Local RA named trace options
 { "deps", TR_TraceRADependencies },
 { "details", TR_TraceRADetails },
+{ "linearScan", TR_TraceRALinearScan },
 { "preRA", TR_TraceRAPreAssignmentInstruction },
 { "spillTemps", TR_TraceRASpillTemps },
 { "states", TR_TraceRARegisterStates },
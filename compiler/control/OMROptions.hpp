@@ -271,7 +271,7 @@ enum TR_CompilationOptions
    // Option word 6
    //
    TR_EnableAggressiveLoopVersioning      = 0x00000020 + 6,
-   // Available                           = 0x00000040 + 6,
+   TR_DisableLazyDFSets                   = 0x00000040 + 6,
    TR_CompileBit                          = 0x00000080 + 6,
    TR_WaitBit                             = 0x00000100 + 6,
    TR_DisableZ14                          = 0x00000200 + 6,
@@ -293,7 +293,7 @@ enum TR_CompilationOptions
    TR_UseSamplingJProfilingForAllFirstTimeComps   = 0x02000000 + 6,
    TR_NoStoreAOT                          = 0x04000000 + 6,
    TR_NoLoadAOT                           = 0x08000000 + 6,
-   // Available                           = 0x10000000 + 6,
+   TR_EnableCodeCacheCompaction           = 0x10000000 + 6,
    TR_UseSamplingJProfilingForDLT                 = 0x20000000 + 6,
    TR_UseSamplingJProfilingForInterpSampledMethods= 0x40000000 + 6,
    TR_EmitRelocatableELFFile              = 0x80000000 + 6,
@@ -325,7 +325,7 @@ enum TR_CompilationOptions
    TR_DisableTOCForConsts                 = 0x08000000 + 7,
    TR_UseLowPriorityQueueDuringCLP        = 0x10000000 + 7,
    TR_DisableVectorBCD                    = 0x20000000 + 7,
-   // Available                           = 0x40000000 + 7,
+   TR_EnableLinearScanRA                  = 0x40000000 + 7,
    TR_DisableTraps                        = 0x80000000 + 7,
 
    // Option word 8
@@ -1031,7 +1031,7 @@ enum TR_CompilationOptions
    TR_TraceRAPreAssignmentInstruction   = 0x00000008,
    TR_TraceRARegisterStates             = 0x00000010,
    TR_TraceRASpillTemps                 = 0x00000020,
-   // Available                         = 0x00000040,
+   TR_TraceRALinearScan                 = 0x00000040,
    TR_TraceRAListing                    = 0x00000200,
 
    // Instruction Level GRA tracing option word
@@ -1657,6 +1657,7 @@ public:
    int32_t getBigCalleeScorchingOptThreshold() const  {return _bigCalleeScorchingOptThreshold;}
    int32_t getLargeCompiledMethodExemptionFreqCutoff() const {return _largeCompiledMethodExemptionFreqCutoff;}
    int32_t getMaxSzForVPInliningWarm() const          {return _maxSzForVPInliningWarm;}
+   int32_t getCompileBudget() const                   {return _compileBudget;}
    int32_t getInlinerVeryLargeCompiledMethodThreshold() const {return _inlinerVeryLargeCompiledMethodThreshold;}
    int32_t getInlinerVeryLargeCompiledMethodFaninThreshold() const {return _inlinerVeryLargeCompiledMethodFaninThreshold;}
 
@@ -2410,6 +2411,7 @@ protected:
    int32_t                     _inlinerVeryLargeCompiledMethodFaninThreshold; // for inlining
    int32_t                     _largeCompiledMethodExemptionFreqCutoff;
    int32_t                     _maxSzForVPInliningWarm;
+   int32_t                     _compileBudget; // for frontends that cut down the hot strategy
 
    int32_t                     _loopyAsyncCheckInsertionMaxEntryFreq;
 
@@ -42,6 +42,7 @@ struct TR_X86CPUIDBuffer
       uint32_t l3;
       } _cacheDescription;
    uint32_t _featureFlags8;
+   uint32_t _extendedFeatureFlags;  // ECX of CPUID 0x80000001
    };
 
 enum TR_X86ProcessorVendors
@@ -137,6 +138,7 @@ enum TR_X86ProcessorFeatures2
 inline uint32_t getFeatureFlags2Mask()
    {
    return  TR_SSSE3
+         | TR_FMA
          | TR_SSE4_1
          | TR_POPCNT
          | TR_AESNI
@@ -182,10 +184,44 @@ enum TR_X86ProcessorFeatures8
 
 inline uint32_t getFeatureFlags8Mask()
    {
-   return  TR_HLE
+   return  TR_BMI1
+         | TR_HLE
+         | TR_BMI2
+         | TR_ERMSB
          | TR_RTM;
    }
 
+enum TR_X86ProcessorExtendedFeatures
+   {
+   TR_LAHFSAHF64              = 0x00000001,
+   TR_CmpLegacy               = 0x00000002,
+   TR_SVM                     = 0x00000004,
+   TR_ExtApicSpace            = 0x00000008,
+   TR_AltMovCr8               = 0x00000010,
+   TR_ABM                     = 0x00000020, // LZCNT
+   TR_SSE4A                   = 0x00000040,
+   TR_MisAlignSSE             = 0x00000080,
+   TR_PREFETCHW               = 0x00000100,
+   TR_OSVW                    = 0x00000200,
+   TR_IBS                     = 0x00000400,
+   TR_XOP                     = 0x00000800,
+   TR_SKINIT                  = 0x00001000,
+   TR_WDT                     = 0x00002000,
+   // Reserved by AMD         = 0x00004000,
+   TR_LWP                     = 0x00008000,
+   TR_FMA4                    = 0x00010000,
+   TR_TCE                     = 0x00020000,
+   // Reserved by AMD         = 0x00040000,
+   // Reserved by AMD         = 0x00080000,
+   // Reserved by AMD         = 0x00100000,
+   TR_TBM                     = 0x00200000,
+   };
+
+inline uint32_t getExtendedFeatureFlagsMask()
+   {
+   return  TR_ABM;
+   }
+
 enum TR_ProcessorDescription
    {
    TR_ProcessorUnknown          = 0x00000000,
@@ -481,6 +481,11 @@ TR_BitVector *TR_NodeAliasSetInterface<mayKillAliasSet>::getTRAliases_impl(bool
    TR::Compilation *comp = TR::comp();
    TR_BitVector *bv = NULL;
 
+   // A call to a pure function defines nothing, not even its own symbol, so
+   // that it stays available for commoning
+   if (_node->getOpCode().isCall() && _node->isPureCall())
+      return bv;
+
    if (_node->getOpCode().hasSymbolReference() && (_node->getOpCode().isLikeDef() || _node->mightHaveVolatileSymbolReference())) //we want the old behavior in these cases
       {
       if (_node->getSymbolReference()->sharesSymbol(includeGCSafePoint))
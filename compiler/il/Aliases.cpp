@@ -132,6 +132,10 @@ OMR::SymbolReference::getUseonlyAliasesBV(TR::SymbolReferenceTable * symRefTab)
             return &symRefTab->aliasBuilder.defaultMethodUseAliases();
             }
 
+         // A pure function reads no memory
+         if (methodSymbol->isPureFunction())
+            return NULL;
+
          if (!methodSymbol->isHelper())
             {
             return &symRefTab->aliasBuilder.defaultMethodUseAliases();
@@ -280,7 +284,8 @@ OMR::SymbolReference::getUseDefAliasesBV(bool isDirectCall, bool includeGCSafePo
             if ((self()->isUnresolved() && (_symbol->isConstantDynamic() || !_symbol->isConstObjectRef())) ||
 	        _symbol->isVolatile() || self()->isLiteralPoolAddress() ||
                 self()->isFromLiteralPool() || _symbol->isUnsafeShadowSymbol() ||
-                (_symbol->isArrayShadowSymbol() && comp->getMethodSymbol()->hasVeryRefinedAliasSets()))
+                (_symbol->isArrayShadowSymbol() && comp->getMethodSymbol()->hasVeryRefinedAliasSets()) ||
+                (kind == TR::Symbol::IsShadow && !symRefTab->aliasBuilder.addressTakenAutos().isEmpty()))
                {
                // getUseDefAliases might not return NULL
                }
@@ -307,6 +312,10 @@ OMR::SymbolReference::getUseDefAliasesBV(bool isDirectCall, bool includeGCSafePo
          {
          TR::MethodSymbol * methodSymbol = _symbol->castToMethodSymbol();
 
+         // Pure and read only functions write no memory
+         if (methodSymbol->isPureFunction() || methodSymbol->isReadOnlyFunction())
+            return NULL;
+
          if (!methodSymbol->isHelper())
             return symRefTab->aliasBuilder.methodAliases(self());
 
@@ -639,6 +648,14 @@ OMR::SymbolReference::getUseDefAliasesBV(bool isDirectCall, bool includeGCSafePo
             self()->setSharedShadowAliases(aliases, symRefTab);
             }
 
+         // An indirect access may reach any auto whose address is taken
+         if (!symRefTab->aliasBuilder.addressTakenAutos().isEmpty())
+            {
+            if (!aliases)
+               aliases = new (aliasRegion) TR_BitVector(bvInitialSize, aliasRegion, growability);
+            *aliases |= symRefTab->aliasBuilder.addressTakenAutos();
+            }
+
          if (symRefTab->findGenericIntShadowSymbol())
             {
             if (!aliases)
@@ -688,6 +705,19 @@ OMR::SymbolReference::getUseDefAliasesBV(bool isDirectCall, bool includeGCSafePo
             if (!aliases)
                aliases = new (aliasRegion) TR_BitVector(bvInitialSize, aliasRegion, growability);
             aliases->set(symRefTab->getArrayShadowIndex(_symbol->getDataType().vectorToScalar()));
+
+            // including the refined shadows of the scalar type, which alias the vector shadow below
+            if (supportArrayRefinement && comp->getMethodSymbol()->hasVeryRefinedAliasSets())
+               {
+               TR::DataType scalarType = _symbol->getDataType().vectorToScalar();
+               TR_BitVectorIterator bvi(symRefTab->aliasBuilder.arrayElementSymRefs());
+               while (bvi.hasMoreElements())
+                  {
+                  int32_t symRefNum = bvi.getNextElement();
+                  if (symRefTab->getSymRef(symRefNum)->getSymbol()->getDataType() == scalarType)
+                     aliases->set(symRefNum);
+                  }
+               }
             }
          // the other way around
          if (_symbol->isArrayShadowSymbol() && !_symbol->getDataType().isVector())
@@ -785,6 +815,29 @@ OMR::SymbolReference::getUseDefAliasesBV(bool isDirectCall, bool includeGCSafePo
          TR_BitVector *aliases = NULL;
          return aliases;
          }
+      case TR::Symbol::IsAutomatic:
+      case TR::Symbol::IsParameter:
+         {
+         // An auto whose address is taken may be read or written by any
+         // indirect access and by any call
+         if (symRefTab->aliasBuilder.addressTakenAutos().get(self()->getReferenceNumber()))
+            {
+            TR_BitVector *aliases = new (aliasRegion) TR_BitVector(bvInitialSize, aliasRegion, growability);
+            *aliases |= symRefTab->aliasBuilder.addressShadowSymRefs();
+            *aliases |= symRefTab->aliasBuilder.intShadowSymRefs();
+            *aliases |= symRefTab->aliasBuilder.nonIntPrimitiveShadowSymRefs();
+            *aliases |= symRefTab->aliasBuilder.genericIntShadowSymRefs();
+            *aliases |= symRefTab->aliasBuilder.genericIntArrayShadowSymRefs();
+            *aliases |= symRefTab->aliasBuilder.genericIntNonArrayShadowSymRefs();
+            *aliases |= symRefTab->aliasBuilder.arrayElementSymRefs();
+            *aliases |= symRefTab->aliasBuilder.arrayletElementSymRefs();
+            *aliases |= symRefTab->aliasBuilder.unsafeSymRefNumbers();
+            *aliases |= symRefTab->aliasBuilder.methodSymRefs();
+            aliases->set(self()->getReferenceNumber());
+            return aliases;
+            }
+         }
+         // fall through
       default:
          //TR_ASSERT(0, "getUseDefAliasing called for non method");
          if (comp->generateArraylets() && comp->getSymRefTab()->aliasBuilder.gcSafePointSymRefNumbers().get(self()->getReferenceNumber()) && includeGCSafePoint)
@@ -828,7 +881,8 @@ OMR::SymbolReference::sharesSymbol(bool includingGCSafePoint)
          if ((self()->isUnresolved() && (_symbol->isConstantDynamic() || !_symbol->isConstObjectRef())) ||
 	       _symbol->isVolatile() || self()->isLiteralPoolAddress() ||
                self()->isFromLiteralPool() || _symbol->isUnsafeShadowSymbol() ||
-               (_symbol->isArrayShadowSymbol() && c->getMethodSymbol()->hasVeryRefinedAliasSets()))
+               (_symbol->isArrayShadowSymbol() && c->getMethodSymbol()->hasVeryRefinedAliasSets()) ||
+               (kind == TR::Symbol::IsShadow && !symRefTab->aliasBuilder.addressTakenAutos().isEmpty()))
             {
             // getUseDefAliases might not return NULL
             }
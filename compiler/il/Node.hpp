@@ -44,6 +44,11 @@ public:
       : OMR::NodeConnector(originatingByteCodeNode, op, numChildren)
       {}
 
+   Node(TR::Compilation *comp, TR::Node *originatingByteCodeNode, TR::ILOpCodes op,
+        uint16_t numChildren)
+      : OMR::NodeConnector(comp, originatingByteCodeNode, op, numChildren)
+      {}
+
    Node(Node *from, uint16_t numChildren = 0)
       : OMR::NodeConnector(from, numChildren)
       {}
@@ -1529,6 +1529,7 @@ OMR::Block::split(TR::TreeTop * startOfNewBlock, TR::CFG * cfg, bool fixupCommon
    {
    TR_Structure * structure = cfg->getStructure();
    cfg->setStructure(NULL);
+   cfg->suspendDominatorUpdates();
    TR::Compilation * comp = cfg->comp();
    comp->setCurrentBlock(self());
    TR::Node * startNode = startOfNewBlock->getNode();
@@ -1549,7 +1550,7 @@ OMR::Block::split(TR::TreeTop * startOfNewBlock, TR::CFG * cfg, bool fixupCommon
       self()->uncommonNodesBetweenBlocks(comp, block2, methodSymbol);
       }
 
-   self()->moveSuccessors(block2);
+   cfg->moveSuccessors(self(), block2);
    cfg->addEdge(self(), block2);
    if (copyExceptionSuccessors)
       cfg->copyExceptionSuccessors(self(), block2);
@@ -1608,6 +1609,11 @@ OMR::Block::split(TR::TreeTop * startOfNewBlock, TR::CFG * cfg, bool fixupCommon
          }
       }
 
+   // The dominator tree is not updated in place for a split; it is rebuilt
+   // when next asked for
+   //
+   cfg->resumeDominatorUpdates(false);
+
    cfg->setStructure(structure);
 
    return block2;
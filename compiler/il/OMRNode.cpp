@@ -131,6 +131,11 @@ OMR::Node::~Node()
    }
 
 OMR::Node::Node(TR::Node *originatingByteCodeNode, TR::ILOpCodes op, uint16_t numChildren)
+   : Node(TR::comp(), originatingByteCodeNode, op, numChildren)
+   {
+   }
+
+OMR::Node::Node(TR::Compilation *comp, TR::Node *originatingByteCodeNode, TR::ILOpCodes op, uint16_t numChildren)
    : _opCode(op),
      _numChildren(numChildren),
      //_globalIndex(0),
@@ -142,9 +147,7 @@ OMR::Node::Node(TR::Node *originatingByteCodeNode, TR::ILOpCodes op, uint16_t nu
      _unionBase(),
      _unionPropertyA()
    {
-   TR::Compilation * comp = TR::comp();
-
-   if (!comp->isPeekingMethod() && self()->uses64BitGPRs())
+   if (!comp->isPeekingMethod() && self()->uses64BitGPRs(comp))
       comp->getJittedMethodSymbol()->setMayHaveLongOps(true);
 
    uint16_t numElems = numChildren;
@@ -598,9 +601,15 @@ OMR::Node::recreateAndCopyValidPropertiesImpl(TR::Node *originalNode, TR::ILOpCo
 
 TR::Node *
 OMR::Node::createInternal(TR::Node *originatingByteCodeNode, TR::ILOpCodes op, uint16_t numChildren, TR::Node *originalNode)
+   {
+   return TR::Node::createInternal(TR::comp(), originatingByteCodeNode, op, numChildren, originalNode);
+   }
+
+TR::Node *
+OMR::Node::createInternal(TR::Compilation *comp, TR::Node *originatingByteCodeNode, TR::ILOpCodes op, uint16_t numChildren, TR::Node *originalNode)
    {
    if (!originalNode)
-      return new (TR::comp()->getNodePool()) TR::Node(originatingByteCodeNode, op, numChildren);
+      return new (comp->getNodePool()) TR::Node(comp, originatingByteCodeNode, op, numChildren);
    else
       {
       // Recreate node from originalNode, ignore originatingByteCodeNode
@@ -611,7 +620,7 @@ OMR::Node::createInternal(TR::Node *originatingByteCodeNode, TR::ILOpCodes op, u
       UnionA unionA = originalNode->_unionA;
       const TR_ByteCodeInfo byteCodeInfo = originalNode->getByteCodeInfo();  // copy bytecode info into temporary variable
       //TR::Node * node = new (TR::comp()->getNodePool(), poolIndex) TR::Node(0, op, numChildren);
-      TR::Node *node = new ((void*)originalNode) TR::Node(0, op, numChildren);
+      TR::Node *node = new ((void*)originalNode) TR::Node(comp, 0, op, numChildren);
       node->setGlobalIndex(globalIndex);
       node->setByteCodeInfo(byteCodeInfo);
 
@@ -924,6 +933,76 @@ OMR::Node::create(TR::ILOpCodes op, uint16_t numChildren, TR::Node *first, TR::N
    }
 
 
+
+TR::Node *
+OMR::Node::createWithComp(TR::Compilation *comp, TR::ILOpCodes op, uint16_t numChildren)
+   {
+   TR_ASSERT(TR::Node::isLegalCallToCreate(op), "assertion failure");
+   return TR::Node::createInternal(comp, 0, op, numChildren);
+   }
+
+TR::Node *
+OMR::Node::createWithComp(TR::Compilation *comp, TR::ILOpCodes op, uint16_t numChildren, TR::Node *first)
+   {
+   TR_ASSERT(TR::Node::isLegalCallToCreate(op), "assertion failure");
+   TR::Node *node = TR::Node::createInternal(comp, first, op, numChildren);
+   node->setAndIncChild(0, first);
+   return node;
+   }
+
+TR::Node *
+OMR::Node::createWithComp(TR::Compilation *comp, TR::ILOpCodes op, uint16_t numChildren, TR::Node *first, TR::Node *second)
+   {
+   TR::Node *node = TR::Node::createWithComp(comp, op, numChildren, first);
+   node->setAndIncChild(1, second);
+   return node;
+   }
+
+TR::Node *
+OMR::Node::createWithComp(TR::Compilation *comp, TR::ILOpCodes op, uint16_t numChildren, TR::Node *first, TR::Node *second, TR::Node *third)
+   {
+   TR::Node *node = TR::Node::createWithComp(comp, op, numChildren, first, second);
+   node->setAndIncChild(2, third);
+   return node;
+   }
+
+TR::Node *
+OMR::Node::createWithSymRefWithComp(TR::Compilation *comp, TR::ILOpCodes op, uint16_t numChildren, TR::SymbolReference *symRef)
+   {
+   TR::Node *node = TR::Node::createInternal(comp, 0, op, numChildren);
+   node->setSymbolReference(symRef);
+   return node;
+   }
+
+TR::Node *
+OMR::Node::createWithSymRefWithComp(TR::Compilation *comp, TR::ILOpCodes op, uint16_t numChildren, TR::Node *first, TR::SymbolReference *symRef)
+   {
+   TR::Node *node = TR::Node::createInternal(comp, first, op, numChildren);
+   node->setAndIncChild(0, first);
+   node->setSymbolReference(symRef);
+   return node;
+   }
+
+TR::Node *
+OMR::Node::createWithSymRefWithComp(TR::Compilation *comp, TR::ILOpCodes op, uint16_t numChildren, TR::Node *first, TR::Node *second, TR::SymbolReference *symRef)
+   {
+   TR::Node *node = TR::Node::createInternal(comp, first, op, numChildren);
+   node->setAndIncChild(0, first);
+   node->setAndIncChild(1, second);
+   node->setSymbolReference(symRef);
+   return node;
+   }
+
+TR::Node *
+OMR::Node::createLoadWithComp(TR::Compilation *comp, TR::SymbolReference *symRef)
+   {
+   TR::Node *load = TR::Node::createWithSymRefWithComp(comp, comp->il.opCodeForDirectLoad(symRef->getSymbol()->getDataType()), 0, symRef);
+   if (symRef->getSymbol()->isParm())
+      symRef->getSymbol()->getParmSymbol()->setReferencedParameter();
+   return load;
+   }
+
+
 TR::Node *
 OMR::Node::recreateWithoutProperties(TR::Node *originalNode, TR::ILOpCodes op, uint16_t numChildren, TR::Node *first)
    {
@@ -2821,8 +2900,13 @@ OMR::Node::performsVolatileAccess(vcount_t visitCount)
 bool
 OMR::Node::uses64BitGPRs()
    {
-   TR::Compilation * c = TR::comp();
-   return self()->getOpCode().isLong()  || c->cg()->usesImplicit64BitGPRs(self());
+   return self()->uses64BitGPRs(TR::comp());
+   }
+
+bool
+OMR::Node::uses64BitGPRs(TR::Compilation *comp)
+   {
+   return self()->getOpCode().isLong()  || comp->cg()->usesImplicit64BitGPRs(self());
    }
 
 
@@ -6083,6 +6167,34 @@ OMR::Node::setIsSafeForCGToFastPathUnsafeCall(bool v)
 
 
 
+bool
+OMR::Node::isTailCall()
+   {
+   TR_ASSERT(self()->getOpCode().isCall(), "Opcode must be a call");
+   return _flags.testAny(tailCall);
+   }
+
+void
+OMR::Node::setIsTailCall(bool v)
+   {
+   TR_ASSERT(self()->getOpCode().isCall(), "Opcode must be a call");
+   _flags.set(tailCall, v);
+   }
+
+bool
+OMR::Node::chkTailCall()
+   {
+   return self()->getOpCode().isCall() && _flags.testAny(tailCall);
+   }
+
+const char *
+OMR::Node::printIsTailCall()
+   {
+   return self()->chkTailCall() ? "tailCall " : "";
+   }
+
+
+
 bool
 OMR::Node::containsCompressionSequence()
    {
@@ -8696,3 +8808,29 @@ OMR::Node::isPotentialOSRPointHelperCall()
 
    return false;
    }
+
+bool
+OMR::Node::isMultiplyOverflowCheck()
+   {
+   TR::ILOpCodes op = self()->getOpCodeValue();
+   if (op != TR::ificmpne && op != TR::iflcmpne)
+      return false;
+
+   bool is64Bit = (op == TR::iflcmpne);
+   TR::Node *high = self()->getFirstChild();
+   TR::Node *shift = self()->getSecondChild();
+   if (high->getOpCodeValue() != (is64Bit ? TR::lmulh : TR::imulh) ||
+       shift->getOpCodeValue() != (is64Bit ? TR::lshr : TR::ishr))
+      return false;
+
+   // The high half of the product must be the sign extension of the low half
+   TR::Node *product = shift->getFirstChild();
+   TR::Node *amount = shift->getSecondChild();
+   if (product->getOpCodeValue() != (is64Bit ? TR::lmul : TR::imul) ||
+       amount->getOpCodeValue() != TR::iconst ||
+       amount->getInt() != (is64Bit ? 63 : 31))
+      return false;
+
+   return (product->getFirstChild() == high->getFirstChild() && product->getSecondChild() == high->getSecondChild()) ||
+          (product->getFirstChild() == high->getSecondChild() && product->getSecondChild() == high->getFirstChild());
+   }
@@ -143,11 +143,17 @@ protected:
 
    Node(TR::Node *originatingByteCodeNode, TR::ILOpCodes op, uint16_t numChildren);
 
+   // Same as above for callers that already hold the compilation, saving the
+   // thread local lookup of TR::comp() on every node created
+   //
+   Node(TR::Compilation *comp, TR::Node *originatingByteCodeNode, TR::ILOpCodes op, uint16_t numChildren);
+
    Node(TR::Node *from, uint16_t numChildren = 0);
 
    static void copyValidProperties(TR::Node *fromNode, TR::Node *toNode);
 
    static TR::Node *createInternal(TR::Node *originatingByteCodeNode, TR::ILOpCodes op, uint16_t numChildren, TR::Node *originalNode = 0);
+   static TR::Node *createInternal(TR::Compilation *comp, TR::Node *originatingByteCodeNode, TR::ILOpCodes op, uint16_t numChildren, TR::Node *originalNode = 0);
 
 /**
  * Public constructors and helpers
@@ -237,6 +243,20 @@ public:
    static TR::Node *create(TR::ILOpCodes op, uint16_t numChildren, TR::Node *first, TR::Node *second, TR::Node *third, TR::Node *fourth, TR::Node *fifth, TR::Node *sixth, TR::Node *seventh);
    static TR::Node *create(TR::ILOpCodes op, uint16_t numChildren, TR::Node *first, TR::Node *second, TR::Node *third, TR::Node *fourth, TR::Node *fifth, TR::Node *sixth, TR::Node *seventh, TR::Node *eighth);
 
+   // create methods for IL generators that already hold the compilation, saving the
+   // thread local lookup of TR::comp() on every node created.  They are named apart
+   // from create so that they cannot be confused with the originating node overloads
+   // when called with a null pointer
+   //
+   static TR::Node *createWithComp(TR::Compilation *comp, TR::ILOpCodes op, uint16_t numChildren = 0);
+   static TR::Node *createWithComp(TR::Compilation *comp, TR::ILOpCodes op, uint16_t numChildren, TR::Node *first);
+   static TR::Node *createWithComp(TR::Compilation *comp, TR::ILOpCodes op, uint16_t numChildren, TR::Node *first, TR::Node *second);
+   static TR::Node *createWithComp(TR::Compilation *comp, TR::ILOpCodes op, uint16_t numChildren, TR::Node *first, TR::Node *second, TR::Node *third);
+   static TR::Node *createWithSymRefWithComp(TR::Compilation *comp, TR::ILOpCodes op, uint16_t numChildren, TR::SymbolReference *symRef);
+   static TR::Node *createWithSymRefWithComp(TR::Compilation *comp, TR::ILOpCodes op, uint16_t numChildren, TR::Node *first, TR::SymbolReference *symRef);
+   static TR::Node *createWithSymRefWithComp(TR::Compilation *comp, TR::ILOpCodes op, uint16_t numChildren, TR::Node *first, TR::Node *second, TR::SymbolReference *symRef);
+   static TR::Node *createLoadWithComp(TR::Compilation *comp, TR::SymbolReference *symRef);
+
    static TR::Node *recreateWithoutProperties(TR::Node *originalNode, TR::ILOpCodes op, uint16_t numChildren, TR::Node *first);
    static TR::Node *recreateWithoutProperties(TR::Node *originalNode, TR::ILOpCodes op, uint16_t numChildren, TR::Node *first, TR::Node *second);
    static TR::Node *recreateWithoutProperties(TR::Node *originalNode, TR::ILOpCodes op, uint16_t numChildren, TR::Node *first, TR::Node *second, TR::Node *third);
@@ -513,6 +533,7 @@ public:
    bool                   performsVolatileAccess(vcount_t visitCount);
 
    bool                   uses64BitGPRs();
+   bool                   uses64BitGPRs(TR::Compilation *comp);
 
    bool                   isRematerializable(TR::Node *parent, bool onlyConsiderOpCode);
 
@@ -544,6 +565,13 @@ public:
     *    Return true if the node is a call with potentialOSRPointHelperSymbol
     */
    bool                   isPotentialOSRPointHelperCall();
+   /**
+    * \brief
+    *    Return true if the node is an ificmpne or iflcmpne that branches
+    *    when the product of two values overflows, in the form
+    *    ifxcmpne (xmulh a b) (xshr (xmul a b) (iconst bits-1))
+    */
+   bool                   isMultiplyOverflowCheck();
 
    // A common query used by the optimizer
    inline bool            isSingleRef();
@@ -1138,6 +1166,11 @@ public:
    bool isSafeForCGToFastPathUnsafeCall();
    void setIsSafeForCGToFastPathUnsafeCall(bool v);
 
+   bool isTailCall();
+   void setIsTailCall(bool v);
+   bool chkTailCall();
+   const char * printIsTailCall();
+
    // Flag used by TR::ladd and TR::lsub or by TR::lshl and TR::lshr for compressedPointers
    bool containsCompressionSequence();
    void setContainsCompressionSequence(bool v);
@@ -1908,6 +1941,7 @@ protected:
       desynchronizeCall                     = 0x00020000,
       preparedForDirectToJNI                = 0x00040000, // TODO: make J9_PROJECT_SPECIFIC
       unsafeFastPathCall                    = 0x00080000, // TODO: make J9_PROJECT_SPECIFIC
+      tailCall                              = 0x00100000, ///< call in tail position that reuses the caller's frame
 
       // Flag used by TR::ladd and TR::lsub or by TR::lshl and TR::lshr for compressedPointers
       isCompressionSequence                 = 0x00000800,
@@ -125,6 +125,8 @@ public:
       HasCheckCasts                 = 0x00000004,
       HasInstanceOfs                = 0x00000008,
       HasBranches                   = 0x00000010,
+      PureFunction                  = 0x00000020, ///< result depends only on the arguments, no memory is read or written
+      ReadOnlyFunction              = 0x00000040, ///< memory may be read but is never written
       dummyLastFlag2
       };
 
@@ -194,7 +196,11 @@ public:
    bool safeToSkipZeroInitializationOnNewarrays() { return false; }
    bool safeToSkipChecksOnArrayCopies() { return false; }
 
-   bool isPureFunction() { return false; }
+   void setIsPureFunction(bool b = true)       { _methodFlags2.set(PureFunction, b); }
+   bool isPureFunction()                       { return _methodFlags2.testAny(PureFunction); }
+
+   void setIsReadOnlyFunction(bool b = true)   { _methodFlags2.set(ReadOnlyFunction, b); }
+   bool isReadOnlyFunction()                   { return _methodFlags2.testAny(ReadOnlyFunction); }
 
 protected:
 
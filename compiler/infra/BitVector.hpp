@@ -729,7 +729,9 @@ class TR_BitVector
          return; // All relevant bits are already reset
       if (lastChunk >= _numChunks)
          {
-         setChunkSize(getChunkIndex(n));
+         // Bits beyond the allocated chunks are already reset
+         lastChunk = _numChunks - 1;
+         n = getBitIndex(_numChunks) - 1;
          }
 
       if (firstChunk == lastChunk)
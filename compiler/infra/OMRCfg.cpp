@@ -50,10 +50,12 @@
 #include "infra/Stack.hpp"
 #include "infra/CfgEdge.hpp"
 #include "infra/CfgNode.hpp"
+#include "optimizer/Dominators.hpp"
 #include "optimizer/Optimizer.hpp"
 #include "optimizer/Structure.hpp"
 #include "optimizer/StructuralAnalysis.hpp"
 #include "ras/Debug.hpp"
+#include "ras/DebugCounter.hpp"
 
 #ifdef __MVS__
 #include <stdlib.h>
@@ -72,10 +74,12 @@ OMR::CFG::addNode(TR::CFGNode *n, TR_RegionStructure *parent, bool isEntryInPare
    {
    _nodes.add(n);
    n->setNumber(allocateNodeNumber());
+   updateDominatorsForNewNode(n);
 
    if (parent &&
        getStructure())
       {
+      _numStructureEdits++;
       TR::Block *block = n->asBlock();
       if (block)
          {
@@ -130,11 +134,13 @@ OMR::CFG::addEdge(TR::CFGEdge *e)
       }
 
      _numEdges++;
+   updateDominatorsForNewEdge(e->getFrom(), e->getTo(), false);
 
    // Tell the control tree to modify the structures containing this edge
    //
    if (getStructure() != NULL)
       {
+      _numStructureEdits++;
       getStructure()->addEdge(e, false);
       if (comp()->getOption(TR_TraceAddAndRemoveEdge))
          {
@@ -212,11 +218,13 @@ OMR::CFG::addExceptionEdge(
       }
    TR::CFGEdge* e = TR::CFGEdge::createExceptionEdge(f,t, _internalRegion);
    _numEdges++;
+   updateDominatorsForNewEdge(f, t, true);
 
    // Tell the control tree to modify the structures containing this edge
    //
    if (getStructure() != NULL)
       {
+      _numStructureEdits++;
       getStructure()->addEdge(e, true);
       if (comp()->getOption(TR_TraceAddAndRemoveEdge))
          {
@@ -341,6 +349,300 @@ OMR::CFG::setStructure(TR_Structure *p)
    return (_rootStructure = p);
    }
 
+static uint64_t
+mixDominatorsSignature(uint64_t key)
+   {
+   key ^= key >> 30;
+   key *= 0xbf58476d1ce4e5b9ULL;
+   key ^= key >> 27;
+   key *= 0x94d049bb133111ebULL;
+   key ^= key >> 31;
+   return key;
+   }
+
+static uint64_t
+nodeSignature(TR::CFGNode *node)
+   {
+   return mixDominatorsSignature(((uint64_t)(uint32_t)node->getNumber() << 32) | 0xffffffffULL);
+   }
+
+static uint64_t
+edgeSignature(TR::CFGNode *from, TR::CFGNode *to, bool isException)
+   {
+   return mixDominatorsSignature((((uint64_t)(uint32_t)from->getNumber() << 32) | (uint32_t)to->getNumber()) * 2 + (isException ? 1 : 0));
+   }
+
+// The signature is a sum rather than an exclusive or, so that an edge added
+// twice does not cancel itself out
+//
+uint64_t
+OMR::CFG::computeDominatorsSignature()
+   {
+   uint64_t signature = 0;
+   for (TR::CFGNode *node = getFirstNode(); node; node = node->getNext())
+      {
+      signature += nodeSignature(node);
+      for (auto e = node->getSuccessors().begin(); e != node->getSuccessors().end(); ++e)
+         signature += edgeSignature(node, (*e)->getTo(), false);
+      for (auto e = node->getExceptionSuccessors().begin(); e != node->getExceptionSuccessors().end(); ++e)
+         signature += edgeSignature(node, (*e)->getTo(), true);
+      }
+   return signature;
+   }
+
+// Compare a dominator tree that is about to be reused, and may have been
+// updated in place, with one built from scratch.  Enabled by the
+// TR_VerifyDominators environment variable.
+//
+static void
+verifyDominators(TR::Compilation *comp, TR_Dominators *dominators)
+   {
+   TR_Dominators rebuilt(comp);
+   for (TR::CFGNode *node = comp->getFlowGraph()->getFirstNode(); node; node = node->getNext())
+      {
+      TR::Block *block = toBlock(node);
+      TR::Block *expected = rebuilt.getDominator(block);
+      TR::Block *actual = dominators->getDominator(block);
+      TR_ASSERT_FATAL(actual == expected, "%s: reused dominator of block_%d is block_%d, rebuilt tree has block_%d",
+         comp->signature(), block->getNumber(), actual ? actual->getNumber() : -1, expected ? expected->getNumber() : -1);
+      }
+   }
+
+TR_Dominators *
+OMR::CFG::getDominators(bool needsDepthFirstNumbers)
+   {
+   TR_ASSERT(comp()->getFlowGraph() == self(), "dominators are only kept for the compilation's flow graph");
+   TR_ASSERT(!_dominatorUpdatesSuspended, "dominators requested in the middle of a CFG edit");
+
+   if (_dominators)
+      {
+      if (computeDominatorsSignature() != _dominatorsSignature)
+         {
+         dumpOptDetails(comp(), "   (Dominators are out of date after edits made outside the CFG)\n");
+         invalidateDominators();
+         }
+      else if (needsDepthFirstNumbers && !_dominatorsAreDepthFirst)
+         {
+         invalidateDominators();
+         }
+      else
+         {
+         _numDominatorReuses++;
+         if (_dominatorEdits > 0)
+            {
+            _numDominatorReusesAfterEdits++;
+            TR::DebugCounter::incStaticDebugCounter(comp(), "dominators/reusedAfterEdits");
+            dumpOptDetails(comp(), "   (Reusing dominators updated for %d CFG edits)\n", _dominatorEdits);
+            }
+         else
+            dumpOptDetails(comp(), "   (Reusing dominators)\n");
+
+         static char *verify = feGetEnv("TR_VerifyDominators");
+         if (verify)
+            verifyDominators(comp(), _dominators);
+
+         _dominatorEdits = 0;
+         _dominators->resetUpdateCost();
+         return _dominators;
+         }
+      }
+
+   dumpOptDetails(comp(), "   (Building dominators)\n");
+   _dominators = new (trHeapMemory()) TR_Dominators(comp());
+   _dominatorsSignature = computeDominatorsSignature();
+   _dominatorEdits = 0;
+   _dominatorsAreDepthFirst = true;
+   _numDominatorBuilds++;
+   return _dominators;
+   }
+
+void
+OMR::CFG::invalidateDominators()
+   {
+   if (!_dominators)
+      return;
+
+   dumpOptDetails(comp(), "     (Invalidating dominators)\n");
+   _dominators->~TR_Dominators();
+   _dominators = NULL;
+   }
+
+void
+OMR::CFG::suspendDominatorUpdates()
+   {
+   // A compound edit inside another can't be followed by either of them
+   //
+   if (_dominatorUpdatesSuspended)
+      invalidateDominators();
+   _dominatorUpdatesSuspended++;
+   _firstNodeNumberWhileSuspended = getNextNodeNumber();
+   }
+
+void
+OMR::CFG::resumeDominatorUpdates(bool updated)
+   {
+   TR_ASSERT(_dominatorUpdatesSuspended > 0, "dominator updates were not suspended");
+   _dominatorUpdatesSuspended--;
+
+   // The caller's update only accounts for the blocks it knows it added, so
+   // check that no other new block has been left out of the tree.  New nodes
+   // are at the head of the list.
+   //
+   for (TR::CFGNode *node = getFirstNode(); updated && node && node->getNumber() >= _firstNodeNumberWhileSuspended; node = node->getNext())
+      {
+      if (_dominators && !_dominators->isReachable(toBlock(node)) &&
+          (!node->getPredecessors().empty() || !node->getExceptionPredecessors().empty()))
+         updated = false;
+      }
+
+   updateDominators(updated);
+   }
+
+void
+OMR::CFG::updateDominators(bool updated)
+   {
+   if (!_dominators)
+      return;
+
+   // Past this point rebuilding the tree costs less than keeping it up to date
+   //
+   if (!updated || _dominators->getUpdateCost() > 16 * getNumberOfNodes())
+      invalidateDominators();
+   }
+
+void
+OMR::CFG::updateDominatorsForNewNode(TR::CFGNode *node)
+   {
+   if (!_dominators)
+      return;
+
+   _dominatorsSignature += nodeSignature(node);
+   _dominatorEdits++;
+   _dominatorsAreDepthFirst = false;
+   _dominators->addBlock(toBlock(node));
+
+   // Edges to the block that were linked up before it was added to the CFG
+   // are accounted for now that it has a number
+   //
+   bool updated = true;
+   TR::Block *block = toBlock(node);
+   for (auto e = node->getPredecessors().begin(); e != node->getPredecessors().end(); ++e)
+      {
+      if ((*e)->getFrom()->getNumber() < 0)
+         continue;
+      _dominatorsSignature += edgeSignature((*e)->getFrom(), node, false);
+      updated = updated && _dominators->addEdge(toBlock((*e)->getFrom()), block);
+      }
+   for (auto e = node->getExceptionPredecessors().begin(); e != node->getExceptionPredecessors().end(); ++e)
+      {
+      if ((*e)->getFrom()->getNumber() < 0)
+         continue;
+      _dominatorsSignature += edgeSignature((*e)->getFrom(), node, true);
+      updated = updated && _dominators->addEdge(toBlock((*e)->getFrom()), block);
+      }
+   for (auto e = node->getSuccessors().begin(); e != node->getSuccessors().end(); ++e)
+      {
+      if ((*e)->getTo()->getNumber() < 0 || (*e)->getTo() == node)
+         continue;
+      _dominatorsSignature += edgeSignature(node, (*e)->getTo(), false);
+      updated = updated && _dominators->addEdge(block, toBlock((*e)->getTo()));
+      }
+   for (auto e = node->getExceptionSuccessors().begin(); e != node->getExceptionSuccessors().end(); ++e)
+      {
+      if ((*e)->getTo()->getNumber() < 0 || (*e)->getTo() == node)
+         continue;
+      _dominatorsSignature += edgeSignature(node, (*e)->getTo(), true);
+      updated = updated && _dominators->addEdge(block, toBlock((*e)->getTo()));
+      }
+
+   if (!_dominatorUpdatesSuspended)
+      updateDominators(updated);
+   }
+
+void
+OMR::CFG::updateDominatorsForRemovedNode(TR::CFGNode *node)
+   {
+   if (!_dominators)
+      return;
+
+   _dominatorsSignature -= nodeSignature(node);
+   _dominatorEdits++;
+   _dominatorsAreDepthFirst = false;
+   if (!_dominatorUpdatesSuspended)
+      updateDominators(!_dominators->isReachable(toBlock(node)));
+   }
+
+void
+OMR::CFG::updateDominatorsForNewEdge(TR::CFGNode *from, TR::CFGNode *to, bool isException)
+   {
+   if (!_dominators)
+      return;
+
+   // A block can be linked up before it is added to the CFG, in which case
+   // the edge is accounted for when it is added
+   //
+   if (from->getNumber() < 0 || to->getNumber() < 0)
+      return;
+
+   _dominatorsSignature += edgeSignature(from, to, isException);
+   _dominatorEdits++;
+   _dominatorsAreDepthFirst = false;
+   if (!_dominatorUpdatesSuspended)
+      updateDominators(_dominators->addEdge(toBlock(from), toBlock(to)));
+   }
+
+void
+OMR::CFG::updateDominatorsForRemovedEdge(TR::CFGNode *from, TR::CFGNode *to, bool isException)
+   {
+   if (!_dominators)
+      return;
+
+   if (from->getNumber() < 0 || to->getNumber() < 0)
+      return;
+
+   _dominatorsSignature -= edgeSignature(from, to, isException);
+   _dominatorEdits++;
+   _dominatorsAreDepthFirst = false;
+   if (!_dominatorUpdatesSuspended)
+      updateDominators(_dominators->removeEdge(toBlock(from), toBlock(to)));
+   }
+
+void
+OMR::CFG::moveSuccessors(TR::CFGNode *from, TR::CFGNode *to)
+   {
+   if (_dominators)
+      {
+      for (auto e = from->getSuccessors().begin(); e != from->getSuccessors().end(); ++e)
+         _dominatorsSignature += edgeSignature(to, (*e)->getTo(), false) - edgeSignature(from, (*e)->getTo(), false);
+      _dominatorEdits++;
+      _dominatorsAreDepthFirst = false;
+      if (!_dominatorUpdatesSuspended)
+         invalidateDominators();
+      }
+   from->moveSuccessors(to);
+   }
+
+void
+OMR::CFG::accountForMergedBlocks(TR::CFGNode *block, TR::CFGNode *next)
+   {
+   if (!_dominators)
+      return;
+
+   _dominatorsSignature -= nodeSignature(next) + edgeSignature(block, next, false);
+   for (auto e = next->getSuccessors().begin(); e != next->getSuccessors().end(); ++e)
+      _dominatorsSignature += edgeSignature(block, (*e)->getTo(), false) - edgeSignature(next, (*e)->getTo(), false);
+   for (auto e = next->getExceptionSuccessors().begin(); e != next->getExceptionSuccessors().end(); ++e)
+      {
+      _dominatorsSignature -= edgeSignature(next, (*e)->getTo(), true);
+      if (getStructure())
+         _dominatorsSignature += edgeSignature(block, (*e)->getTo(), true);
+      }
+   _dominatorEdits++;
+   _dominatorsAreDepthFirst = false;
+   if (!_dominatorUpdatesSuspended)
+      invalidateDominators();
+   }
+
 /**
  * Default predicate for copyExceptionSuccessors.
  */
@@ -678,6 +980,7 @@ TR::CFGNode *OMR::CFG::removeNode(TR::CFGNode *node)
       return 0;
 
    _nodes.remove(node);
+   updateDominatorsForRemovedNode(node);
    if (comp()->getOption(TR_TraceAddAndRemoveEdge))
       traceMsg(comp(),"\nRemoving node %d\n", node->getNumber());
 
@@ -782,6 +1085,7 @@ bool OMR::CFG::removeEdge(TR::CFGEdge *edge)
    _mightHaveUnreachableBlocks = true;
 
    bool found = false;
+   bool isException = false;
 
    if (std::find(from->getSuccessors().begin(), from->getSuccessors().end(), edge) != from->getSuccessors().end()) {
       found = true;
@@ -789,6 +1093,7 @@ bool OMR::CFG::removeEdge(TR::CFGEdge *edge)
    }
    else if (std::find(from->getExceptionSuccessors().begin(), from->getExceptionSuccessors().end(), edge) != from->getExceptionSuccessors().end()) {
       found = true;
+      isException = true;
       from->getExceptionSuccessors().remove(edge);
    }
 
@@ -805,6 +1110,7 @@ bool OMR::CFG::removeEdge(TR::CFGEdge *edge)
       return false;
 
    _numEdges--;
+   updateDominatorsForRemovedEdge(from, to, isException);
 
    if (comp()->getOption(TR_TraceAddAndRemoveEdge))
       traceMsg(comp(), "\nRemoving edge %d-->%d (depth %d):\n", from->getNumber(), to->getNumber(), _removeEdgeNestingDepth);
@@ -835,6 +1141,7 @@ bool OMR::CFG::removeEdge(TR::CFGEdge *edge)
    //
    if (getStructure())
       {
+      _numStructureEdits++;
       TR_Structure *fromStruct   = toBlock(from)->getStructureOf();
       TR_Structure *toStruct   = toBlock(to)->getStructureOf();
       if (fromStruct && toStruct)
@@ -881,14 +1188,19 @@ bool OMR::CFG::removeEdge(TR::CFGEdge *edge)
 
             if (comp()->getOption(TR_TraceAddAndRemoveEdge))
                traceMsg(comp(), "\n2Removing edge %d-->%d (depth %d):\n", from->getNumber(), to->getNumber(), _removeEdgeNestingDepth);
+            bool isExceptionEdge = false;
             if (std::find(from->getSuccessors().begin(), from->getSuccessors().end(), e) != from->getSuccessors().end())
                from->getSuccessors().remove(e);
             else
+               {
+               isExceptionEdge = true;
                from->getExceptionSuccessors().remove(e);
+               }
             if (std::find(to->getPredecessors().begin(), to->getPredecessors().end(), e) != to->getPredecessors().end())
                to->getPredecessors().remove(e);
             else
                to->getExceptionPredecessors().remove(e);
+            updateDominatorsForRemovedEdge(from, to, isExceptionEdge);
 
             // break cycles by not adding 'to' that is
             // already in the removed list
@@ -940,6 +1252,7 @@ bool OMR::CFG::removeEdge(TR::CFGEdge *edge)
             {
             if (_nodes.remove(n))
                {
+               updateDominatorsForRemovedNode(n);
                if (comp()->getOption(TR_TraceAddAndRemoveEdge))
                   traceMsg(comp(),"\nRemoved node %d\n", n->getNumber());
 
@@ -993,14 +1306,19 @@ bool OMR::CFG::removeEdge(TR::CFGEdge *edge, bool recursiveImpl)
 
    _numEdges--;
    _mightHaveUnreachableBlocks = true;
+   bool isException = false;
    if (std::find(from->getSuccessors().begin(), from->getSuccessors().end(), edge) != from->getSuccessors().end())
 	  from->getSuccessors().remove(edge);
    else
+      {
+      isException = true;
 	  from->getExceptionSuccessors().remove(edge);
+      }
    if (std::find(to->getPredecessors().begin(), to->getPredecessors().end(), edge) != to->getPredecessors().end())
 	  to->getPredecessors().remove(edge);
    else
       to->getExceptionPredecessors().remove(edge);
+   updateDominatorsForRemovedEdge(from, to, isException);
 
    bool blocksWereRemoved = false;
 
@@ -1059,6 +1377,7 @@ bool OMR::CFG::removeEdge(TR::CFGEdge *edge, bool recursiveImpl)
    //
    if (getStructure())
       {
+      _numStructureEdits++;
       TR_Structure *fromStruct   = toBlock(from)->getStructureOf();
       TR_Structure *toStruct   = toBlock(to)->getStructureOf();
       if (fromStruct && toStruct)
@@ -49,6 +49,7 @@ class TR_Structure;
 class TR_StructureSubGraphNode;
 class TR_BitVector;
 class TR_BlockCloner;
+class TR_Dominators;
 class TR_BlockFrequencyInfo;
 class TR_ExternalProfiler;
 namespace TR { class Block; }
@@ -136,6 +137,16 @@ class CFG
       _calledFrequency = 0;
       _initialBlockFrequency = -1;
       _edgeProbabilities = NULL;
+      _dominators = NULL;
+      _dominatorsSignature = 0;
+      _dominatorUpdatesSuspended = 0;
+      _firstNodeNumberWhileSuspended = 0;
+      _dominatorEdits = 0;
+      _dominatorsAreDepthFirst = false;
+      _numDominatorBuilds = 0;
+      _numDominatorReuses = 0;
+      _numDominatorReusesAfterEdits = 0;
+      _numStructureEdits = 0;
    }
 
    TR::CFG * self();
@@ -160,6 +171,48 @@ class CFG
    TR_Structure *setStructure(TR_Structure *p);
    TR_Structure *invalidateStructure();
 
+   /**
+    * Get the dominator tree of the CFG, which must be the compilation's flow
+    * graph.  The tree is kept from one caller to the next, and edits made
+    * through the CFG update it in place when TR_Dominators can do so exactly
+    * (edge additions and removals, merges of a block into its only
+    * predecessor) or drop it when it cannot.  A signature of the nodes and
+    * edges it was last brought up to date with catches edits made behind the
+    * CFG's back, in which case the tree is rebuilt.
+    *
+    * @param needsDepthFirstNumbers the caller relies on the depth-first
+    *        numbers of the tree, which only a tree that has not been updated
+    *        in place has
+    */
+   TR_Dominators *getDominators(bool needsDepthFirstNumbers = false);
+   TR_Dominators *getCachedDominators() { return _dominators; }
+   void invalidateDominators();
+
+   /**
+    * Stop updating the dominator tree edge by edge during a compound edit,
+    * such as a block split, whose intermediate states it cannot follow.  The
+    * caller updates the tree in one step, if it is still cached, and passes
+    * the result to resumeDominatorUpdates, or passes false to drop the tree.
+    */
+   void suspendDominatorUpdates();
+   void resumeDominatorUpdates(bool updated);
+
+   /// TR::CFGNode::moveSuccessors, keeping the dominator signature up to date.
+   void moveSuccessors(TR::CFGNode *from, TR::CFGNode *to);
+
+   /**
+    * Keep the dominator signature up to date for code that merges "next"
+    * into "block", its only predecessor, by moving the edges itself.  Must
+    * be called before any edge is moved or block renumbered.  The exception edges of "next" are
+    * moved to "block" if there is a structure and dropped otherwise.
+    */
+   void accountForMergedBlocks(TR::CFGNode *block, TR::CFGNode *next);
+
+   int32_t getNumDominatorBuilds() { return _numDominatorBuilds; }
+   int32_t getNumDominatorReuses() { return _numDominatorReuses; }
+   int32_t getNumDominatorReusesAfterEdits() { return _numDominatorReusesAfterEdits; }
+   int32_t getNumStructureEdits() { return _numStructureEdits; }
+
    TR::CFGNode *getFirstNode() {return _nodes.getFirst();}
    TR_LinkHead1<TR::CFGNode> & getNodes() {return _nodes;}
 
@@ -364,6 +417,24 @@ protected:
 
    int32_t                  _removeEdgeNestingDepth;
 
+   uint64_t computeDominatorsSignature();
+   void updateDominatorsForNewNode(TR::CFGNode *node);
+   void updateDominatorsForRemovedNode(TR::CFGNode *node);
+   void updateDominatorsForNewEdge(TR::CFGNode *from, TR::CFGNode *to, bool isException);
+   void updateDominatorsForRemovedEdge(TR::CFGNode *from, TR::CFGNode *to, bool isException);
+   void updateDominators(bool updated);
+
+   TR_Dominators           *_dominators;
+   uint64_t                 _dominatorsSignature;
+   int32_t                  _dominatorUpdatesSuspended;
+   int32_t                  _firstNodeNumberWhileSuspended;
+   int32_t                  _dominatorEdits;
+   bool                     _dominatorsAreDepthFirst;
+   int32_t                  _numDominatorBuilds;
+   int32_t                  _numDominatorReuses;
+   int32_t                  _numDominatorReusesAfterEdits;
+   int32_t                  _numStructureEdits;
+
    int32_t                  _maxFrequency;
    int32_t                  _maxEdgeFrequency;
    int32_t                  _oldMaxFrequency;
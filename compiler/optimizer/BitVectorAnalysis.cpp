@@ -89,20 +89,46 @@ performAnalysis(TR_Structure *rootStructure,
    return true;
    }
 
+// Problems smaller than this always have their containers pre-sized: the
+// sets are cheap to allocate and the pre-sized vectors avoid any regrowth.
+//
+#define LAZY_CONTAINER_MIN_BITS        2048
+#define LAZY_CONTAINER_MIN_TOTAL_BITS  (8 * 1024 * 1024)
+
+template<class Container>
+bool
+TR_BasicDFSetAnalysis<Container *>::
+shouldSizeContainersLazily()
+   {
+   if (comp()->getOption(TR_DisableLazyDFSets) || !setsAreMostlyEmpty())
+      return false;
+
+   // A pre-sized container costs _numberOfBits for every CFG node.  A lazily
+   // sized one costs nothing while its set is empty, but is reallocated each
+   // time it grows, and the old storage is only reclaimed with the stack
+   // region.  That loses when the sets fill up, as reaching definitions' do.
+   //
+   int64_t denseBits = (int64_t)_numberOfBits * _numberOfNodes;
+   return _numberOfBits >= LAZY_CONTAINER_MIN_BITS &&
+          denseBits >= LAZY_CONTAINER_MIN_TOTAL_BITS;
+   }
+
 template<class Container>
 void
 TR_BasicDFSetAnalysis<Container *>::
-allocateContainer(Container **result, bool, bool)
+allocateContainer(Container **result, bool isSparse, bool)
    {
-   *result = new (trStackMemory()) Container(_numberOfBits, trMemory(), stackAlloc);
+   int32_t initialBits = (isSparse && _sizeContainersLazily) ? 0 : _numberOfBits;
+   *result = new (trStackMemory()) Container(initialBits, trMemory(), stackAlloc);
    }
 
 template<class Container>
 void
 TR_BasicDFSetAnalysis<Container *>::
-allocateBlockInfoContainer(Container **result, bool, bool)
+allocateBlockInfoContainer(Container **result, bool isSparse, bool)
    {
-   *result =  new (trStackMemory()) Container(_numberOfBits, trMemory(), stackAlloc);
+   int32_t initialBits = (isSparse && _sizeContainersLazily) ? 0 : _numberOfBits;
+   *result =  new (trStackMemory()) Container(initialBits, trMemory(), stackAlloc);
    }
 
 template<class Container>
@@ -110,7 +136,8 @@ void
 TR_BasicDFSetAnalysis<Container *>::
 allocateBlockInfoContainer(Container **result, Container*)
    {
-   *result =  new (trStackMemory()) Container(_numberOfBits, trMemory(), stackAlloc);
+   int32_t initialBits = _sizeContainersLazily ? 0 : _numberOfBits;
+   *result =  new (trStackMemory()) Container(initialBits, trMemory(), stackAlloc);
    }
 
 template<class Container>
@@ -118,7 +145,8 @@ void
 TR_BasicDFSetAnalysis<Container *>::
 allocateTempContainer(Container **result, Container*)
    {
-   *result =  new (trStackMemory()) Container(_numberOfBits, trMemory(), stackAlloc);
+   int32_t initialBits = _sizeContainersLazily ? 0 : _numberOfBits;
+   *result =  new (trStackMemory()) Container(initialBits, trMemory(), stackAlloc);
    }
 
 template<class Container>void TR_BasicDFSetAnalysis<Container *>::initializeBlockInfo(bool allocateLater)
@@ -132,6 +160,11 @@ template<class Container>void TR_BasicDFSetAnalysis<Container *>::initializeBloc
    if (_numberOfBits == Container::nullContainerCharacteristic)
       _numberOfBits = getNumberOfBits();
 
+   _sizeContainersLazily = shouldSizeContainersLazily();
+   if (traceBVA())
+      dumpOptDetails(comp(), "\nUsing %s containers for %d bits over %d nodes\n",
+         _sizeContainersLazily ? "lazily sized" : "pre-sized", (int32_t)_numberOfBits, _numberOfNodes);
+
    _blockAnalysisInfo = (Container **)trMemory()->allocateStackMemory(_numberOfNodes*sizeof(Container *));
 
    if (allocateLater)
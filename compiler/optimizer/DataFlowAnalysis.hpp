@@ -249,6 +249,7 @@ template<class Container>class TR_BasicDFSetAnalysis<Container *> :
       _blockAnalysisInfo    = 0;
       _hasImproperRegion    = false;
       _nodesInCycle         = NULL;
+      _sizeContainersLazily = false;
       }
 
    bool traceBVA() { return _traceBVA;}
@@ -333,6 +334,15 @@ template<class Container>class TR_BasicDFSetAnalysis<Container *> :
    virtual bool canGenAndKillForStructure(TR_Structure *) = 0;
    virtual bool supportsGenAndKillSetsForStructures() {return true;}
 
+   // Decide whether containers requested as sparse should be allocated empty
+   // and grown on demand rather than pre-sized to the number of bits. They
+   // are still dense vectors, and growing one reallocates it, so this only
+   // pays off for large problems whose per-block sets mostly stay empty.
+   // Analyses whose sets do override setsAreMostlyEmpty().
+   bool shouldSizeContainersLazily();
+   virtual bool setsAreMostlyEmpty() { return false; }
+   bool sizeContainersLazily() { return _sizeContainersLazily; }
+
    virtual void allocateContainer(Container **result, bool isSparse = true, bool lock = false);
    virtual void allocateBlockInfoContainer(Container **result, bool isSparse = true, bool lock = false);
    virtual void allocateBlockInfoContainer(Container **result, Container *other);
@@ -356,6 +366,7 @@ template<class Container>class TR_BasicDFSetAnalysis<Container *> :
    int32_t _maxReferenceNumber;
    TR::Node **_supportedNodesAsArray;
    bool _hasImproperRegion;
+   bool _sizeContainersLazily;
    };
 
 
@@ -859,6 +870,9 @@ class TR_Liveness : public TR_BackwardUnionBitVectorAnalysis
    virtual int32_t getNumberOfBits();
    virtual bool supportsGenAndKillSets();
    virtual void initializeGenAndKillSetInfo();
+
+   // Most locals of a large method are only live in a few blocks
+   virtual bool setsAreMostlyEmpty() { return true; }
    virtual void analyzeNode(TR::Node *, vcount_t, TR_BlockStructure *, TR_BitVector *);
    virtual void analyzeTreeTopsInBlockStructure(TR_BlockStructure *);
    virtual bool postInitializationProcessing();
@@ -888,6 +902,9 @@ class TR_LiveOnAllPaths : public TR_BackwardIntersectionBitVectorAnalysis
    virtual int32_t getNumberOfBits();
    virtual bool supportsGenAndKillSets();
    virtual void initializeGenAndKillSetInfo();
+
+   // Most locals of a large method are only live in a few blocks
+   virtual bool setsAreMostlyEmpty() { return true; }
    virtual void analyzeNode(TR::Node *, vcount_t, TR_BlockStructure *, TR_BitVector *);
    virtual void analyzeTreeTopsInBlockStructure(TR_BlockStructure *);
    virtual bool postInitializationProcessing();
@@ -28,28 +28,33 @@
 #include "control/Options.hpp"
 #include "control/Options_inlines.hpp"
 #include "env/IO.hpp"
+#include "env/StackMemoryRegion.hpp"
 #include "env/TRMemory.hpp"
 #include "il/Block.hpp"
 #include "il/symbol/ResolvedMethodSymbol.hpp"
 #include "infra/Assert.hpp"
+#include "infra/BitVector.hpp"
 #include "infra/Cfg.hpp"
 #include "infra/List.hpp"
 #include "infra/CfgEdge.hpp"
 #include "infra/CfgNode.hpp"
 #include "ras/Debug.hpp"
+#include "ras/DebugCounter.hpp"
 
 TR_Dominators::TR_Dominators(TR::Compilation *c, bool post) :
    _region(c->trMemory()->heapMemoryRegion()),
    _compilation(c),
    _info(c->getFlowGraph()->getNextNodeNumber()+1, BBInfo(_region), _region),
    _dfNumbers(c->getFlowGraph()->getNextNodeNumber()+1, 0, _region),
-   _dominators(c->getFlowGraph()->getNextNodeNumber()+1, static_cast<TR::Block *>(NULL), _region)
+   _dominators(c->getFlowGraph()->getNextNodeNumber()+1, static_cast<TR::Block *>(NULL), _region),
+   _removedBlockDominators(std::less<TR::Block *>(), _region)
    {
    LexicalTimer tlex("TR_Dominators::TR_Dominators", _compilation->phaseTimer());
 
    _postDominators = post;
    _isValid = true;
    _topDfNum = 0;
+   _updateCost = 0;
    _visitCount = c->incOrResetVisitCount();
    _trace = comp()->getOption(TR_TraceDominators);
 
@@ -135,7 +140,16 @@ TR::Block * TR_Dominators::getDominator(TR::Block *block)
       {
       return NULL;
       }
-   return _dominators[block->getNumber()];
+
+   TR::Block *dominator = _dominators[block->getNumber()];
+   if (dominator && !_removedBlockDominators.empty())
+      {
+      RemovedBlockMap::iterator removed;
+      while ((removed = _removedBlockDominators.find(dominator)) != _removedBlockDominators.end())
+         dominator = removed->second;
+      _dominators[block->getNumber()] = dominator;
+      }
+   return dominator;
    }
 
 int TR_Dominators::dominates(TR::Block *block, TR::Block *other)
@@ -151,6 +165,195 @@ int TR_Dominators::dominates(TR::Block *block, TR::Block *other)
    return 0;
    }
 
+bool TR_Dominators::isReachable(TR::Block *block)
+   {
+   if (block->getNumber() < 0 || block->getNumber() >= _dominators.size())
+      return false;
+   return block == _cfg->getStart() || _dominators[block->getNumber()] != NULL;
+   }
+
+void TR_Dominators::addBlock(TR::Block *block)
+   {
+   TR_ASSERT(!_postDominators, "post-dominators are not updated in place");
+   TR_ASSERT(block->getNumber() >= 0, "block_%p has not been added to the CFG", block);
+   if (block->getNumber() >= _dominators.size())
+      {
+      _dominators.resize(_cfg->getNextNodeNumber()+1, NULL);
+      _dfNumbers.resize(_cfg->getNextNodeNumber()+1, 0);
+      }
+   }
+
+void TR_Dominators::setDominator(TR::Block *block, TR::Block *dominator, int32_t dfNumber)
+   {
+   addBlock(block);
+   _dominators[block->getNumber()] = dominator;
+   _dfNumbers[block->getNumber()] = dfNumber;
+   if (trace())
+      {
+      if (dominator)
+         traceMsg(comp(), "   Dominator of block_%d is now block_%d\n", block->getNumber(), dominator->getNumber());
+      else
+         traceMsg(comp(), "   block_%d is no longer reachable\n", block->getNumber());
+      }
+   }
+
+// Take "block", which is leaving the CFG, out of the tree and hand its
+// children to "dominator".  Blocks are looked up by number but a removed
+// block may still be renumbered, so the forwarding is keyed by the block.
+//
+void TR_Dominators::removeFromTree(TR::Block *block, TR::Block *dominator)
+   {
+   _updateCost++;
+   _removedBlockDominators[block] = dominator;
+   setDominator(block, NULL, 0);
+   }
+
+// Does some remaining predecessor of "to", or "to" itself, dominate "from"?
+// If so every path through the edge from->to can reach "to" without it, and
+// the path that does is made of a subset of the same blocks.
+//
+bool TR_Dominators::hasShortcutAround(TR::Block *from, TR::Block *to, TR_BitVector *removedBlocks)
+   {
+   if (dominates(to, from))
+      return true;
+
+   TR_PredecessorIterator preds(to);
+   for (TR::CFGEdge *edge = preds.getFirst(); edge; edge = preds.getNext())
+      {
+      TR::Block *pred = toBlock(edge->getFrom());
+      if (removedBlocks && removedBlocks->isSet(pred->getNumber()))
+         continue;
+      if (isReachable(pred) && dominates(pred, from))
+         return true;
+      }
+   return false;
+   }
+
+bool TR_Dominators::addEdge(TR::Block *from, TR::Block *to)
+   {
+   // Nothing new is reachable through an edge out of an unreachable block
+   //
+   if (!isReachable(from))
+      return true;
+
+   if (!isReachable(to))
+      {
+      // "to" is only reachable through the new edge, so it is dominated by
+      // "from".  Nothing else changes if the blocks "to" branches to are
+      // already reachable and their dominators dominate "from" as well.
+      //
+      TR_SuccessorIterator succs(to);
+      for (TR::CFGEdge *edge = succs.getFirst(); edge; edge = succs.getNext())
+         {
+         TR::Block *succ = toBlock(edge->getTo());
+         if (succ == to)
+            continue;
+         if (!isReachable(succ))
+            return false;
+         TR::Block *dominator = getDominator(succ);
+         if (dominator && !dominates(dominator, from))
+            return false;
+         }
+      setDominator(to, from, _dfNumbers[from->getNumber()]);
+      return true;
+      }
+
+   // A new path to "to" changes nothing if it passes all of the blocks that
+   // dominate "to", which it does when the immediate dominator dominates "from"
+   //
+   TR::Block *dominator = getDominator(to);
+   if (!dominator || dominates(dominator, from))
+      return true;
+
+   // "from" is being redirected past a successor that only goes on to "to".
+   // That successor no longer dominates "to", but all of its own dominators
+   // still do.
+   //
+   if (from->hasSuccessor(dominator) &&
+       dominator->getExceptionSuccessors().empty() &&
+       dominator->getSuccessors().size() == 1 &&
+       dominator->getSuccessors().front()->getTo() == to)
+      {
+      setDominator(to, getDominator(dominator), _dfNumbers[to->getNumber()]);
+      return true;
+      }
+
+   return false;
+   }
+
+bool TR_Dominators::removeEdge(TR::Block *from, TR::Block *to)
+   {
+   if (!isReachable(from) || !isReachable(to))
+      return true;
+
+   if (hasShortcutAround(from, to, NULL))
+      return true;
+
+   // Otherwise nothing changes only if "to" can no longer be reached at all,
+   // and none of the blocks it dominates, which go with it, was needed to
+   // reach the blocks they branch to.
+   //
+   TR_PredecessorIterator preds(to);
+   for (TR::CFGEdge *edge = preds.getFirst(); edge; edge = preds.getNext())
+      {
+      TR::Block *pred = toBlock(edge->getFrom());
+      if (isReachable(pred) && !dominates(to, pred))
+         return false;
+      }
+
+   TR::StackMemoryRegion stackMemoryRegion(*comp()->trMemory());
+   TR_BitVector removedBlocks(stackMemoryRegion);
+   TR::CFGNode *node;
+   for (node = _cfg->getFirstNode(); node; node = node->getNext())
+      {
+      TR::Block *block = toBlock(node);
+      _updateCost++;
+      if (isReachable(block) && dominates(to, block))
+         removedBlocks.set(block->getNumber());
+      }
+
+   for (node = _cfg->getFirstNode(); node; node = node->getNext())
+      {
+      TR::Block *block = toBlock(node);
+      if (!removedBlocks.isSet(block->getNumber()))
+         continue;
+
+      TR_SuccessorIterator succs(block);
+      for (TR::CFGEdge *edge = succs.getFirst(); edge; edge = succs.getNext())
+         {
+         TR::Block *succ = toBlock(edge->getTo());
+         if (removedBlocks.isSet(succ->getNumber()) || !isReachable(succ))
+            continue;
+         if (!hasShortcutAround(block, succ, &removedBlocks))
+            return false;
+         }
+      }
+
+   for (node = _cfg->getFirstNode(); node; node = node->getNext())
+      {
+      TR::Block *block = toBlock(node);
+      if (removedBlocks.isSet(block->getNumber()))
+         setDominator(block, NULL, 0);
+      }
+   return true;
+   }
+
+// "next", whose only predecessor is "block", is merged into it.  "block"
+// then dominates everything "next" did.
+//
+bool TR_Dominators::mergeBlocks(TR::Block *block, TR::Block *next)
+   {
+   if (!isReachable(block))
+      return true;
+
+   if (getDominator(next) != block)
+      return false;
+
+   removeFromTree(next, block);
+   TR::DebugCounter::incStaticDebugCounter(comp(), "dominators/mergeBlocks");
+   return true;
+   }
+
 void TR_Dominators::findDominators(TR::Block *start)
    {
    int32_t i;
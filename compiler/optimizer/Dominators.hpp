@@ -24,6 +24,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <map>
 #include "compile/Compilation.hpp"
 #include "env/TRMemory.hpp"
 #include "il/Block.hpp"
@@ -56,6 +57,25 @@ class TR_Dominators
    TR::Block       *getDominator(TR::Block *);
    int             dominates(TR::Block *block, TR::Block *other);
 
+   // Update the (forward) dominator tree in place for an edit of the CFG,
+   // see OMR::CFG::getDominators.  Each returns false if the edit may have
+   // changed dominators in a way it cannot work out exactly, in which case
+   // the tree must be rebuilt.  Blocks updated in place share the depth-first
+   // number of a block that dominates them, so the numbering stays consistent
+   // with the tree for dominates() but is no longer a depth-first order.
+   //
+   void            addBlock(TR::Block *block);
+   bool            addEdge(TR::Block *from, TR::Block *to);
+   bool            removeEdge(TR::Block *from, TR::Block *to);
+   bool            mergeBlocks(TR::Block *block, TR::Block *next);
+   bool            isReachable(TR::Block *block);
+
+   // Number of blocks visited by the in place updates since the last reset,
+   // to compare with the cost of a rebuild.
+   //
+   int32_t         getUpdateCost()   { return _updateCost; }
+   void            resetUpdateCost() { _updateCost = 0; }
+
    TR::Compilation * comp()         { return _compilation; }
    bool trace() { return _trace; }
 
@@ -116,6 +136,10 @@ class TR_Dominators
    BBInfo& getInfo(int32_t index) {return _info[index];}
    int32_t blockNumber(int32_t index) {return _info[index]._block->getNumber();}
 
+   void    setDominator(TR::Block *block, TR::Block *dominator, int32_t dfNumber);
+   void    removeFromTree(TR::Block *block, TR::Block *dominator);
+   bool    hasShortcutAround(TR::Block *from, TR::Block *to, TR_BitVector *removedBlocks);
+
    void    findDominators(TR::Block *start);
    void    initialize(TR::Block *block, BBInfo *parent);
    int32_t eval(int32_t);
@@ -130,7 +154,17 @@ class TR_Dominators
    TR::Compilation *_compilation;
    TR::deque<BBInfo, TR::Region&>  _info;
    TR::deque<TR::Block *, TR::Region&> _dominators;
+
+   // Blocks merged away or bypassed, and the block their children in the
+   // tree were handed to.  getDominator follows these lazily, so taking a
+   // block out of the tree doesn't need a walk over the whole CFG.
+   //
+   typedef TR::typed_allocator<std::pair<TR::Block * const, TR::Block *>, TR::Region &> RemovedBlockAllocator;
+   typedef std::map<TR::Block *, TR::Block *, std::less<TR::Block *>, RemovedBlockAllocator> RemovedBlockMap;
+   RemovedBlockMap _removedBlockDominators;
+
    int32_t         _numNodes;
+   int32_t         _updateCost;
    int32_t         _topDfNum;
    vcount_t        _visitCount;
 
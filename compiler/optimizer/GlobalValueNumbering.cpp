@@ -0,0 +1,505 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/GlobalValueNumbering.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include "compile/Compilation.hpp"
+#include "compile/SymbolReferenceTable.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "il/AliasSetInterface.hpp"
+#include "il/Block.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "il/symbol/ResolvedMethodSymbol.hpp"
+#include "infra/BitVector.hpp"
+#include "infra/Cfg.hpp"
+#include "infra/Checklist.hpp"
+#include "optimizer/Dominators.hpp"
+#include "optimizer/Optimization_inlines.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "ras/DebugCounter.hpp"
+
+#define OPT_DETAILS "O^O GLOBAL VALUE NUMBERING: "
+
+bool TR_GlobalValueNumbering::ValueKey::operator<(const ValueKey &other) const
+   {
+   if (_opCode != other._opCode)
+      return _opCode < other._opCode;
+   if (_symRef != other._symRef)
+      return _symRef < other._symRef;
+   if (_constant != other._constant)
+      return _constant < other._constant;
+   for (int32_t i = 0; i < 3; i++)
+      {
+      if (_children[i] != other._children[i])
+         return _children[i] < other._children[i];
+      }
+   if (_version != other._version)
+      return _version < other._version;
+   return _epoch < other._epoch;
+   }
+
+TR_GlobalValueNumbering::TR_GlobalValueNumbering(TR::OptimizationManager *manager)
+   : TR::Optimization(manager),
+     _region(NULL),
+     _valueNumbers(NULL),
+     _nodeValueNumbers(NULL),
+     _available(NULL),
+     _numberedNodes(NULL),
+     _visitedNodes(NULL),
+     _killedSymRefs(NULL),
+     _aliases(NULL),
+     _versions(NULL),
+     _availableUndo(NULL),
+     _versionUndo(NULL),
+     _nextValueNumber(0),
+     _nextVersion(0),
+     _epoch(0),
+     _numReplaced(0)
+   {}
+
+int32_t TR_GlobalValueNumbering::perform()
+   {
+   TR::CFG *cfg = comp()->getFlowGraph();
+
+   // From here, down, stack memory allocations will die when the function returns
+   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+   TR_Dominators &dominators = *cfg->getDominators();
+
+   // Build the dominator tree as lists of children
+   //
+   int32_t numBlocks = cfg->getNextNodeNumber() + 1;
+   TR::vector<TR::Block *, TR::Region &> firstChild(numBlocks, NULL, stackMemoryRegion);
+   TR::vector<TR::Block *, TR::Region &> nextSibling(numBlocks, NULL, stackMemoryRegion);
+   for (TR::CFGNode *node = cfg->getFirstNode(); node; node = node->getNext())
+      {
+      TR::Block *block = toBlock(node);
+      TR::Block *dominator = dominators.getDominator(block);
+      if (!dominator)
+         continue;
+      nextSibling[block->getNumber()] = firstChild[dominator->getNumber()];
+      firstChild[dominator->getNumber()] = block;
+      }
+
+   int32_t numSymRefs = comp()->getSymRefTab()->getNumSymRefs();
+   TR_BitVector killedSymRefs(numSymRefs, stackMemoryRegion);
+   TR_BitVector aliases(numSymRefs, stackMemoryRegion);
+   TR::NodeChecklist visited(comp());
+   _killedSymRefs = &killedSymRefs;
+   _aliases = &aliases;
+   for (TR::TreeTop *tt = comp()->getStartTree(); tt; tt = tt->getNextTreeTop())
+      collectKilledSymRefs(tt->getNode(), visited);
+
+   ValueMap valueNumbers(std::less<ValueKey>(), stackMemoryRegion);
+   NodeValueMap nodeValueNumbers(std::less<TR::Node *>(), stackMemoryRegion);
+   AvailableMap available(std::less<int32_t>(), stackMemoryRegion);
+   TR::NodeChecklist numberedNodes(comp());
+   TR::NodeChecklist visitedNodes(comp());
+   TR::vector<int32_t, TR::Region &> versions(numSymRefs, 0, stackMemoryRegion);
+   TR::vector<int32_t, TR::Region &> availableUndo(stackMemoryRegion);
+   TR::vector<std::pair<int32_t, int32_t>, TR::Region &> versionUndo(stackMemoryRegion);
+   _region = &stackMemoryRegion;
+   _valueNumbers = &valueNumbers;
+   _nodeValueNumbers = &nodeValueNumbers;
+   _available = &available;
+   _numberedNodes = &numberedNodes;
+   _visitedNodes = &visitedNodes;
+   _versions = &versions;
+   _availableUndo = &availableUndo;
+   _versionUndo = &versionUndo;
+   _numReplaced = 0;
+
+   // Walk the dominator tree in preorder.  What a block makes available and
+   // the versions its stores and calls kill are undone when its subtree is
+   // done, so siblings only see what their common dominators computed.
+   //
+   struct Frame
+      {
+      TR::Block *_block;
+      TR::Block *_nextChild;
+      size_t _availableMark;
+      size_t _versionMark;
+      int32_t _epoch;
+      };
+   TR::vector<Frame, TR::Region &> stack(stackMemoryRegion);
+   TR::Block *block = toBlock(cfg->getStart());
+   while (true)
+      {
+      if (block)
+         {
+         Frame frame;
+         frame._block = block;
+         frame._nextChild = firstChild[block->getNumber()];
+         frame._availableMark = availableUndo.size();
+         frame._versionMark = versionUndo.size();
+         frame._epoch = _epoch;
+         stack.push_back(frame);
+
+         // Another predecessor may have killed anything that was loaded in
+         // the dominator
+         //
+         if (block->getPredecessors().size() + block->getExceptionPredecessors().size() > 1)
+            _epoch = ++_nextVersion;
+
+         processBlock(block);
+         }
+
+      if (stack.empty())
+         break;
+
+      Frame &top = stack.back();
+      block = top._nextChild;
+      if (block)
+         {
+         top._nextChild = nextSibling[block->getNumber()];
+         continue;
+         }
+
+      while (availableUndo.size() > top._availableMark)
+         {
+         available.erase(availableUndo.back());
+         availableUndo.pop_back();
+         }
+      while (versionUndo.size() > top._versionMark)
+         {
+         versions[versionUndo.back().first] = versionUndo.back().second;
+         versionUndo.pop_back();
+         }
+      _epoch = top._epoch;
+      stack.pop_back();
+      }
+
+   _killedSymRefs = NULL;
+   _aliases = NULL;
+   _valueNumbers = NULL;
+   _nodeValueNumbers = NULL;
+   _available = NULL;
+   _numberedNodes = NULL;
+   _visitedNodes = NULL;
+   _versions = NULL;
+   _availableUndo = NULL;
+   _versionUndo = NULL;
+   _region = NULL;
+
+   if (_numReplaced > 0)
+      {
+      optimizer()->setUseDefInfo(NULL);
+      optimizer()->setValueNumberInfo(NULL);
+      optimizer()->setAliasSetsAreValid(false);
+      }
+
+   return _numReplaced;
+   }
+
+const char *
+TR_GlobalValueNumbering::optDetailString() const throw()
+   {
+   return "O^O GLOBAL VALUE NUMBERING: ";
+   }
+
+/**
+ * \brief Add every symbol reference \p node may kill to the symbol references
+ * killed somewhere in the method.
+ */
+void TR_GlobalValueNumbering::collectKilledSymRefs(TR::Node *node, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return;
+   visited.add(node);
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      collectKilledSymRefs(node->getChild(i), visited);
+
+   if (node->getOpCode().isLikeDef() && node->getOpCode().hasSymbolReference())
+      _killedSymRefs->set(node->getSymbolReference()->getReferenceNumber());
+
+   TR_NodeKillAliasSetInterface aliases = node->mayKill(true);
+   if (!aliases.isZero(comp()))
+      aliases.getAliasesAndUnionWith(*_killedSymRefs);
+   }
+
+void TR_GlobalValueNumbering::processBlock(TR::Block *block)
+   {
+   if (!block->getEntry())
+      return;
+
+   for (TR::TreeTop *tt = block->getEntry()->getNextTreeTop(); tt != block->getExit(); tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      bool hasKill = numberNode(node);
+
+      // A value can only be stored into a temp before a tree that ends the
+      // block, which is only correct if nothing in that tree kills it
+      //
+      TR::ILOpCode &opCode = node->getOpCode();
+      bool endsBlock = opCode.isBranch() || opCode.isJumpWithMultipleTargets() || opCode.isReturn();
+      replaceRedundantNodes(node, block, tt, !endsBlock || !hasKill);
+      }
+   }
+
+/**
+ * \brief Give \p node and its children value numbers, and kill the symbol
+ * references the stores and calls among them may define.
+ *
+ * \return true if \p node or one of its children may kill a symbol reference
+ */
+bool TR_GlobalValueNumbering::numberNode(TR::Node *node)
+   {
+   if (_numberedNodes->contains(node))
+      return false;
+   _numberedNodes->add(node);
+
+   bool hasKill = false;
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      if (numberNode(node->getChild(i)))
+         hasKill = true;
+      }
+
+   (*_nodeValueNumbers)[node] = getValueNumber(node);
+
+   if (node->getOpCode().isLikeDef() && node->getOpCode().hasSymbolReference())
+      {
+      killSymRef(node->getSymbolReference()->getReferenceNumber());
+      hasKill = true;
+      }
+
+   TR_NodeKillAliasSetInterface aliases = node->mayKill(true);
+   if (!aliases.isZero(comp()))
+      {
+      aliases.getAliases(*_aliases);
+      TR_BitVectorIterator bvi(*_aliases);
+      while (bvi.hasMoreElements())
+         killSymRef(bvi.getNextElement());
+      hasKill = true;
+      }
+
+   return hasKill;
+   }
+
+/**
+ * \brief Compute the value number of \p node from those of its children.
+ *
+ * \return a positive value number shared by all nodes that compute the same
+ * value, or a negative one unique to \p node if it cannot be commoned
+ */
+int32_t TR_GlobalValueNumbering::getValueNumber(TR::Node *node)
+   {
+   if (!isValueNumberable(node))
+      return -(++_nextValueNumber);
+
+   TR::ILOpCode &opCode = node->getOpCode();
+   ValueKey key;
+   key._opCode = node->getOpCodeValue();
+   key._symRef = -1;
+   key._constant = 0;
+   key._version = 0;
+   key._epoch = 0;
+   for (int32_t i = 0; i < 3; i++)
+      key._children[i] = i < node->getNumChildren() ? (*_nodeValueNumbers)[node->getChild(i)] : 0;
+
+   if (opCode.isLoadConst())
+      {
+      TR::DataType type = node->getDataType();
+      if (type == TR::Float)
+         key._constant = node->getFloatBits();
+      else if (type == TR::Double)
+         key._constant = node->getDoubleBits();
+      else if (type == TR::Address)
+         key._constant = node->getAddress();
+      else if (type.isIntegral())
+         key._constant = node->get64bitIntegralValue();
+      else
+         return -(++_nextValueNumber);
+      }
+
+   if (opCode.hasSymbolReference())
+      {
+      int32_t symRefNum = node->getSymbolReference()->getReferenceNumber();
+      key._symRef = symRefNum;
+      if (opCode.isLoadVar() && _killedSymRefs->get(symRefNum))
+         {
+         key._version = symRefNum < _versions->size() ? (*_versions)[symRefNum] : 0;
+         key._epoch = _epoch;
+         }
+      }
+
+   ValueMap::iterator it = _valueNumbers->find(key);
+   if (it != _valueNumbers->end())
+      return it->second;
+
+   int32_t valueNumber = ++_nextValueNumber;
+   _valueNumbers->insert(std::make_pair(key, valueNumber));
+   return valueNumber;
+   }
+
+/**
+ * \brief Determine whether \p node computes a value that only depends on its
+ * children, its symbol reference and, for loads, the memory it reads.
+ */
+bool TR_GlobalValueNumbering::isValueNumberable(TR::Node *node)
+   {
+   TR::ILOpCode &opCode = node->getOpCode();
+   if (opCode.isTreeTop() || opCode.isCall() || opCode.isCheck() || opCode.isNew() ||
+       opCode.isLoadReg() || node->getOpCodeValue() == TR::PassThrough)
+      return false;
+
+   if (node->getNumChildren() > 3)
+      return false;
+
+   TR::DataType type = node->getDataType();
+   if (type == TR::NoType || type == TR::Aggregate)
+      return false;
+
+   if (opCode.hasSymbolReference())
+      {
+      if (!opCode.isLoadVar() && !opCode.isLoadAddr())
+         return false;
+      if (node->getSymbol()->isVolatile())
+         return false;
+      }
+
+   return true;
+   }
+
+/**
+ * \brief Determine whether loading \p node from a temp is cheaper than
+ * computing it again.
+ */
+bool TR_GlobalValueNumbering::isWorthReplacing(TR::Node *node)
+   {
+   if (node->getOpCode().isLoadIndirect())
+      return true;
+
+   if (node->getOpCode().hasSymbolReference() || node->getOpCode().isLoadConst())
+      return false;
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      if (node->getChild(i)->getNumChildren() > 0)
+         return true;
+      }
+   return false;
+   }
+
+void TR_GlobalValueNumbering::killSymRef(int32_t symRefNum)
+   {
+   if (symRefNum >= _versions->size())
+      return;
+   _versionUndo->push_back(std::make_pair(symRefNum, (*_versions)[symRefNum]));
+   (*_versions)[symRefNum] = ++_nextVersion;
+   }
+
+/**
+ * \brief Replace the nodes under \p node whose value was computed in a
+ * dominating block, and make the others available to the blocks \p block
+ * dominates.
+ */
+void TR_GlobalValueNumbering::replaceRedundantNodes(TR::Node *node, TR::Block *block, TR::TreeTop *treeTop, bool canAnchor)
+   {
+   if (_visitedNodes->contains(node))
+      return;
+   _visitedNodes->add(node);
+
+   int32_t valueNumber = (*_nodeValueNumbers)[node];
+   bool worthReplacing = valueNumber > 0 && isWorthReplacing(node);
+   bool isAvailable = false;
+   if (worthReplacing)
+      {
+      AvailableMap::iterator it = _available->find(valueNumber);
+      if (it != _available->end())
+         {
+         // Repeats within a block are left to localCSE
+         //
+         Available *available = it->second;
+         isAvailable = true;
+         if (available->_block != block &&
+             performTransformation(comp(), "%sReplacing n%dn [%p] in block_%d by the value of n%dn [%p] in block_%d\n",
+                                   OPT_DETAILS, node->getGlobalIndex(), node, block->getNumber(),
+                                   available->_node->getGlobalIndex(), available->_node, available->_block->getNumber()))
+            {
+            replaceWithTemp(node, available);
+            _numReplaced++;
+            TR::DebugCounter::incStaticDebugCounter(comp(), "globalValueNumbering/replaced");
+            return;
+            }
+         }
+      }
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      replaceRedundantNodes(node->getChild(i), block, treeTop, canAnchor);
+
+   if (worthReplacing && canAnchor && !isAvailable)
+      {
+      Available *available = new (*_region) Available;
+      available->_node = node;
+      available->_block = block;
+      available->_treeTop = treeTop;
+      available->_temp = NULL;
+      _available->insert(std::make_pair(valueNumber, available));
+      _availableUndo->push_back(valueNumber);
+      }
+   }
+
+/**
+ * \brief Turn \p node into a load of the temp holding the value of the
+ * dominating node in \p available, storing that node into a new temp first
+ * if this is the first node it replaces.
+ */
+void TR_GlobalValueNumbering::replaceWithTemp(TR::Node *node, Available *available)
+   {
+   TR::DataType type = node->getDataType();
+   if (!available->_temp)
+      {
+      available->_temp = comp()->getSymRefTab()->createTemporary(comp()->getMethodSymbol(), type);
+      if (type == TR::Address)
+         available->_temp->getSymbol()->setNotCollected();
+
+      TR::TreeTop *storeTree = TR::TreeTop::create(comp(), TR::Node::createStore(available->_temp, available->_node));
+      TR::ILOpCode &opCode = available->_treeTop->getNode()->getOpCode();
+      if (opCode.isBranch() || opCode.isJumpWithMultipleTargets() || opCode.isReturn())
+         available->_treeTop->insertBefore(storeTree);
+      else
+         available->_treeTop->insertAfter(storeTree);
+
+      dumpOptDetails(comp(), "%sStoring n%dn [%p] into #%d\n",
+                     OPT_DETAILS, available->_node->getGlobalIndex(), available->_node,
+                     available->_temp->getReferenceNumber());
+      }
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      node->getChild(i)->recursivelyDecReferenceCount();
+      node->setChild(i, NULL);
+      }
+   TR::Node::recreateWithSymRef(node, comp()->il.opCodeForDirectLoad(type), available->_temp);
+   node->setNumChildren(0);
+   }
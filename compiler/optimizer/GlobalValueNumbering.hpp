@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef GLOBALVALUENUMBERING_INCL
+#define GLOBALVALUENUMBERING_INCL
+
+#include <stddef.h>
+#include <stdint.h>
+#include <map>
+#include "env/TRMemory.hpp"
+#include "infra/vector.hpp"
+#include "optimizer/Optimization.hpp"
+#include "optimizer/OptimizationManager.hpp"
+
+class TR_BitVector;
+namespace TR { class Block; }
+namespace TR { class Node; }
+namespace TR { class NodeChecklist; }
+namespace TR { class SymbolReference; }
+namespace TR { class TreeTop; }
+
+/**
+ * Removes expressions and loads that are fully redundant across blocks.
+ *
+ * The blocks are visited in a preorder walk of the dominator tree.  Every
+ * node gets a value number from a hash of its opcode, symbol reference,
+ * constant value and the value numbers of its children.  A load also hashes
+ * the version of its symbol reference, which changes at every store or call
+ * that may kill it, and the current memory epoch, which changes on entry to
+ * any block with more than one predecessor.  So two loads only get the same
+ * value number if the dominating one reaches the other along the dominator
+ * tree path without an intervening kill.  Loads of symbols that are never
+ * killed in the method hash neither, and stay available everywhere.
+ *
+ * When a value computed in a dominating block is computed again, the
+ * dominating node is stored into a temporary right after it is evaluated and
+ * the redundant node becomes a load of that temporary, which GRA can then
+ * assign to a register.  Only indirect loads and expressions with a non
+ * trivial operand are replaced, as recomputing the rest is as cheap as the
+ * load of a temporary.
+ */
+class TR_GlobalValueNumbering : public TR::Optimization
+   {
+   public:
+
+   TR_GlobalValueNumbering(TR::OptimizationManager *manager);
+   static TR::Optimization *create(TR::OptimizationManager *manager)
+      {
+      return new (manager->allocator()) TR_GlobalValueNumbering(manager);
+      }
+
+   virtual int32_t perform();
+   virtual const char * optDetailString() const throw();
+
+   private:
+
+   struct ValueKey
+      {
+      int32_t _opCode;
+      int32_t _symRef;
+      int64_t _constant;
+      int32_t _children[3];
+      int32_t _version;
+      int32_t _epoch;
+
+      bool operator<(const ValueKey &other) const;
+      };
+
+   struct Available
+      {
+      TR::Node *_node;
+      TR::Block *_block;
+      TR::TreeTop *_treeTop;
+      TR::SymbolReference *_temp;
+      };
+
+   typedef TR::typed_allocator<std::pair<const ValueKey, int32_t>, TR::Region &> ValueMapAllocator;
+   typedef std::map<ValueKey, int32_t, std::less<ValueKey>, ValueMapAllocator> ValueMap;
+   typedef TR::typed_allocator<std::pair<TR::Node * const, int32_t>, TR::Region &> NodeValueMapAllocator;
+   typedef std::map<TR::Node *, int32_t, std::less<TR::Node *>, NodeValueMapAllocator> NodeValueMap;
+   typedef TR::typed_allocator<std::pair<const int32_t, Available *>, TR::Region &> AvailableMapAllocator;
+   typedef std::map<int32_t, Available *, std::less<int32_t>, AvailableMapAllocator> AvailableMap;
+
+   void collectKilledSymRefs(TR::Node *node, TR::NodeChecklist &visited);
+   void processBlock(TR::Block *block);
+   bool numberNode(TR::Node *node);
+   int32_t getValueNumber(TR::Node *node);
+   bool isValueNumberable(TR::Node *node);
+   bool isWorthReplacing(TR::Node *node);
+   void killSymRef(int32_t symRefNum);
+   void replaceRedundantNodes(TR::Node *node, TR::Block *block, TR::TreeTop *treeTop, bool canAnchor);
+   void replaceWithTemp(TR::Node *node, Available *available);
+
+   TR::Region *_region;
+   ValueMap *_valueNumbers;
+   NodeValueMap *_nodeValueNumbers;
+   AvailableMap *_available;
+   TR::NodeChecklist *_numberedNodes;
+   TR::NodeChecklist *_visitedNodes;
+   TR_BitVector *_killedSymRefs;
+   TR_BitVector *_aliases;
+   TR::vector<int32_t, TR::Region &> *_versions;
+   TR::vector<int32_t, TR::Region &> *_availableUndo;
+   TR::vector<std::pair<int32_t, int32_t>, TR::Region &> *_versionUndo;
+   int32_t _nextValueNumber;
+   int32_t _nextVersion;
+   int32_t _epoch;
+   int32_t _numReplaced;
+   };
+
+#endif
@@ -5517,8 +5517,7 @@ int32_t TR_InductionVariableAnalysis::perform()
 
    TR::StackMemoryRegion stackMemoryRegion(*trMemory());
 
-   // FIXME: Why is this allocated with heap memory?
-   _dominators = new (trHeapMemory()) TR_Dominators(comp());
+   _dominators = comp()->getFlowGraph()->getDominators();
 
    // Gathers symrefs that are assigned inside a loop. This removes stale IVs
    // in the same traversal, so there's no need to removeStaleIVs().
@@ -0,0 +1,339 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/LocalArrayScalarization.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include "compile/Compilation.hpp"
+#include "compile/SymbolReferenceTable.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "il/symbol/ResolvedMethodSymbol.hpp"
+#include "infra/List.hpp"
+#include "optimizer/Optimization_inlines.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "ras/DebugCounter.hpp"
+
+#define OPT_DETAILS "O^O LOCAL ARRAY SCALARIZATION: "
+
+TR_LocalArrayScalarization::TR_LocalArrayScalarization(TR::OptimizationManager *manager)
+   : TR::Optimization(manager),
+     _region(NULL),
+     _candidates(NULL)
+   {}
+
+int32_t TR_LocalArrayScalarization::perform()
+   {
+   // From here, down, stack memory allocations will die when the function returns
+   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+   CandidateMap candidates(std::less<TR::Symbol *>(), stackMemoryRegion);
+   _region = &stackMemoryRegion;
+   _candidates = &candidates;
+
+   vcount_t visitCount = comp()->incVisitCount();
+   for (TR::TreeTop *tt = comp()->getStartTree(); tt; tt = tt->getNextTreeTop())
+      examineNode(tt->getNode(), visitCount);
+
+   int32_t numScalarized = 0;
+   for (CandidateMap::iterator it = candidates.begin(); it != candidates.end(); ++it)
+      {
+      Candidate *candidate = it->second;
+      if (candidate->_escapes)
+         {
+         if (trace())
+            traceMsg(comp(), "Local array #%d escapes\n", candidate->_symRef->getReferenceNumber());
+         continue;
+         }
+
+      if (candidate->_accesses->isEmpty() || !collectFields(candidate))
+         continue;
+
+      if (!performTransformation(comp(), "%sScalarizing local array #%d of %d bytes into %d temps\n",
+                                 OPT_DETAILS, candidate->_symRef->getReferenceNumber(),
+                                 candidate->_symRef->getSymbol()->getSize(), candidate->_fields->getSize()))
+         continue;
+
+      scalarize(candidate);
+      TR::DebugCounter::incStaticDebugCounter(comp(), "localArrayScalarization/scalarized");
+      numScalarized++;
+      }
+
+   _candidates = NULL;
+   _region = NULL;
+
+   if (numScalarized > 0)
+      {
+      optimizer()->setUseDefInfo(NULL);
+      optimizer()->setValueNumberInfo(NULL);
+      optimizer()->setAliasSetsAreValid(false);
+      }
+
+   return numScalarized;
+   }
+
+const char *
+TR_LocalArrayScalarization::optDetailString() const throw()
+   {
+   return "O^O LOCAL ARRAY SCALARIZATION: ";
+   }
+
+void TR_LocalArrayScalarization::examineNode(TR::Node *node, vcount_t visitCount)
+   {
+   if (node->getVisitCount() == visitCount)
+      return;
+   node->setVisitCount(visitCount);
+
+   // Any reference to the local other than taking its address, such as a
+   // direct load or store of the whole aggregate, keeps it in memory
+   //
+   if (node->getOpCode().hasSymbolReference() &&
+       node->getSymbolReference() &&
+       node->getOpCodeValue() != TR::loadaddr)
+      {
+      Candidate *candidate = getCandidate(node->getSymbolReference());
+      if (candidate)
+         candidate->_escapes = true;
+      }
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      examineUse(node, i);
+      examineNode(node->getChild(i), visitCount);
+      }
+   }
+
+static bool getConstantOffset(TR::Node *node, int64_t &offset)
+   {
+   if (node->getOpCodeValue() == TR::i2l)
+      node = node->getFirstChild();
+
+   if (!node->getOpCode().isLoadConst() || !node->getType().isIntegral())
+      return false;
+
+   offset = node->get64bitIntegralValue();
+   return true;
+   }
+
+/**
+ * \brief Examine the use of the address of a local aggregate as the
+ * \p childIndex child of \p parent.
+ */
+void TR_LocalArrayScalarization::examineUse(TR::Node *parent, int32_t childIndex)
+   {
+   TR::Node *child = parent->getChild(childIndex);
+   int64_t offset;
+
+   // The uses of the element address are examined with its parents
+   if (child->getOpCodeValue() == TR::loadaddr &&
+       (parent->getOpCodeValue() == TR::aladd || parent->getOpCodeValue() == TR::aiadd) &&
+       childIndex == 0 &&
+       getConstantOffset(parent->getSecondChild(), offset))
+      return;
+
+   Candidate *candidate = getCandidate(child, offset);
+   if (!candidate)
+      return;
+
+   // An anchored address is evaluated but not used
+   if (parent->getOpCodeValue() == TR::treetop)
+      return;
+
+   if (childIndex == 0 && isElementAccess(parent))
+      {
+      Access *access = new (*_region) Access;
+      access->_node = parent;
+      access->_offset = offset;
+      candidate->_accesses->add(access);
+      }
+   else
+      {
+      if (trace())
+         traceMsg(comp(), "Address of local array #%d escapes to n%dn\n",
+                  candidate->_symRef->getReferenceNumber(), parent->getGlobalIndex());
+      candidate->_escapes = true;
+      }
+   }
+
+/**
+ * \brief Find the local aggregate whose element at \p offset is addressed by
+ * \p address.
+ *
+ * \return NULL if \p address is not the address of an element of a local aggregate
+ */
+TR_LocalArrayScalarization::Candidate *
+TR_LocalArrayScalarization::getCandidate(TR::Node *address, int64_t &offset)
+   {
+   offset = 0;
+   if ((address->getOpCodeValue() == TR::aladd || address->getOpCodeValue() == TR::aiadd) &&
+       getConstantOffset(address->getSecondChild(), offset))
+      address = address->getFirstChild();
+
+   if (address->getOpCodeValue() != TR::loadaddr)
+      return NULL;
+
+   return getCandidate(address->getSymbolReference());
+   }
+
+/**
+ * \brief Find the candidate for the local aggregate \p symRef refers to.
+ *
+ * \return NULL if \p symRef does not refer to a local aggregate
+ */
+TR_LocalArrayScalarization::Candidate *
+TR_LocalArrayScalarization::getCandidate(TR::SymbolReference *symRef)
+   {
+   TR::Symbol *symbol = symRef->getSymbol();
+   if (!symbol->isAuto() || !symbol->isLocalObject() || symbol->getDataType() != TR::Aggregate)
+      return NULL;
+
+   CandidateMap::iterator it = _candidates->find(symbol);
+   if (it != _candidates->end())
+      return it->second;
+
+   Candidate *candidate = new (*_region) Candidate;
+   candidate->_symRef = symRef;
+   candidate->_escapes = false;
+   candidate->_accesses = new (*_region) List<Access>(*_region);
+   candidate->_fields = new (*_region) List<Field>(*_region);
+   _candidates->insert(std::make_pair(symbol, candidate));
+   return candidate;
+   }
+
+bool TR_LocalArrayScalarization::isElementAccess(TR::Node *node)
+   {
+   TR::ILOpCode &opCode = node->getOpCode();
+   if (!opCode.isLoadIndirect() && !opCode.isStoreIndirect())
+      return false;
+
+   if (opCode.isWrtBar() || !node->getSymbol()->isArrayShadowSymbol())
+      return false;
+
+   TR::DataType type = node->getDataType();
+   return !type.isVector() && type != TR::Aggregate && type != TR::NoType;
+   }
+
+/**
+ * \brief Assign the accesses of \p candidate to fields.
+ *
+ * \return false if accesses at the same offset have different types, or
+ * accesses at different offsets overlap
+ */
+bool TR_LocalArrayScalarization::collectFields(Candidate *candidate)
+   {
+   int64_t aggregateSize = candidate->_symRef->getSymbol()->getSize();
+   ListIterator<Access> accessIt(candidate->_accesses);
+   for (Access *access = accessIt.getFirst(); access; access = accessIt.getNext())
+      {
+      TR::DataType type = access->_node->getDataType();
+      int64_t size = TR::DataType::getSize(type);
+      if (access->_offset < 0 || access->_offset + size > aggregateSize)
+         {
+         if (trace())
+            traceMsg(comp(), "Access n%dn is outside local array #%d\n",
+                     access->_node->getGlobalIndex(), candidate->_symRef->getReferenceNumber());
+         return false;
+         }
+
+      bool found = false;
+      ListIterator<Field> fieldIt(candidate->_fields);
+      for (Field *field = fieldIt.getFirst(); field; field = fieldIt.getNext())
+         {
+         if (field->_offset == access->_offset && field->_type == type)
+            {
+            found = true;
+            break;
+            }
+
+         int64_t fieldSize = TR::DataType::getSize(field->_type);
+         if (access->_offset < field->_offset + fieldSize &&
+             field->_offset < access->_offset + size)
+            {
+            if (trace())
+               traceMsg(comp(), "Access n%dn overlaps field at offset %lld of local array #%d\n",
+                        access->_node->getGlobalIndex(), field->_offset, candidate->_symRef->getReferenceNumber());
+            return false;
+            }
+         }
+
+      if (!found)
+         {
+         Field *field = new (*_region) Field;
+         field->_offset = access->_offset;
+         field->_type = type;
+         field->_temp = NULL;
+         candidate->_fields->add(field);
+         }
+      }
+
+   return true;
+   }
+
+void TR_LocalArrayScalarization::scalarize(Candidate *candidate)
+   {
+   ListIterator<Field> fieldIt(candidate->_fields);
+   for (Field *field = fieldIt.getFirst(); field; field = fieldIt.getNext())
+      {
+      field->_temp = comp()->getSymRefTab()->createTemporary(comp()->getMethodSymbol(), field->_type);
+      field->_temp->getSymbol()->setNotCollected();
+      }
+
+   ListIterator<Access> accessIt(candidate->_accesses);
+   for (Access *access = accessIt.getFirst(); access; access = accessIt.getNext())
+      {
+      TR::Node *node = access->_node;
+      TR::DataType type = node->getDataType();
+      TR::SymbolReference *temp = NULL;
+      for (Field *field = fieldIt.getFirst(); field; field = fieldIt.getNext())
+         {
+         if (field->_offset == access->_offset && field->_type == type)
+            temp = field->_temp;
+         }
+
+      dumpOptDetails(comp(), "%sReplacing n%dn [%p] at offset %lld with #%d\n",
+                     OPT_DETAILS, node->getGlobalIndex(), node, access->_offset, temp->getReferenceNumber());
+
+      node->getFirstChild()->recursivelyDecReferenceCount();
+      if (node->getOpCode().isStore())
+         {
+         TR::Node *value = node->getSecondChild();
+         TR::Node::recreateWithSymRef(node, comp()->il.opCodeForDirectStore(type), temp);
+         node->setChild(0, value);
+         node->setChild(1, NULL);
+         node->setNumChildren(1);
+         }
+      else
+         {
+         TR::Node::recreateWithSymRef(node, comp()->il.opCodeForDirectLoad(type), temp);
+         node->setChild(0, NULL);
+         node->setNumChildren(0);
+         }
+      }
+   }
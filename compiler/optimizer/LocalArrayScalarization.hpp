@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef LOCALARRAYSCALARIZATION_INCL
+#define LOCALARRAYSCALARIZATION_INCL
+
+#include <stdint.h>
+#include <map>
+#include "env/TRMemory.hpp"
+#include "il/DataTypes.hpp"
+#include "infra/List.hpp"
+#include "optimizer/Optimization.hpp"
+#include "optimizer/OptimizationManager.hpp"
+
+namespace TR { class Node; }
+namespace TR { class Symbol; }
+namespace TR { class SymbolReference; }
+
+/**
+ * Replaces local aggregates, such as the small structs and unions a front
+ * end allocates as local byte arrays, by one temporary per field.
+ *
+ * A local aggregate qualifies if its address is only used by element loads
+ * and stores of the form
+ *
+ *    xloadi/xstorei <array-shadow>
+ *       aladd
+ *          loadaddr <local>
+ *          lconst offset
+ *
+ * and the accesses at any one offset all have the same type and do not
+ * overlap the accesses at other offsets.  Every such access becomes a direct
+ * load or store of the temporary for its offset, which GRA can then assign
+ * to a register.  Aggregates whose address escapes, for instance to a call
+ * or through a variable offset, stay in memory.
+ */
+class TR_LocalArrayScalarization : public TR::Optimization
+   {
+   public:
+
+   TR_LocalArrayScalarization(TR::OptimizationManager *manager);
+   static TR::Optimization *create(TR::OptimizationManager *manager)
+      {
+      return new (manager->allocator()) TR_LocalArrayScalarization(manager);
+      }
+
+   virtual int32_t perform();
+   virtual const char * optDetailString() const throw();
+
+   private:
+
+   struct Access
+      {
+      TR::Node *_node;
+      int64_t _offset;
+      };
+
+   struct Field
+      {
+      int64_t _offset;
+      TR::DataType _type;
+      TR::SymbolReference *_temp;
+      };
+
+   struct Candidate
+      {
+      TR::SymbolReference *_symRef;
+      bool _escapes;
+      List<Access> *_accesses;
+      List<Field> *_fields;
+      };
+
+   typedef TR::typed_allocator<std::pair<TR::Symbol * const, Candidate *>, TR::Region &> CandidateMapAllocator;
+   typedef std::map<TR::Symbol *, Candidate *, std::less<TR::Symbol *>, CandidateMapAllocator> CandidateMap;
+
+   void examineNode(TR::Node *node, vcount_t visitCount);
+   void examineUse(TR::Node *parent, int32_t childIndex);
+   Candidate *getCandidate(TR::Node *address, int64_t &offset);
+   Candidate *getCandidate(TR::SymbolReference *symRef);
+   bool isElementAccess(TR::Node *node);
+   bool collectFields(Candidate *candidate);
+   void scalarize(Candidate *candidate);
+
+   TR::Region *_region;
+   CandidateMap *_candidates;
+   };
+
+#endif
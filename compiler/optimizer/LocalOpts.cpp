@@ -3556,6 +3556,12 @@ int32_t TR_EliminateRedundantGotos::process(TR::TreeTop *startTree, TR::TreeTop
             !performTransformation(comp(), "%sEliminating goto at the end of block_%d with BBStart %p\n", optDetailString(), block->getNumber(), block->getEntry()->getNode()))
         continue;
 
+      // Redirecting the predecessors one at a time goes through states the
+      // dominator tree can't follow, so it is dropped and rebuilt when next
+      // asked for
+      //
+      cfg->suspendDominatorUpdates();
+
       if (manuallyFixStructure)
          {
          // We are removing a goto block that is the head of a structure region.
@@ -3630,6 +3636,8 @@ int32_t TR_EliminateRedundantGotos::process(TR::TreeTop *startTree, TR::TreeTop
          redirectPredecessors(block, destBlock, fixablePreds, emptyBlock, asyncMessagesFlag);
          }
 
+      cfg->resumeDominatorUpdates(false);
+
       // Place an asynccheck as the first treetop of the successor, if there was one in the removed block
       // This is necessary as placing it in the predecessor may result in a seperation from its OSR guard
       //
@@ -0,0 +1,1074 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/LoopVectorizer.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include "codegen/CodeGenerator.hpp"
+#include "compile/Compilation.hpp"
+#include "compile/SymbolReferenceTable.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "il/Block.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/Cfg.hpp"
+#include "infra/CfgEdge.hpp"
+#include "infra/List.hpp"
+#include "optimizer/InductionVariable.hpp"
+#include "optimizer/Optimization_inlines.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "optimizer/Structure.hpp"
+#include "ras/DebugCounter.hpp"
+
+#define OPT_DETAILS "O^O LOOP VECTORIZER: "
+
+// Width of the vector registers used for AutoSIMD
+static const int32_t vectorWidth = 16;
+
+TR_LoopVectorizer::TR_LoopVectorizer(TR::OptimizationManager *manager)
+   : TR::Optimization(manager),
+     _cfg(NULL),
+     _vectorize(false),
+     _reduceCopies(false),
+     _reduceFills(false),
+     _valueInfo(NULL),
+     _stores(NULL),
+     _vectorLoads(NULL)
+   {}
+
+bool TR_LoopVectorizer::shouldPerform()
+   {
+   if (!TR::Compiler->target.is64Bit())
+      return false;
+
+   _vectorize = !comp()->getOption(TR_DisableAutoSIMD) && cg()->getSupportsAutoSIMD();
+   _reduceCopies = !comp()->getOption(TR_DisableArrayCopyOpts) && cg()->getSupportsPrimitiveArrayCopy();
+   _reduceFills = !comp()->getOption(TR_DisableArraySetOpts) && cg()->getSupportsArraySet();
+   if (!_vectorize && !_reduceCopies && !_reduceFills)
+      return false;
+
+   return comp()->mayHaveLoops();
+   }
+
+int32_t TR_LoopVectorizer::perform()
+   {
+   _cfg = comp()->getFlowGraph();
+   TR_Structure *rootStructure = _cfg->getStructure();
+   if (!rootStructure)
+      return 0;
+
+   // From here, down, stack memory allocations will die when the function returns
+   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+
+   TR_ScratchList<TR_RegionStructure> loops(trMemory());
+   collectInnermostLoops(rootStructure, loops);
+
+   // Analyze every loop while the structure is still valid, the transformation
+   // changes the CFG in ways the structure cannot follow
+   //
+   TR_ScratchList<CandidateLoop> candidates(trMemory());
+   ListIterator<TR_RegionStructure> it(&loops);
+   for (TR_RegionStructure *loop = it.getFirst(); loop; loop = it.getNext())
+      {
+      TR_ScratchList<TR::Node> stores(trMemory());
+      TR_ScratchList<TR::Node> vectorLoads(trMemory());
+      CandidateLoop *candidate = new (stackMemoryRegion) CandidateLoop;
+      candidate->_region = loop;
+      candidate->_valueInfo = new (stackMemoryRegion) ValueInfoMap(std::less<TR::Node *>(), stackMemoryRegion);
+      _valueInfo = candidate->_valueInfo;
+      _stores = &stores;
+      _vectorLoads = &vectorLoads;
+
+      if (!analyzeLoop(*candidate))
+         continue;
+
+      if (candidate->_idiom != NoIdiom)
+         {
+         if (!performTransformation(comp(), "%sReducing %s loop %d (block_%d) of %d byte elements to %s\n",
+                                    OPT_DETAILS, candidate->_idiom == CopyIdiom ? "copy" : "fill",
+                                    loop->getNumber(), candidate->_loop->getNumber(), candidate->_elementSize,
+                                    candidate->_idiom == CopyIdiom ? "arraycopy" : "arrayset"))
+            continue;
+         }
+      else if (!performTransformation(comp(), "%sVectorizing loop %d (block_%d) with %d elements per iteration and %d alias checks\n",
+                                      OPT_DETAILS, loop->getNumber(), candidate->_loop->getNumber(),
+                                      candidate->_vectorLength, candidate->_numAliasChecks))
+         {
+         continue;
+         }
+
+      candidates.add(candidate);
+      }
+
+   _stores = NULL;
+   _vectorLoads = NULL;
+
+   int32_t numVectorized = 0;
+   if (!candidates.isEmpty())
+      _cfg->setStructure(NULL);
+
+   ListIterator<CandidateLoop> candidateIt(&candidates);
+   for (CandidateLoop *candidate = candidateIt.getFirst(); candidate; candidate = candidateIt.getNext())
+      {
+      _valueInfo = candidate->_valueInfo;
+      if (candidate->_idiom != NoIdiom)
+         {
+         reduceLoop(*candidate);
+         TR::DebugCounter::incStaticDebugCounter(comp(), candidate->_idiom == CopyIdiom ?
+            "loopVectorizer/arraycopy" : "loopVectorizer/arrayset");
+         }
+      else
+         {
+         vectorizeLoop(*candidate);
+         TR::DebugCounter::incStaticDebugCounter(comp(), "loopVectorizer/vectorized");
+         }
+      numVectorized++;
+      }
+
+   _valueInfo = NULL;
+
+   if (numVectorized > 0)
+      {
+      optimizer()->setUseDefInfo(NULL);
+      optimizer()->setValueNumberInfo(NULL);
+
+      // The induction variables of the new loops are needed by later loop opts
+      requestOpt(OMR::inductionVariableAnalysis);
+      }
+
+   return numVectorized;
+   }
+
+const char *
+TR_LoopVectorizer::optDetailString() const throw()
+   {
+   return "O^O LOOP VECTORIZER: ";
+   }
+
+// Returns true if str contains a natural loop
+//
+bool TR_LoopVectorizer::collectInnermostLoops(TR_Structure *str, List<TR_RegionStructure> &loops)
+   {
+   TR_RegionStructure *region = str->asRegion();
+   if (region == NULL)
+      return false;
+
+   bool containsLoop = false;
+   TR_RegionStructure::Cursor it(*region);
+   for (TR_StructureSubGraphNode *node = it.getCurrent(); node; node = it.getNext())
+      {
+      if (collectInnermostLoops(node->getStructure(), loops))
+         containsLoop = true;
+      }
+
+   if (!region->isNaturalLoop())
+      return containsLoop;
+
+   if (!containsLoop)
+      loops.add(region);
+   return true;
+   }
+
+static bool isVectorizableType(TR::DataType type)
+   {
+   return type == TR::Int32 || type == TR::Int64 || type == TR::Float || type == TR::Double;
+   }
+
+// Elements a copy or fill loop may move
+//
+static bool isIdiomType(TR::DataType type)
+   {
+   return type.isIntegral() || type == TR::Float || type == TR::Double;
+   }
+
+static TR::ILOpCodes vectorOpCode(TR::ILOpCodes op)
+   {
+   switch (op)
+      {
+      case TR::iadd: case TR::ladd: case TR::fadd: case TR::dadd:
+         return TR::vadd;
+      case TR::isub: case TR::lsub: case TR::fsub: case TR::dsub:
+         return TR::vsub;
+      case TR::imul: case TR::lmul: case TR::fmul: case TR::dmul:
+         return TR::vmul;
+      case TR::fdiv: case TR::ddiv:
+         return TR::vdiv;
+      case TR::iand: case TR::land:
+         return TR::vand;
+      case TR::ior: case TR::lor:
+         return TR::vor;
+      case TR::ixor: case TR::lxor:
+         return TR::vxor;
+      default:
+         return TR::BadILOp;
+      }
+   }
+
+static TR::ILOpCodes reverseBranchOpCode(TR::ILOpCodes op)
+   {
+   switch (op)
+      {
+      case TR::ificmplt: return TR::ificmpge;
+      case TR::ificmple: return TR::ificmpgt;
+      case TR::ificmpge: return TR::ificmplt;
+      case TR::ificmpgt: return TR::ificmple;
+      case TR::iflcmplt: return TR::iflcmpge;
+      case TR::iflcmple: return TR::iflcmpgt;
+      case TR::iflcmpge: return TR::iflcmplt;
+      case TR::iflcmpgt: return TR::iflcmple;
+      default:           return TR::BadILOp;
+      }
+   }
+
+bool TR_LoopVectorizer::analyzeLoop(CandidateLoop &candidate)
+   {
+   TR_RegionStructure *region = candidate._region;
+
+   TR_PrimaryInductionVariable *piv = region->getPrimaryInductionVariable();
+   if (piv == NULL)
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> no primary induction variable\n", region->getNumber());
+      return false;
+      }
+
+   TR::Block *loop = region->getEntryBlock();
+   if (loop->isCold())
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> cold loop\n", region->getNumber());
+      return false;
+      }
+
+   // The loop is either a single block ending with the loop test, or, as
+   // left by the loop canonicalizer, a body followed by a block that holds
+   // nothing but the loop test
+   //
+   TR_ScratchList<TR::Block> blocksInLoop(trMemory());
+   region->getBlocks(&blocksInLoop);
+   TR::Block *latch = piv->getBranchBlock();
+   if (blocksInLoop.getSize() > 2 || (blocksInLoop.getSize() == 2) == (latch == loop))
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> loop has more than a body and a loop test\n", region->getNumber());
+      return false;
+      }
+
+   TR::SymbolReference *ivSymRef = piv->getSymRef();
+   TR::DataType ivType = ivSymRef->getSymbol()->getDataType();
+   if (piv->getDeltaOnBackEdge() != 1 || piv->isUnsigned() || (ivType != TR::Int32 && ivType != TR::Int64))
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> induction variable #%d is not a signed counter incremented by 1\n",
+                  region->getNumber(), ivSymRef->getReferenceNumber());
+      return false;
+      }
+
+   if (loop->hasExceptionSuccessors() || loop->hasExceptionPredecessors() ||
+       latch->hasExceptionSuccessors() || latch->hasExceptionPredecessors())
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> exception edges\n", region->getNumber());
+      return false;
+      }
+
+   // The loop must be entered from a loop invariant block that either falls
+   // through or branches unconditionally to it
+   //
+   TR::Block *preHeader = NULL;
+   for (auto edge = loop->getPredecessors().begin(); edge != loop->getPredecessors().end(); ++edge)
+      {
+      TR::Block *from = toBlock((*edge)->getFrom());
+      if (from == latch)
+         continue;
+      if (preHeader != NULL)
+         return false;
+      preHeader = from;
+      }
+
+   if (preHeader == NULL || !preHeader->isLoopInvariantBlock() ||
+       preHeader->getSuccessors().size() != 1 || preHeader->hasExceptionSuccessors())
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> no preheader\n", region->getNumber());
+      return false;
+      }
+
+   if (preHeader->getEntry()->getNextTreeTop() != preHeader->getExit())
+      {
+      TR::Node *lastNode = preHeader->getLastRealTreeTop()->getNode();
+      if (lastNode->getOpCode().isBranch() && lastNode->getOpCodeValue() != TR::Goto)
+         return false;
+      if (lastNode->getOpCode().isJumpWithMultipleTargets() || lastNode->getOpCode().isReturn())
+         return false;
+      }
+
+   // The loop test either branches back to the loop or branches out of it
+   // and falls through to the loop
+   //
+   TR::TreeTop *branchTree = latch->getLastRealTreeTop();
+   TR::Node *branch = branchTree->getNode();
+   bool isLong = ivType == TR::Int64;
+   TR::ILOpCodes branchOp = branch->getOpCodeValue();
+   TR::Block *exit = NULL;
+   if (branch->getOpCode().isIf() && branch->getBranchDestination() == loop->getEntry())
+      {
+      exit = latch->getNextBlock();
+      }
+   else if (branch->getOpCode().isIf() && latch->getNextBlock() == loop)
+      {
+      exit = branch->getBranchDestination()->getNode()->getBlock();
+      branchOp = reverseBranchOpCode(branchOp);
+      }
+
+   if (exit == NULL ||
+       (isLong ? (branchOp != TR::iflcmplt && branchOp != TR::iflcmple) :
+                 (branchOp != TR::ificmplt && branchOp != TR::ificmple)) ||
+       latch->getSuccessors().size() != 2)
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> loop test %s n%dn is not recognized\n",
+                  region->getNumber(), branch->getOpCode().getName(), branch->getGlobalIndex());
+      return false;
+      }
+
+   TR::TreeTop *ivStoreTree = loop->getLastRealTreeTop();
+   if (latch != loop)
+      {
+      if (latch->getFirstRealTreeTop() != branchTree || loop->getSuccessors().size() != 1)
+         return false;
+      if (ivStoreTree->getNode()->getOpCodeValue() == TR::Goto)
+         ivStoreTree = ivStoreTree->getPrevTreeTop();
+      else if (loop->getNextBlock() != latch)
+         return false;
+      }
+   else
+      {
+      ivStoreTree = branchTree->getPrevTreeTop();
+      }
+
+   TR::Node *ivStore = ivStoreTree->getNode();
+   if (!ivStore->getOpCode().isStoreDirect() || ivStore->getSymbolReference() != ivSymRef)
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> induction variable not updated right before the loop test\n", region->getNumber());
+      return false;
+      }
+
+   TR::Node *increment = ivStore->getFirstChild();
+   TR::Node *step = increment->getNumChildren() == 2 ? increment->getSecondChild() : NULL;
+   if (!(increment->getOpCodeValue() == (isLong ? TR::ladd : TR::iadd) ||
+         increment->getOpCodeValue() == (isLong ? TR::lsub : TR::isub)) ||
+       !increment->getFirstChild()->getOpCode().isLoadVarDirect() ||
+       increment->getFirstChild()->getSymbolReference() != ivSymRef ||
+       !step->getOpCode().isLoadConst() ||
+       step->get64bitIntegralValue() != (increment->getOpCode().isAdd() ? 1 : -1))
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> induction variable update n%dn is not recognized\n",
+                  region->getNumber(), ivStore->getGlobalIndex());
+      return false;
+      }
+
+   candidate._preHeader = preHeader;
+   candidate._loop = loop;
+   candidate._latch = latch;
+   candidate._exit = exit;
+   candidate._ivStoreTree = ivStoreTree;
+   candidate._ivSymRef = ivSymRef;
+   candidate._branchOp = branchOp;
+   candidate._elementSize = 0;
+   candidate._numAliasChecks = 0;
+   candidate._idiom = NoIdiom;
+   candidate._idiomStore = NULL;
+
+   // Collect the array element stores; anything else with a side effect
+   // prevents vectorization
+   //
+   for (TR::TreeTop *tt = loop->getFirstRealTreeTop(); tt != ivStoreTree; tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      if (node->getOpCodeValue() == TR::treetop)
+         continue;
+
+      if (node->getOpCode().isStoreIndirect() &&
+          node->getSymbol()->isArrayShadowSymbol() &&
+          isIdiomType(node->getDataType()))
+         {
+         _stores->add(node);
+         continue;
+         }
+
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> tree n%dn (%s) cannot be vectorized\n",
+                  region->getNumber(), node->getGlobalIndex(), node->getOpCode().getName());
+      return false;
+      }
+
+   if (_stores->isEmpty())
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> no array stores\n", region->getNumber());
+      return false;
+      }
+
+   candidate._idiom = findIdiom(candidate);
+   if (candidate._idiom == NoIdiom && !_vectorize)
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> not a copy or fill loop\n", region->getNumber());
+      return false;
+      }
+
+   for (TR::TreeTop *tt = loop->getFirstRealTreeTop(); candidate._idiom == NoIdiom && tt != ivStoreTree; tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      bool vectorizable;
+      if (node->getOpCodeValue() == TR::treetop)
+         {
+         vectorizable = classify(node->getFirstChild(), candidate)._kind != Invalid;
+         }
+      else
+         {
+         ValueInfo address = classify(node->getFirstChild(), candidate);
+         ValueInfo value = classify(node->getSecondChild(), candidate);
+         vectorizable = isVectorizableType(node->getDataType()) &&
+                        address._kind == Affine &&
+                        address._stride == node->getSize() &&
+                        (value._kind == Vector || value._kind == Invariant) &&
+                        setElementSize(node->getDataType(), candidate) &&
+                        cg()->getSupportsOpCodeForAutoSIMD(TR::ILOpCode(TR::vstorei), node->getDataType()) &&
+                        (value._kind == Vector ||
+                         cg()->getSupportsOpCodeForAutoSIMD(TR::ILOpCode(TR::vsplats), node->getDataType()));
+         }
+
+      if (!vectorizable)
+         {
+         if (trace())
+            traceMsg(comp(), "Reject loop %d ==> tree n%dn (%s) cannot be vectorized\n",
+                     region->getNumber(), node->getGlobalIndex(), node->getOpCode().getName());
+         return false;
+         }
+      }
+
+   // Work out which value of the induction variable the loop test compares
+   //
+   TR::Node *ivTest = branch->getFirstChild();
+   if (ivTest == increment || (latch != loop && ivTest->getOpCode().isLoadVarDirect() && ivTest->getSymbolReference() == ivSymRef))
+      {
+      candidate._testAdjust = 1;
+      }
+   else if (ivTest->getOpCode().isLoadVarDirect() && ivTest->getSymbolReference() == ivSymRef)
+      {
+      bool isOldValue = ivTest == increment->getFirstChild() || _valueInfo->find(ivTest) != _valueInfo->end();
+      candidate._testAdjust = isOldValue ? 0 : 1;
+      }
+   else
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> loop test does not compare the induction variable\n", region->getNumber());
+      return false;
+      }
+
+   candidate._bound = branch->getSecondChild();
+   if (classify(candidate._bound, candidate)._kind != Invariant)
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> loop bound is not invariant\n", region->getNumber());
+      return false;
+      }
+
+   if (candidate._idiom != NoIdiom)
+      return true;
+
+   candidate._vectorLength = vectorWidth / candidate._elementSize;
+   if (candidate._vectorLength < 2)
+      return false;
+
+   return findAliasChecks(candidate);
+   }
+
+// Collects the pairs of accesses that may overlap.  The addresses of both
+// accesses of a pair advance by the element size in every iteration, so the
+// distance between them is loop invariant and is tested once before the loop.
+//
+bool TR_LoopVectorizer::findAliasChecks(CandidateLoop &candidate)
+   {
+   ListIterator<TR::Node> storeIt(_stores);
+   for (TR::Node *store = storeIt.getFirst(); store; store = storeIt.getNext())
+      {
+      ListIterator<TR::Node> otherStoreIt(_stores);
+      TR::Node *access = otherStoreIt.getFirst();
+      while (access != store)
+         access = otherStoreIt.getNext();
+      for (access = otherStoreIt.getNext(); access; access = otherStoreIt.getNext())
+         {
+         if (!addAliasCheck(store, access, candidate))
+            return false;
+         }
+
+      ListIterator<TR::Node> loadIt(_vectorLoads);
+      for (access = loadIt.getFirst(); access; access = loadIt.getNext())
+         {
+         if (!addAliasCheck(store, access, candidate))
+            return false;
+         }
+      }
+
+   return true;
+   }
+
+bool TR_LoopVectorizer::addAliasCheck(TR::Node *store, TR::Node *access, CandidateLoop &candidate)
+   {
+   if (access->getFirstChild() == store->getFirstChild() ||
+       !store->mayKill().contains(access->getSymbolReference(), comp()))
+      return true;
+
+   if (candidate._numAliasChecks == maxAliasChecks)
+      {
+      if (trace())
+         traceMsg(comp(), "Reject loop %d ==> too many alias checks\n", candidate._region->getNumber());
+      return false;
+      }
+
+   AliasCheck &check = candidate._aliasChecks[candidate._numAliasChecks++];
+   check._store = store;
+   check._access = access;
+   return true;
+   }
+
+bool TR_LoopVectorizer::isKilledInLoop(TR::SymbolReference *symRef, CandidateLoop &candidate)
+   {
+   if (symRef == candidate._ivSymRef ||
+       candidate._ivStoreTree->getNode()->mayKill().contains(symRef, comp()))
+      return true;
+
+   ListIterator<TR::Node> it(_stores);
+   for (TR::Node *store = it.getFirst(); store; store = it.getNext())
+      {
+      if (store->mayKill().contains(symRef, comp()))
+         return true;
+      }
+   return false;
+   }
+
+// All the vector values of a loop must have the same number of elements
+//
+bool TR_LoopVectorizer::setElementSize(TR::DataType type, CandidateLoop &candidate)
+   {
+   int32_t size = TR::DataType::getSize(type);
+   if (candidate._elementSize == 0)
+      candidate._elementSize = size;
+   return candidate._elementSize == size;
+   }
+
+TR_LoopVectorizer::ValueInfo TR_LoopVectorizer::classify(TR::Node *node, CandidateLoop &candidate)
+   {
+   auto found = _valueInfo->find(node);
+   if (found != _valueInfo->end())
+      return found->second;
+
+   ValueInfo info = { Invalid, 0 };
+   TR::ILOpCode &op = node->getOpCode();
+   TR::ILOpCodes opValue = op.getOpCodeValue();
+   TR::DataType type = node->getDataType();
+
+   if (op.isLoadConst() || opValue == TR::loadaddr)
+      {
+      info._kind = Invariant;
+      }
+   else if (op.isLoadVarDirect())
+      {
+      if (node->getSymbolReference() == candidate._ivSymRef)
+         {
+         info._kind = Affine;
+         info._stride = 1;
+         }
+      else if (!isKilledInLoop(node->getSymbolReference(), candidate))
+         {
+         info._kind = Invariant;
+         }
+      }
+   else if (op.isLoadIndirect())
+      {
+      ValueInfo address = classify(node->getFirstChild(), candidate);
+      if (address._kind == Affine &&
+          address._stride == node->getSize() &&
+          node->getSymbol()->isArrayShadowSymbol() &&
+          isVectorizableType(type) &&
+          cg()->getSupportsOpCodeForAutoSIMD(TR::ILOpCode(TR::vloadi), type) &&
+          setElementSize(type, candidate))
+         {
+         info._kind = Vector;
+         _vectorLoads->add(node);
+         }
+      else if (address._kind == Invariant && !isKilledInLoop(node->getSymbolReference(), candidate))
+         {
+         info._kind = Invariant;
+         }
+      }
+   else if (op.isConversion() && node->getNumChildren() == 1)
+      {
+      ValueInfo child = classify(node->getFirstChild(), candidate);
+      if (child._kind == Invariant || (child._kind == Affine && opValue == TR::i2l))
+         info = child;
+      }
+   else if ((op.isArithmetic() || op.isBooleanCompare()) && node->getNumChildren() <= 2)
+      {
+      ValueInfo first = classify(node->getFirstChild(), candidate);
+      ValueInfo second = node->getNumChildren() == 2 ? classify(node->getSecondChild(), candidate) : first;
+      TR::Node *secondChild = node->getNumChildren() == 2 ? node->getSecondChild() : NULL;
+
+      if (first._kind == Invalid || second._kind == Invalid)
+         {
+         }
+      else if (first._kind == Vector || second._kind == Vector)
+         {
+         // Element wise operation on vectors and splatted invariants
+         TR::ILOpCodes vectorOp = vectorOpCode(opValue);
+         if (vectorOp != TR::BadILOp &&
+             first._kind != Affine && second._kind != Affine &&
+             cg()->getSupportsOpCodeForAutoSIMD(TR::ILOpCode(vectorOp), type) &&
+             setElementSize(type, candidate) &&
+             (first._kind == Vector || cg()->getSupportsOpCodeForAutoSIMD(TR::ILOpCode(TR::vsplats), type)) &&
+             (second._kind == Vector || cg()->getSupportsOpCodeForAutoSIMD(TR::ILOpCode(TR::vsplats), type)))
+            info._kind = Vector;
+         }
+      else if (first._kind == Affine || second._kind == Affine)
+         {
+         // Address arithmetic on the induction variable
+         if (op.isAdd() && node->getNumChildren() == 2)
+            {
+            info._kind = Affine;
+            info._stride = (first._kind == Affine ? first._stride : 0) + (second._kind == Affine ? second._stride : 0);
+            }
+         else if (op.isSub() && node->getNumChildren() == 2)
+            {
+            info._kind = Affine;
+            info._stride = (first._kind == Affine ? first._stride : 0) - (second._kind == Affine ? second._stride : 0);
+            }
+         else if ((opValue == TR::imul || opValue == TR::lmul) &&
+                  first._kind == Affine && secondChild->getOpCode().isLoadConst())
+            {
+            info._kind = Affine;
+            info._stride = first._stride * secondChild->get64bitIntegralValue();
+            }
+         else if ((opValue == TR::ishl || opValue == TR::lshl) &&
+                  first._kind == Affine && secondChild->getOpCode().isLoadConst() &&
+                  secondChild->get64bitIntegralValue() >= 0 && secondChild->get64bitIntegralValue() < 32)
+            {
+            info._kind = Affine;
+            info._stride = first._stride << secondChild->get64bitIntegralValue();
+            }
+         }
+      else
+         {
+         info._kind = Invariant;
+         }
+      }
+
+   _valueInfo->insert(std::make_pair(node, info));
+   return info;
+   }
+
+// Recognizes a loop body that does nothing but copy one array to another,
+// or fill an array with a loop invariant value, one element per iteration
+//
+TR_LoopVectorizer::IdiomKind TR_LoopVectorizer::findIdiom(CandidateLoop &candidate)
+   {
+   if (_stores->getSize() != 1)
+      return NoIdiom;
+
+   TR::Node *store = _stores->getListHead()->getData();
+   TR::Node *value = store->getSecondChild();
+   int32_t elementSize = store->getSize();
+   if (store->getSymbolReference()->getOffset() != 0)
+      return NoIdiom;
+
+   ValueInfo address = classify(store->getFirstChild(), candidate);
+   if (address._kind != Affine || address._stride != elementSize)
+      return NoIdiom;
+
+   IdiomKind idiom = NoIdiom;
+   if (value->getOpCode().isLoadIndirect() &&
+       value->getSymbol()->isArrayShadowSymbol() &&
+       value->getDataType() == store->getDataType() &&
+       value->getSymbolReference()->getOffset() == 0)
+      {
+      ValueInfo source = classify(value->getFirstChild(), candidate);
+      if (_reduceCopies && source._kind == Affine && source._stride == elementSize)
+         idiom = CopyIdiom;
+      }
+   else if (_reduceFills && classify(value, candidate)._kind == Invariant)
+      {
+      idiom = FillIdiom;
+      }
+
+   if (idiom == NoIdiom)
+      return NoIdiom;
+
+   // Anything anchored in the loop must be free of side effects, as it is
+   // not evaluated by the reduced loop
+   //
+   for (TR::TreeTop *tt = candidate._loop->getFirstRealTreeTop(); tt != candidate._ivStoreTree; tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      if (node->getOpCodeValue() == TR::treetop &&
+          node->getFirstChild() != value &&
+          classify(node->getFirstChild(), candidate)._kind == Invalid)
+         return NoIdiom;
+      }
+
+   candidate._idiomStore = store;
+   candidate._elementSize = elementSize;
+   return idiom;
+   }
+
+TR::Block *TR_LoopVectorizer::createBlock(CandidateLoop &candidate, int32_t frequency)
+   {
+   TR::Block *block = TR::Block::createEmptyBlock(candidate._loop->getEntry()->getNode(), comp(), frequency, candidate._loop);
+   _cfg->addNode(block);
+   return block;
+   }
+
+TR::Node *TR_LoopVectorizer::cloneScalar(TR::Node *node, NodeMap &clones)
+   {
+   auto found = clones.find(node);
+   if (found != clones.end())
+      return found->second;
+
+   TR::Node *clone = TR::Node::copy(node);
+   clone->setReferenceCount(0);
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      clone->setAndIncChild(i, cloneScalar(node->getChild(i), clones));
+
+   clones.insert(std::make_pair(node, clone));
+   return clone;
+   }
+
+TR::SymbolReference *TR_LoopVectorizer::vectorShadow(TR::DataType elementType)
+   {
+   return comp()->getSymRefTab()->findOrCreateArrayShadowSymbolRef(elementType.scalarToVector(), NULL);
+   }
+
+// Returns the vector form of node; invariant scalars are splatted
+//
+TR::Node *TR_LoopVectorizer::vectorize(TR::Node *node, NodeMap &vectors, NodeMap &clones)
+   {
+   auto found = vectors.find(node);
+   if (found != vectors.end())
+      return found->second;
+
+   TR::Node *vector;
+   if ((*_valueInfo)[node]._kind != Vector)
+      {
+      vector = TR::Node::create(TR::vsplats, 1, cloneScalar(node, clones));
+      }
+   else if (node->getOpCode().isLoadIndirect())
+      {
+      vector = TR::Node::createWithSymRef(TR::vloadi, 1, 1, cloneScalar(node->getFirstChild(), clones),
+                                          vectorShadow(node->getDataType()));
+      }
+   else
+      {
+      TR::Node *first = vectorize(node->getFirstChild(), vectors, clones);
+      TR::Node *second = vectorize(node->getSecondChild(), vectors, clones);
+      vector = TR::Node::create(vectorOpCode(node->getOpCodeValue()), 2, first, second);
+      }
+
+   vectors.insert(std::make_pair(node, vector));
+   return vector;
+   }
+
+void TR_LoopVectorizer::vectorizeLoop(CandidateLoop &candidate)
+   {
+   TR::Block *preHeader = candidate._preHeader;
+   TR::Block *loop = candidate._loop;
+   TR::Block *exit = candidate._exit;
+   TR::SymbolReference *ivSymRef = candidate._ivSymRef;
+   bool isLong = ivSymRef->getSymbol()->getDataType() == TR::Int64;
+   int32_t vectorLength = candidate._vectorLength;
+   TR::Region &region = comp()->trMemory()->currentStackRegion();
+
+   TR::Block *checkBlock = createBlock(candidate, preHeader->getFrequency());
+   TR::Block *vectorPreHeader = createBlock(candidate, preHeader->getFrequency());
+   TR::Block *vectorLoop = createBlock(candidate, loop->getFrequency());
+   TR::Block *guardBlock = createBlock(candidate, preHeader->getFrequency());
+   TR::Block *scalarPreHeader = createBlock(candidate, preHeader->getFrequency());
+   vectorPreHeader->setAsLoopInvariantBlock(true);
+   scalarPreHeader->setAsLoopInvariantBlock(true);
+
+   // The vector loop runs while at least vectorLength iterations remain.  The
+   // last iteration it covers is the one that tests i + vectorLength - 1, so
+   // it may start while i cmp bound - (vectorLength - 2 + testAdjust).  The
+   // limit is computed in 64 bits so that it cannot wrap around; when it is
+   // below the range of the induction variable the vector loop is skipped.
+   //
+   int64_t limitAdjust = vectorLength - 2 + candidate._testAdjust;
+   bool isLessOrEqual = candidate._branchOp == TR::ificmple || candidate._branchOp == TR::iflcmple;
+   TR::SymbolReference *limitSymRef = comp()->getSymRefTab()->createTemporary(comp()->getMethodSymbol(), isLong ? TR::Int64 : TR::Int32);
+
+   NodeMap checkClones(std::less<TR::Node *>(), region);
+   TR::Node *bound = cloneScalar(candidate._bound, checkClones);
+   TR::Node *skipVectorLoop;
+   TR::Node *limitStore;
+   if (isLong)
+      {
+      TR::Node *limit = TR::Node::create(TR::lsub, 2, bound, TR::Node::lconst(limitAdjust));
+      limitStore = TR::Node::createStore(limitSymRef, limit);
+      skipVectorLoop = TR::Node::create(TR::ior, 2,
+         TR::Node::create(TR::lcmplt, 2, bound, TR::Node::lconst(TR::getMinSigned<TR::Int64>() + limitAdjust)),
+         TR::Node::create(isLessOrEqual ? TR::lcmpgt : TR::lcmpge, 2, TR::Node::createLoad(ivSymRef), limit));
+      }
+   else
+      {
+      TR::Node *limit = TR::Node::create(TR::lsub, 2, TR::Node::create(TR::i2l, 1, bound), TR::Node::lconst(limitAdjust));
+      limitStore = TR::Node::createStore(limitSymRef, TR::Node::create(TR::l2i, 1, limit));
+      skipVectorLoop = TR::Node::create(isLessOrEqual ? TR::lcmpgt : TR::lcmpge, 2,
+         TR::Node::create(TR::i2l, 1, TR::Node::createLoad(ivSymRef)), limit);
+      }
+
+   // Accesses whose distance is less than a vector apart would see each
+   // other's elements out of order
+   //
+   for (int32_t i = 0; i < candidate._numAliasChecks; i++)
+      {
+      AliasCheck &check = candidate._aliasChecks[i];
+      TR::Node *distance = TR::Node::create(TR::lsub, 2,
+         TR::Node::create(TR::a2l, 1, cloneScalar(check._access->getFirstChild(), checkClones)),
+         TR::Node::create(TR::a2l, 1, cloneScalar(check._store->getFirstChild(), checkClones)));
+      TR::Node *overlaps = TR::Node::create(TR::iand, 2,
+         TR::Node::create(TR::lucmple, 2,
+            TR::Node::create(TR::ladd, 2, distance, TR::Node::lconst(vectorWidth - 1)),
+            TR::Node::lconst(2 * (vectorWidth - 1))),
+         TR::Node::create(TR::lcmpne, 2, distance, TR::Node::lconst(0)));
+      skipVectorLoop = TR::Node::create(TR::ior, 2, skipVectorLoop, overlaps);
+      }
+
+   checkBlock->append(TR::TreeTop::create(comp(), limitStore));
+   checkBlock->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(TR::ificmpne, skipVectorLoop, TR::Node::iconst(0), scalarPreHeader->getEntry())));
+
+   // The vector loop
+   //
+   NodeMap vectorClones(std::less<TR::Node *>(), region);
+   NodeMap vectors(std::less<TR::Node *>(), region);
+   for (TR::TreeTop *tt = loop->getFirstRealTreeTop(); tt != candidate._ivStoreTree; tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      TR::Node *vectorNode;
+      if (node->getOpCodeValue() == TR::treetop)
+         {
+         TR::Node *child = node->getFirstChild();
+         vectorNode = TR::Node::create(TR::treetop, 1,
+            (*_valueInfo)[child]._kind == Vector ? vectorize(child, vectors, vectorClones) : cloneScalar(child, vectorClones));
+         }
+      else
+         {
+         vectorNode = TR::Node::createWithSymRef(TR::vstorei, 2, 2,
+            cloneScalar(node->getFirstChild(), vectorClones),
+            vectorize(node->getSecondChild(), vectors, vectorClones),
+            vectorShadow(node->getDataType()));
+         }
+      vectorLoop->append(TR::TreeTop::create(comp(), vectorNode));
+      }
+
+   TR::Node *ivIncrement = isLong ?
+      TR::Node::create(TR::ladd, 2, TR::Node::createLoad(ivSymRef), TR::Node::lconst(vectorLength)) :
+      TR::Node::create(TR::iadd, 2, TR::Node::createLoad(ivSymRef), TR::Node::iconst(vectorLength));
+   vectorLoop->append(TR::TreeTop::create(comp(), TR::Node::createStore(ivSymRef, ivIncrement)));
+   vectorLoop->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(candidate._branchOp, TR::Node::createLoad(ivSymRef), TR::Node::createLoad(limitSymRef), vectorLoop->getEntry())));
+
+   // Leave if the last iteration done by the vector loop was the last one
+   //
+   NodeMap guardClones(std::less<TR::Node *>(), region);
+   TR::Node *ivTest = TR::Node::createLoad(ivSymRef);
+   if (candidate._testAdjust == 0)
+      ivTest = isLong ?
+         TR::Node::create(TR::lsub, 2, ivTest, TR::Node::lconst(1)) :
+         TR::Node::create(TR::isub, 2, ivTest, TR::Node::iconst(1));
+   guardBlock->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(reverseBranchOpCode(candidate._branchOp), ivTest,
+                         cloneScalar(candidate._bound, guardClones), exit->getEntry())));
+
+   _cfg->addEdge(checkBlock, vectorPreHeader);
+   _cfg->addEdge(checkBlock, scalarPreHeader);
+   _cfg->addEdge(vectorPreHeader, vectorLoop);
+   _cfg->addEdge(vectorLoop, vectorLoop);
+   _cfg->addEdge(vectorLoop, guardBlock);
+   _cfg->addEdge(guardBlock, exit);
+   _cfg->addEdge(guardBlock, scalarPreHeader);
+
+   TR::Block *blocks[] = { checkBlock, vectorPreHeader, vectorLoop, guardBlock, scalarPreHeader };
+   insertBlocks(candidate, blocks, sizeof(blocks) / sizeof(blocks[0]));
+   }
+
+void TR_LoopVectorizer::reduceLoop(CandidateLoop &candidate)
+   {
+   TR::Block *preHeader = candidate._preHeader;
+   TR::Block *exit = candidate._exit;
+   TR::Node *store = candidate._idiomStore;
+   TR::SymbolReference *ivSymRef = candidate._ivSymRef;
+   bool isLong = ivSymRef->getSymbol()->getDataType() == TR::Int64;
+   int32_t elementSize = candidate._elementSize;
+   TR::Region &region = comp()->trMemory()->currentStackRegion();
+
+   TR::Block *checkBlock = createBlock(candidate, preHeader->getFrequency());
+   TR::Block *reducedBlock = createBlock(candidate, preHeader->getFrequency());
+   TR::Block *scalarPreHeader = createBlock(candidate, preHeader->getFrequency());
+   scalarPreHeader->setAsLoopInvariantBlock(true);
+
+   // The loop runs once, and then again while i cmp bound holds for the value
+   // of i the loop test sees, so it runs bound - i + adjust times when that
+   // is more than once.  The count is computed in 64 bits so that it cannot
+   // wrap around for 32 bit induction variables; a long loop that would run
+   // once is never reduced, so that bound - i does not overflow either.
+   //
+   bool isLessOrEqual = candidate._branchOp == TR::ificmple || candidate._branchOp == TR::iflcmple;
+   int64_t countAdjust = (isLessOrEqual ? 1 : 0) + 1 - candidate._testAdjust;
+   TR::SymbolReference *countSymRef = comp()->getSymRefTab()->createTemporary(comp()->getMethodSymbol(), TR::Int64);
+
+   NodeMap checkClones(std::less<TR::Node *>(), region);
+   TR::Node *bound = cloneScalar(candidate._bound, checkClones);
+   TR::Node *iv = TR::Node::createLoad(ivSymRef);
+   TR::Node *skipReducedLoop = NULL;
+   if (isLong)
+      {
+      skipReducedLoop = TR::Node::create(TR::lcmplt, 2, bound, iv);
+      }
+   else
+      {
+      bound = TR::Node::create(TR::i2l, 1, bound);
+      iv = TR::Node::create(TR::i2l, 1, iv);
+      }
+
+   TR::Node *count = TR::Node::create(TR::ladd, 2,
+      TR::Node::create(TR::lsub, 2, bound, iv), TR::Node::lconst(countAdjust));
+   TR::Node *tooShort = TR::Node::create(TR::lcmple, 2, count, TR::Node::lconst(1));
+   skipReducedLoop = skipReducedLoop ? TR::Node::create(TR::ior, 2, skipReducedLoop, tooShort) : tooShort;
+
+   // Copying element by element from the front repeats the first elements of
+   // the source when the destination starts inside of it
+   //
+   if (candidate._idiom == CopyIdiom)
+      {
+      TR::Node *distance = TR::Node::create(TR::lsub, 2,
+         TR::Node::create(TR::a2l, 1, cloneScalar(store->getFirstChild(), checkClones)),
+         TR::Node::create(TR::a2l, 1, cloneScalar(store->getSecondChild()->getFirstChild(), checkClones)));
+      TR::Node *overlaps = TR::Node::create(TR::lucmplt, 2,
+         TR::Node::create(TR::lsub, 2, distance, TR::Node::lconst(1)),
+         TR::Node::create(TR::lsub, 2,
+            TR::Node::create(TR::lmul, 2, count, TR::Node::lconst(elementSize)), TR::Node::lconst(1)));
+      skipReducedLoop = TR::Node::create(TR::ior, 2, skipReducedLoop, overlaps);
+      }
+
+   checkBlock->append(TR::TreeTop::create(comp(), TR::Node::createStore(countSymRef, count)));
+   checkBlock->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(TR::ificmpne, skipReducedLoop, TR::Node::iconst(0), scalarPreHeader->getEntry())));
+
+   // The reduced loop
+   //
+   NodeMap reducedClones(std::less<TR::Node *>(), region);
+   TR::Node *size = TR::Node::create(TR::lmul, 2, TR::Node::createLoad(countSymRef), TR::Node::lconst(elementSize));
+   TR::Node *reduced;
+   if (candidate._idiom == CopyIdiom)
+      {
+      reduced = TR::Node::createArraycopy(
+         cloneScalar(store->getSecondChild()->getFirstChild(), reducedClones),
+         cloneScalar(store->getFirstChild(), reducedClones),
+         size);
+      reduced->setSymbolReference(comp()->getSymRefTab()->findOrCreateArrayCopySymbol());
+      reduced->setArrayCopyElementType(store->getDataType());
+      reduced->setForwardArrayCopy(true);
+      }
+   else
+      {
+      reduced = TR::Node::create(TR::arrayset, 3,
+         cloneScalar(store->getFirstChild(), reducedClones),
+         cloneScalar(store->getSecondChild(), reducedClones),
+         size);
+      reduced->setSymbolReference(comp()->getSymRefTab()->findOrCreateArraySetSymbol());
+      }
+   reducedBlock->append(TR::TreeTop::create(comp(), TR::Node::create(TR::treetop, 1, reduced)));
+
+   TR::Node *ivIncrement = isLong ?
+      TR::Node::create(TR::ladd, 2, TR::Node::createLoad(ivSymRef), TR::Node::createLoad(countSymRef)) :
+      TR::Node::create(TR::iadd, 2, TR::Node::createLoad(ivSymRef), TR::Node::create(TR::l2i, 1, TR::Node::createLoad(countSymRef)));
+   reducedBlock->append(TR::TreeTop::create(comp(), TR::Node::createStore(ivSymRef, ivIncrement)));
+   reducedBlock->append(TR::TreeTop::create(comp(), TR::Node::create(store, TR::Goto, 0, exit->getEntry())));
+
+   _cfg->addEdge(checkBlock, reducedBlock);
+   _cfg->addEdge(checkBlock, scalarPreHeader);
+   _cfg->addEdge(reducedBlock, exit);
+
+   TR::Block *blocks[] = { checkBlock, reducedBlock, scalarPreHeader };
+   insertBlocks(candidate, blocks, sizeof(blocks) / sizeof(blocks[0]));
+   }
+
+// Lays the new blocks out in the given order between the preheader and the
+// loop, right after the preheader when it falls through to the loop,
+// otherwise at the end of the method with a goto back to the loop.  The last
+// block becomes the preheader of the original loop.
+//
+void TR_LoopVectorizer::insertBlocks(CandidateLoop &candidate, TR::Block **blocks, int32_t numBlocks)
+   {
+   TR::Block *preHeader = candidate._preHeader;
+   TR::Block *loop = candidate._loop;
+   TR::Block *scalarPreHeader = blocks[numBlocks - 1];
+
+   TR::TreeTop *prevTree;
+   TR::Node *preHeaderGoto = NULL;
+   if (preHeader->getEntry()->getNextTreeTop() != preHeader->getExit() &&
+       preHeader->getLastRealTreeTop()->getNode()->getOpCodeValue() == TR::Goto)
+      preHeaderGoto = preHeader->getLastRealTreeTop()->getNode();
+
+   if (preHeaderGoto)
+      {
+      preHeaderGoto->setBranchDestination(blocks[0]->getEntry());
+      prevTree = comp()->getMethodSymbol()->getLastTreeTop();
+      scalarPreHeader->append(TR::TreeTop::create(comp(), TR::Node::create(preHeaderGoto, TR::Goto, 0, loop->getEntry())));
+      }
+   else
+      {
+      prevTree = preHeader->getExit();
+      }
+
+   TR::TreeTop *nextTree = prevTree->getNextTreeTop();
+   prevTree->join(blocks[0]->getEntry());
+   for (int32_t i = 1; i < numBlocks; i++)
+      blocks[i - 1]->getExit()->join(blocks[i]->getEntry());
+   scalarPreHeader->getExit()->join(nextTree);
+
+   _cfg->addEdge(preHeader, blocks[0]);
+   _cfg->addEdge(scalarPreHeader, loop);
+   _cfg->removeEdge(preHeader, loop);
+   }
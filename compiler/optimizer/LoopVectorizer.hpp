@@ -0,0 +1,186 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef LOOPVECTORIZER_INCL
+#define LOOPVECTORIZER_INCL
+
+#include <stdint.h>
+#include <map>
+#include "env/TRMemory.hpp"
+#include "il/DataTypes.hpp"
+#include "il/ILOpCodes.hpp"
+#include "infra/List.hpp"
+#include "optimizer/Optimization.hpp"
+#include "optimizer/OptimizationManager.hpp"
+
+class TR_RegionStructure;
+class TR_Structure;
+namespace TR { class Block; }
+namespace TR { class CFG; }
+namespace TR { class Node; }
+namespace TR { class SymbolReference; }
+namespace TR { class TreeTop; }
+
+/**
+ * Vectorizes counted loops for the SIMD units of the target.
+ *
+ * Candidates are innermost loops of a single block, or of a body and the
+ * latch holding the loop test, whose primary induction variable is
+ * incremented by one and compared against a loop invariant bound, and
+ * whose only side effects are array element stores of the form
+ *
+ *    a[i] = f(b[i], c[i], invariant...)
+ *
+ * where f is made of element wise operations the code generator supports
+ * for AutoSIMD and every access has a unit stride.  Such a loop
+ *
+ *    preheader: ...
+ *    loop:      body ; i = i + 1 ; if (i < n) goto loop
+ *
+ * becomes
+ *
+ *    preheader: ...
+ *    check:     limit = n - (VL - 1) ;
+ *               if (i >= limit || accesses overlap) goto scalarPreheader
+ *    vectorPreheader:
+ *    vector:    vector body ; i = i + VL ; if (i < limit) goto vector
+ *    guard:     if (i >= n) goto exit
+ *    scalarPreheader:
+ *    loop:      body ; i = i + 1 ; if (i < n) goto loop
+ *
+ * The original loop serves both as the scalar prologue, when the trip count
+ * is too small or the arrays overlap at run time, and as the scalar epilogue
+ * for the remaining iterations.
+ *
+ * Loops whose body is nothing but a copy or a fill, of elements of any size,
+ *
+ *    a[i] = b[i]          a[i] = invariant
+ *
+ * are instead reduced to a single arraycopy or arrayset, which the code
+ * generator lowers to unrolled moves or string instructions:
+ *
+ *    preheader: ...
+ *    check:     count = n - i + adjust ;
+ *               if (count <= 1 || a overlaps b ahead of it) goto scalarPreheader
+ *    reduced:   arraycopy(&b[i], &a[i], count * size) ; i = i + count ; goto exit
+ *    scalarPreheader:
+ *    loop:      body ; i = i + 1 ; if (i < n) goto loop
+ */
+class TR_LoopVectorizer : public TR::Optimization
+   {
+   public:
+
+   TR_LoopVectorizer(TR::OptimizationManager *manager);
+   static TR::Optimization *create(TR::OptimizationManager *manager)
+      {
+      return new (manager->allocator()) TR_LoopVectorizer(manager);
+      }
+
+   virtual bool shouldPerform();
+   virtual int32_t perform();
+   virtual const char * optDetailString() const throw();
+
+   private:
+
+   enum ValueKind
+      {
+      Invalid = 0,
+      Invariant,  // same value in every iteration
+      Affine,     // changes by a constant stride in every iteration
+      Vector      // element of an array accessed with unit stride
+      };
+
+   struct ValueInfo
+      {
+      ValueKind _kind;
+      int64_t _stride;
+      };
+
+   typedef TR::typed_allocator<std::pair<TR::Node * const, ValueInfo>, TR::Region &> ValueInfoMapAllocator;
+   typedef std::map<TR::Node *, ValueInfo, std::less<TR::Node *>, ValueInfoMapAllocator> ValueInfoMap;
+
+   typedef TR::typed_allocator<std::pair<TR::Node * const, TR::Node *>, TR::Region &> NodeMapAllocator;
+   typedef std::map<TR::Node *, TR::Node *, std::less<TR::Node *>, NodeMapAllocator> NodeMap;
+
+   enum IdiomKind
+      {
+      NoIdiom = 0,
+      CopyIdiom,  // a[i] = b[i]
+      FillIdiom   // a[i] = invariant
+      };
+
+   struct AliasCheck
+      {
+      TR::Node *_store;
+      TR::Node *_access;
+      };
+
+   static const int32_t maxAliasChecks = 8;
+
+   struct CandidateLoop
+      {
+      TR_RegionStructure *_region;
+      TR::Block *_preHeader;
+      TR::Block *_loop;
+      TR::Block *_latch;        // block holding the loop test, may be _loop
+      TR::Block *_exit;
+      TR::TreeTop *_ivStoreTree;
+      TR::SymbolReference *_ivSymRef;
+      TR::Node *_bound;
+      TR::ILOpCodes _branchOp;
+      int32_t _testAdjust;      // 1 if the loop test sees the incremented value of the iv
+      int32_t _elementSize;
+      int32_t _vectorLength;
+      int32_t _numAliasChecks;
+      AliasCheck _aliasChecks[maxAliasChecks];
+      IdiomKind _idiom;
+      TR::Node *_idiomStore;
+      ValueInfoMap *_valueInfo;
+      };
+
+   bool collectInnermostLoops(TR_Structure *str, List<TR_RegionStructure> &loops);
+   bool analyzeLoop(CandidateLoop &candidate);
+   bool findAliasChecks(CandidateLoop &candidate);
+   bool addAliasCheck(TR::Node *store, TR::Node *access, CandidateLoop &candidate);
+   bool isKilledInLoop(TR::SymbolReference *symRef, CandidateLoop &candidate);
+   bool setElementSize(TR::DataType type, CandidateLoop &candidate);
+   ValueInfo classify(TR::Node *node, CandidateLoop &candidate);
+   IdiomKind findIdiom(CandidateLoop &candidate);
+
+   void vectorizeLoop(CandidateLoop &candidate);
+   TR::Block *createBlock(CandidateLoop &candidate, int32_t frequency);
+   TR::Node *cloneScalar(TR::Node *node, NodeMap &clones);
+   TR::Node *vectorize(TR::Node *node, NodeMap &vectors, NodeMap &clones);
+   TR::SymbolReference *vectorShadow(TR::DataType elementType);
+
+   void reduceLoop(CandidateLoop &candidate);
+   void insertBlocks(CandidateLoop &candidate, TR::Block **blocks, int32_t numBlocks);
+
+   TR::CFG *_cfg;
+   bool _vectorize;
+   bool _reduceCopies;
+   bool _reduceFills;
+   ValueInfoMap *_valueInfo;
+   List<TR::Node> *_stores;
+   List<TR::Node> *_vectorLoads;
+   };
+
+#endif
@@ -140,6 +140,16 @@ void printNode(TR::Node *node, TR_BitVector &visitedNodes, int32_t indentation)
    }
    */
 
+TR_LoopAliasRefiner::TR_LoopAliasRefiner(TR::OptimizationManager *manager)
+   : TR_LoopVersioner(manager, false, true)
+   {}
+
+const char *
+TR_LoopAliasRefiner::optDetailString() const throw()
+   {
+   return "O^O LOOP ALIAS REFINER: ";
+   }
+
 TR_LoopSpecializer::TR_LoopSpecializer(TR::OptimizationManager *manager)
    : TR_LoopVersioner(manager, true)
    {}
@@ -443,6 +453,7 @@ int32_t TR_LoopVersioner::performWithoutDominators()
          {
          naturalLoop->resetInvariance();
          naturalLoop->computeInvariantExpressions();
+         _addressingTooComplicated = false;
          }
 
       _seenDefinedSymbolReferences->empty();
@@ -761,6 +772,10 @@ int32_t TR_LoopVersioner::performWithoutDominators()
    if (somethingChanged)
       requestOpt(OMR::andSimplification);
 
+   // The versioned loops have new induction variable stores in the slow copy
+   if (somethingChanged && refineAliases())
+      requestOpt(OMR::inductionVariableAnalysis);
+
    if (trace())
       {
       traceMsg(comp(), "\nCFG after loop versioning:\n");
@@ -8859,15 +8874,361 @@ bool TR_LoopVersioner::isStoreInRequiredForm(int32_t symRefNum, TR_Structure *lo
    }
 
 
+/**
+ * \brief Find the array accesses of the current loop whose aliases can be
+ * refined after versioning the loop on the disjointness of the memory they
+ * access.
+ *
+ * An access qualifies if its address is <tt>base + offset</tt>, where \c base
+ * is the load of a loop invariant auto or parm and \c offset is an affine
+ * function of the loop driving induction variable. The loop must not contain
+ * calls or indirect accesses other than array element accesses, and it must
+ * write memory through one base and access memory through another.
+ *
+ * \return true if the loop should be versioned
+ */
 bool TR_LoopVersioner::processArrayAliasCandidates()
    {
-   TR_ASSERT(!refineAliases(),"something wrong");
-   return false;
-}
-void TR_LoopVersioner::collectArrayAliasCandidates(TR::Node *node,vcount_t visitCount){ TR_ASSERT(!refineAliases(),"something wrong");}
-void TR_LoopVersioner::buildAliasRefinementComparisonTrees(List<TR::TreeTop> *nullCheckTrees, List<TR::TreeTop> *divCheckTrees, List<TR::TreeTop> *checkCastTrees, List<TR::TreeTop> *arrayStoreCheckTrees, TR_ScratchList<TR::Node> *comparisonTrees, TR::Block *exitGotoBlock){TR_ASSERT(!refineAliases(),"something wrong");}
+   ArrayAliasCandidates &candidates = _curLoop->_arrayAliasCandidates;
+   ArrayAliasGroups &groups = _curLoop->_arrayAliasGroups;
+   candidates.clear();
+   groups.clear();
+
+   if (_addressingTooComplicated ||
+       !TR::Compiler->target.is64Bit() ||
+       _versionableInductionVariables.isEmpty() ||
+       _loopTestTree == NULL ||
+       !_loopConditionInvariant)
+      return false;
+
+   TR_ScratchList<TR::Block> blocksInLoop(trMemory());
+   _currentNaturalLoop->getBlocks(&blocksInLoop);
+   ListIterator<TR::Block> blocksIt(&blocksInLoop);
+   for (TR::Block *block = blocksIt.getFirst(); block; block = blocksIt.getNext())
+      {
+      for (TR::TreeTop *tt = block->getEntry(); tt != block->getExit(); tt = tt->getNextTreeTop())
+         {
+         TR::Node *node = tt->getNode();
+         if (node->getOpCode().isCall() ||
+             (node->getNumChildren() > 0 && node->getFirstChild()->getOpCode().isCall()))
+            {
+            if (trace())
+               traceMsg(comp(), "Loop %d contains call n%dn, not refining aliases\n", _currentNaturalLoop->getNumber(), node->getGlobalIndex());
+            return false;
+            }
+         }
+      }
+
+   // The induction variable must be stepped by a constant towards the loop
+   // limit, so that it stays between its entry value and the limit
+   //
+   int32_t ivSymRefNum = *_versionableInductionVariables.getListHead()->getData();
+   TR::Node *ivStore = _storeTrees[ivSymRefNum]->getNode();
+   TR::Node *ivValue = ivStore->getFirstChild();
+   if ((ivValue->getOpCodeValue() != TR::iadd && ivValue->getOpCodeValue() != TR::isub) ||
+       !ivValue->getFirstChild()->getOpCode().isLoadVarDirect() ||
+       ivValue->getFirstChild()->getSymbolReference()->getReferenceNumber() != ivSymRefNum ||
+       !ivValue->getSecondChild()->getOpCode().isLoadConst())
+      return false;
+
+   int32_t increment = ivValue->getSecondChild()->getInt();
+   if (ivValue->getOpCodeValue() == TR::isub)
+      increment = -increment;
+   if (increment == 0 || increment == TR::getMinSigned<TR::Int32>())
+      return false;
+
+   TR::Node *loopTest = _loopTestTree->getNode();
+   TR::Node *testedValue = loopTest->getFirstChild();
+   if (testedValue != ivValue &&
+       !(testedValue->getOpCode().isLoadVarDirect() && testedValue->getSymbolReference()->getReferenceNumber() == ivSymRefNum))
+      return false;
+
+   TR::Block *destination = loopTest->getBranchDestination()->getNode()->getBlock();
+   TR::ILOpCode continueOp = loopTest->getOpCode();
+   if (!_currentNaturalLoop->contains(destination->getStructureOf(), _currentNaturalLoop->getParent()))
+      continueOp = TR::ILOpCode(continueOp.getOpCodeForReverseBranch());
+   if (increment > 0 ?
+       (continueOp.getOpCodeValue() != TR::ificmplt && continueOp.getOpCodeValue() != TR::ificmple) :
+       (continueOp.getOpCodeValue() != TR::ificmpgt && continueOp.getOpCodeValue() != TR::ificmpge))
+      return false;
+
+   _curLoop->_arrayAliasInductionVariable = comp()->getSymRefTab()->getSymRef(ivSymRefNum);
+   _curLoop->_arrayAliasIncrement = increment;
+
+   ListIterator<TR::Node> accessIt(_arrayAccesses);
+   for (TR::Node *node = accessIt.getFirst(); node; node = accessIt.getNext())
+      {
+      if (!node->getOpCode().isIndirect() || node->getDataType().isVector())
+         continue;
+
+      // Accesses that do not qualify keep their array shadow, which remains
+      // aliased to the refined shadows
+      //
+      TR::Node *address = node->getFirstChild();
+      TR::Node *base = address->getFirstChild();
+      int64_t stride = 0;
+      if (address->getOpCodeValue() != TR::aladd ||
+          !base->getOpCode().isLoadVarDirect() ||
+          !base->getSymbol()->isAutoOrParm() ||
+          !isExprInvariant(base) ||
+          !getArrayAliasStride(address->getSecondChild(), stride))
+         {
+         if (trace())
+            traceMsg(comp(), "Array access n%dn does not qualify for alias refinement\n", node->getGlobalIndex());
+         continue;
+         }
+
+      ArrayAliasCandidate candidate;
+      candidate._node = node;
+      candidate._stride = stride;
+      candidate._group = -1;
+      for (int32_t g = 0; g < groups.size(); g++)
+         {
+         if (groups[g]._base == base->getSymbolReference() &&
+             groups[g]._type == node->getSymbol()->getDataType())
+            candidate._group = g;
+         }
+      if (candidate._group < 0)
+         {
+         ArrayAliasGroup group;
+         group._base = base->getSymbolReference();
+         group._type = node->getSymbol()->getDataType();
+         candidate._group = groups.size();
+         groups.push_back(group);
+         }
+      candidates.push_back(candidate);
+      }
+
+   static const int32_t maxDisjointnessTests = 16;
+   int32_t numTests = 0;
+   for (size_t i = 0; i < candidates.size(); i++)
+      for (size_t j = i + 1; j < candidates.size(); j++)
+         if (needsDisjointnessTest(candidates[i], candidates[j]))
+            numTests++;
+
+   if (trace())
+      traceMsg(comp(), "Loop %d has %d array alias candidates in %d groups needing %d disjointness tests\n",
+               _currentNaturalLoop->getNumber(), (int32_t)candidates.size(), (int32_t)groups.size(), numTests);
+
+   return numTests > 0 && numTests <= maxDisjointnessTests;
+   }
+
+void TR_LoopVersioner::collectArrayAliasCandidates(TR::Node *node, vcount_t visitCount)
+   {
+   // Other indirect accesses could reach the same memory as the array
+   // accesses without being aliased to their refined shadows
+   if (!node->getOpCode().hasSymbolReference() ||
+       !node->getSymbolReference()->getSymbol()->isArrayShadowSymbol())
+      _addressingTooComplicated = true;
+   }
+
+/**
+ * \brief Compute the change of the value of \p node for every unit the
+ * induction variable of the alias refinement changes by.
+ *
+ * \return false if \p node is not an affine function of the induction variable
+ */
+bool TR_LoopVersioner::getArrayAliasStride(TR::Node *node, int64_t &stride)
+   {
+   TR::ILOpCode &opCode = node->getOpCode();
+   if (opCode.isLoadConst())
+      {
+      stride = 0;
+      return true;
+      }
+
+   if (opCode.isLoadVarDirect())
+      {
+      if (node->getSymbolReference() == _curLoop->_arrayAliasInductionVariable)
+         {
+         stride = 1;
+         return true;
+         }
+      stride = 0;
+      return node->getSymbol()->isAutoOrParm() && isExprInvariant(node);
+      }
+
+   int64_t first, second;
+   switch (node->getOpCodeValue())
+      {
+      case TR::i2l:
+         return getArrayAliasStride(node->getFirstChild(), stride);
+      case TR::iadd:
+      case TR::ladd:
+      case TR::isub:
+      case TR::lsub:
+         if (!getArrayAliasStride(node->getFirstChild(), first) ||
+             !getArrayAliasStride(node->getSecondChild(), second))
+            return false;
+         stride = opCode.isAdd() ? first + second : first - second;
+         return true;
+      case TR::imul:
+      case TR::lmul:
+         if (!node->getSecondChild()->getOpCode().isLoadConst() ||
+             !getArrayAliasStride(node->getFirstChild(), first))
+            return false;
+         stride = first * node->getSecondChild()->get64bitIntegralValue();
+         return true;
+      case TR::ishl:
+      case TR::lshl:
+         if (!node->getSecondChild()->getOpCode().isLoadConst() ||
+             node->getSecondChild()->get64bitIntegralValue() < 0 ||
+             node->getSecondChild()->get64bitIntegralValue() > 31 ||
+             !getArrayAliasStride(node->getFirstChild(), first))
+            return false;
+         stride = first << node->getSecondChild()->get64bitIntegralValue();
+         return true;
+      default:
+         return false;
+      }
+   }
+
+/**
+ * \brief Two accesses must be proven disjoint if they go through different
+ * bases and at least one of them writes memory.
+ */
+bool TR_LoopVersioner::needsDisjointnessTest(ArrayAliasCandidate &first, ArrayAliasCandidate &second)
+   {
+   ArrayAliasGroups &groups = _curLoop->_arrayAliasGroups;
+   if (groups[first._group]._base == groups[second._group]._base)
+      return false;
+
+   // Accesses already known to be independent, such as those through
+   // different restrict pointers, need no test
+   TR::Node *store = first._node->getOpCode().isStore() ? first._node : second._node;
+   TR::Node *other = store == first._node ? second._node : first._node;
+   return store->getOpCode().isStore() &&
+          store->mayKill().contains(other->getSymbolReference(), comp());
+   }
+
+/**
+ * \brief Create the lowest address, or the address past the highest one,
+ * accessed by \p candidate in the loop.
+ *
+ * The induction variable goes from its value on entry to the loop, \c entry,
+ * towards the loop limit, \c limit. Whether the loop tests the induction
+ * variable before or after it is stepped, every value the access sees lies
+ * between \c entry and <tt>limit + increment</tt>, so the addresses lie between
+ *
+ *    address(entry)  and  address(entry) + stride * (limit + increment - entry)
+ */
+TR::Node *TR_LoopVersioner::createArrayAccessBound(TR::Node *originNode, ArrayAliasCandidate &candidate, bool upper)
+   {
+   TR::Node *node = candidate._node;
+   int32_t increment = _curLoop->_arrayAliasIncrement;
+   TR::Node *bound = node->getFirstChild()->duplicateTreeForCodeMotion();
+
+   bool addressGrows = (candidate._stride >= 0) == (increment > 0);
+   if (upper == addressGrows && candidate._stride != 0)
+      {
+      TR::Node *limit = TR::Node::create(TR::i2l, 1, _loopTestTree->getNode()->getSecondChild()->duplicateTreeForCodeMotion());
+      TR::Node *entry = TR::Node::create(TR::i2l, 1, TR::Node::createLoad(originNode, _curLoop->_arrayAliasInductionVariable));
+      TR::Node *distance = TR::Node::create(TR::lsub, 2,
+         TR::Node::create(TR::ladd, 2, limit, TR::Node::lconst(originNode, increment)),
+         entry);
+      bound = TR::Node::create(TR::aladd, 2, bound,
+         TR::Node::create(TR::lmul, 2, distance, TR::Node::lconst(originNode, candidate._stride)));
+      }
+
+   if (upper)
+      bound = TR::Node::create(TR::aladd, 2, bound, TR::Node::lconst(originNode, node->getSize()));
+
+   return TR::Node::create(TR::a2l, 1, bound);
+   }
+
+void TR_LoopVersioner::buildAliasRefinementComparisonTrees(List<TR::TreeTop> *nullCheckTrees, List<TR::TreeTop> *divCheckTrees, List<TR::TreeTop> *checkCastTrees, List<TR::TreeTop> *arrayStoreCheckTrees, TR_ScratchList<TR::Node> *comparisonTrees, TR::Block *exitGotoBlock)
+   {
+   ArrayAliasCandidates &candidates = _curLoop->_arrayAliasCandidates;
+   if (candidates.empty())
+      return;
+
+   TR::Node *loopTest = _loopTestTree->getNode();
+   if (!performTransformation(
+         comp(),
+         "%s Creating tests outside loop for checking if the array accesses in loop %d are disjoint\n",
+         OPT_DETAILS_LOOP_VERSIONER,
+         _currentNaturalLoop->getNumber()))
+      return;
+
+   // The bounds of the accesses assume that the loop runs from the entry
+   // value of the induction variable towards the limit
+   //
+   TR::Node *entry = TR::Node::createLoad(loopTest, _curLoop->_arrayAliasInductionVariable);
+   TR::Node *limit = loopTest->getSecondChild()->duplicateTreeForCodeMotion();
+   TR::Node *ifNode = TR::Node::createif(_curLoop->_arrayAliasIncrement > 0 ? TR::ificmpgt : TR::ificmplt, entry, limit, _exitGotoTarget);
+   LoopEntryPrep *prep = createLoopEntryPrep(LoopEntryPrep::TEST, ifNode);
+
+   for (size_t i = 0; i < candidates.size(); i++)
+      {
+      for (size_t j = i + 1; j < candidates.size(); j++)
+         {
+         if (!needsDisjointnessTest(candidates[i], candidates[j]))
+            continue;
+
+         dumpOptDetails(
+            comp(),
+            "Creating test outside loop for checking if n%un [%p] and n%un [%p] access disjoint memory\n",
+            candidates[i]._node->getGlobalIndex(),
+            candidates[i]._node,
+            candidates[j]._node->getGlobalIndex(),
+            candidates[j]._node);
+
+         TR::Node *overlaps = TR::Node::create(TR::iand, 2,
+            TR::Node::create(TR::lucmplt, 2, createArrayAccessBound(loopTest, candidates[i], false), createArrayAccessBound(loopTest, candidates[j], true)),
+            TR::Node::create(TR::lucmplt, 2, createArrayAccessBound(loopTest, candidates[j], false), createArrayAccessBound(loopTest, candidates[i], true)));
+         ifNode = TR::Node::createif(TR::ificmpne, overlaps, TR::Node::iconst(loopTest, 0), _exitGotoTarget);
+         prep = createChainedLoopEntryPrep(LoopEntryPrep::TEST, ifNode, prep);
+         }
+      }
+
+   if (prep != NULL)
+      _curLoop->_loopImprovements.push_back(
+         new (_curLoop->_memRegion) RefineArrayAliases(this, prep));
+   }
+
+void TR_LoopVersioner::RefineArrayAliases::improveLoop()
+   {
+   CurLoop *curLoop = _versioner->_curLoop;
+   ArrayAliasCandidates &candidates = curLoop->_arrayAliasCandidates;
+   ArrayAliasGroups &groups = curLoop->_arrayAliasGroups;
+   TR::SymbolReferenceTable *symRefTab = comp()->getSymRefTab();
+
+   // Accesses through different bases were either tested to be disjoint or
+   // only read memory
+   //
+   TR::vector<TR::SymbolReference *, TR::Region&> refinedSymRefs(groups.size(), NULL, curLoop->_memRegion);
+   for (size_t g = 0; g < groups.size(); g++)
+      {
+      refinedSymRefs[g] = symRefTab->createRefinedArrayShadowSymbolRef(groups[g]._type);
+      for (size_t h = 0; h < g; h++)
+         {
+         if (groups[h]._base != groups[g]._base)
+            refinedSymRefs[g]->makeIndependent(symRefTab, refinedSymRefs[h]);
+         }
+      }
+
+   for (size_t i = 0; i < candidates.size(); i++)
+      {
+      TR::Node *node = candidates[i]._node;
+      dumpOptDetails(
+         comp(),
+         "Refining aliases of n%un [%p] to #%d\n",
+         node->getGlobalIndex(),
+         node,
+         refinedSymRefs[candidates[i]._group]->getReferenceNumber());
+      node->setSymbolReference(refinedSymRefs[candidates[i]._group]);
+      }
+
+   _versioner->_invalidateAliasSets = true;
+   TR::DebugCounter::incStaticDebugCounter(comp(), "loopVersioner/disjointArrays");
+   }
+
 void TR_LoopVersioner::initAdditionalDataStructures(){}
-void TR_LoopVersioner::refineArrayAliases(TR_RegionStructure *r) {TR_ASSERT(!refineAliases(),"something wrong");}
+
+void TR_LoopVersioner::refineArrayAliases(TR_RegionStructure *r)
+   {
+   // The aliases of the fast loop are refined by RefineArrayAliases
+   }
 
 void TR_LoopVersioner::findAndReplaceContigArrayLen(TR::Node *parent, TR::Node *node, vcount_t visitCount)
    {
@@ -10113,6 +10474,10 @@ TR_LoopVersioner::CurLoop::CurLoop(
    , _privTemps(std::less<const Expr*>(), memRegion)
    , _privatizationsRequested(false)
    , _privatizationOK(false)
+   , _arrayAliasCandidates(memRegion)
+   , _arrayAliasGroups(memRegion)
+   , _arrayAliasInductionVariable(NULL)
+   , _arrayAliasIncrement(0)
    {}
 
 /**
@@ -37,6 +37,7 @@
 #include "infra/Checklist.hpp"
 #include "infra/Link.hpp"
 #include "infra/List.hpp"
+#include "infra/vector.hpp"
 #include "optimizer/OptimizationManager.hpp"
 #include "optimizer/LoopCanonicalizer.hpp"
 
@@ -652,6 +653,34 @@ class TR_LoopVersioner : public TR_LoopTransformer
    typedef TR::typed_allocator<std::pair<const Expr * const, TR::Node*>, TR::Region&> EmitExprMemoAlloc;
    typedef std::map<const Expr*, TR::Node*, std::less<const Expr*>, EmitExprMemoAlloc> EmitExprMemo;
 
+   /**
+    * \brief An array element access in the loop whose aliases can be
+    * refined in the fast version of the loop.
+    *
+    * The address of the access is <tt>base + offset</tt>, where \c base is
+    * loop invariant and \c offset changes by \c _stride bytes for every unit
+    * the loop driving induction variable changes by.
+    */
+   struct ArrayAliasCandidate
+      {
+      TR::Node *_node;
+      int64_t _stride;
+      int32_t _group;
+      };
+
+   /**
+    * \brief Accesses of one type through one base, which share a refined
+    * array shadow in the fast version of the loop.
+    */
+   struct ArrayAliasGroup
+      {
+      TR::SymbolReference *_base;
+      TR::DataType _type;
+      };
+
+   typedef TR::vector<ArrayAliasCandidate, TR::Region&> ArrayAliasCandidates;
+   typedef TR::vector<ArrayAliasGroup, TR::Region&> ArrayAliasGroups;
+
    /**
     * \brief Information about the loop currently under consideration by
     * TR_LoopVersioner.
@@ -709,6 +738,18 @@ class TR_LoopVersioner : public TR_LoopTransformer
 
       /// The result of the analysis to say whether privatization can be done.
       bool _privatizationOK;
+
+      /// Array accesses whose aliases are refined. \see processArrayAliasCandidates()
+      ArrayAliasCandidates _arrayAliasCandidates;
+
+      /// The groups of \ref _arrayAliasCandidates
+      ArrayAliasGroups _arrayAliasGroups;
+
+      /// The induction variable the offsets of \ref _arrayAliasCandidates depend on
+      TR::SymbolReference *_arrayAliasInductionVariable;
+
+      /// The change of \ref _arrayAliasInductionVariable in every iteration
+      int32_t _arrayAliasIncrement;
       };
 
    class Hoist : public LoopImprovement
@@ -904,6 +945,22 @@ class TR_LoopVersioner : public TR_LoopTransformer
       const bool _original;
       };
 
+   /**
+    * \brief Give the array accesses of the fast loop array shadows that are
+    * independent of the shadows of the accesses through other bases.
+    */
+   class RefineArrayAliases : public LoopImprovement
+      {
+      public:
+      TR_ALLOC(TR_Memory::LoopTransformer)
+
+      RefineArrayAliases(TR_LoopVersioner *versioner, LoopEntryPrep *prep)
+         : LoopImprovement(versioner, prep)
+         {}
+
+      virtual void improveLoop();
+      };
+
    bool shouldOnlySpecializeLoops() { return _onlySpecializingLoops; }
    void setOnlySpecializeLoops(bool b) { _onlySpecializingLoops = b; }
 
@@ -918,6 +975,9 @@ class TR_LoopVersioner : public TR_LoopTransformer
    virtual void buildAliasRefinementComparisonTrees(List<TR::TreeTop> *, List<TR::TreeTop> *, List<TR::TreeTop> *, List<TR::TreeTop> *, TR_ScratchList<TR::Node> *, TR::Block *);
    virtual void initAdditionalDataStructures();
    virtual void refineArrayAliases(TR_RegionStructure *);
+   bool getArrayAliasStride(TR::Node *node, int64_t &stride);
+   bool needsDisjointnessTest(ArrayAliasCandidate &first, ArrayAliasCandidate &second);
+   TR::Node *createArrayAccessBound(TR::Node *originNode, ArrayAliasCandidate &candidate, bool upper);
 
    int32_t performWithDominators();
    int32_t performWithoutDominators();
@@ -1057,6 +1117,38 @@ class TR_LoopVersioner : public TR_LoopTransformer
    };
 
 
+/**
+ * Class TR_LoopAliasRefiner
+ * =========================
+ *
+ * The loop alias refiner versions loops that access memory through two or
+ * more loop invariant base pointers, such as
+ *
+ *    for (i = 0; i < n; i++)
+ *       dst[i] = a[i] + b[i];
+ *
+ * The test outside the loop checks that the address ranges accessed through
+ * the different pointers are disjoint. In the fast version of the loop the
+ * accesses through each pointer get their own array shadow, independent of
+ * the shadows of the other pointers, so that later optimizations need not
+ * assume that a store through one pointer changes the values loaded through
+ * the others.
+ */
+
+class TR_LoopAliasRefiner : public TR_LoopVersioner
+   {
+   public:
+
+   TR_LoopAliasRefiner(TR::OptimizationManager *manager);
+
+   virtual const char * optDetailString() const throw();
+
+   static TR::Optimization *create(TR::OptimizationManager *manager)
+      {
+      return new (manager->allocator()) TR_LoopAliasRefiner(manager);
+      }
+   };
+
 /**
  * Class TR_LoopSpecializer
  * ========================
@@ -23,6 +23,8 @@
 
 #include <algorithm>
 #include <stddef.h>
+#include <stdlib.h>
+#include "codegen/CodeGenerator.hpp"
 #include "compile/Compilation.hpp"
 #include "env/StackMemoryRegion.hpp"
 #include "env/TRMemory.hpp"
@@ -472,6 +474,38 @@ bool OMR::CFGSimplifier::simplifyCondStoreSequence(bool needToDuplicateTree)
    return true;
    }
 
+// Limit on the cost of the values of an if-converted conditional store, as
+// the ternary evaluates the values of both paths
+//
+#define DEFAULT_IF_CONVERSION_COST_LIMIT 6
+
+static bool isCheapToSpeculate(TR::Node *node, TR::NodeChecklist *evaluated, int32_t &budget)
+   {
+   if (evaluated->contains(node))
+      return true;
+   evaluated->add(node);
+
+   TR::ILOpCode &opCode = node->getOpCode();
+   if (opCode.isLoadConst())
+      return true;
+
+   // A division or remainder may trap on a path that never computed it
+   //
+   if (opCode.isDiv() || opCode.isRem())
+      return false;
+
+   budget -= opCode.isMul() ? 3 : 1;
+   if (budget < 0)
+      return false;
+
+   for (int32_t i = 0; i < node->getNumChildren(); ++i)
+      {
+      if (!isCheapToSpeculate(node->getChild(i), evaluated, budget))
+         return false;
+      }
+   return true;
+   }
+
 bool OMR::CFGSimplifier::simplifySimpleStore(bool needToDuplicateTree)
    {
    static char *disableSimplifySimpleStore = feGetEnv("TR_disableSimplifySimpleStore");
@@ -574,8 +608,10 @@ bool OMR::CFGSimplifier::simplifySimpleStore(bool needToDuplicateTree)
          traceMsg(comp(), "   Fallthrough checks out\n");
       }
 
-   if (!storeNode->getDataType().isIntegral()
-       && !storeNode->getDataType().isAddress())
+   TR::DataType dataType = storeNode->getDataType();
+   if (!dataType.isIntegral()
+       && !dataType.isAddress()
+       && !((dataType == TR::Float || dataType == TR::Double) && cg()->getSupportsFloatingPointTernary()))
       return false;
 
    if (trace())
@@ -587,6 +623,28 @@ bool OMR::CFGSimplifier::simplifySimpleStore(bool needToDuplicateTree)
    if (trace())
       traceMsg(comp(), "   StoreNode symRef checks out\n");
 
+   if (compareNode->getOpCode().convertIfCmpToCmp() == TR::BadILOp)
+      return false;
+
+   // Both values are computed once the branch is gone, so only if-convert
+   // when what the paths compute beyond the compare is cheap
+   //
+   static char *costLimit = feGetEnv("TR_ifConversionCostLimit");
+   int32_t budget = costLimit ? atoi(costLimit) : DEFAULT_IF_CONVERSION_COST_LIMIT;
+   TR::NodeChecklist evaluated(comp());
+   evaluated.add(compareNode->getFirstChild());
+   evaluated.add(compareNode->getSecondChild());
+   if ((trueValue && !isCheapToSpeculate(trueValue, &evaluated, budget)) ||
+       (falseValue && !isCheapToSpeculate(falseValue, &evaluated, budget)))
+      {
+      if (trace())
+         traceMsg(comp(), "   Values are too expensive to compute on both paths\n");
+      return false;
+      }
+
+   if (trace())
+      traceMsg(comp(), "   Values are cheap enough, %d of the cost limit left\n", budget);
+
    if (!performTransformation(comp(), "%sReplace conditional store with store of an appropriate ternary at node [%p]\n", OPT_DETAILS, compareNode))
       return false;
 
@@ -313,10 +313,10 @@ void OMR::LocalCSE::transformBlock(TR::TreeTop * entryTree, TR::TreeTop * exitTr
    memset(_replacedNodesAsArray, 0, _numNodes*sizeof(TR::Node*));
    memset(_replacedNodesByAsArray, 0, _numNodes*sizeof(TR::Node*));
 
-   _hashTable = new (stackMemoryRegion) HashTable(std::less<int32_t>(), stackMemoryRegion);
-   _hashTableWithSyms = new (stackMemoryRegion) HashTable(std::less<int32_t>(), stackMemoryRegion);
-   _hashTableWithCalls = new (stackMemoryRegion) HashTable(std::less<int32_t>(), stackMemoryRegion);
-   _hashTableWithConsts = new (stackMemoryRegion) HashTable(std::less<int32_t>(), stackMemoryRegion);
+   _hashTable = new (stackMemoryRegion) HashTable(stackMemoryRegion);
+   _hashTableWithSyms = new (stackMemoryRegion) HashTable(stackMemoryRegion);
+   _hashTableWithCalls = new (stackMemoryRegion) HashTable(stackMemoryRegion);
+   _hashTableWithConsts = new (stackMemoryRegion) HashTable(stackMemoryRegion);
 
    _nextReplacedNode = 0;
    TR_BitVector seenAvailableLoadedSymbolReferences(stackMemoryRegion);
@@ -1314,11 +1314,10 @@ TR::Node* OMR::LocalCSE::getAvailableExpression(TR::Node *parent, TR::Node *node
       hashTable = _hashTable;
 
    int32_t hashValue = hash(parent, node);
-   auto range = hashTable->equal_range(hashValue);
 
-   for(auto it = range.first; it != range.second;)
+   for (int32_t slot = hashTable->findFirst(hashValue); slot >= 0; slot = hashTable->findNext(hashValue, slot))
       {
-      TR::Node *other = it->second;
+      TR::Node *other = hashTable->nodeAt(slot);
       bool remove = false;
       if (areSyntacticallyEquivalent(other, node, &remove))
          {
@@ -1331,16 +1330,9 @@ TR::Node* OMR::LocalCSE::getAvailableExpression(TR::Node *parent, TR::Node *node
          {
          if (trace())
             traceMsg(comp(), "remove is true, removing entry %p\n", other);
-         auto nextIt = it;
-         ++nextIt;
-         hashTable->erase(it);
-         it = nextIt;
+         hashTable->removeAt(slot);
          _killedNodes.set(other->getGlobalIndex());
          }
-      else
-         {
-         ++it;
-         }
       }
 
    if (node->hasPinningArrayPointer() &&
@@ -1468,15 +1460,9 @@ void OMR::LocalCSE::killAvailableExpressionsUsingBitVector(HashTable *hashTable,
    while (bvi.hasMoreElements())
       {
       int32_t nextSymRefNum = bvi.getNextElement();
-      auto range = hashTable->equal_range(nextSymRefNum);
-      if (range.first != range.second)
-         {
-         auto lastItem = range.second;
-         --lastItem;
-         _killedNodes.set(lastItem->second->getGlobalIndex());
-
-         hashTable->erase(range.first, range.second);
-         }
+      TR::Node *lastItem = hashTable->removeAll(nextSymRefNum);
+      if (lastItem)
+         _killedNodes.set(lastItem->getGlobalIndex());
       }
    }
 
@@ -1674,32 +1660,136 @@ void OMR::LocalCSE::addToHashTable(TR::Node *node, int32_t hashValue)
       _arrayRefNodes->add(node);
       }
 
-   auto pair = std::make_pair(hashValue, node);
-
    if (node->getOpCode().hasSymbolReference() && ((node->getOpCodeValue() != TR::loadaddr) || _loadaddrAsLoad))
       {
       if (node->getOpCode().isCall())
          {
-         _hashTableWithCalls->insert(pair);
+         _hashTableWithCalls->insert(hashValue, node);
          _availableCallExprs.set(node->getSymbolReference()->getReferenceNumber());
          }
       else
          {
-         _hashTableWithSyms->insert(pair);
+         _hashTableWithSyms->insert(hashValue, node);
          _availableLoadExprs.set(node->getSymbolReference()->getReferenceNumber());
          }
       }
    else if (node->getOpCode().isLoadConst())
-      _hashTableWithConsts->insert(pair);
+      _hashTableWithConsts->insert(hashValue, node);
    else
-      _hashTable->insert(pair);
+      _hashTable->insert(hashValue, node);
    }
 
 
 void OMR::LocalCSE::removeFromHashTable(HashTable *hashTable, int32_t hashValue)
    {
-   auto range = hashTable->equal_range(hashValue);
-   hashTable->erase(range.first, range.second);
+   hashTable->removeAll(hashValue);
+   }
+
+
+OMR::LocalCSE::HashTable::HashTable(TR::Region &region, int32_t initialCapacity)
+   : _region(region),
+     _mask(initialCapacity - 1),
+     _numLive(0),
+     _numUsed(0)
+   {
+   TR_ASSERT((initialCapacity & (initialCapacity - 1)) == 0, "LocalCSE hash table capacity must be a power of two");
+   _entries = (Entry *)_region.allocate(initialCapacity * sizeof(Entry));
+   memset(_entries, 0, initialCapacity * sizeof(Entry));
+   }
+
+
+int32_t OMR::LocalCSE::HashTable::findFrom(int32_t key, int32_t slot)
+   {
+   // The table is never full, so every probe sequence ends at an empty slot
+   //
+   for (; _entries[slot]._state != Empty; slot = (slot + 1) & _mask)
+      {
+      if (_entries[slot]._state == Live && _entries[slot]._key == key)
+         return slot;
+      }
+   return -1;
+   }
+
+
+void OMR::LocalCSE::HashTable::insert(int32_t key, TR::Node *node)
+   {
+   // Keep at least a quarter of the slots empty so probe sequences stay short
+   //
+   if (4 * (_numUsed + 1) > 3 * (_mask + 1))
+      grow();
+
+   int32_t slot = homeSlot(key);
+   while (_entries[slot]._state != Empty)
+      slot = (slot + 1) & _mask;
+
+   _entries[slot]._key = key;
+   _entries[slot]._state = Live;
+   _entries[slot]._node = node;
+   _numLive++;
+   _numUsed++;
+   }
+
+
+void OMR::LocalCSE::HashTable::removeAt(int32_t slot)
+   {
+   TR_ASSERT(_entries[slot]._state == Live, "Removing a LocalCSE hash table entry that is not live");
+   _entries[slot]._state = Removed;
+   _numLive--;
+   }
+
+
+TR::Node *OMR::LocalCSE::HashTable::removeAll(int32_t key)
+   {
+   TR::Node *last = NULL;
+   for (int32_t slot = findFirst(key); slot >= 0; slot = findNext(key, slot))
+      {
+      last = _entries[slot]._node;
+      removeAt(slot);
+      }
+   return last;
+   }
+
+
+void OMR::LocalCSE::HashTable::clear()
+   {
+   if (_numUsed == 0)
+      return;
+   memset(_entries, 0, (_mask + 1) * sizeof(Entry));
+   _numLive = 0;
+   _numUsed = 0;
+   }
+
+
+void OMR::LocalCSE::HashTable::grow()
+   {
+   Entry *oldEntries = _entries;
+   int32_t oldCapacity = _mask + 1;
+
+   // Only double when live entries dominate; otherwise rehashing in place
+   // is enough to get rid of the tombstones
+   //
+   int32_t newCapacity = (2 * _numLive >= oldCapacity / 2) ? 2 * oldCapacity : oldCapacity;
+   _entries = (Entry *)_region.allocate(newCapacity * sizeof(Entry));
+   memset(_entries, 0, newCapacity * sizeof(Entry));
+   _mask = newCapacity - 1;
+   _numLive = 0;
+   _numUsed = 0;
+
+   // Walk the old table starting just past an empty slot so that every
+   // cluster is visited from its beginning; entries sharing a key are then
+   // reinserted in their original order
+   //
+   int32_t start = 0;
+   while (oldEntries[start]._state != Empty)
+      start++;
+   for (int32_t i = 1; i <= oldCapacity; i++)
+      {
+      Entry &entry = oldEntries[(start + i) & (oldCapacity - 1)];
+      if (entry._state == Live)
+         insert(entry._key, entry._node);
+      }
+
+   _region.deallocate(oldEntries);
    }
 
 
@@ -84,8 +84,64 @@ class LocalCSE : public TR::Optimization
    virtual void postPerformOnBlocks();
    virtual const char * optDetailString() const throw();
 
-   typedef TR::typed_allocator< std::pair< const int32_t, TR::Node* >, TR::Region & > HashTableAllocator;
-   typedef std::multimap< int32_t, TR::Node*, std::less<int32_t>, HashTableAllocator > HashTable;
+   /**
+    * Flat open addressing multimap from hash value to available expression.
+    *
+    * Entries live in a single region allocated array probed linearly from
+    * the home slot of the key.  New entries always go into the first empty
+    * slot of the probe sequence (removed entries leave a tombstone behind),
+    * so entries sharing a key are visited in insertion order, just as with
+    * the equal_range of the std::multimap this replaces.
+    */
+   class HashTable
+      {
+      public:
+
+      HashTable(TR::Region &region, int32_t initialCapacity = 64);
+
+      void insert(int32_t key, TR::Node *node);
+
+      /**
+       * Slot cursor over the entries with a given key: findFirst returns
+       * the slot of the oldest entry (or -1), findNext the following one.
+       * Removing the entry under the cursor with removeAt does not disturb
+       * the iteration.
+       */
+      int32_t findFirst(int32_t key) { return findFrom(key, homeSlot(key)); }
+      int32_t findNext(int32_t key, int32_t slot) { return findFrom(key, (slot + 1) & _mask); }
+      TR::Node *nodeAt(int32_t slot) { return _entries[slot]._node; }
+      void removeAt(int32_t slot);
+
+      /**
+       * Remove every entry with the given key.  Returns the most recently
+       * inserted of them, or NULL if there were none.
+       */
+      TR::Node *removeAll(int32_t key);
+
+      void clear();
+      bool isEmpty() { return _numLive == 0; }
+
+      private:
+
+      enum EntryState { Empty = 0, Live, Removed };
+
+      struct Entry
+         {
+         int32_t _key;
+         int32_t _state;
+         TR::Node *_node;
+         };
+
+      int32_t homeSlot(int32_t key) { return (int32_t)(((uint32_t)key * 0x9E3779B1u) >> 8) & _mask; }
+      int32_t findFrom(int32_t key, int32_t slot);
+      void grow();
+
+      TR::Region &_region;
+      Entry *_entries;
+      int32_t _mask;
+      int32_t _numLive;
+      int32_t _numUsed;   // live entries plus tombstones
+      };
 
    protected:
 
@@ -165,6 +165,11 @@ OMR::OptimizationManager::OptimizationManager(TR::Optimizer *o, OptimizationFact
       case OMR::loopSpecializer:
          _flags.set(requiresStructure | checkStructure | dumpStructure);
          break;
+      case OMR::loopAliasRefiner:
+         _flags.set(requiresStructure | checkStructure | dumpStructure);
+         if (self()->comp()->getMethodHotness() >= hot)
+            _flags.set(requiresLocalsUseDefInfo | doesNotRequireLoadsAsDefs | requiresLocalsValueNumbering);
+         break;
       case OMR::generalStoreSinking:
          _flags.set(requiresStructure);
          break;
@@ -192,6 +197,9 @@ OMR::OptimizationManager::OptimizationManager(TR::Optimizer *o, OptimizationFact
       case OMR::prefetchInsertion:
          _flags.set(requiresStructure | checkStructure | dumpStructure);
          break;
+      case OMR::SPMDKernelParallelization:
+         _flags.set(requiresStructure | checkStructure | dumpStructure);
+         break;
       case OMR::osrDefAnalysis:
          if (self()->comp()->getOption(TR_DisableOSRSharedSlots))
             _flags.set(doesNotRequireAliasSets | doesNotRequireTreeDumps | supportsIlGenOptLevel);
@@ -43,6 +43,7 @@
 #include "env/PersistentInfo.hpp"
 #include "env/StackMemoryRegion.hpp"
 #include "env/TRMemory.hpp"
+#include "env/VerboseLog.hpp"
 #include "env/jittypes.h"
 #include "il/Block.hpp"
 #include "il/DataTypes.hpp"
@@ -730,7 +731,10 @@ OMR::Optimizer::Optimizer(TR::Compilation *comp, TR::ResolvedMethodSymbol *metho
      _successorBitsGRA(NULL),
      _stackedOptimizer(false),
      _firstTimeStructureIsBuilt(true),
-     _disableLoopOptsThatCanCreateLoops(false)
+     _disableLoopOptsThatCanCreateLoops(false),
+     _numStructureBuilds(0),
+     _numStructureReusesAfterEdits(0),
+     _structureEditsAtLastUse(0)
    {
    // zero opts table
    memset(_opts, 0, sizeof(_opts));
@@ -1155,6 +1159,9 @@ void OMR::Optimizer::optimize()
 
    dumpPostOptTrees();
 
+   if (!isIlGenOpt() && comp()->isOutermostMethod())
+      reportAnalysisReuse();
+
    if (comp()->getOption(TR_TraceOpts))
       {
       if (comp()->isOutermostMethod())
@@ -1171,6 +1178,24 @@ void OMR::Optimizer::optimize()
    _stackedOptimizer = false;
    }
 
+void OMR::Optimizer::reportAnalysisReuse()
+   {
+   TR::CFG *cfg = comp()->getFlowGraph();
+   if (!cfg)
+      return;
+
+   if (comp()->getOption(TR_TraceOptDetails))
+      traceMsg(comp(), "Analyses: dominators built %d, reused %d (%d after in-place updates); structure built %d, reused after edits %d\n",
+               cfg->getNumDominatorBuilds(), cfg->getNumDominatorReuses(), cfg->getNumDominatorReusesAfterEdits(),
+               _numStructureBuilds, _numStructureReusesAfterEdits);
+
+   if (TR::Options::getVerboseOption(TR_VerboseOptimizer))
+      TR_VerboseLog::writeLineLocked(TR_Vlog_INFO,
+         "%s dominatorsBuilt=%d dominatorsReused=%d dominatorsReusedAfterEdits=%d structureBuilt=%d structureReusedAfterEdits=%d",
+         comp()->signature(), cfg->getNumDominatorBuilds(), cfg->getNumDominatorReuses(), cfg->getNumDominatorReusesAfterEdits(),
+         _numStructureBuilds, _numStructureReusesAfterEdits);
+   }
+
 void OMR::Optimizer::dumpPostOptTrees()
    {
    // do nothing for IlGen optimizer
@@ -1719,6 +1744,16 @@ int32_t OMR::Optimizer::performOptimization(const OptimizationStrategy *optimiza
       if (manager->getRequiresUseDefInfo() || manager->getRequiresValueNumbering())
          manager->setRequiresStructure(true);
 
+      // The CFG repairs the structure in place for most edits; count the
+      // times that saved rebuilding it
+      //
+      if (manager->getRequiresStructure() && comp()->getFlowGraph()->getStructure() &&
+          comp()->getFlowGraph()->getNumStructureEdits() != _structureEditsAtLastUse)
+         {
+         _numStructureReusesAfterEdits++;
+         _structureEditsAtLastUse = comp()->getFlowGraph()->getNumStructureEdits();
+         }
+
       if (manager->getRequiresStructure() && !comp()->getFlowGraph()->getStructure())
          {
          TR::Compilation::CompilationPhaseScope buildingStructure(comp());
@@ -1736,6 +1771,8 @@ int32_t OMR::Optimizer::performOptimization(const OptimizationStrategy *optimiza
 #endif
 
          actualCost += doStructuralAnalysis();
+         _numStructureBuilds++;
+         _structureEditsAtLastUse = comp()->getFlowGraph()->getNumStructureEdits();
 
          if (_firstTimeStructureIsBuilt && comp()->getFlowGraph()->getStructure())
             {
@@ -238,6 +238,7 @@ class Optimizer
    List<TR::Node>& getClassPointerNodes() { return _classPointerNodes; }
 
    void dumpPostOptTrees();
+   void reportAnalysisReuse();
 
 #ifdef DEBUG
    int32_t     getDumpGraphsIndex() { return _dumpGraphsIndex; }
@@ -375,6 +376,10 @@ class Optimizer
    bool                          _firstTimeStructureIsBuilt;
    bool                          _disableLoopOptsThatCanCreateLoops;
 
+   int32_t                       _numStructureBuilds;
+   int32_t                       _numStructureReusesAfterEdits;
+   int32_t                       _structureEditsAtLastUse;
+
    TR_BitVector *                _seenBlocksGRA; // used during the GRA as a global
    TR_BitVector *                _resetExitsGRA; // used during the GRA as a global
    TR_BitVector *                _successorBitsGRA; // used during the GRA as a global
@@ -48,6 +48,7 @@
 #include "infra/BitVector.hpp"
 #include "infra/Cfg.hpp"
 #include "infra/SimpleRegex.hpp"
+#include "optimizer/Dominators.hpp"
 #include "optimizer/Optimization_inlines.hpp"
 #include "optimizer/Optimizer.hpp"
 #include "optimizer/Simplifier.hpp"
@@ -10442,7 +10443,9 @@ TR::Node *irolSimplifier(TR::Node * node, TR::Block * block, TR::Simplifier * s)
       {
       int32_t rotateAmount = secondChild->getInt() & INT_SHIFT_MASK;
       rotateAmount &= 31; // to ensure that 32-rotateAmount below isn't negative.
-      int32_t value = (firstChild->getUnsignedInt() << rotateAmount) | (firstChild->getUnsignedInt() >> (32-rotateAmount));
+      int32_t value = firstChild->getUnsignedInt();
+      if (rotateAmount != 0) // a shift by 32 is undefined
+         value = (firstChild->getUnsignedInt() << rotateAmount) | (firstChild->getUnsignedInt() >> (32-rotateAmount));
 
       foldIntConstant(node, value, s, false);
       return node;
@@ -10466,7 +10469,9 @@ TR::Node *lrolSimplifier(TR::Node * node, TR::Block * block, TR::Simplifier * s)
    if (firstChild->getOpCode().isLoadConst() && secondChild->getOpCode().isLoadConst())
       {
       int32_t rotateAmount = secondChild->getInt() & LONG_SHIFT_MASK;
-      uint64_t value = (firstChild->getUnsignedLongInt() << rotateAmount) | (firstChild->getUnsignedLongInt() >> (64-rotateAmount));
+      uint64_t value = firstChild->getUnsignedLongInt();
+      if (rotateAmount != 0) // a shift by 64 is undefined
+         value = (firstChild->getUnsignedLongInt() << rotateAmount) | (firstChild->getUnsignedLongInt() >> (64-rotateAmount));
 
       foldLongIntConstant(node, value, s, false);
       return node;
@@ -13155,12 +13160,67 @@ TR::Node *ificmpeqSimplifier(TR::Node * node, TR::Block * block, TR::Simplifier
    }
 
 
+static bool isZeroConst(TR::Node * node)
+   {
+   return node->getOpCode().isLoadConst() && node->get64bitIntegralValue() == 0;
+   }
+
+static bool multiplyOverflows(int64_t op1, int64_t op2, bool is64Bit)
+   {
+   if (!is64Bit)
+      {
+      int64_t product = op1 * op2;
+      return product != (int32_t)product;
+      }
+
+   if (op1 == 0 || op2 == 0)
+      return false;
+   if ((op1 == -1 && op2 == TR::getMinSigned<TR::Int64>()) ||
+       (op2 == -1 && op1 == TR::getMinSigned<TR::Int64>()))
+      return true;
+   int64_t product = (int64_t)((uint64_t)op1 * (uint64_t)op2);
+   return product / op2 != op1;
+   }
+
+/**
+ * \brief Fold a multiply overflow check (see TR::Node::isMultiplyOverflowCheck)
+ * whose outcome is known from constant operands.
+ *
+ * \return true if the check was folded
+ */
+static bool foldMultiplyOverflowCheck(TR::Node * node, TR::Block * block, TR::Simplifier * s)
+   {
+   TR::Node * op1 = node->getFirstChild()->getFirstChild();
+   TR::Node * op2 = node->getFirstChild()->getSecondChild();
+   bool is64Bit = (node->getOpCodeValue() == TR::iflcmpne);
+
+   if (op1->getOpCode().isLoadConst() && op2->getOpCode().isLoadConst())
+      {
+      s->conditionalToUnconditional(node, block, multiplyOverflows(op1->get64bitIntegralValue(), op2->get64bitIntegralValue(), is64Bit));
+      return true;
+      }
+
+   // Multiplying by zero or one cannot overflow
+   TR::Node * constOp = op2->getOpCode().isLoadConst() ? op2 : op1;
+   if (constOp->getOpCode().isLoadConst() &&
+       (constOp->get64bitIntegralValue() == 0 || constOp->get64bitIntegralValue() == 1))
+      {
+      s->conditionalToUnconditional(node, block, false);
+      return true;
+      }
+
+   return false;
+   }
+
 //---------------------------------------------------------------------
 // Integer if compare not equal (signed and unsigned)
 //
 
 TR::Node *ificmpneSimplifier(TR::Node * node, TR::Block * block, TR::Simplifier * s)
    {
+   if (node->isMultiplyOverflowCheck() && foldMultiplyOverflowCheck(node, block, s))
+      return node;
+
    simplifyChildren(node, block, s);
    if (removeIfToFollowingBlock(node, block, s) == NULL)
       return NULL;
@@ -13481,6 +13541,9 @@ TR::Node *iflcmpeqSimplifier(TR::Node * node, TR::Block * block, TR::Simplifier
 
 TR::Node *iflcmpneSimplifier(TR::Node * node, TR::Block * block, TR::Simplifier * s)
    {
+   if (node->isMultiplyOverflowCheck() && foldMultiplyOverflowCheck(node, block, s))
+      return node;
+
    simplifyChildren(node, block, s);
    if (removeIfToFollowingBlock(node, block, s) == NULL)
       return NULL;
@@ -15331,6 +15394,18 @@ TR::Node *endBlockSimplifier(TR::Node * node, TR::Block * block, TR::Simplifier
 
    if (cfg)
       {
+      // The edges are moved directly below and the structure renumbers the
+      // blocks, so the dominators are fixed up before the blocks are merged
+      //
+      cfg->suspendDominatorUpdates();
+      TR_Dominators *dominators = cfg->getCachedDominators();
+      bool mergesDominators = false;
+      if (!moreThanOnePred)
+         {
+         cfg->accountForMergedBlocks(block, nextBlock);
+         mergesDominators = dominators && dominators->mergeBlocks(block, nextBlock);
+         }
+
       // Fix up structure by telling it that the blocks are going to be merged.
       //
       TR_Structure * rootStructure = cfg->getStructure();
@@ -15388,6 +15463,8 @@ TR::Node *endBlockSimplifier(TR::Node * node, TR::Block * block, TR::Simplifier
       cfg->getNodes().remove(nextBlock);
       nextBlock->removeNode();
       //cfg->getRemovedNodes().add(nextBlock);
+
+      cfg->resumeDominatorUpdates(mergesDominators);
       }
 
    // Fix up the trees:
@@ -16283,6 +16360,13 @@ TR::Node *ifxcmpoSimplifier(TR::Node * node, TR::Block * block, TR::Simplifier *
       else
          s->conditionalToUnconditional(node, block, !overflow);
       }
+   else if (isZeroConst(node->getSecondChild()) ||
+            node->getFirstChild() == node->getSecondChild() ||
+            (node->getFirstChild()->isNonNegative() && node->getSecondChild()->isNonNegative()))
+      {
+      // The difference of values with the same sign cannot overflow
+      s->conditionalToUnconditional(node, block, (opCode == TR::ificmpno) || (opCode == TR::iflcmpno));
+      }
 
    return node;
    }
@@ -16308,6 +16392,13 @@ TR::Node *ifxcmnoSimplifier(TR::Node * node, TR::Block * block, TR::Simplifier *
       else
          s->conditionalToUnconditional(node, block, !overflow);
       }
+   else if (isZeroConst(node->getFirstChild()) || isZeroConst(node->getSecondChild()) ||
+            (node->getFirstChild()->isNonNegative() && node->getSecondChild()->isNonPositive()) ||
+            (node->getFirstChild()->isNonPositive() && node->getSecondChild()->isNonNegative()))
+      {
+      // The sum of values with different signs cannot overflow
+      s->conditionalToUnconditional(node, block, (opCode == TR::ificmnno) || (opCode == TR::iflcmnno));
+      }
 
    return node;
    }
@@ -17138,6 +17229,15 @@ TR::Node *fmaxminSimplifier(TR::Node * node, TR::Block * block, TR::Simplifier *
          }
       }
 
+   // A NaN operand is ignored unless every operand is a NaN, which the
+   // comparisons below do not model
+   //
+   for (i = 0; i < num_children; i++)
+      {
+      if (node->getChild(i)->getOpCode().isLoadConst() && isNaNFloat(node->getChild(i)))
+         return node;
+      }
+
    if (has_const)
       {
       for (i=0; i < num_children; i++)
@@ -17198,6 +17298,15 @@ TR::Node *dmaxminSimplifier(TR::Node * node, TR::Block * block, TR::Simplifier *
          }
       }
 
+   // A NaN operand is ignored unless every operand is a NaN, which the
+   // comparisons below do not model
+   //
+   for (i = 0; i < num_children; i++)
+      {
+      if (node->getChild(i)->getOpCode().isLoadConst() && isNaNDouble(node->getChild(i)))
+         return node;
+      }
+
    if (has_const)
       {
       for (i = 0; i < num_children; i++)
@@ -220,10 +220,10 @@ TR_Structure *TR_RegionAnalysis::getRegions(TR::Compilation *comp)
    {
    TR::StackMemoryRegion stackMemoryRegion(*comp->trMemory());
 
-   // Calculate dominators
-   // This has the side-effect of renumbering the blocks in depth-first order
+   // Calculate dominators, or reuse the ones kept by the CFG as long as they
+   // still carry depth-first numbers, which the region analysis relies on
    //
-   TR_Dominators dominators(comp);
+   TR_Dominators &dominators = *comp->getFlowGraph()->getDominators(true);
 
    #if DEBUG
    if (debug("verifyDominator"))
@@ -73,7 +73,12 @@ int32_t TR::SwitchAnalyzer::perform()
    TR::StackMemoryRegion stackMemoryRegion(*trMemory());
 
    _cfg               = comp()->getFlowGraph();
-   _haveProfilingInfo = (comp()->isOptServer()) ? _cfg->setFrequencies() : false;
+   // Frequencies set from a profile of the method must not be recomputed
+   //
+   if (comp()->hasBlockFrequencyInfo())
+      _haveProfilingInfo = true;
+   else
+      _haveProfilingInfo = (comp()->isOptServer()) ? _cfg->setFrequencies() : false;
    _blocksGeneratedByMe = new (trStackMemory()) TR_BitVector(_cfg->getNextNodeNumber(),
                                                        trMemory(), stackAlloc, growable);
 
@@ -793,6 +798,18 @@ void TR::SwitchAnalyzer::emit(TR_LinkHead<SwitchInfo> *chain, TR_LinkHead<Switch
    int32_t numCases      = _switch->getCaseIndexUpperBound() - 2;
    int32_t numMajors     = majorsInChain + majorsInBound + majorsInEarly;
 
+   // Without profiling information to peel off a hot value, a table whose
+   // cases form a single dense set would only be rebuilt as the same table
+   //
+   if (_switch->getOpCodeValue() == TR::table && !_haveProfilingInfo &&
+       majorsInBound == 0 && majorsInEarly == 0 &&
+       chain->getFirst() && !chain->getFirst()->getNext() && chain->getFirst()->_kind == Dense)
+      {
+      if (trace())
+         traceMsg(comp(), "Table in block_%d is already dense\n", _block->getNumber());
+      return;
+      }
+
    if (_switch->getOpCodeValue() == TR::lookup && (!comp()->isOptServer() || numCases>LOOKUP_SWITCH_GEN_IN_IL_OVERRIDE))
       {
       if (trace())
@@ -1320,7 +1337,7 @@ TR::Block *TR::SwitchAnalyzer::addTableBlock(SwitchInfo *dense)
 
 int32_t *TR::SwitchAnalyzer::setupFrequencies(TR::Node *node)
    {
-   if (!_haveProfilingInfo) return 0;
+   if (!_haveProfilingInfo || _block->getFrequency() <= 0) return 0;
 
    int8_t *targetCounts = (int8_t*)   trMemory()->allocateStackMemory(_cfg->getNextNodeNumber() * sizeof(int8_t));
    memset (targetCounts, 0, sizeof(int8_t) * _cfg->getNextNodeNumber());
@@ -1328,7 +1345,8 @@ int32_t *TR::SwitchAnalyzer::setupFrequencies(TR::Node *node)
    memset  (frequencies, 0, sizeof(int32_t) * node->getCaseIndexUpperBound());
 
    // Count the number of cases reaching a particular target, divide target block frequency
-   // by the number of cases
+   // by the number of cases.  A profile gives the frequency of the edge to the target,
+   // which excludes the target's other predecessors.
    //
    CASECONST_TYPE i;
    for (i = node->getCaseIndexUpperBound() - 1; i > 0; --i)
@@ -1344,7 +1362,8 @@ int32_t *TR::SwitchAnalyzer::setupFrequencies(TR::Node *node)
       TR::Block *targetBlock = caseNode->getBranchDestination()->getNode()->getBlock();
       int32_t targetCount = targetCounts[targetBlock->getNumber()];
       TR_ASSERT(targetCount != 0, "unreachle successor of switch statement");
-      int32_t frequency = targetBlock->getFrequency() / targetCount;
+      TR::CFGEdge *edge = comp()->hasBlockFrequencyInfo() ? _block->getEdge(targetBlock) : NULL;
+      int32_t frequency = (edge ? edge->getFrequency() : targetBlock->getFrequency()) / targetCount;
       frequencies[i] = frequency;
 
       if (trace())
@@ -93,6 +93,7 @@
 
 extern TR::Node *constrainChildren(OMR::ValuePropagation *vp, TR::Node *node);
 extern TR::Node *constrainVcall(OMR::ValuePropagation *vp, TR::Node *node);
+extern TR::Node *constrainIfcmpo(OMR::ValuePropagation *vp, TR::Node *node);
 extern void createGuardSiteForRemovedGuard(TR::Compilation *comp, TR::Node* ifNode);
 
 static void checkForNonNegativeAndOverflowProperties(OMR::ValuePropagation *vp, TR::Node *node, TR::VPConstraint *constraint = NULL)
@@ -9967,6 +9968,8 @@ TR::Node *constrainIfcmpeq(OMR::ValuePropagation *vp, TR::Node *node)
 
 TR::Node *constrainIfcmpne(OMR::ValuePropagation *vp, TR::Node *node)
    {
+   if (node->isMultiplyOverflowCheck())
+      return constrainIfcmpo(vp, node);
    return constrainIfcmpeqne(vp, node, false);
    }
 
@@ -10634,6 +10637,149 @@ TR::Node *constrainCondBranch(OMR::ValuePropagation *vp, TR::Node *node)
    return node;
    }
 
+static bool arithmeticOverflows(TR::ILOpCodes arith, int64_t op1, int64_t op2, bool is64Bit)
+   {
+   int64_t result;
+   bool overflow;
+   switch (arith)
+      {
+      case TR::ladd:
+         result = (int64_t)((uint64_t)op1 + (uint64_t)op2);
+         overflow = ((op1 ^ result) & (op2 ^ result)) < 0;
+         break;
+      case TR::lsub:
+         result = (int64_t)((uint64_t)op1 - (uint64_t)op2);
+         overflow = ((op1 ^ op2) & (op1 ^ result)) < 0;
+         break;
+      default:
+         if (op1 == 0 || op2 == 0)
+            return false;
+         result = (int64_t)((uint64_t)op1 * (uint64_t)op2);
+         overflow = (op1 == -1 && op2 == TR::getMinSigned<TR::Int64>()) ||
+                    (op2 == -1 && op1 == TR::getMinSigned<TR::Int64>()) ||
+                    result / op2 != op1;
+         break;
+      }
+
+   // 32-bit operands cannot overflow the 64-bit computation
+   return is64Bit ? overflow : (result != (int32_t)result);
+   }
+
+// Determine whether the add, subtract or multiply (given as ladd, lsub or
+// lmul) of lhs and rhs must overflow, cannot overflow, or may overflow given
+// the constraints on the operands.
+//
+static TR_YesNoMaybe overflowCheckOutcome(OMR::ValuePropagation *vp, TR::ILOpCodes arith, TR::Node *lhs, TR::Node *rhs, bool is64Bit)
+   {
+   bool isGlobal;
+   TR::VPConstraint *lhsConstraint = vp->getConstraint(lhs, isGlobal);
+   TR::VPConstraint *rhsConstraint = vp->getConstraint(rhs, isGlobal);
+
+   int64_t lhsBounds[2], rhsBounds[2];
+   if (is64Bit)
+      {
+      lhsBounds[0] = lhsConstraint ? lhsConstraint->getLowLong()  : TR::getMinSigned<TR::Int64>();
+      lhsBounds[1] = lhsConstraint ? lhsConstraint->getHighLong() : TR::getMaxSigned<TR::Int64>();
+      rhsBounds[0] = rhsConstraint ? rhsConstraint->getLowLong()  : TR::getMinSigned<TR::Int64>();
+      rhsBounds[1] = rhsConstraint ? rhsConstraint->getHighLong() : TR::getMaxSigned<TR::Int64>();
+      }
+   else
+      {
+      lhsBounds[0] = lhsConstraint ? lhsConstraint->getLowInt()  : TR::getMinSigned<TR::Int32>();
+      lhsBounds[1] = lhsConstraint ? lhsConstraint->getHighInt() : TR::getMaxSigned<TR::Int32>();
+      rhsBounds[0] = rhsConstraint ? rhsConstraint->getLowInt()  : TR::getMinSigned<TR::Int32>();
+      rhsBounds[1] = rhsConstraint ? rhsConstraint->getHighInt() : TR::getMaxSigned<TR::Int32>();
+      }
+
+   // The extremes of the exact result are at the corners of the operand ranges
+   //
+   int32_t numOverflows = 0;
+   for (int32_t i = 0; i < 2; i++)
+      for (int32_t j = 0; j < 2; j++)
+         if (arithmeticOverflows(arith, lhsBounds[i], rhsBounds[j], is64Bit))
+            numOverflows++;
+
+   if (numOverflows == 0)
+      return TR_no;
+   if (lhsBounds[0] == lhsBounds[1] && rhsBounds[0] == rhsBounds[1])
+      return TR_yes;
+   return TR_maybe;
+   }
+
+// Handles ificmpo, ificmpno, iflcmpo, iflcmpno, ificmno, ificmnno, iflcmno,
+// iflcmnno and multiply overflow checks (see TR::Node::isMultiplyOverflowCheck)
+//
+TR::Node *constrainIfcmpo(OMR::ValuePropagation *vp, TR::Node *node)
+   {
+   constrainChildren(vp, node);
+
+   TR::ILOpCodes arith = TR::lmul;
+   bool branchOnOverflow = true;
+   switch (node->getOpCodeValue())
+      {
+      case TR::ificmno:
+      case TR::iflcmno:
+         arith = TR::ladd;
+         break;
+      case TR::ificmnno:
+      case TR::iflcmnno:
+         arith = TR::ladd;
+         branchOnOverflow = false;
+         break;
+      case TR::ificmpo:
+      case TR::iflcmpo:
+         arith = TR::lsub;
+         break;
+      case TR::ificmpno:
+      case TR::iflcmpno:
+         arith = TR::lsub;
+         branchOnOverflow = false;
+         break;
+      default:
+         break;
+      }
+
+   TR::Block *target = node->getBranchDestination()->getNode()->getBlock();
+   TR::CFGEdge *edge = vp->findOutEdge(vp->_curBlock->getSuccessors(), target);
+
+   // A multiply overflow check may have lost its shape if the product was
+   // folded while constraining the children
+   //
+   TR_YesNoMaybe overflow = TR_maybe;
+   if (vp->_curBlock->getNextBlock() != target)
+      {
+      bool is64Bit = node->getFirstChild()->getType().isInt64();
+      if (arith != TR::lmul)
+         overflow = overflowCheckOutcome(vp, arith, node->getFirstChild(), node->getSecondChild(), is64Bit);
+      else if (node->isMultiplyOverflowCheck())
+         overflow = overflowCheckOutcome(vp, arith, node->getFirstChild()->getFirstChild(), node->getFirstChild()->getSecondChild(), is64Bit);
+      }
+
+   if (overflow != TR_maybe)
+      {
+      bool branches = ((overflow == TR_yes) == branchOnOverflow);
+      if (!branches &&
+          performTransformation(vp->comp(), "%sRemoving overflow check [%p] %s\n", OPT_DETAILS, node, node->getOpCode().getName()))
+         {
+         removeConditionalBranch(vp, node, edge);
+         return node;
+         }
+
+      if (branches &&
+          performTransformation(vp->comp(), "%sChanging overflow check [%p] %s into goto\n", OPT_DETAILS, node, node->getOpCode().getName()))
+         {
+         vp->printEdgeConstraints(vp->createEdgeConstraints(edge, false));
+         changeConditionalToGoto(vp, node, edge);
+         return node;
+         }
+      }
+
+   if (vp->trace())
+      traceMsg(vp->comp(), "   Conditional branch\n");
+   vp->printEdgeConstraints(vp->createEdgeConstraints(edge, true));
+   return node;
+   }
+
 // Handles icmpeq, icmpne, lcmpeq, lcmpne, acmpeq, acmpne
 //
 static TR::Node *constrainCmpeqne(OMR::ValuePropagation *vp, TR::Node *node, bool testEqual)
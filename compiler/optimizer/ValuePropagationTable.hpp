@@ -76,6 +76,7 @@ TR::Node *constrainIfcmpgt(OMR::ValuePropagation *vp, TR::Node *node);
 TR::Node *constrainIfcmple(OMR::ValuePropagation *vp, TR::Node *node);
 TR::Node *constrainIfcmplt(OMR::ValuePropagation *vp, TR::Node *node);
 TR::Node *constrainIfcmpne(OMR::ValuePropagation *vp, TR::Node *node);
+TR::Node *constrainIfcmpo(OMR::ValuePropagation *vp, TR::Node *node);
 TR::Node *constrainIiload(OMR::ValuePropagation *vp, TR::Node *node);
 TR::Node *constrainImul(OMR::ValuePropagation *vp, TR::Node *node);
 TR::Node *constrainIumul(OMR::ValuePropagation *vp, TR::Node *node);
@@ -849,14 +850,14 @@ const ValuePropagationPtr constraintHandlers[] =
    constrainChildren,        // TR::icmp
    constrainChildren,        // TR::lucmp
 
-   constrainCondBranch,      // TR::ificmpo
-   constrainCondBranch,      // TR::ificmpno
-   constrainCondBranch,      // TR::iflcmpo
-   constrainCondBranch,      // TR::iflcmpno
-   constrainCondBranch,      // TR::ificmno
-   constrainCondBranch,      // TR::ificmnno
-   constrainCondBranch,      // TR::iflcmno
-   constrainCondBranch,      // TR::iflcmnno
+   constrainIfcmpo,          // TR::ificmpo
+   constrainIfcmpo,          // TR::ificmpno
+   constrainIfcmpo,          // TR::iflcmpo
+   constrainIfcmpo,          // TR::iflcmpno
+   constrainIfcmpo,          // TR::ificmno
+   constrainIfcmpo,          // TR::ificmnno
+   constrainIfcmpo,          // TR::iflcmno
+   constrainIfcmpo,          // TR::iflcmnno
 
    constrainChildren,        // TR::iuaddc
    constrainChildren,        // TR::luaddc
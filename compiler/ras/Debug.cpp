@@ -1004,6 +1004,7 @@ TR_Debug::nodePrintAllFlags(TR::Node *node, TR_PrettyPrinterString &output)
       output.append(format, node->printIsDontTransformArrayCopyCall());
    output.append(format, node->printIsNodeRecognizedArrayCopyCall());
    output.append(format, node->printCanDesynchronizeCall());
+   output.append(format, node->printIsTailCall());
    output.append(format, node->printContainsCompressionSequence());
    output.append(format, node->printIsInternalPointer());
    output.append(format, node->printIsMaxLoopIterationGuard());
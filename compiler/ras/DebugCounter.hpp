@@ -27,6 +27,7 @@
 #include <stdarg.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include "cs2/hashtab.h"
 #include "env/CompilerEnv.hpp"
 #include "env/TRMemory.hpp"
@@ -291,6 +292,7 @@ class DebugCounterGroup
    const char *counterName(TR::Compilation *comp, const char *format, va_list args);
 
    DebugCounter *getCounter(TR::Compilation *comp, const char *name, int8_t fidelity=DebugCounter::Undetermined); // Returns NULL if counter is disabled
+   DebugCounter *findCounter(const char *name) { return findCounter(name, strlen(name)); } // Returns NULL if counter was never created
 
    DebugCounterAggregation *createAggregation(TR::Compilation *comp, const char * name);
    DebugCounterAggregation * findAggregation(const char *nameChars, int32_t nameLength);
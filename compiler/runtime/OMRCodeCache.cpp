@@ -1230,6 +1230,51 @@ OMR::CodeCache::findFreeBlock(size_t size, bool isCold, bool isMethodHeaderNeede
    }
 
 
+// Find the lowest addressed warm free block below limit that will satisfy the
+// request.  The free block list is sorted by address, so this is the first
+// one that fits.
+//
+uint8_t *
+OMR::CodeCache::findFreeBlockBelow(size_t size, uint8_t *limit, size_t &blockSize)
+   {
+   TR::CodeCacheConfig & config = _manager->codeCacheConfig();
+   size = (size_t)align((uint8_t *)size, config.codeCacheAlignment() - 1);
+
+   CodeCacheFreeCacheBlock *prevLink = NULL;
+   CodeCacheFreeCacheBlock *currLink;
+   for (currLink = _freeBlockList; currLink; prevLink = currLink, currLink = currLink->_next)
+      {
+      if ((uint8_t *)currLink >= limit || (uint8_t *)currLink >= _warmCodeAlloc)
+         return NULL;
+      if (currLink->_size >= size)
+         break;
+      }
+   if (!currLink)
+      return NULL;
+
+   bool wasLargest = currLink->_size == _sizeOfLargestFreeWarmBlock;
+   self()->removeFreeBlock(size, prevLink, currLink);
+   blockSize = currLink->_size;
+
+   if (wasLargest)
+      {
+      _sizeOfLargestFreeWarmBlock = 0;
+      for (CodeCacheFreeCacheBlock *link = _freeBlockList; link && (uint8_t *)link < _warmCodeAlloc; link = link->_next)
+         self()->updateMaxSizeOfFreeBlocks(link, link->_size);
+      }
+
+   if (config.verboseReclamation())
+      {
+      TR_VerboseLog::writeLineLocked(TR_Vlog_CODECACHE,"--ccr- findFreeBlockBelow: CodeCache=%p size=%u limit=%p block=%p blockSize=%u", this, size, limit, currLink, blockSize);
+      }
+
+   if (config.doSanityChecks())
+      self()->checkForErrors();
+
+   return (uint8_t *)currLink;
+   }
+
+
 // Remove a free block from the list of free blocks for this code cache to make
 // it available for re-use.
 //
@@ -114,6 +114,19 @@ public:
 
    uint8_t *findFreeBlock(size_t size, bool isCold, bool isMethodHeaderNeeded);
 
+   /**
+    * @brief Takes the lowest addressed warm free block below limit that can
+    *        hold size bytes off the list of free blocks, e.g. to move code
+    *        down when compacting this CodeCache.
+    *
+    * @param[in] size : the number of bytes needed
+    * @param[in] limit : the block must start below this address
+    * @param[out] blockSize : the size of the block taken, which is at least size
+    *
+    * @return the start of the block, or NULL if there is no such block
+    */
+   uint8_t *findFreeBlockBelow(size_t size, uint8_t *limit, size_t &blockSize);
+
    void reserve(int32_t reservingCompThreadID);
 
    void unreserve();
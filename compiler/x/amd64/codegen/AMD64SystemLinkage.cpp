@@ -42,6 +42,8 @@
 #include "il/Node_inlines.hpp"
 #include "il/Symbol.hpp"
 #include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
 #include "il/symbol/LabelSymbol.hpp"
 #include "il/symbol/MethodSymbol.hpp"
 #include "il/symbol/ParameterSymbol.hpp"
@@ -710,6 +712,13 @@ TR::AMD64SystemLinkage::buildIndirectDispatch(TR::Node *callNode)
    TR::SymbolReference *methodSymRef = callNode->getSymbolReference();
    TR_ASSERT(methodSymRef->getSymbol()->castToMethodSymbol()->isComputed(), "system linkage only supports computed indirect call for now %p\n", callNode);
 
+   if (callNode->isTailCall())
+      {
+      if (canBuildTailDispatch(callNode))
+         return buildTailDispatch(callNode);
+      callNode->setIsTailCall(false);
+      }
+
    // Evaluate VFT
    //
    TR::Register *vftRegister;
@@ -763,6 +772,13 @@ TR::Register *TR::AMD64SystemLinkage::buildDirectDispatch(
       TR::Node *callNode,
       bool spillFPRegs)
    {
+   if (callNode->isTailCall())
+      {
+      if (canBuildTailDispatch(callNode))
+         return buildTailDispatch(callNode);
+      callNode->setIsTailCall(false);
+      }
+
    TR::SymbolReference *methodSymRef = callNode->getSymbolReference();
    TR::MethodSymbol *methodSymbol = methodSymRef->getSymbol()->castToMethodSymbol();
 
@@ -813,7 +829,9 @@ TR::Register *TR::AMD64SystemLinkage::buildDirectDispatch(
          methodSymRef,
          cg());
 
-      if (comp()->getOption(TR_EmitRelocatableELFFile))
+      // Code cache compaction moves the callee and has to find this call site
+      //
+      if (comp()->getOption(TR_EmitRelocatableELFFile) || comp()->getOption(TR_EnableCodeCacheCompaction))
          {
          LoadRegisterInstruction->setReloKind(TR_NativeMethodAbsolute);
          }
@@ -837,6 +855,99 @@ TR::Register *TR::AMD64SystemLinkage::buildDirectDispatch(
    return returnReg;
    }
 
+/**
+ * \brief Determine whether \p callNode, which is marked as a tail call, can
+ * reuse the frame of the caller.
+ *
+ * The call must be followed directly by the return of its result, and all
+ * of its arguments must be passed in registers so that the incoming argument
+ * area of the caller, which belongs to its own caller, is left alone.
+ */
+bool TR::AMD64SystemLinkage::canBuildTailDispatch(TR::Node *callNode)
+   {
+   TR::TreeTop *callTree = cg()->getCurrentEvaluationTreeTop();
+   if (callTree->getNode() != callNode && callTree->getNode()->getFirstChild() != callNode)
+      return false;
+
+   TR::Node *returnNode = callTree->getNextTreeTop()->getNode();
+   if (!returnNode->getOpCode().isReturn())
+      return false;
+
+   if (returnNode->getNumChildren() == 0 ? callNode->getDataType() != TR::NoType : returnNode->getFirstChild() != callNode)
+      return false;
+
+   if (!callNode->getOpCode().isIndirect() && !callNode->getSymbol()->castToMethodSymbol()->getMethodAddress())
+      return false;
+
+   int32_t sizeOfOutGoingArgs = 0;
+   uint16_t numIntArgs = 0,
+            numFloatArgs = 0;
+   for (int32_t i = callNode->getFirstArgumentIndex(); i < callNode->getNumChildren(); i++)
+      {
+      TR::parmLayoutResult layoutResult;
+      layoutParm(callNode->getChild(i), sizeOfOutGoingArgs, numIntArgs, numFloatArgs, layoutResult);
+      if (!(layoutResult.abstract & TR::parmLayoutResult::IN_LINKAGE_REG))
+         return false;
+      }
+
+   return true;
+   }
+
+/**
+ * \brief Build a call that replaces the frame of the caller.
+ *
+ * The arguments are moved to their linkage registers and the target to the
+ * first scratch register, which neither the epilogue nor the arguments use.
+ * The epilogue is then inserted at a ReturnMarker, and the callee is entered
+ * with a jump so that it returns directly to the caller of this method.
+ */
+TR::Register *TR::AMD64SystemLinkage::buildTailDispatch(TR::Node *callNode)
+   {
+   TR::SymbolReference *methodSymRef = callNode->getSymbolReference();
+   TR::MethodSymbol *methodSymbol = methodSymRef->getSymbol()->castToMethodSymbol();
+
+   if (comp()->getOption(TR_TraceCG))
+      traceMsg(comp(), "Building tail call dispatch for n%dn\n", callNode->getGlobalIndex());
+
+   // pre = number of argument registers + VFT register + target register
+   //
+   uint32_t pre = getProperties().getNumIntegerArgumentRegisters() + getProperties().getNumFloatArgumentRegisters() + 2;
+   TR::RegisterDependencyConditions *deps = generateRegisterDependencyConditions(pre, 0, cg());
+
+   TR::Register *targetReg = cg()->allocateRegister();
+   if (callNode->getOpCode().isIndirect())
+      {
+      TR::Register *vftRegister = cg()->evaluate(callNode->getFirstChild());
+      generateRegRegInstruction(MOV8RegReg, callNode, targetReg, vftRegister, cg());
+      }
+   else
+      {
+      auto LoadRegisterInstruction = generateRegImm64SymInstruction(
+         MOV8RegImm64,
+         callNode,
+         targetReg,
+         (uintptr_t)methodSymbol->getMethodAddress(),
+         methodSymRef,
+         cg());
+
+      if (comp()->getOption(TR_EmitRelocatableELFFile) || comp()->getOption(TR_EnableCodeCacheCompaction))
+         {
+         LoadRegisterInstruction->setReloKind(TR_NativeMethodAbsolute);
+         }
+      }
+
+   deps->addPreCondition(targetReg, getProperties().getIntegerScratchRegister(0), cg());
+   buildArgs(callNode, deps);
+
+   generateInstruction(ReturnMarker, callNode, cg());
+   generateRegInstruction(JMPReg, callNode, targetReg, deps, cg());
+   cg()->resetIsLeafMethod();
+
+   cg()->stopUsingRegister(targetReg);
+
+   return NULL;
+   }
+
 static const TR::RealRegister::RegNum NOT_ASSIGNED = (TR::RealRegister::RegNum)-1;
 
 uint32_t
@@ -55,6 +55,9 @@ class AMD64SystemLinkage : public TR::X86SystemLinkage
    virtual TR::Register *buildIndirectDispatch(TR::Node *callNode);
    virtual TR::Register *buildDirectDispatch(TR::Node *callNode, bool spillFPRegs);
 
+   bool canBuildTailDispatch(TR::Node *callNode);
+   TR::Register *buildTailDispatch(TR::Node *callNode);
+
    TR::Register *buildVolatileAndReturnDependencies(TR::Node *callNode, TR::RegisterDependencyConditions *deps);
 
    virtual TR::RealRegister* getSingleWordFrameAllocationRegister() { return machine()->getRealRegister(TR::RealRegister::r11); }
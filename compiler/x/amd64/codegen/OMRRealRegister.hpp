@@ -318,7 +318,7 @@ class OMR_EXTENSIBLE RealRegister : public OMR::X86::RealRegister
    */
    void setRegisterFieldInVEX(uint8_t *opcodeByte)
       {
-      *opcodeByte ^= ((_fullRegisterBinaryEncodings[_registerNumber].needsRexForByte << 3) | _fullRegisterBinaryEncodings[_registerNumber].id) << 3; // vvvv is in bits 3-6 of last byte of VEX
+      *opcodeByte ^= ((_fullRegisterBinaryEncodings[_registerNumber].needsRexPlusRXB << 3) | _fullRegisterBinaryEncodings[_registerNumber].id) << 3; // vvvv is in bits 3-6 of last byte of VEX
       }
 
    void setRegisterFieldInModRM(uint8_t *modRMByte)
@@ -128,6 +128,9 @@ TR::Register *OMR::X86::AMD64::TreeEvaluator::lloadEvaluator(TR::Node *node, TR:
 
 TR::Register *OMR::X86::AMD64::TreeEvaluator::landEvaluator(TR::Node *node, TR::CodeGenerator *cg)
    {
+   TR::Register *targetRegister = TR::TreeEvaluator::generateAndNot(node, cg);
+   if (targetRegister)
+      return targetRegister;
    return TR::TreeEvaluator::logicalEvaluator(node, _logicalOpPackage[landOpPackage], cg);
    }
 
@@ -414,8 +414,8 @@
    TR::TreeEvaluator::iternaryEvaluator,                               // TR::bternary
    TR::TreeEvaluator::iternaryEvaluator,                               // TR::sternary
    TR::TreeEvaluator::iternaryEvaluator,                               // TR::aternary
-   TR::TreeEvaluator::badILOpEvaluator,                                // TR::fternary
-   TR::TreeEvaluator::badILOpEvaluator,                                // TR::dternary
+   TR::TreeEvaluator::fpTernaryEvaluator,                              // TR::fternary
+   TR::TreeEvaluator::fpTernaryEvaluator,                              // TR::dternary
    TR::TreeEvaluator::treetopEvaluator,                                // TR::treetop
    TR::TreeEvaluator::badILOpEvaluator,                                // TR::MethodEnterHook (J9)
    TR::TreeEvaluator::badILOpEvaluator,                                // TR::MethodExitHook (J9)
@@ -751,26 +751,26 @@
    TR::TreeEvaluator::unImpOpEvaluator,                                // TR::iumax
    TR::TreeEvaluator::minmaxEvaluator,                                 // TR::lmax
    TR::TreeEvaluator::unImpOpEvaluator,                                // TR::lumax
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::fmax
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::dmax
+   TR::TreeEvaluator::fpMinMaxEvaluator,                               // TR::fmax
+   TR::TreeEvaluator::fpMinMaxEvaluator,                               // TR::dmax
    TR::TreeEvaluator::minmaxEvaluator,                                 // TR::imin
    TR::TreeEvaluator::unImpOpEvaluator,                                // TR::iumin
    TR::TreeEvaluator::minmaxEvaluator,                                 // TR::lmin
    TR::TreeEvaluator::unImpOpEvaluator,                                // TR::lumin
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::fmin
-   TR::TreeEvaluator::unImpOpEvaluator,                                // TR::dmin
+   TR::TreeEvaluator::fpMinMaxEvaluator,                               // TR::fmin
+   TR::TreeEvaluator::fpMinMaxEvaluator,                               // TR::dmin
    TR::TreeEvaluator::unImpOpEvaluator,                                // TR::trt
    TR::TreeEvaluator::unImpOpEvaluator,                                // TR::trtSimple
    TR::TreeEvaluator::badILOpEvaluator,                                // TR::ihbit (J9)
    TR::TreeEvaluator::badILOpEvaluator,                                // TR::ilbit (J9)
-   TR::TreeEvaluator::badILOpEvaluator,                                // TR::inolz (J9)
-   TR::TreeEvaluator::badILOpEvaluator,                                // TR::inotz (J9)
-   TR::TreeEvaluator::badILOpEvaluator,                                // TR::ipopcnt (J9)
+   TR::TreeEvaluator::integerNumberOfLeadingZerosEvaluator,            // TR::inolz
+   TR::TreeEvaluator::integerNumberOfTrailingZerosEvaluator,           // TR::inotz
+   TR::TreeEvaluator::integerBitCountEvaluator,                        // TR::ipopcnt
    TR::TreeEvaluator::badILOpEvaluator,                                // TR::lhbit (J9)
    TR::TreeEvaluator::badILOpEvaluator,                                // TR::llbit (J9)
-   TR::TreeEvaluator::badILOpEvaluator,                                // TR::lnolz (J9)
-   TR::TreeEvaluator::badILOpEvaluator,                                // TR::lnotz (J9)
-   TR::TreeEvaluator::badILOpEvaluator,                                // TR::lpopcnt (J9)
+   TR::TreeEvaluator::integerNumberOfLeadingZerosEvaluator,            // TR::lnolz
+   TR::TreeEvaluator::integerNumberOfTrailingZerosEvaluator,           // TR::lnotz
+   TR::TreeEvaluator::integerBitCountEvaluator,                        // TR::lpopcnt
    TR::TreeEvaluator::ibyteswapEvaluator,                              // TR::ibyteswap
    TR::TreeEvaluator::bitpermuteEvaluator,                             // TR::bbitpermute
    TR::TreeEvaluator::bitpermuteEvaluator,                             // TR::sbitpermute
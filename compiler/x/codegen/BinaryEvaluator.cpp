@@ -1993,8 +1993,11 @@ TR::Register *OMR::X86::TreeEvaluator::integerMulEvaluator(TR::Node *node, TR::C
                                                                      node,
                                                                      cg,
                                                                      canClobberSource);
+         // A decomposed multiply does not set the overflow flag for the product
+         //
          int32_t dummy;
-         targetRegister = mulDecomposer->decomposeIntegerMultiplier(dummy, 0);
+         if (!NEED_CC(node))
+            targetRegister = mulDecomposer->decomposeIntegerMultiplier(dummy, 0);
 
          // decomposition failed
          // large constants must be loaded into a register first so these cases
@@ -2646,6 +2649,22 @@ TR::Register *OMR::X86::TreeEvaluator::integerDivOrRemEvaluator(TR::Node *node,
    TR_ASSERT(0, "Shouldn't get here");
    }
 
+// Map a shift by CL to the BMI2 shift by any register
+//
+static TR_X86OpCodes getBMI2ShiftOpCode(TR_X86OpCodes regShiftOpCode)
+   {
+   switch (regShiftOpCode)
+      {
+      case SHL4RegCL: return SHLX4RegRegReg;
+      case SHL8RegCL: return SHLX8RegRegReg;
+      case SAR4RegCL: return SARX4RegRegReg;
+      case SAR8RegCL: return SARX8RegRegReg;
+      case SHR4RegCL: return SHRX4RegRegReg;
+      case SHR8RegCL: return SHRX8RegRegReg;
+      default:        return BADIA32Op;
+      }
+   }
+
 TR::X86RegInstruction  *OMR::X86::TreeEvaluator::generateRegisterShift(TR::Node *node, TR_X86OpCodes immShiftOpCode, TR_X86OpCodes regShiftOpCode,TR::CodeGenerator *cg)
    {
    bool                  nodeIs64Bit    = TR::TreeEvaluator::getNodeIs64Bit(node, cg);
@@ -2734,21 +2753,37 @@ TR::X86RegInstruction  *OMR::X86::TreeEvaluator::generateRegisterShift(TR::Node
       if(!shiftAmountReg)
          shiftAmountReg = cg->evaluate(secondChild);
 
-      TR::RegisterDependencyConditions  *shiftDependencies = generateRegisterDependencyConditions((uint8_t)1, 1, cg);
-      shiftDependencies->addPreCondition(shiftAmountReg, TR::RealRegister::ecx, cg);
-      shiftDependencies->addPostCondition(shiftAmountReg, TR::RealRegister::ecx, cg);
-      targetRegister = TR::TreeEvaluator::intOrLongClobberEvaluate(firstChild, nodeIs64Bit, cg);
+      TR_X86OpCodes shiftXOpCode = BADIA32Op;
+      if (cg->getX86ProcessorInfo().supportsBMI2() && cg->getX86ProcessorInfo().supportsAVX())
+         shiftXOpCode = getBMI2ShiftOpCode(regShiftOpCode);
 
-      if (SHIFT_MAY_HAVE_ADDRESS_CHILD     &&
-          node->getOpCode().isLeftShift()  &&
-          targetRegister->containsCollectedReference())
+      if (shiftXOpCode != BADIA32Op)
          {
-         TR::Register *origTargetRegister = targetRegister;
+         // SHLX/SARX/SHRX take the shift amount in any register and leave the
+         // source and the flags intact
+         //
+         TR::Register *sourceRegister = cg->evaluate(firstChild);
          targetRegister = cg->allocateRegister();
-         instr = generateRegRegInstruction(MOVRegReg(nodeIs64Bit), node, targetRegister, origTargetRegister, cg);
+         instr = generateRegRegRegInstruction(shiftXOpCode, node, targetRegister, shiftAmountReg, sourceRegister, cg);
          }
+      else
+         {
+         TR::RegisterDependencyConditions  *shiftDependencies = generateRegisterDependencyConditions((uint8_t)1, 1, cg);
+         shiftDependencies->addPreCondition(shiftAmountReg, TR::RealRegister::ecx, cg);
+         shiftDependencies->addPostCondition(shiftAmountReg, TR::RealRegister::ecx, cg);
+         targetRegister = TR::TreeEvaluator::intOrLongClobberEvaluate(firstChild, nodeIs64Bit, cg);
 
-      instr = generateRegRegInstruction(regShiftOpCode, node, targetRegister, shiftAmountReg, shiftDependencies, cg);
+         if (SHIFT_MAY_HAVE_ADDRESS_CHILD     &&
+             node->getOpCode().isLeftShift()  &&
+             targetRegister->containsCollectedReference())
+            {
+            TR::Register *origTargetRegister = targetRegister;
+            targetRegister = cg->allocateRegister();
+            instr = generateRegRegInstruction(MOVRegReg(nodeIs64Bit), node, targetRegister, origTargetRegister, cg);
+            }
+
+         instr = generateRegRegInstruction(regShiftOpCode, node, targetRegister, shiftAmountReg, shiftDependencies, cg);
+         }
       }
 
    node->setRegister(targetRegister);
@@ -2917,8 +2952,19 @@ TR::Register *OMR::X86::TreeEvaluator::integerRolEvaluator(TR::Node *node, TR::C
          }
       else
          {
-         targetRegister = TR::TreeEvaluator::intOrLongClobberEvaluate(firstChild, nodeIs64Bit, cg);
-         generateRegImmInstruction(ROLRegImm1(nodeIs64Bit), node, targetRegister, rotateAmount , cg);
+         if (cg->getX86ProcessorInfo().supportsBMI2() && cg->getX86ProcessorInfo().supportsAVX())
+            {
+            // RORX leaves the source and the flags intact
+            //
+            TR::Register *sourceRegister = cg->evaluate(firstChild);
+            targetRegister = cg->allocateRegister();
+            generateRegRegImmInstruction(RORXRegRegImm1(nodeIs64Bit), node, targetRegister, sourceRegister, (nodeIs64Bit ? 64 : 32) - rotateAmount, cg);
+            }
+         else
+            {
+            targetRegister = TR::TreeEvaluator::intOrLongClobberEvaluate(firstChild, nodeIs64Bit, cg);
+            generateRegImmInstruction(ROLRegImm1(nodeIs64Bit), node, targetRegister, rotateAmount , cg);
+            }
          }
       }
    else
@@ -3783,8 +3829,60 @@ TR::Register *OMR::X86::TreeEvaluator::candEvaluator(TR::Node *node, TR::CodeGen
    return TR::TreeEvaluator::logicalEvaluator(node, _logicalOpPackage[candOpPackage], cg);
    }
 
+static bool isBitwiseNot(TR::Node *node)
+   {
+   return (node->getOpCodeValue() == TR::ixor || node->getOpCodeValue() == TR::lxor) &&
+          node->getReferenceCount() == 1 &&
+          node->getRegister() == NULL &&
+          node->getSecondChild()->getOpCode().isLoadConst() &&
+          node->getSecondChild()->get64bitIntegralValue() == -1;
+   }
+
+// Evaluate and(x, xor(y, -1)) as ANDN if the processor has BMI1.
+//
+// Returns NULL if the node does not match, in which case nothing has been evaluated.
+//
+TR::Register *OMR::X86::TreeEvaluator::generateAndNot(TR::Node *node, TR::CodeGenerator *cg)
+   {
+   if (!cg->getX86ProcessorInfo().supportsBMI1() || !cg->getX86ProcessorInfo().supportsAVX() ||
+       node->isDirectMemoryUpdate())
+      return NULL;
+
+   TR::Node *notChild = node->getFirstChild();
+   TR::Node *otherChild = node->getSecondChild();
+   if (!isBitwiseNot(notChild))
+      {
+      notChild = node->getSecondChild();
+      otherChild = node->getFirstChild();
+      if (!isBitwiseNot(notChild))
+         return NULL;
+      }
+
+   if (!performTransformation(cg->comp(), "O^O Changing [%p] to ANDN\n", node))
+      return NULL;
+
+   bool nodeIs64Bit = TR::TreeEvaluator::getNodeIs64Bit(node, cg);
+   TR::Register *notSourceRegister = cg->evaluate(notChild->getFirstChild());
+   TR::Register *otherSourceRegister = cg->evaluate(otherChild);
+   TR::Register *targetRegister = cg->allocateRegister();
+
+   // target = ~notSource & otherSource
+   //
+   generateRegRegRegInstruction(ANDNRegRegReg(nodeIs64Bit), node, targetRegister, notSourceRegister, otherSourceRegister, cg);
+
+   node->setRegister(targetRegister);
+   cg->decReferenceCount(notChild->getFirstChild());
+   cg->decReferenceCount(notChild->getSecondChild());
+   cg->decReferenceCount(notChild);
+   cg->decReferenceCount(otherChild);
+   return targetRegister;
+   }
+
 TR::Register *OMR::X86::TreeEvaluator::iandEvaluator(TR::Node *node, TR::CodeGenerator *cg)
    {
+   TR::Register *targetRegister = TR::TreeEvaluator::generateAndNot(node, cg);
+   if (targetRegister)
+      return targetRegister;
    return TR::TreeEvaluator::logicalEvaluator(node, _logicalOpPackage[iandOpPackage], cg);
    }
 
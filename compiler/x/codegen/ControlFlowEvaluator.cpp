@@ -80,6 +80,7 @@ class TR_OpaqueClassBlock;
 class TR_OpaqueMethodBlock;
 
 static bool virtualGuardHelper(TR::Node *node, TR::CodeGenerator *cg);
+static bool patchableGuardHelper(TR::Node *node, TR::CodeGenerator *cg);
 
 // The following functions are simple enough to inline, and are called often
 // enough that we want to take advantage of inlining.  However, it is used
@@ -463,6 +464,16 @@ TR::Register *OMR::X86::TreeEvaluator::tableEvaluator(TR::Node *node, TR::CodeGe
          cg->evaluate(secondChild->getFirstChild()); // evaluate the glRegDeps
       }
 
+   // The bound check only looks at the low half of the selector register, so
+   // clear the high half before the selector indexes the table
+   //
+   TR::Register *indexReg = selectorReg;
+   if (TR::Compiler->target.is64Bit())
+      {
+      indexReg = cg->allocateRegister();
+      generateRegRegInstruction(MOVZXReg8Reg4, node, indexReg, selectorReg, cg);
+      }
+
    TR::MemoryReference *jumpMR = NULL;
    TR::Register *branchTableReg = NULL;
    if (TR::Compiler->target.is64Bit() && cg->comp()->compileRelocatableCode())
@@ -478,13 +489,13 @@ TR::Register *OMR::X86::TreeEvaluator::tableEvaluator(TR::Node *node, TR::CodeGe
       TR::MemoryReference *branchTableLeaMR = generateX86MemoryReference(label, cg);
       branchTableReg = cg->allocateRegister();
       generateRegMemInstruction(LEA8RegMem, node, branchTableReg, branchTableLeaMR, cg);
-      jumpMR = generateX86MemoryReference(branchTableReg, selectorReg, 3, cg);
+      jumpMR = generateX86MemoryReference(branchTableReg, indexReg, 3, cg);
       }
    else
       {
       jumpMR = generateX86MemoryReference(
          (TR::Register *)NULL,
-         selectorReg,
+         indexReg,
          (uint8_t)(TR::Compiler->target.is64Bit()? 3 : 2),
          (intptrj_t)branchTable, cg);
 
@@ -526,6 +537,9 @@ TR::Register *OMR::X86::TreeEvaluator::tableEvaluator(TR::Node *node, TR::CodeGe
    if (branchTableReg != NULL)
       cg->stopUsingRegister(branchTableReg);
 
+   if (indexReg != selectorReg)
+      cg->stopUsingRegister(indexReg);
+
    return NULL;
    }
 
@@ -1194,10 +1208,35 @@ TR::Register *OMR::X86::TreeEvaluator::igotoEvaluator(TR::Node* node, TR::CodeGe
    return NULL;
    }
 
+// A return of the result of a call that was dispatched as a tail call is
+// never reached: the callee returns directly to the caller of this method
+//
+bool OMR::X86::TreeEvaluator::isReturnAfterTailCall(TR::Node *node, TR::CodeGenerator *cg)
+   {
+   TR::Node *callNode = NULL;
+   if (node->getNumChildren() > 0)
+      {
+      callNode = node->getFirstChild();
+      }
+   else
+      {
+      TR::Node *prevNode = cg->getCurrentEvaluationTreeTop()->getPrevTreeTop()->getNode();
+      callNode = prevNode->getNumChildren() > 0 ? prevNode->getFirstChild() : prevNode;
+      }
+
+   return callNode->getOpCode().isCall() && callNode->isTailCall();
+   }
+
 TR::Register *OMR::X86::TreeEvaluator::integerReturnEvaluator(TR::Node *node, TR::CodeGenerator *cg)
    {
    TR::Compilation *comp = cg->comp();
 
+   if (TR::TreeEvaluator::isReturnAfterTailCall(node, cg))
+      {
+      cg->decReferenceCount(node->getFirstChild());
+      return NULL;
+      }
+
    // Restore the default FPCW if it has been forced to single precision mode.
    //
    if (cg->enableSinglePrecisionMethods() &&
@@ -1265,6 +1304,9 @@ TR::Register *OMR::X86::TreeEvaluator::returnEvaluator(TR::Node *node, TR::CodeG
    {
    TR::Compilation *comp = cg->comp();
 
+   if (TR::TreeEvaluator::isReturnAfterTailCall(node, cg))
+      return NULL;
+
    // Restore the default FPCW if it has been forced to single precision mode.
    //
    if (cg->enableSinglePrecisionMethods() &&
@@ -1410,15 +1452,51 @@ static inline void generateMergedGuardCodeIfNeeded(TR::Node *node, TR::CodeGener
    }
 
 
+// Branch on the overflow flag of the multiply of a multiply overflow check
+// (see TR::Node::isMultiplyOverflowCheck). The multiply is evaluated here for
+// its condition codes unless the tree before has already done so.
+//
+static bool generateMultiplyOverflowBranch(TR::Node *node, TR::CodeGenerator *cg)
+   {
+   TR::Node *high = node->getFirstChild();
+   TR::Node *shift = node->getSecondChild();
+   TR::Node *product = shift->getFirstChild();
+
+   // A 64-bit multiply on IA32 is a sequence whose last instruction does not
+   // set the overflow flag for the whole product
+   //
+   if (TR::Compiler->target.is32Bit() && product->getType().isInt64())
+      return false;
+
+   if (!product->getRegister())
+      {
+      product->setNodeRequiresConditionCodes(true);
+      cg->evaluate(product);
+      }
+   else if (!TR::TreeEvaluator::overflowFlagIsSetBy(product, cg))
+      {
+      return false;
+      }
+
+   generateConditionalJumpInstruction(JO4, node, cg, true);
+
+   cg->recursivelyDecReferenceCount(high);
+   cg->recursivelyDecReferenceCount(shift);
+   return true;
+   }
+
 TR::Register *OMR::X86::TreeEvaluator::integerIfCmpneEvaluator(TR::Node *node, TR::CodeGenerator *cg)
    {
    TR::Compilation *comp = cg->comp();
-   if (virtualGuardHelper(node, cg))
+   if (virtualGuardHelper(node, cg) || patchableGuardHelper(node, cg))
       {
       return NULL;
       }
    else
       {
+      if (node->isMultiplyOverflowCheck() && generateMultiplyOverflowBranch(node, cg))
+         return NULL;
+
 #ifdef J9_PROJECT_SPECIFIC
       // Check for the special case of a BigDecimal long lookaside overflow check.
       //
@@ -2372,6 +2450,52 @@ static bool virtualGuardHelper(TR::Node *node, TR::CodeGenerator *cg)
 #endif
    }
 
+// The NOP of a patchable guard is replaced by a JMP4 with one 8 byte store
+//
+static const TR_AtomicRegion patchableGuardAtomicRegions[] =
+   {
+   { 0x0, 5 },
+   { 0,0 }
+   };
+
+/**
+ * Compiles a guard on a word the front end sets when an assumption no longer
+ * holds, see OMR::CodeGenerator::isPatchableGuard(), to a 5 byte NOP that the
+ * front end overwrites with a jump to the branch destination.  The register
+ * dependencies the branch would have are placed on a label just before the
+ * NOP, so the registers are right for the destination whichever way it is
+ * reached.
+ */
+static bool patchableGuardHelper(TR::Node *node, TR::CodeGenerator *cg)
+   {
+   if (!cg->isPatchableGuard(node))
+      return false;
+
+   TR::LabelSymbol *siteLabel = generateLabelSymbol(cg);
+   if (node->getNumChildren() == 3)
+      {
+      List<TR::Register> popRegisters(cg->trMemory());
+      TR::X86LabelInstruction *labelInstr = generateLabelInstruction(LABEL, node, siteLabel, node->getChild(2), &popRegisters, cg);
+      if (labelInstr->getDependencyConditions())
+         labelInstr->getDependencyConditions()->setMayNeedToPopFPRegisters(true);
+      TR_ASSERT(popRegisters.isEmpty(), "Patchable guards do not support x87 registers");
+      }
+   else
+      {
+      generateLabelInstruction(LABEL, node, siteLabel, cg);
+      }
+
+   TR::Instruction *nop = generatePaddingInstruction(5, node, cg);
+   generateBoundaryAvoidanceInstruction(patchableGuardAtomicRegions, 8, 8, nop, cg);
+
+   TR::Node *load = node->getFirstChild();
+   cg->addPatchableGuardSite(nop, node->getBranchDestination()->getNode()->getLabel(),
+                             load->getSymbol()->castToStaticSymbol()->getStaticAddress());
+   cg->recursivelyDecReferenceCount(load);
+   cg->recursivelyDecReferenceCount(node->getSecondChild());
+   return true;
+   }
+
 void
 OMR::X86::CodeGenerator::addMetaDataForBranchTableAddress(
       uint8_t *target,
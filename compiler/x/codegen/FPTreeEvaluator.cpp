@@ -509,6 +509,12 @@ TR::Register *OMR::X86::TreeEvaluator::floatingPointStoreEvaluator(TR::Node *nod
 
 TR::Register *OMR::X86::TreeEvaluator::fpReturnEvaluator(TR::Node *node, TR::CodeGenerator *cg)
    {
+   if (TR::TreeEvaluator::isReturnAfterTailCall(node, cg))
+      {
+      cg->decReferenceCount(node->getFirstChild());
+      return NULL;
+      }
+
    TR::Register *returnRegister = cg->evaluate(node->getFirstChild());
    TR_ASSERT(returnRegister, "Return node's child should evaluate to a register");
    TR::Compilation *comp = cg->comp();
@@ -722,13 +728,226 @@ TR::Register *OMR::X86::TreeEvaluator::fpSqrtEvaluator(TR::Node *node, TR::CodeG
    return result;
    }
 
+// fmax/fmin/dmax/dmin follow C fmax/fmin: a NaN operand is ignored unless both
+// operands are NaN.  MAXSD/MINSD return the second operand when either one is a
+// NaN, which covers a NaN first operand; a NaN second operand is masked out with
+// an unordered compare.
+//
+TR::Register *OMR::X86::TreeEvaluator::fpMinMaxEvaluator(TR::Node *node, TR::CodeGenerator *cg)
+   {
+   TR_ASSERT(cg->useSSEForSingleAndDoublePrecision(), "fpMinMaxEvaluator requires SSE");
+
+   bool isFloat = node->getDataType() == TR::Float;
+   TR_X86OpCodes opcode;
+   if (node->getOpCode().isMax())
+      opcode = isFloat ? MAXSSRegReg : MAXSDRegReg;
+   else
+      opcode = isFloat ? MINSSRegReg : MINSDRegReg;
+
+   TR::Register *a = cg->evaluate(node->getFirstChild());
+   TR::Register *b = cg->evaluate(node->getSecondChild());
+
+   TR::Register *minmax = cg->allocateRegister(TR_FPR);
+   TR::Register *result = cg->allocateRegister(TR_FPR);
+   TR::Register *tmp = cg->allocateRegister(TR_FPR);
+   if (isFloat)
+      {
+      minmax->setIsSinglePrecision();
+      result->setIsSinglePrecision();
+      tmp->setIsSinglePrecision();
+      }
+
+   // minmax = min/max(a, b)
+   generateRegRegInstruction(MOVDQURegReg, node, minmax, a, cg);
+   generateRegRegInstruction(opcode, node, minmax, b, cg);
+
+   // result = isnan(b) ? a : minmax
+   generateRegRegInstruction(MOVDQURegReg, node, result, b, cg);
+   generateRegRegImmInstruction(isFloat ? CMPSSRegRegImm1 : CMPSDRegRegImm1, node, result, result, 3 /* unordered */, cg);
+   generateRegRegInstruction(MOVDQURegReg, node, tmp, a, cg);
+   generateRegRegInstruction(PANDRegReg, node, tmp, result, cg);
+   generateRegRegInstruction(PANDNRegReg, node, result, minmax, cg);
+   generateRegRegInstruction(PORRegReg, node, result, tmp, cg);
+
+   cg->stopUsingRegister(tmp);
+   cg->stopUsingRegister(minmax);
+
+   node->setRegister(result);
+   cg->decReferenceCount(node->getFirstChild());
+   cg->decReferenceCount(node->getSecondChild());
+   return result;
+   }
+
+// Get the CMPSS/CMPSD predicate that computes the float or double compare
+// \p opCode, and whether its operands must be swapped.  The predicates of
+// SSE cannot express the ordered not-equal and unordered equal compares.
+//
+static bool getFPComparePredicate(TR::ILOpCodes opCode, uint8_t &predicate, bool &swapOperands)
+   {
+   swapOperands = false;
+   switch (opCode)
+      {
+      case TR::fcmpeq:  case TR::dcmpeq:                        predicate = 0; break; // EQ
+      case TR::fcmplt:  case TR::dcmplt:                        predicate = 1; break; // LT
+      case TR::fcmple:  case TR::dcmple:                        predicate = 2; break; // LE
+      case TR::fcmpgt:  case TR::dcmpgt:  swapOperands = true;  predicate = 1; break; // LT
+      case TR::fcmpge:  case TR::dcmpge:  swapOperands = true;  predicate = 2; break; // LE
+      case TR::fcmpneu: case TR::dcmpneu:                       predicate = 4; break; // NEQ
+      case TR::fcmpgeu: case TR::dcmpgeu:                       predicate = 5; break; // NLT
+      case TR::fcmpgtu: case TR::dcmpgtu:                       predicate = 6; break; // NLE
+      case TR::fcmpleu: case TR::dcmpleu: swapOperands = true;  predicate = 5; break; // NLT
+      case TR::fcmpltu: case TR::dcmpltu: swapOperands = true;  predicate = 6; break; // NLE
+      default:
+         return false;
+      }
+   return true;
+   }
+
+// fternary and dternary select without branching: a mask of all ones or all
+// zeros is computed from the condition and the result is
+// (maskValue & mask) | (otherValue & ~mask).  When the condition is a float
+// or double compare of the same precision CMPSS/CMPSD computes the mask
+// directly; otherwise it comes from the integer condition.
+//
+TR::Register *OMR::X86::TreeEvaluator::fpTernaryEvaluator(TR::Node *node, TR::CodeGenerator *cg)
+   {
+   TR_ASSERT(cg->useSSEForSingleAndDoublePrecision(), "fpTernaryEvaluator requires SSE");
+
+   TR::Node *condition = node->getChild(0);
+   TR::Node *trueVal   = node->getChild(1);
+   TR::Node *falseVal  = node->getChild(2);
+   bool isFloat = node->getDataType() == TR::Float;
+
+   TR::Register *mask = cg->allocateRegister(TR_FPR);
+   TR::Register *result = cg->allocateRegister(TR_FPR);
+   if (isFloat)
+      {
+      mask->setIsSinglePrecision();
+      result->setIsSinglePrecision();
+      }
+
+   uint8_t predicate;
+   bool swapOperands;
+   TR::Node *maskVal, *otherVal;
+   if (!condition->getRegister() &&
+       condition->getReferenceCount() == 1 &&
+       getFPComparePredicate(condition->getOpCodeValue(), predicate, swapOperands) &&
+       condition->getFirstChild()->getDataType() == node->getDataType())
+      {
+      // mask = condition ? ~0 : 0
+      TR::Register *a = cg->evaluate(condition->getChild(swapOperands ? 1 : 0));
+      TR::Register *b = cg->evaluate(condition->getChild(swapOperands ? 0 : 1));
+      generateRegRegInstruction(MOVDQURegReg, node, mask, a, cg);
+      generateRegRegImmInstruction(isFloat ? CMPSSRegRegImm1 : CMPSDRegRegImm1, node, mask, b, predicate, cg);
+      cg->decReferenceCount(condition->getFirstChild());
+      cg->decReferenceCount(condition->getSecondChild());
+      maskVal = trueVal;
+      otherVal = falseVal;
+      }
+   else
+      {
+      // mask = condition ? 0 : ~0, as CMP sets the carry flag only for a zero condition
+      TR::Register *condReg = cg->evaluate(condition);
+      TR::Register *tmp = cg->allocateRegister();
+      generateRegImmInstruction(CMP4RegImms, node, condReg, 1, cg);
+      generateRegRegInstruction(SBB4RegReg, node, tmp, tmp, cg);
+      generateRegRegInstruction(MOVDRegReg4, node, mask, tmp, cg);
+      generateRegRegImmInstruction(PSHUFDRegRegImm1, node, mask, mask, 0, cg);
+      cg->stopUsingRegister(tmp);
+      maskVal = falseVal;
+      otherVal = trueVal;
+      }
+
+   TR::Register *maskValReg = cg->evaluate(maskVal);
+   TR::Register *otherValReg = cg->evaluate(otherVal);
+
+   generateRegRegInstruction(MOVDQURegReg, node, result, maskValReg, cg);
+   generateRegRegInstruction(PANDRegReg, node, result, mask, cg);
+   generateRegRegInstruction(PANDNRegReg, node, mask, otherValReg, cg);
+   generateRegRegInstruction(PORRegReg, node, result, mask, cg);
+   cg->stopUsingRegister(mask);
+
+   node->setRegister(result);
+   cg->decReferenceCount(condition);
+   cg->decReferenceCount(trueVal);
+   cg->decReferenceCount(falseVal);
+   return result;
+   }
+
+// return true if mul node is marked appropriately and not shared.
+//
+static bool isFPStrictMul(TR::Node *node, TR::CodeGenerator *cg)
+   {
+   if (!node->getOpCode().isMul() ||
+       !node->isFPStrictCompliant() ||
+       node->getRegister())
+      return false;
+
+   if (node->getReferenceCount() < 2)
+      return true;
+
+   node->setIsFPStrictCompliant(false); // need to set this otherwise children get incorrectly bumped
+   return false;
+   }
+
+static bool canGenerateFusedMultiplyAdd(TR::Node *node, TR::CodeGenerator *cg)
+   {
+   if (!cg->supportsFusedMultiplyAdd() || !cg->useSSEForSingleAndDoublePrecision())
+      return false;
+
+   return (isFPStrictMul(node->getFirstChild(), cg) || isFPStrictMul(node->getSecondChild(), cg)) &&
+          performTransformation(cg->comp(), "O^O Changing [%p] to fused multiply add\n", node);
+   }
+
+/** Generate a fused multiply add from the tree (A * B) + C, where node is the + node
+ * and one of its children the * subtree.
+ */
+static TR::Register *generateFusedMultiplyAdd(TR::Node *node, TR::CodeGenerator *cg)
+   {
+   TR::Node *mulNode = node->getFirstChild();
+   TR::Node *addChild = node->getSecondChild();
+
+   if (!isFPStrictMul(mulNode, cg))
+      {
+      addChild = node->getFirstChild();
+      mulNode = node->getSecondChild();
+      }
+
+   TR_ASSERT(mulNode->getReferenceCount() < 2, "Mul node %p reference count %d >= 2\n", mulNode, mulNode->getReferenceCount());
+   TR_ASSERT(mulNode->isFPStrictCompliant(), "Mul node %p is not fpStrict Compliant\n", mulNode);
+
+   TR::Register *aReg = cg->evaluate(mulNode->getFirstChild());
+   TR::Register *bReg = cg->evaluate(mulNode->getSecondChild());
+   TR::Register *cReg = cg->evaluate(addChild);
+
+   TR::Register *result = cg->allocateRegister(TR_FPR);
+   if (node->getDataType() == TR::Float)
+      result->setIsSinglePrecision();
+
+   // result = a * b + result
+   //
+   generateRegRegInstruction(MOVDQURegReg, node, result, cReg, cg);
+   generateRegRegRegInstruction(node->getDataType() == TR::Float ? VFMADD231SSRegRegReg : VFMADD231SDRegRegReg, node, result, aReg, bReg, cg);
+
+   node->setRegister(result);
+   cg->decReferenceCount(mulNode->getFirstChild());
+   cg->decReferenceCount(mulNode->getSecondChild());
+   cg->decReferenceCount(mulNode);
+   cg->decReferenceCount(addChild);
+   return result;
+   }
+
 TR::Register *OMR::X86::TreeEvaluator::faddEvaluator(TR::Node *node, TR::CodeGenerator *cg)
    {
+   if (canGenerateFusedMultiplyAdd(node, cg))
+      return generateFusedMultiplyAdd(node, cg);
    return TR::TreeEvaluator::fpBinaryArithmeticEvaluator(node, true, cg);
    }
 
 TR::Register *OMR::X86::TreeEvaluator::daddEvaluator(TR::Node *node, TR::CodeGenerator *cg)
    {
+   if (canGenerateFusedMultiplyAdd(node, cg))
+      return generateFusedMultiplyAdd(node, cg);
    return TR::TreeEvaluator::fpBinaryArithmeticEvaluator(node, false, cg);
    }
 
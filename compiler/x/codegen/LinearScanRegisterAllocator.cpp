@@ -0,0 +1,657 @@
+/*******************************************************************************
+ * Copyright (c) 2000, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "x/codegen/LinearScanRegisterAllocator.hpp"
+
+#include <algorithm>
+#include <stdint.h>
+#include <utility>
+#include "codegen/BackingStore.hpp"
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/Instruction.hpp"
+#include "codegen/Linkage.hpp"
+#include "codegen/Machine.hpp"
+#include "codegen/MemoryReference.hpp"
+#include "codegen/RealRegister.hpp"
+#include "codegen/Register.hpp"
+#include "codegen/RegisterDependency.hpp"
+#include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "ras/Debug.hpp"
+#include "codegen/X86Instruction.hpp"
+#include "x/codegen/X86Ops.hpp"
+
+// Each instruction takes two positions: its uses and pre-conditions sit on
+// the first, and the registers it defines and its post-conditions on the
+// second.
+//
+#define USE_POSITION(p) (p)
+#define DEF_POSITION(p) ((p) + 1)
+
+// Spill code is only inserted this many times; the last scan only picks
+// registers.
+//
+#define MAX_SPILL_ROUNDS 2
+
+TR_X86LinearScanRegisterAllocator::TR_X86LinearScanRegisterAllocator(TR::CodeGenerator *cg, TR::Region &region)
+   : _cg(cg),
+     _region(region),
+     _intervals(region),
+     _intervalOfRegister(region),
+     _spillSlots(region),
+     _sharedMemoryReferences(region),
+     _numAllocatableRegisters(0),
+     _firstSpillTemp(cg->getRegisterArray().size()),
+     _trace(cg->getTraceRAOption(TR_TraceRALinearScan))
+   {
+   TR::Machine *machine = cg->machine();
+
+   for (int32_t r = TR::RealRegister::FirstGPR; r <= TR::RealRegister::LastAssignableGPR; r++)
+      _fixedUses[r] = new (region) FixedUses(region);
+
+   // Volatile registers first, so that the preserved registers that have to be
+   // saved in the prologue are only used under pressure
+   //
+   for (int32_t preserved = 0; preserved <= 1; preserved++)
+      {
+      for (int32_t r = TR::RealRegister::FirstGPR; r <= TR::RealRegister::LastAssignableGPR; r++)
+         {
+         TR::RealRegister::RegNum regNum = (TR::RealRegister::RegNum)r;
+         if (machine->getRealRegister(regNum)->getState() == TR::RealRegister::Locked)
+            continue;
+         if ((cg->getProperties().isPreservedRegister(regNum) != 0) == (preserved != 0))
+            _allocationOrder[_numAllocatableRegisters++] = regNum;
+         }
+      }
+   }
+
+void TR_X86LinearScanRegisterAllocator::perform()
+   {
+   TR::Compilation *comp = cg()->comp();
+
+   // Out of line sections and the non-linear assigner both walk the
+   // instruction stream in an order the intervals do not follow.
+   //
+   if (!TR::Compiler->target.is64Bit() ||
+       !cg()->getOutlinedInstructionsList().empty() ||
+       cg()->getUseNonLinearRegisterAssigner())
+      return;
+
+   findSharedMemoryReferences();
+
+   for (int32_t round = 0; ; round++)
+      {
+      if (!buildIntervals())
+         {
+         if (_trace)
+            traceMsg(comp, "Linear scan: register pair found, no registers picked\n");
+         return;
+         }
+
+      int32_t numSpilled = scan();
+
+      if (_trace)
+         traceMsg(comp, "Linear scan round %d: %d intervals, %d spilled\n", round, (int32_t)_intervals.size(), numSpilled);
+
+      if (numSpilled == 0 || round == MAX_SPILL_ROUNDS)
+         break;
+
+      insertSpillCode();
+      }
+
+   for (auto it = _intervals.begin(); it != _intervals.end(); ++it)
+      {
+      if (_trace)
+         traceMsg(comp, "   %s [%d, %d]%s -> %s\n",
+                  comp->getDebug()->getName(it->_virtual), it->_start, it->_end,
+                  it->_spillable ? "" : " unspillable",
+                  it->_assigned == TR::RealRegister::NoReg ? "none" : comp->getDebug()->getName(cg()->machine()->getRealRegister(it->_assigned)));
+
+      if (it->_assigned != TR::RealRegister::NoReg)
+         it->_virtual->setLinearScanRegister(it->_assigned);
+      }
+   }
+
+// A memory reference reached from more than one instruction cannot have its
+// registers replaced for just one of them.
+//
+void TR_X86LinearScanRegisterAllocator::findSharedMemoryReferences()
+   {
+   TR::vector<TR::MemoryReference *, TR::Region &> memoryReferences(_region);
+
+   for (TR::Instruction *instr = cg()->getFirstInstruction(); instr; instr = instr->getNext())
+      {
+      if (instr->getMemoryReference())
+         memoryReferences.push_back(instr->getMemoryReference());
+      }
+
+   std::sort(memoryReferences.begin(), memoryReferences.end());
+   for (size_t i = 1; i < memoryReferences.size(); i++)
+      {
+      if (memoryReferences[i] == memoryReferences[i - 1] &&
+          (_sharedMemoryReferences.empty() || _sharedMemoryReferences.back() != memoryReferences[i]))
+         _sharedMemoryReferences.push_back(memoryReferences[i]);
+      }
+   }
+
+bool TR_X86LinearScanRegisterAllocator::isRewritable(TR::Instruction *instr)
+   {
+   if (instr->getPrev() == NULL)
+      return false;
+
+   switch (instr->getKind())
+      {
+      case TR::Instruction::IsReg:
+      case TR::Instruction::IsRegReg:
+      case TR::Instruction::IsRegRegImm:
+      case TR::Instruction::IsRegRegReg:
+      case TR::Instruction::IsRegImm:
+      case TR::Instruction::IsRegImmSym:
+      case TR::Instruction::IsRegImm64:
+      case TR::Instruction::IsRegImm64Sym:
+      case TR::Instruction::IsRegMem:
+      case TR::Instruction::IsRegMemImm:
+      case TR::Instruction::IsRegRegMem:
+      case TR::Instruction::IsMem:
+      case TR::Instruction::IsMemTable:
+      case TR::Instruction::IsCallMem:
+      case TR::Instruction::IsMemImm:
+      case TR::Instruction::IsMemImmSym:
+      case TR::Instruction::IsMemImmSnippet:
+      case TR::Instruction::IsMemReg:
+      case TR::Instruction::IsMemRegImm:
+         break;
+      default:
+         return false;
+      }
+
+   TR::MemoryReference *mr = instr->getMemoryReference();
+   return mr == NULL || !std::binary_search(_sharedMemoryReferences.begin(), _sharedMemoryReferences.end(), mr);
+   }
+
+bool TR_X86LinearScanRegisterAllocator::addReference(TR::Register *reg, int32_t position, bool spillable)
+   {
+   if (reg == NULL)
+      return true;
+
+   if (reg->getRegisterPair())
+      return false;
+
+   if (reg->getKind() != TR_GPR || reg->getRealRegister())
+      return true;
+
+   // Registers missing from the register array cannot be indexed, and get no
+   // interval; the local register assigner places them on its own.
+   //
+   TR_Array<TR::Register *> &registers = cg()->getRegisterArray();
+   uint32_t index = reg->getIndex();
+   if (index >= registers.size() || registers[index] != reg)
+      return true;
+
+   int32_t id = _intervalOfRegister[index];
+   if (id < 0)
+      {
+      Interval interval;
+      interval._virtual = reg;
+      interval._start = position;
+      interval._end = position;
+      interval._references = 0;
+      interval._hint = TR::RealRegister::NoReg;
+      interval._assigned = TR::RealRegister::NoReg;
+      interval._spillable = index < _firstSpillTemp &&
+                            !reg->containsCollectedReference() &&
+                            !reg->containsInternalPointer() &&
+                            !reg->isPlaceholderReg() &&
+                            !reg->getRematerializationInfo() &&
+                            !reg->isDiscardable() &&
+                            !reg->getMemRef() &&
+                            !reg->getBackingStorage();
+      interval._rematerializable = reg->getRematerializationInfo() != NULL;
+      interval._spilled = false;
+
+      id = (int32_t)_intervals.size();
+      _intervalOfRegister[index] = id;
+      _intervals.push_back(interval);
+      }
+
+   Interval &interval = _intervals[id];
+   interval._start = std::min(interval._start, position);
+   interval._end = std::max(interval._end, position);
+   interval._references++;
+   if (!spillable)
+      interval._spillable = false;
+
+   return true;
+   }
+
+void TR_X86LinearScanRegisterAllocator::addFixedUse(TR::Register *reg, TR::RealRegister::RegNum realReg, int32_t position)
+   {
+   if (realReg < TR::RealRegister::FirstGPR || realReg > TR::RealRegister::LastAssignableGPR)
+      return;
+
+   int32_t id = -1;
+   if (reg && reg->getKind() == TR_GPR && !reg->getRealRegister() && reg->getIndex() < _intervalOfRegister.size())
+      id = _intervalOfRegister[reg->getIndex()];
+
+   FixedUse use;
+   use._position = position;
+   use._interval = id;
+   _fixedUses[realReg]->push_back(use);
+
+   if (id >= 0 && _intervals[id]._hint == TR::RealRegister::NoReg)
+      _intervals[id]._hint = realReg;
+   }
+
+bool TR_X86LinearScanRegisterAllocator::buildIntervals()
+   {
+   TR_Array<TR::Register *> &registers = cg()->getRegisterArray();
+
+   _intervals.clear();
+   _intervalOfRegister.assign(registers.size(), -1);
+   for (int32_t r = TR::RealRegister::FirstGPR; r <= TR::RealRegister::LastAssignableGPR; r++)
+      _fixedUses[r]->clear();
+
+   int32_t position = 0;
+   for (TR::Instruction *instr = cg()->getFirstInstruction(); instr; instr = instr->getNext(), position += 2)
+      {
+      bool rewritable = isRewritable(instr);
+      TR::Register *target = instr->getTargetRegister();
+
+      if (target)
+         {
+         TR_X86OpCode &opCode = instr->getOpCode();
+         int32_t targetPosition = (opCode.modifiesTarget() && !opCode.usesTarget()) ? DEF_POSITION(position) : USE_POSITION(position);
+         if (!addReference(target, targetPosition, rewritable))
+            return false;
+         }
+
+      if (!addReference(instr->getSourceRegister(), USE_POSITION(position), rewritable) ||
+          !addReference(instr->getSource2ndRegister(), USE_POSITION(position), rewritable))
+         return false;
+
+      TR::MemoryReference *mr = instr->getMemoryReference();
+      if (mr &&
+          (!addReference(mr->getBaseRegister(), USE_POSITION(position), rewritable) ||
+           !addReference(mr->getIndexRegister(), USE_POSITION(position), rewritable)))
+         return false;
+
+      // Dependencies tie a virtual to a real register, and are never rewritten.
+      // Register associations are only a hint to the local register assigner.
+      //
+      TR::RegisterDependencyConditions *deps = instr->getDependencyConditions();
+      if (deps && instr->getOpCodeValue() != ASSOCREGS)
+         {
+         for (int32_t i = 0; i < deps->getNumPreConditions(); i++)
+            {
+            TR::RegisterDependency *dep = deps->getPreConditions()->getRegisterDependency(i);
+            if (!addReference(dep->getRegister(), USE_POSITION(position), false))
+               return false;
+            addFixedUse(dep->getRegister(), dep->getRealRegister(), USE_POSITION(position));
+            }
+
+         for (int32_t i = 0; i < deps->getNumPostConditions(); i++)
+            {
+            TR::RegisterDependency *dep = deps->getPostConditions()->getRegisterDependency(i);
+            if (!addReference(dep->getRegister(), DEF_POSITION(position), false))
+               return false;
+            addFixedUse(dep->getRegister(), dep->getRealRegister(), DEF_POSITION(position));
+            }
+         }
+      }
+
+   // A virtual referenced somewhere outside the instruction stream cannot be
+   // rewritten safely
+   //
+   for (auto it = _intervals.begin(); it != _intervals.end(); ++it)
+      {
+      if (it->_references != it->_virtual->getTotalUseCount())
+         it->_spillable = false;
+
+      // A virtual in a dependency has to be in that register anyway
+      //
+      if (it->_hint != TR::RealRegister::NoReg)
+         it->_rematerializable = false;
+      }
+
+   return true;
+   }
+
+// Whether a dependency puts some other virtual in realReg while the interval
+// is live
+//
+bool TR_X86LinearScanRegisterAllocator::isFixedElsewhere(TR::RealRegister::RegNum realReg, int32_t interval)
+   {
+   FixedUses &uses = *_fixedUses[realReg];
+   Interval &current = _intervals[interval];
+
+   FixedUse key;
+   key._position = current._start;
+   key._interval = -1;
+   auto it = std::lower_bound(uses.begin(), uses.end(), key);
+
+   for (; it != uses.end() && it->_position <= current._end; ++it)
+      {
+      if (it->_interval != interval)
+         return true;
+      }
+
+   return false;
+   }
+
+TR::RealRegister::RegNum TR_X86LinearScanRegisterAllocator::pickRegister(int32_t interval, uint32_t freeRegisters)
+   {
+   // A virtual that a dependency puts in a real register only ever gets that
+   // one, so that the local register assigner does not have to move it there
+   //
+   TR::RealRegister::RegNum hint = _intervals[interval]._hint;
+   if (hint != TR::RealRegister::NoReg)
+      return ((freeRegisters & (1 << hint)) && !isFixedElsewhere(hint, interval)) ? hint : TR::RealRegister::NoReg;
+
+   for (int32_t i = 0; i < _numAllocatableRegisters; i++)
+      {
+      TR::RealRegister::RegNum regNum = _allocationOrder[i];
+      if ((freeRegisters & (1 << regNum)) && !isFixedElsewhere(regNum, interval))
+         return regNum;
+      }
+
+   return TR::RealRegister::NoReg;
+   }
+
+// A rematerializable interval costs nothing to give up, since the local
+// register assigner reloads it from where it came from. Otherwise spilling an
+// interval costs a load or store at each of its references and frees a
+// register over its whole length, so the interval with the fewest references
+// for its length is the cheapest to spill.
+//
+bool TR_X86LinearScanRegisterAllocator::isCheaperToEvict(int32_t interval, int32_t other)
+   {
+   Interval &first = _intervals[interval];
+   Interval &second = _intervals[other];
+
+   if (first._rematerializable != second._rematerializable)
+      return first._rematerializable;
+
+   if (first._rematerializable)
+      return first._end > second._end;
+
+   return (int64_t)first._references * (second._end - second._start + 1) <
+          (int64_t)second._references * (first._end - first._start + 1);
+   }
+
+// No register is free for the interval: evict whichever of it and the active
+// intervals holding a register it could use is cheapest to give up
+//
+void TR_X86LinearScanRegisterAllocator::spillAtInterval(int32_t interval, TR::vector<int32_t, TR::Region &> &active)
+   {
+   Interval &current = _intervals[interval];
+   if (current._rematerializable)
+      return;
+
+   int32_t victim = -1;
+   for (size_t i = 0; i < active.size(); i++)
+      {
+      Interval &candidate = _intervals[active[i]];
+      if (!(candidate._spillable || candidate._rematerializable) ||
+          (current._hint != TR::RealRegister::NoReg && candidate._assigned != current._hint) ||
+          (current._spillable && !isCheaperToEvict(active[i], interval)) ||
+          (victim >= 0 && !isCheaperToEvict(active[i], active[victim])) ||
+          isFixedElsewhere(candidate._assigned, interval))
+         continue;
+
+      victim = (int32_t)i;
+      }
+
+   if (victim >= 0)
+      {
+      Interval &evicted = _intervals[active[victim]];
+      current._assigned = evicted._assigned;
+      evicted._assigned = TR::RealRegister::NoReg;
+      evicted._spilled = !evicted._rematerializable;
+      active[victim] = interval;
+      }
+   else if (current._spillable)
+      {
+      current._spilled = true;
+      }
+
+   // Otherwise the interval keeps no register, and the local register assigner
+   // finds one for it
+   }
+
+int32_t TR_X86LinearScanRegisterAllocator::scan()
+   {
+   TR::vector<std::pair<int32_t, int32_t>, TR::Region &> order(_region);
+   TR::vector<int32_t, TR::Region &> active(_region);
+
+   for (int32_t i = 0; i < (int32_t)_intervals.size(); i++)
+      order.push_back(std::make_pair(_intervals[i]._start, i));
+
+   std::sort(order.begin(), order.end());
+
+   uint32_t freeRegisters = 0;
+   for (int32_t i = 0; i < _numAllocatableRegisters; i++)
+      freeRegisters |= 1 << _allocationOrder[i];
+
+   for (auto it = order.begin(); it != order.end(); ++it)
+      {
+      int32_t id = it->second;
+      Interval &current = _intervals[id];
+
+      for (size_t i = 0; i < active.size(); )
+         {
+         if (_intervals[active[i]]._end < current._start)
+            {
+            freeRegisters |= 1 << _intervals[active[i]]._assigned;
+            active[i] = active.back();
+            active.pop_back();
+            }
+         else
+            {
+            i++;
+            }
+         }
+
+      TR::RealRegister::RegNum regNum = pickRegister(id, freeRegisters);
+      if (regNum != TR::RealRegister::NoReg)
+         {
+         current._assigned = regNum;
+         freeRegisters &= ~(1 << regNum);
+         active.push_back(id);
+         }
+      else
+         {
+         spillAtInterval(id, active);
+         }
+      }
+
+   int32_t numSpilled = 0;
+   for (auto it = _intervals.begin(); it != _intervals.end(); ++it)
+      {
+      if (it->_spilled)
+         numSpilled++;
+      }
+
+   return numSpilled;
+   }
+
+int32_t TR_X86LinearScanRegisterAllocator::replaceRegister(TR::Instruction *instr, TR::Register *virtReg, TR::Register *newReg, bool &onlyTarget)
+   {
+   int32_t replaced = 0;
+   bool targetReplaced = false;
+
+   switch (instr->getKind())
+      {
+      case TR::Instruction::IsRegRegReg:
+      case TR::Instruction::IsRegRegMem:
+         if (instr->getSource2ndRegister() == virtReg)
+            {
+            if (instr->getKind() == TR::Instruction::IsRegRegReg)
+               ((TR::X86RegRegRegInstruction *)instr)->setSource2ndRegister(newReg);
+            else
+               ((TR::X86RegRegMemInstruction *)instr)->setSource2ndRegister(newReg);
+            replaced++;
+            }
+         break;
+      default:
+         break;
+      }
+
+   switch (instr->getKind())
+      {
+      case TR::Instruction::IsRegReg:
+      case TR::Instruction::IsRegRegImm:
+      case TR::Instruction::IsRegRegReg:
+         if (instr->getSourceRegister() == virtReg)
+            {
+            ((TR::X86RegRegInstruction *)instr)->setSourceRegister(newReg);
+            replaced++;
+            }
+         // Fall through
+      case TR::Instruction::IsReg:
+      case TR::Instruction::IsRegImm:
+      case TR::Instruction::IsRegImmSym:
+      case TR::Instruction::IsRegImm64:
+      case TR::Instruction::IsRegImm64Sym:
+      case TR::Instruction::IsRegMem:
+      case TR::Instruction::IsRegMemImm:
+      case TR::Instruction::IsRegRegMem:
+         if (instr->getTargetRegister() == virtReg)
+            {
+            ((TR::X86RegInstruction *)instr)->setTargetRegister(newReg);
+            targetReplaced = true;
+            replaced++;
+            }
+         break;
+      case TR::Instruction::IsMemReg:
+      case TR::Instruction::IsMemRegImm:
+         if (instr->getSourceRegister() == virtReg)
+            {
+            ((TR::X86MemRegInstruction *)instr)->setSourceRegister(newReg);
+            replaced++;
+            }
+         break;
+      default:
+         break;
+      }
+
+   int32_t replacedOperands = replaced;
+
+   TR::MemoryReference *mr = instr->getMemoryReference();
+   if (mr)
+      {
+      if (mr->getBaseRegister() == virtReg)
+         {
+         mr->setBaseRegister(newReg);
+         replaced++;
+         }
+      if (mr->getIndexRegister() == virtReg)
+         {
+         mr->setIndexRegister(newReg);
+         replaced++;
+         }
+      }
+
+   onlyTarget = targetReplaced && replaced == 1 && replacedOperands == 1;
+   return replaced;
+   }
+
+// Give every spilled virtual a spill slot, and replace each of its references
+// with a new virtual that is reloaded from the slot before the instruction and
+// stored back to it after a definition
+//
+void TR_X86LinearScanRegisterAllocator::insertSpillCode()
+   {
+   TR::Compilation *comp = cg()->comp();
+
+   _spillSlots.assign(_intervals.size(), NULL);
+   for (size_t i = 0; i < _intervals.size(); i++)
+      {
+      if (_intervals[i]._spilled)
+         _spillSlots[i] = cg()->allocateSpill(8, false, NULL);
+      }
+
+   TR::Instruction *next;
+   for (TR::Instruction *instr = cg()->getFirstInstruction(); instr; instr = next)
+      {
+      next = instr->getNext();
+
+      TR::Register *candidates[5];
+      int32_t numCandidates = 0;
+      candidates[numCandidates++] = instr->getTargetRegister();
+      candidates[numCandidates++] = instr->getSourceRegister();
+      candidates[numCandidates++] = instr->getSource2ndRegister();
+      if (instr->getMemoryReference())
+         {
+         candidates[numCandidates++] = instr->getMemoryReference()->getBaseRegister();
+         candidates[numCandidates++] = instr->getMemoryReference()->getIndexRegister();
+         }
+
+      for (int32_t c = 0; c < numCandidates; c++)
+         {
+         TR::Register *virtReg = candidates[c];
+         if (virtReg == NULL ||
+             virtReg->getKind() != TR_GPR ||
+             virtReg->getRealRegister() ||
+             virtReg->getIndex() >= _intervalOfRegister.size() ||
+             _intervalOfRegister[virtReg->getIndex()] < 0)
+            continue;
+
+         int32_t id = _intervalOfRegister[virtReg->getIndex()];
+         if (!_intervals[id]._spilled ||
+             std::find(candidates, candidates + c, virtReg) != candidates + c)
+            continue;
+
+         TR::Register *newReg = cg()->allocateRegister(TR_GPR);
+         cg()->stopUsingRegister(newReg);
+
+         bool onlyTarget;
+         int32_t replaced = replaceRegister(instr, virtReg, newReg, onlyTarget);
+         for (int32_t i = 0; i < replaced; i++)
+            instr->useRegister(newReg);
+         virtReg->decTotalUseCount(replaced);
+
+         TR_X86OpCode &opCode = instr->getOpCode();
+         bool fullDefinition = onlyTarget &&
+                               opCode.modifiesTarget() &&
+                               !opCode.usesTarget() &&
+                               !opCode.testsSomeFlag() &&
+                               (opCode.clearsUpperBits() || opCode.setsUpperBits());
+
+         TR_BackingStore *location = _spillSlots[id];
+         if (!fullDefinition)
+            generateRegMemInstruction(instr->getPrev(), LRegMem(), newReg,
+                                      generateX86MemoryReference(location->getSymbolReference(), cg()), cg());
+
+         if (instr->defsRegister(newReg))
+            generateMemRegInstruction(instr, SMemReg(),
+                                      generateX86MemoryReference(location->getSymbolReference(), cg()), newReg, cg());
+
+         newReg->setFutureUseCount(newReg->getTotalUseCount());
+         virtReg->setFutureUseCount(virtReg->getTotalUseCount());
+
+         if (_trace)
+            traceMsg(comp, "   spilled %s in %s replaced by %s\n",
+                     comp->getDebug()->getName(virtReg), comp->getDebug()->getName(instr), comp->getDebug()->getName(newReg));
+         }
+      }
+   }
@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * Copyright (c) 2000, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef X86_LINEARSCANREGISTERALLOCATOR_INCL
+#define X86_LINEARSCANREGISTERALLOCATOR_INCL
+
+#include <stdint.h>
+#include "codegen/RealRegister.hpp"
+#include "env/TRMemory.hpp"
+#include "infra/vector.hpp"
+
+class TR_BackingStore;
+namespace TR { class CodeGenerator; }
+namespace TR { class Instruction; }
+namespace TR { class MemoryReference; }
+namespace TR { class Register; }
+
+/**
+ * Linear scan allocation of the GPR virtual registers, run over the whole
+ * instruction stream before the backward local register assigner.
+ *
+ * Each virtual gets one live interval, from its first to its last reference
+ * in the instruction stream. Register dependencies pin a real register at a
+ * single position, and a virtual named in one is only given that register;
+ * virtuals in dependencies are never spilled here. The intervals are scanned
+ * in order of their start. When no real register is free, a rematerializable
+ * interval is given up first, and otherwise the interval with the fewest
+ * references for its length is spilled. A spilled virtual is replaced by a
+ * fresh virtual at each of its references, reloaded from a spill slot before
+ * the reference and stored back after a definition, and the scan is run again
+ * to place the new virtuals.
+ *
+ * The real register picked for each virtual is left in the virtual, and
+ * OMR::X86::Machine::findBestFreeGPRegister takes it whenever it is free. The
+ * local register assigner still makes the final assignment, so it moves
+ * values for register dependencies and covers any choice the scan got wrong.
+ */
+class TR_X86LinearScanRegisterAllocator
+   {
+   public:
+
+   TR_X86LinearScanRegisterAllocator(TR::CodeGenerator *cg, TR::Region &region);
+
+   void perform();
+
+   private:
+
+   struct Interval
+      {
+      TR::Register             *_virtual;
+      int32_t                   _start;
+      int32_t                   _end;
+      int32_t                   _references;
+      TR::RealRegister::RegNum  _hint;
+      TR::RealRegister::RegNum  _assigned;
+      bool                      _spillable;
+      bool                      _rematerializable;
+      bool                      _spilled;
+      };
+
+   // A real register named by a register dependency, and the interval of the
+   // virtual that the dependency puts in it
+   //
+   struct FixedUse
+      {
+      int32_t _position;
+      int32_t _interval;
+
+      bool operator<(const FixedUse &other) const { return _position < other._position; }
+      };
+
+   typedef TR::vector<FixedUse, TR::Region &> FixedUses;
+
+   bool buildIntervals();
+   bool addReference(TR::Register *reg, int32_t position, bool spillable);
+   void addFixedUse(TR::Register *reg, TR::RealRegister::RegNum realReg, int32_t position);
+   bool isFixedElsewhere(TR::RealRegister::RegNum realReg, int32_t interval);
+   TR::RealRegister::RegNum pickRegister(int32_t interval, uint32_t freeRegisters);
+   bool isCheaperToEvict(int32_t interval, int32_t other);
+   void spillAtInterval(int32_t interval, TR::vector<int32_t, TR::Region &> &active);
+   int32_t scan();
+   void findSharedMemoryReferences();
+   void insertSpillCode();
+   int32_t replaceRegister(TR::Instruction *instr, TR::Register *virtReg, TR::Register *newReg, bool &onlyTarget);
+   bool isRewritable(TR::Instruction *instr);
+
+   TR::CodeGenerator *cg() { return _cg; }
+
+   TR::CodeGenerator                      *_cg;
+   TR::Region                             &_region;
+   TR::vector<Interval, TR::Region &>      _intervals;
+   TR::vector<int32_t, TR::Region &>       _intervalOfRegister;
+   TR::vector<TR_BackingStore *, TR::Region &> _spillSlots;
+   TR::vector<TR::MemoryReference *, TR::Region &> _sharedMemoryReferences;
+   FixedUses                              *_fixedUses[TR::RealRegister::LastAssignableGPR + 1];
+   TR::RealRegister::RegNum                _allocationOrder[TR::RealRegister::LastAssignableGPR + 1];
+   int32_t                                 _numAllocatableRegisters;
+   uint32_t                                _firstSpillTemp;
+   bool                                    _trace;
+   };
+
+#endif
@@ -65,6 +65,7 @@
 #include "env/CompilerEnv.hpp"
 #include "env/IO.hpp"
 #include "env/TRMemory.hpp"
+#include "env/StackMemoryRegion.hpp"
 #include "env/jittypes.h"
 #include "il/Block.hpp"
 #include "il/DataTypes.hpp"
@@ -84,6 +85,7 @@
 #include "infra/Assert.hpp"
 #include "infra/Bit.hpp"
 #include "infra/BitVector.hpp"
+#include "infra/Checklist.hpp"
 #include "infra/Flags.hpp"
 #include "infra/IGNode.hpp"
 #include "infra/InterferenceGraph.hpp"
@@ -94,6 +96,7 @@
 #include "ras/DebugCounter.hpp"
 #include "runtime/CodeCacheManager.hpp"
 #include "x/codegen/DataSnippet.hpp"
+#include "x/codegen/LinearScanRegisterAllocator.hpp"
 #include "x/codegen/OutlinedInstructions.hpp"
 #include "x/codegen/FPTreeEvaluator.hpp"
 #include "x/codegen/X86Instruction.hpp"
@@ -117,6 +120,7 @@ void TR_X86ProcessorInfo::initialize()
    _featureFlags.set(TR::Compiler->target.cpu.getX86ProcessorFeatureFlags());
    _featureFlags2.set(TR::Compiler->target.cpu.getX86ProcessorFeatureFlags2());
    _featureFlags8.set(TR::Compiler->target.cpu.getX86ProcessorFeatureFlags8());
+   _extendedFeatureFlags.set(TR::Compiler->target.cpu.getX86ProcessorExtendedFeatureFlags());
 
    // Determine the processor vendor.
    //
@@ -548,6 +552,68 @@ OMR::X86::CodeGenerator::createLinkage(TR_LinkageConventions lc)
    return linkage;
    }
 
+static TR::Node *
+findOverflowBranchOperation(TR::Node *branch, TR::Node *node, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return NULL;
+   visited.add(node);
+
+   if (node->getNumChildren() == 2 && TR::TreeEvaluator::isOverflowBranchOperation(branch, node))
+      return node;
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      TR::Node *operation = findOverflowBranchOperation(branch, node->getChild(i), visited);
+      if (operation)
+         return operation;
+      }
+   return NULL;
+   }
+
+void
+OMR::X86::CodeGenerator::lowerTreesPostTreeTopVisit(TR::TreeTop *tt, vcount_t visitCount)
+   {
+   OMR::CodeGenerator::lowerTreesPostTreeTopVisit(tt, visitCount);
+
+   TR::Node *node = tt->getNode();
+   if (!node->getOpCode().isIf())
+      return;
+
+   // Have the add, subtract or multiply tested by an overflow branch set the
+   // overflow flag, so the branch need not repeat it (see ifxcmpoEvaluator)
+   //
+   TR::Node *operation = TR::TreeEvaluator::getOverflowBranchOperation(node, tt);
+
+   // The optimizer may have sunk the checked add or subtract into the fall
+   // through block. If that block extends this one, anchor the operation
+   // ahead of the branch: its children are already evaluated by the branch.
+   //
+   TR::TreeTop *exitTree = tt->getNextTreeTop();
+   if (!operation &&
+       exitTree && exitTree->getNode()->getOpCodeValue() == TR::BBEnd &&
+       exitTree->getNextTreeTop() &&
+       exitTree->getNextTreeTop()->getNode()->getBlock()->isExtensionOfPreviousBlock())
+      {
+      TR::NodeChecklist visited(self()->comp());
+      TR::Block *fallThrough = exitTree->getNextTreeTop()->getNode()->getBlock();
+      for (TR::TreeTop *cursor = fallThrough->getFirstRealTreeTop();
+           !operation && cursor != fallThrough->getExit();
+           cursor = cursor->getNextTreeTop())
+         operation = findOverflowBranchOperation(node, cursor->getNode(), visited);
+
+      if (operation &&
+          performTransformation(self()->comp(), "O^O CODE GENERATION: Anchoring overflow checked operation %s [%p] before branch [%p]\n",
+                                operation->getOpCode().getName(), operation, node))
+         TR::TreeTop::create(self()->comp(), tt->getPrevTreeTop(), TR::Node::create(TR::treetop, 1, operation));
+      else
+         operation = NULL;
+      }
+
+   if (operation && !(TR::Compiler->target.is32Bit() && operation->getType().isInt64()))
+      operation->setNodeRequiresConditionCodes(true);
+   }
+
 void
 OMR::X86::CodeGenerator::beginInstructionSelection()
    {
@@ -1066,6 +1132,12 @@ OMR::X86::CodeGenerator::getSupportsBitPermute()
    return true;
    }
 
+bool
+OMR::X86::CodeGenerator::getSupportsFloatingPointTernary()
+   {
+   return self()->useSSEForSingleAndDoublePrecision();
+   }
+
 bool
 OMR::X86::CodeGenerator::supportsMergingGuards()
    {
@@ -1598,6 +1670,13 @@ void OMR::X86::CodeGenerator::doRegisterAssignment(TR_RegisterKinds kindsToAssig
       if (self()->enableRegisterAssociations())
          self()->machine()->setGPRWeightsFromAssociations();
 
+      if ((kindsToAssign & TR_GPR_Mask) && self()->comp()->getOption(TR_EnableLinearScanRA))
+         {
+         LexicalTimer pt3("linear scan register allocation", self()->comp()->phaseTimer());
+         TR::StackMemoryRegion stackMemoryRegion(*self()->trMemory());
+         TR_X86LinearScanRegisterAllocator(self(), stackMemoryRegion).perform();
+         }
+
       self()->doBackwardsRegisterAssignment(kindsToAssign, self()->getAppendInstruction());
       }
    }
@@ -167,10 +167,12 @@ struct TR_X86ProcessorInfo
    bool supportsCLMUL()                    {return testFeatureFlags2(TR_CLMUL);}
    bool supportsAESNI()                    {return testFeatureFlags2(TR_AESNI);}
    bool supportsPOPCNT()                   {return testFeatureFlags2(TR_POPCNT);}
+   bool supportsLZCNT()                    {return testExtendedFeatureFlags(TR_ABM);}
    bool supportsSelfSnoop()                {return testFeatureFlags(TR_SelfSnoop);}
    bool supportsTM()                       {return testFeatureFlags8(TR_RTM);}
    bool supportsHyperThreading()           {return testFeatureFlags(TR_HyperThreading);}
    bool supportsHLE()                      {return testFeatureFlags8(TR_HLE);}
+   bool supportsERMSB()                    {return testFeatureFlags8(TR_ERMSB);}
    bool hasThermalMonitor()                {return testFeatureFlags(TR_ThermalMonitor);}
 
    bool supportsMFence()                   {return testFeatureFlags(TR_SSE2);}
@@ -218,6 +220,7 @@ private:
    flags32_t  _featureFlags;   // cache feature flags for re-use
    flags32_t  _featureFlags2;  // cache feature flags 2 for re-use
    flags32_t  _featureFlags8;  // cache feature flags 8 for re-use
+   flags32_t  _extendedFeatureFlags;  // cache extended feature flags for re-use
 
    uint32_t _processorDescription;
 
@@ -234,10 +237,12 @@ private:
     *                 mask so that the processor validation code also accounts for
     *                 the use of said feature.
     *
-    * @param flag     Either _featureFlags, _featureFlags2, or _featureFlags8
+    * @param flag     Either _featureFlags, _featureFlags2, _featureFlags8, or
+    *                 _extendedFeatureFlags
     * @param feature  The feature being tested for
     * @param mask     The mask returned by either getFeatureFlagsMask(),
-    *                 getFeatureFlags2Mask(), or getFeatureFlags8Mask()
+    *                 getFeatureFlags2Mask(), getFeatureFlags8Mask(), or
+    *                 getExtendedFeatureFlagsMask()
     *
     * @return         The result of flag.testAny(feature)
     */
@@ -286,6 +291,18 @@ private:
       {
       return testFlag(_featureFlags8, feature, getFeatureFlags8Mask());
       }
+
+   /**
+    * @brief testExtendedFeatureFlags Wrapper around testFlag
+    *
+    * @param feature                  The feature being tested for
+    *
+    * @return                         The result of testFlag
+    */
+   bool testExtendedFeatureFlags(uint32_t feature)
+      {
+      return testFlag(_extendedFeatureFlags, feature, getExtendedFeatureFlagsMask());
+      }
    };
 
 enum TR_PaddingProperties
@@ -338,6 +355,7 @@ class OMR_EXTENSIBLE CodeGenerator : public OMR::CodeGenerator
    public:
 
    TR::Linkage *createLinkage(TR_LinkageConventions lc);
+   void lowerTreesPostTreeTopVisit(TR::TreeTop *tt, vcount_t visitCount);
    void beginInstructionSelection();
    void endInstructionSelection();
 
@@ -366,8 +384,15 @@ class OMR_EXTENSIBLE CodeGenerator : public OMR::CodeGenerator
 
    virtual bool getSupportsBitPermute();
 
+   virtual bool getSupportsFloatingPointTernary();
+
    bool supportsMergingGuards();
 
+   // Multiplies flagged FP strict compliant are fused into a following add
+   // with VFMADD231SD/SS
+   //
+   bool supportsFusedMultiplyAdd() {return getX86ProcessorInfo().supportsFMA();}
+
    bool supportsNonHelper(TR::SymbolReferenceTable::CommonNonhelperSymbol symbol);
 
    bool hasTMEvaluator()                       {return true;}
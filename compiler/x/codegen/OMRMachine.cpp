@@ -264,6 +264,24 @@ OMR::X86::Machine::findBestFreeGPRegister(TR::Instruction   *currentInstruction,
          }
       }
 
+   // The linear scan allocator has already checked its choice against the
+   // live ranges of the other virtuals, so take it whenever it is free.
+   //
+   TR::RealRegister::RegNum linearScanRegister = (TR::RealRegister::RegNum)virtReg->getLinearScanRegister();
+   if (linearScanRegister != TR::RealRegister::NoReg &&
+       (requestedRegSize == TR_WordReg || requestedRegSize == TR_HalfWordReg ||
+        (requestedRegSize == TR_ByteReg && linearScanRegister <= TR::RealRegister::Last8BitGPR)))
+      {
+      TR::RealRegister *candidate = _registerFile[linearScanRegister];
+      if ((candidate->getAssignedRegister() == NULL &&
+           candidate->getState() != TR::RealRegister::Blocked &&
+           candidate->getState() != TR::RealRegister::Locked) ||
+          (considerUnlatched && candidate->getState() == TR::RealRegister::Unlatched))
+         {
+         return candidate;
+         }
+      }
+
    switch (requestedRegSize)
       {
       case TR_ByteReg:
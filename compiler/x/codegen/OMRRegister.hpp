@@ -52,9 +52,9 @@ class OMR_EXTENSIBLE Register: public OMR::Register
    {
    protected:
 
-   Register(uint32_t f=0): OMR::Register(f), _memRef(NULL),_rematerializationInfo(NULL) {_liveRegisterInfo._liveRegister = NULL;}
-   Register(TR_RegisterKinds rk): OMR::Register(rk), _memRef(NULL), _rematerializationInfo(NULL) {_liveRegisterInfo._liveRegister = NULL;}
-   Register(TR_RegisterKinds rk, uint16_t ar): OMR::Register(rk, ar), _memRef(NULL), _rematerializationInfo(NULL) {_liveRegisterInfo._liveRegister = NULL;}
+   Register(uint32_t f=0): OMR::Register(f), _memRef(NULL),_rematerializationInfo(NULL), _linearScanRegister(0) {_liveRegisterInfo._liveRegister = NULL;}
+   Register(TR_RegisterKinds rk): OMR::Register(rk), _memRef(NULL), _rematerializationInfo(NULL), _linearScanRegister(0) {_liveRegisterInfo._liveRegister = NULL;}
+   Register(TR_RegisterKinds rk, uint16_t ar): OMR::Register(rk, ar), _memRef(NULL), _rematerializationInfo(NULL), _linearScanRegister(0) {_liveRegisterInfo._liveRegister = NULL;}
 
 
    public:
@@ -74,6 +74,9 @@ class OMR_EXTENSIBLE Register: public OMR::Register
    uint32_t getInterference()           {return _liveRegisterInfo._interference;}
    uint32_t setInterference(uint32_t i) {return (_liveRegisterInfo._interference = i);}
 
+   uint32_t getLinearScanRegister()           {return _linearScanRegister;}
+   uint32_t setLinearScanRegister(uint32_t r) {return (_linearScanRegister = r);}
+
 
    /*
     * Method for manipulating flags
@@ -139,6 +142,10 @@ class OMR_EXTENSIBLE Register: public OMR::Register
    // Both x and z have this, but power doesn't, so duplicating in both x and z
    TR::MemoryReference *_memRef;
 
+   // Real register picked by the linear scan register allocator, taken by the
+   // local register assigner whenever it is free
+   uint8_t _linearScanRegister;
+
    };
 
 }
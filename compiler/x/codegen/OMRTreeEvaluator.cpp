@@ -85,6 +85,80 @@ class TR_OpaqueMethodBlock;
 extern bool existsNextInstructionToTestFlags(TR::Instruction *startInstr,
                                              uint8_t         testMask);
 
+bool OMR::X86::TreeEvaluator::isOverflowBranchOperation(TR::Node *node, TR::Node *operation)
+   {
+   TR::ILOpCodes arithOp;
+   switch (node->getOpCodeValue())
+      {
+      case TR::ificmno:
+      case TR::ificmnno:
+         arithOp = TR::iadd;
+         break;
+      case TR::iflcmno:
+      case TR::iflcmnno:
+         arithOp = TR::ladd;
+         break;
+      case TR::ificmpo:
+      case TR::ificmpno:
+         arithOp = TR::isub;
+         break;
+      case TR::iflcmpo:
+      case TR::iflcmpno:
+         arithOp = TR::lsub;
+         break;
+      default:
+         return false;
+      }
+
+   if (operation->getOpCodeValue() != arithOp)
+      return false;
+
+   TR::Node *firstChild = node->getFirstChild();
+   TR::Node *secondChild = node->getSecondChild();
+   if (operation->getFirstChild() == firstChild && operation->getSecondChild() == secondChild)
+      return true;
+   return operation->getOpCode().isAdd() && operation->getFirstChild() == secondChild && operation->getSecondChild() == firstChild;
+   }
+
+TR::Node *OMR::X86::TreeEvaluator::getOverflowBranchOperation(TR::Node *node, TR::TreeTop *treeTop)
+   {
+   if (node->isMultiplyOverflowCheck())
+      return node->getSecondChild()->getFirstChild();
+
+   TR::TreeTop *prevTree = treeTop->getPrevTreeTop();
+   if (!prevTree)
+      return NULL;
+
+   TR::Node *anchor = prevTree->getNode();
+   TR::Node *operation = NULL;
+   if (anchor->getOpCodeValue() == TR::treetop || anchor->getOpCode().isStoreReg() || anchor->getOpCode().isStoreDirect())
+      operation = anchor->getFirstChild();
+   else if (anchor->getOpCode().isStoreIndirect())
+      operation = anchor->getSecondChild();
+
+   if (!operation || operation->getNumChildren() != 2 || !TR::TreeEvaluator::isOverflowBranchOperation(node, operation))
+      return NULL;
+   return operation;
+   }
+
+bool OMR::X86::TreeEvaluator::overflowFlagIsSetBy(TR::Node *operation, TR::CodeGenerator *cg)
+   {
+   // Only an operation evaluated for its condition codes is guaranteed to end
+   // with the instruction that computes the whole result
+   //
+   if (!NEED_CC(operation))
+      return false;
+
+   for (TR::Instruction *cursor = cg->getAppendInstruction(); cursor; cursor = cursor->getPrev())
+      {
+      if (cursor->getOpCodeValue() == LABEL || cursor->getOpCode().isBranchOp())
+         return false;
+      if (cursor->getOpCode().modifiesOverflowFlag())
+         return cursor->getNode() == operation;
+      }
+   return false;
+   }
+
 TR::Register *OMR::X86::TreeEvaluator::ifxcmpoEvaluator(TR::Node *node, TR::CodeGenerator *cg)
    {
    TR::ILOpCodes opCode = node->getOpCodeValue();
@@ -99,16 +173,23 @@ TR::Register *OMR::X86::TreeEvaluator::ifxcmpoEvaluator(TR::Node *node, TR::Code
    TR::Register* rs1 = cg->evaluate(node->getFirstChild());
    TR::Register* rs2 = cg->evaluate(node->getSecondChild());
 
-   if ((opCode == TR::ificmno) || (opCode == TR::ificmnno) ||
-       (opCode == TR::iflcmno) || (opCode == TR::iflcmnno))
+   // When the tree before this one has just computed the same add or subtract,
+   // branch on its overflow flag rather than repeating the operation
+   //
+   TR::Node *operation = TR::TreeEvaluator::getOverflowBranchOperation(node, cg->getCurrentEvaluationTreeTop());
+   if (!operation || !TR::TreeEvaluator::overflowFlagIsSetBy(operation, cg))
       {
-      TR::Register* tmp = cg->allocateRegister();
-      generateRegRegInstruction(MOVRegReg(nodeIs64Bit), node, tmp, rs1, cg);
-      generateRegRegInstruction(ADDRegReg(nodeIs64Bit), node, tmp, rs2, cg);
-      cg->stopUsingRegister(tmp);
+      if ((opCode == TR::ificmno) || (opCode == TR::ificmnno) ||
+          (opCode == TR::iflcmno) || (opCode == TR::iflcmnno))
+         {
+         TR::Register* tmp = cg->allocateRegister();
+         generateRegRegInstruction(MOVRegReg(nodeIs64Bit), node, tmp, rs1, cg);
+         generateRegRegInstruction(ADDRegReg(nodeIs64Bit), node, tmp, rs2, cg);
+         cg->stopUsingRegister(tmp);
+         }
+      else
+         generateRegRegInstruction(CMPRegReg(nodeIs64Bit), node, rs1, rs2, cg);
       }
-   else
-      generateRegRegInstruction(CMPRegReg(nodeIs64Bit), node, rs1, rs2, cg);
 
    generateConditionalJumpInstruction(reverseBranch ? JNO4 : JO4, node, cg, true);
 
@@ -2239,14 +2320,20 @@ TR::Register *OMR::X86::TreeEvaluator::arraycopyEvaluator(TR::Node *node, TR::Co
          elementSize = TR::Symbol::convertTypeToSize(dt);
       }
 
+   // Short constant length copies are unrolled into SSE and GPR moves.  The
+   // copy with direction moves one chunk at a time from the front, so it is
+   // only used by default for forward copies.
+   //
    static bool optimizeForConstantLengthArrayCopy = feGetEnv("TR_OptimizeForConstantLengthArrayCopy");
+   static bool disableConstantLengthArrayCopy = feGetEnv("TR_DisableConstantLengthArrayCopy");
    static bool ignoreDirectionForConstantLengthArrayCopy = feGetEnv("TR_IgnoreDirectionForConstantLengthArrayCopy");
 #define shortConstArrayWithDirThreshold 256
 #define shortConstArrayWithoutDirThreshold  16*4
    bool isShortConstArrayWithDirection = false;
    bool isShortConstArrayWithoutDirection = false;
    uint32_t size;
-   if (sizeNode->getOpCode().isLoadConst() && TR::Compiler->target.is64Bit() && optimizeForConstantLengthArrayCopy)
+   if (sizeNode->getOpCode().isLoadConst() && TR::Compiler->target.is64Bit() &&
+       (optimizeForConstantLengthArrayCopy || (!disableConstantLengthArrayCopy && !node->isBackwardArrayCopy())))
       {
       size = TR::TreeEvaluator::integerConstNodeValue(sizeNode, cg);
       if ((node->isForwardArrayCopy() || node->isBackwardArrayCopy()) && !ignoreDirectionForConstantLengthArrayCopy)
@@ -2285,6 +2372,11 @@ TR::Register *OMR::X86::TreeEvaluator::arraycopyEvaluator(TR::Node *node, TR::Co
          {
          arrayCopy16BitPrimitive(node, dstReg, srcReg, sizeReg, cg);
          }
+      else if (node->isForwardArrayCopy() && cg->getX86ProcessorInfo().supportsERMSB())
+         {
+         // With enhanced REP MOVSB the byte form is the fastest string copy
+         arrayCopyDefault(node, 1, dstReg, srcReg, sizeReg, cg);
+         }
       else
          {
          arrayCopyDefault(node, elementSize, dstReg, srcReg, sizeReg, cg);
@@ -4122,6 +4214,132 @@ OMR::X86::TreeEvaluator::ibyteswapEvaluator(TR::Node *node, TR::CodeGenerator *c
    return target;
    }
 
+TR::Register *
+OMR::X86::TreeEvaluator::integerNumberOfLeadingZerosEvaluator(TR::Node *node, TR::CodeGenerator *cg)
+   {
+   TR::Node *child = node->getFirstChild();
+   bool nodeIs64Bit = TR::TreeEvaluator::getNodeIs64Bit(child, cg);
+   TR::Register *source = cg->evaluate(child);
+   TR::Register *target = cg->allocateRegister();
+
+   // Without ABM the encoding of LZCNT executes as BSR, so the check is needed
+   // for correctness.
+   //
+   if (cg->getX86ProcessorInfo().supportsLZCNT())
+      {
+      generateRegRegInstruction(LZCNTRegReg(nodeIs64Bit), node, target, source, cg);
+      }
+   else
+      {
+      // BSR gives the index of the highest set bit and sets ZF for a zero source.
+      // (bits-1) - index == index ^ (bits-1), and the zero case maps to bits.
+      //
+      TR::Register *zeroResult = cg->allocateRegister();
+      generateRegImmInstruction(MOV4RegImm4, node, zeroResult, nodeIs64Bit ? 127 : 63, cg);
+      generateRegRegInstruction(BSRRegReg(nodeIs64Bit), node, target, source, cg);
+      generateRegRegInstruction(CMOVE4RegReg, node, target, zeroResult, cg);
+      generateRegImmInstruction(XOR4RegImms, node, target, nodeIs64Bit ? 63 : 31, cg);
+      cg->stopUsingRegister(zeroResult);
+      }
+
+   node->setRegister(target);
+   cg->decReferenceCount(child);
+   return target;
+   }
+
+TR::Register *
+OMR::X86::TreeEvaluator::integerNumberOfTrailingZerosEvaluator(TR::Node *node, TR::CodeGenerator *cg)
+   {
+   TR::Node *child = node->getFirstChild();
+   bool nodeIs64Bit = TR::TreeEvaluator::getNodeIs64Bit(child, cg);
+   TR::Register *source = cg->evaluate(child);
+   TR::Register *target = cg->allocateRegister();
+
+   // Without BMI1 the TZCNT encoding executes as BSF
+   //
+   if (cg->getX86ProcessorInfo().supportsBMI1())
+      {
+      generateRegRegInstruction(TZCNTRegReg(nodeIs64Bit), node, target, source, cg);
+      }
+   else
+      {
+      TR::Register *zeroResult = cg->allocateRegister();
+      generateRegImmInstruction(MOV4RegImm4, node, zeroResult, nodeIs64Bit ? 64 : 32, cg);
+      generateRegRegInstruction(BSFRegReg(nodeIs64Bit), node, target, source, cg);
+      generateRegRegInstruction(CMOVE4RegReg, node, target, zeroResult, cg);
+      cg->stopUsingRegister(zeroResult);
+      }
+
+   node->setRegister(target);
+   cg->decReferenceCount(child);
+   return target;
+   }
+
+static void loadBitCountMask(TR::Node *node, TR::Register *mask, bool nodeIs64Bit, uint64_t value, TR::CodeGenerator *cg)
+   {
+   if (nodeIs64Bit)
+      generateRegImm64Instruction(MOV8RegImm64, node, mask, value, cg);
+   else
+      generateRegImmInstruction(MOV4RegImm4, node, mask, (int32_t)value, cg);
+   }
+
+TR::Register *
+OMR::X86::TreeEvaluator::integerBitCountEvaluator(TR::Node *node, TR::CodeGenerator *cg)
+   {
+   TR::Node *child = node->getFirstChild();
+   bool nodeIs64Bit = TR::TreeEvaluator::getNodeIs64Bit(child, cg);
+   TR::Register *source = cg->evaluate(child);
+   TR::Register *target = cg->allocateRegister();
+
+   if (cg->getX86ProcessorInfo().supportsPOPCNT())
+      {
+      generateRegRegInstruction(POPCNTRegReg(nodeIs64Bit), node, target, source, cg);
+      }
+   else
+      {
+      // Count the bits of each 2, 4 and 8 bit field in parallel, then sum the
+      // bytes with a multiply (Hacker's Delight, 5-1)
+      //
+      TR::Register *tmp = cg->allocateRegister();
+      TR::Register *mask = cg->allocateRegister();
+      generateRegRegInstruction(MOVRegReg(nodeIs64Bit), node, target, source, cg);
+
+      // x = x - ((x >> 1) & 0x55..55)
+      loadBitCountMask(node, mask, nodeIs64Bit, CONSTANT64(0x5555555555555555), cg);
+      generateRegRegInstruction(MOVRegReg(nodeIs64Bit), node, tmp, target, cg);
+      generateRegImmInstruction(SHRRegImm1(nodeIs64Bit), node, tmp, 1, cg);
+      generateRegRegInstruction(ANDRegReg(nodeIs64Bit), node, tmp, mask, cg);
+      generateRegRegInstruction(SUBRegReg(nodeIs64Bit), node, target, tmp, cg);
+
+      // x = (x & 0x33..33) + ((x >> 2) & 0x33..33)
+      loadBitCountMask(node, mask, nodeIs64Bit, CONSTANT64(0x3333333333333333), cg);
+      generateRegRegInstruction(MOVRegReg(nodeIs64Bit), node, tmp, target, cg);
+      generateRegImmInstruction(SHRRegImm1(nodeIs64Bit), node, tmp, 2, cg);
+      generateRegRegInstruction(ANDRegReg(nodeIs64Bit), node, tmp, mask, cg);
+      generateRegRegInstruction(ANDRegReg(nodeIs64Bit), node, target, mask, cg);
+      generateRegRegInstruction(ADDRegReg(nodeIs64Bit), node, target, tmp, cg);
+
+      // x = (x + (x >> 4)) & 0x0f..0f
+      loadBitCountMask(node, mask, nodeIs64Bit, CONSTANT64(0x0f0f0f0f0f0f0f0f), cg);
+      generateRegRegInstruction(MOVRegReg(nodeIs64Bit), node, tmp, target, cg);
+      generateRegImmInstruction(SHRRegImm1(nodeIs64Bit), node, tmp, 4, cg);
+      generateRegRegInstruction(ADDRegReg(nodeIs64Bit), node, target, tmp, cg);
+      generateRegRegInstruction(ANDRegReg(nodeIs64Bit), node, target, mask, cg);
+
+      // x = (x * 0x01..01) >> (bits - 8)
+      loadBitCountMask(node, mask, nodeIs64Bit, CONSTANT64(0x0101010101010101), cg);
+      generateRegRegInstruction(IMULRegReg(nodeIs64Bit), node, target, mask, cg);
+      generateRegImmInstruction(SHRRegImm1(nodeIs64Bit), node, target, nodeIs64Bit ? 56 : 24, cg);
+
+      cg->stopUsingRegister(mask);
+      cg->stopUsingRegister(tmp);
+      }
+
+   node->setRegister(target);
+   cg->decReferenceCount(child);
+   return target;
+   }
+
 enum BinaryArithmeticOps : uint32_t
    {
    BinaryArithmeticInvalid,
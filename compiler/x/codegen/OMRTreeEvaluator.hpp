@@ -65,6 +65,22 @@ class OMR_EXTENSIBLE TreeEvaluator: public OMR::TreeEvaluator
    public:
 
    static TR::Register *ifxcmpoEvaluator(TR::Node *node, TR::CodeGenerator *cg);
+   /**
+    * \brief Find the add, subtract or multiply whose overflow the branch \p node
+    * tests and which may already have set the overflow flag: for ificmno,
+    * ificmpo and friends an operation on the same children anchored by the tree
+    * before \p treeTop, and for a multiply overflow check its multiply.
+    */
+   static TR::Node *getOverflowBranchOperation(TR::Node *node, TR::TreeTop *treeTop);
+   /**
+    * \brief Whether \p operation is the add or subtract of the children of the
+    * ificmno, ificmpo or similar branch \p node
+    */
+   static bool isOverflowBranchOperation(TR::Node *node, TR::Node *operation);
+   /**
+    * \brief Whether the overflow flag is still the one set by evaluating \p operation
+    */
+   static bool overflowFlagIsSetBy(TR::Node *operation, TR::CodeGenerator *cg);
    static TR::Register *iconstEvaluator(TR::Node *node, TR::CodeGenerator *cg);
    static TR::Register *fconstEvaluator(TR::Node *node, TR::CodeGenerator *cg);
    static TR::Register *dconstEvaluator(TR::Node *node, TR::CodeGenerator *cg);
@@ -226,6 +242,9 @@ class OMR_EXTENSIBLE TreeEvaluator: public OMR::TreeEvaluator
    static TR::Register *arraycopyEvaluator(TR::Node *node, TR::CodeGenerator *cg);
    static TR::Register *overflowCHKEvaluator(TR::Node *node, TR::CodeGenerator *cg);
    static TR::Register *ibyteswapEvaluator(TR::Node *node, TR::CodeGenerator *cg);
+   static TR::Register *integerNumberOfLeadingZerosEvaluator(TR::Node *node, TR::CodeGenerator *cg);
+   static TR::Register *integerNumberOfTrailingZerosEvaluator(TR::Node *node, TR::CodeGenerator *cg);
+   static TR::Register *integerBitCountEvaluator(TR::Node *node, TR::CodeGenerator *cg);
    static TR::Register *bitpermuteEvaluator(TR::Node *node, TR::CodeGenerator *cg);
    static TR::Register *PrefetchEvaluator(TR::Node *node, TR::CodeGenerator *cg);
    static TR::Register *BBStartEvaluator(TR::Node *node, TR::CodeGenerator *cg);
@@ -238,6 +257,7 @@ class OMR_EXTENSIBLE TreeEvaluator: public OMR::TreeEvaluator
    // (see also the integerPair*Evaluator functions)
    static TR::Register *integerStoreEvaluator(TR::Node *node, TR::CodeGenerator *cg);
    static TR::Register *integerReturnEvaluator(TR::Node *node, TR::CodeGenerator *cg);
+   static bool isReturnAfterTailCall(TR::Node *node, TR::CodeGenerator *cg);
    static TR::Register *integerMulEvaluator(TR::Node *node, TR::CodeGenerator *cg);
    static TR::Register *integerMulhEvaluator(TR::Node *node, TR::CodeGenerator *cg);
    static TR::Register *integerDualMulEvaluator(TR::Node *node, TR::CodeGenerator *cg);
@@ -281,6 +301,8 @@ class OMR_EXTENSIBLE TreeEvaluator: public OMR::TreeEvaluator
    static TR::Register *fpReturnEvaluator(TR::Node *node, TR::CodeGenerator *cg);
    static TR::Register *fpRemEvaluator(TR::Node *node, TR::CodeGenerator *cg);
    static TR::Register *fpSqrtEvaluator(TR::Node *node, TR::CodeGenerator *cg);
+   static TR::Register *fpMinMaxEvaluator(TR::Node *node, TR::CodeGenerator *cg);
+   static TR::Register *fpTernaryEvaluator(TR::Node *node, TR::CodeGenerator *cg);
 
    // routines for floating point values that can fit in one GPR
    static TR::Register *floatingPointStoreEvaluator(TR::Node *node, TR::CodeGenerator *cg);
@@ -390,6 +412,7 @@ class OMR_EXTENSIBLE TreeEvaluator: public OMR::TreeEvaluator
    static TR::Register *signedIntegerDivOrRemAnalyser(TR::Node *node, TR::CodeGenerator *cg);
    static TR::Register *dstoreEvaluatorHelper(TR::Node *node, TR::CodeGenerator *cg);
    static TR::X86MemInstruction *generateMemoryShift(TR::Node *node, TR_X86OpCodes immShiftOpCode, TR_X86OpCodes regShiftOpCode, TR::CodeGenerator *cg);
+   static TR::Register *generateAndNot(TR::Node *node, TR::CodeGenerator *cg);
    static TR::X86RegInstruction *generateRegisterShift(TR::Node *node, TR_X86OpCodes immShiftOpCode, TR_X86OpCodes regShiftOpCode,TR::CodeGenerator *cg);
    static TR::Instruction *compareGPMemoryToImmediate(TR::Node *node, TR::MemoryReference  *mr, int32_t value, TR::CodeGenerator *cg);
    static void compareGPRegisterToImmediate(TR::Node *node, TR::Register *cmpRegister, int32_t value, TR::CodeGenerator *cg);
@@ -131,6 +131,7 @@ inline TR_X86OpCodes SizeParameterizedOpCode(bool is64Bit =
 #define ANDRegImm4     SizeParameterizedOpCode<AND8RegImm4     , AND4RegImm4     >
 #define ANDRegReg      SizeParameterizedOpCode<AND8RegReg      , AND4RegReg      >
 #define ANDRegImms     SizeParameterizedOpCode<AND8RegImms     , AND4RegImms     >
+#define ANDNRegRegReg  SizeParameterizedOpCode<ANDN8RegRegReg  , ANDN4RegRegReg  >
 #define ORRegReg       SizeParameterizedOpCode<OR8RegReg       , OR4RegReg       >
 #define MOVRegImm4     SizeParameterizedOpCode<MOV8RegImm4     , MOV4RegImm4     >
 #define IMULAccReg     SizeParameterizedOpCode<IMUL8AccReg     , IMUL4AccReg     >
@@ -140,21 +141,27 @@ inline TR_X86OpCodes SizeParameterizedOpCode(bool is64Bit =
 #define DIVAccReg      SizeParameterizedOpCode<DIV8AccReg      , DIV4AccReg      >
 #define NOTReg         SizeParameterizedOpCode<NOT8Reg         , NOT4Reg         >
 #define POPCNTRegReg   SizeParameterizedOpCode<POPCNT8RegReg   , POPCNT4RegReg   >
+#define LZCNTRegReg    SizeParameterizedOpCode<LZCNT8RegReg    , LZCNT4RegReg    >
+#define TZCNTRegReg    SizeParameterizedOpCode<TZCNT8RegReg    , TZCNT4RegReg    >
 #define ROLRegImm1     SizeParameterizedOpCode<ROL8RegImm1     , ROL4RegImm1     >
 #define ROLRegCL       SizeParameterizedOpCode<ROL8RegCL       , ROL4RegCL       >
+#define RORXRegRegImm1 SizeParameterizedOpCode<RORX8RegRegImm1 , RORX4RegRegImm1 >
 #define SHLMemImm1     SizeParameterizedOpCode<SHL8MemImm1     , SHL4MemImm1     >
 #define SHLMemCL       SizeParameterizedOpCode<SHL8MemCL       , SHL4MemCL       >
 #define SHLRegImm1     SizeParameterizedOpCode<SHL8RegImm1     , SHL4RegImm1     >
 #define SHLRegCL       SizeParameterizedOpCode<SHL8RegCL       , SHL4RegCL       >
+#define SHLXRegRegReg  SizeParameterizedOpCode<SHLX8RegRegReg  , SHLX4RegRegReg  >
 #define SARMemImm1     SizeParameterizedOpCode<SAR8MemImm1     , SAR4MemImm1     >
 #define SARMemCL       SizeParameterizedOpCode<SAR8MemCL       , SAR4MemCL       >
 #define SARRegImm1     SizeParameterizedOpCode<SAR8RegImm1     , SAR4RegImm1     >
 #define SARRegCL       SizeParameterizedOpCode<SAR8RegCL       , SAR4RegCL       >
+#define SARXRegRegReg  SizeParameterizedOpCode<SARX8RegRegReg  , SARX4RegRegReg  >
 #define SHRMemImm1     SizeParameterizedOpCode<SHR8MemImm1     , SHR4MemImm1     >
 #define SHRMemCL       SizeParameterizedOpCode<SHR8MemCL       , SHR4MemCL       >
 #define SHRReg1        SizeParameterizedOpCode<SHR8Reg1        , SHR4Reg1        >
 #define SHRRegImm1     SizeParameterizedOpCode<SHR8RegImm1     , SHR4RegImm1     >
 #define SHRRegCL       SizeParameterizedOpCode<SHR8RegCL       , SHR4RegCL       >
+#define SHRXRegRegReg  SizeParameterizedOpCode<SHRX8RegRegReg  , SHRX4RegRegReg  >
 #define TESTMemImm4    SizeParameterizedOpCode<TEST8MemImm4    , TEST4MemImm4    >
 #define TESTRegImm4    SizeParameterizedOpCode<TEST8RegImm4    , TEST4RegImm4    >
 #define TESTRegReg     SizeParameterizedOpCode<TEST8RegReg     , TEST4RegReg     >
@@ -108,6 +108,12 @@ OMR::X86::CPU::getX86ProcessorFeatureFlags8()
    return self()->queryX86TargetCPUID()->_featureFlags8;
    }
 
+uint32_t
+OMR::X86::CPU::getX86ProcessorExtendedFeatureFlags()
+   {
+   return self()->queryX86TargetCPUID()->_extendedFeatureFlags;
+   }
+
 bool
 OMR::X86::CPU::testOSForSSESupport()
    {
@@ -61,6 +61,7 @@ public:
    uint32_t getX86ProcessorFeatureFlags();
    uint32_t getX86ProcessorFeatureFlags2();
    uint32_t getX86ProcessorFeatureFlags8();
+   uint32_t getX86ProcessorExtendedFeatureFlags();
 
    bool testOSForSSESupport();
 
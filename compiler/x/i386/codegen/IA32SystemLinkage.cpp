@@ -362,6 +362,10 @@ int32_t TR::IA32SystemLinkage::buildArgs(
 
 TR::Register *TR::IA32SystemLinkage::buildDirectDispatch(TR::Node *callNode, bool spillFPRegs)
    {
+   // Tail calls are only dispatched by the AMD64 linkages
+   //
+   callNode->setIsTailCall(false);
+
    TR::RealRegister    *stackPointerReg = machine()->getRealRegister(TR::RealRegister::esp);
    TR::SymbolReference *methodSymRef    = callNode->getSymbolReference();
    TR::MethodSymbol    *methodSymbol    = callNode->getSymbol()->castToMethodSymbol();
@@ -53,6 +53,7 @@ inline void maskProcessorFlags(TR_X86CPUIDBuffer* pBuffer)
    pBuffer->_featureFlags  &= getFeatureFlagsMask();
    pBuffer->_featureFlags2 &= getFeatureFlags2Mask();
    pBuffer->_featureFlags8 &= getFeatureFlags8Mask();
+   pBuffer->_extendedFeatureFlags &= getExtendedFeatureFlagsMask();
    }
 
 char* feGetEnv(const char*);
@@ -85,6 +86,14 @@ inline bool jitGetCPUID(TR_X86CPUIDBuffer* pBuffer)
       // EAX = 7, ECX = 0
       cpuidex(CPUInfo, 7, 0);
       pBuffer->_featureFlags8 = CPUInfo[EBX];
+      // EAX = 0x80000001, if the processor has extended leaves up to it
+      pBuffer->_extendedFeatureFlags = 0;
+      cpuid(CPUInfo, 0x80000000);
+      if ((uint32_t)CPUInfo[EAX] >= 0x80000001)
+         {
+         cpuid(CPUInfo, 0x80000001);
+         pBuffer->_extendedFeatureFlags = CPUInfo[ECX];
+         }
 
       // Check for XSAVE
       if(pBuffer->_featureFlags2 & TR_OSXSAVE)
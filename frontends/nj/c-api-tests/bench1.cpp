@@ -0,0 +1,1251 @@
+#include "nj_api.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+/*
+Compile time benchmarks. Each benchmark builds a function whose IL
+stresses a particular part of the compiler, compiles it a number of
+times at each optimization level and reports the average compile time.
+The generated code is also run once to make sure it is still correct.
+
+Run time benchmarks compile a kernel at the warm and hot optimization
+levels and report the average time of a call to the generated code.
+The register pressure benchmark reports both, as global register
+allocation trades compile time for the speed of the code. It compiles
+warm with priority coloring, with the linear scan allocator on top of
+coloring, and with the linear scan allocator alone; for the other
+benchmarks, compare a run with TR_Options=enableLinearScanRA.
+
+Usage: njbench [iterations]
+*/
+
+static int iterations = 10;
+
+typedef void *(*CompileFunction)(JIT_ContextRef ctx, int opt_level);
+
+static double time_compiles(JIT_ContextRef ctx, CompileFunction compile,
+                            int opt_level, void **code) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    *code = compile(ctx, opt_level);
+    if (!*code)
+      return -1.0;
+  }
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::milli> elapsed = end - start;
+  return elapsed.count() / iterations;
+}
+
+/*
+Block heavy IL: a long chain of diamonds, each one recomputing the same
+expressions of the parameter so that local CSE has plenty of candidates
+in every block.
+
+  t = 0
+  for i in 0 .. N-1:
+    A_i: t = t + (x ^ i) * (x ^ i) + (x ^ i)
+         if ((t & 1) != 0) goto A_i+1
+    B_i: t = t + 3
+  A_N: return t
+*/
+
+static const int BLOCK_HEAVY_DIAMONDS = 2000;
+
+static bool block_heavy_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  int n = BLOCK_HEAVY_DIAMONDS;
+  JIT_CreateBlocks(ilinjector, 2 * n + 1);
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto t = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_StoreToTemporary(ilinjector, t, JIT_ConstInt32(0));
+  for (int i = 0; i < n; i++) {
+    JIT_BlockRef a = JIT_GetBlock(ilinjector, 2 * i);
+    JIT_BlockRef b = JIT_GetBlock(ilinjector, 2 * i + 1);
+    JIT_BlockRef next = JIT_GetBlock(ilinjector, 2 * i + 2);
+
+    JIT_SetCurrentBlock(ilinjector, 2 * i);
+    auto x = JIT_LoadParameter(ilinjector, 0);
+    auto k = JIT_ConstInt32(i);
+    auto sq = JIT_CreateNode2C(OP_imul, JIT_CreateNode2C(OP_ixor, x, k),
+                               JIT_CreateNode2C(OP_ixor, x, k));
+    auto sum = JIT_CreateNode2C(
+        OP_iadd,
+        JIT_CreateNode2C(OP_iadd, JIT_LoadTemporary(ilinjector, t), sq),
+        JIT_CreateNode2C(OP_ixor, x, k));
+    JIT_StoreToTemporary(ilinjector, t, sum);
+    auto odd = JIT_CreateNode2C(OP_iand, JIT_LoadTemporary(ilinjector, t),
+                                JIT_ConstInt32(1));
+    JIT_IfNotZeroValue(ilinjector, odd, next);
+    JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(a), JIT_BlockAsCFGNode(b));
+
+    JIT_SetCurrentBlock(ilinjector, 2 * i + 1);
+    JIT_StoreToTemporary(
+        ilinjector, t,
+        JIT_CreateNode2C(OP_iadd, JIT_LoadTemporary(ilinjector, t),
+                         JIT_ConstInt32(3)));
+    JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(b),
+                   JIT_BlockAsCFGNode(next));
+  }
+  JIT_SetCurrentBlock(ilinjector, 2 * n);
+  JIT_ReturnValue(ilinjector, JIT_LoadTemporary(ilinjector, t));
+  return true;
+}
+
+static int32_t block_heavy_expected(int32_t x) {
+  uint32_t t = 0;
+  for (int i = 0; i < BLOCK_HEAVY_DIAMONDS; i++) {
+    uint32_t v = (uint32_t)(x ^ i);
+    t = t + v * v + v;
+    if ((t & 1) == 0)
+      t = t + 3;
+  }
+  return (int32_t)t;
+}
+
+static void *block_heavy_compile(JIT_ContextRef ctx, int opt_level) {
+  JIT_Type params[1] = {JIT_Int32};
+  JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+      ctx, "block_heavy", JIT_Int32, 1, params, block_heavy_il, NULL);
+  void *code = JIT_Compile(function_builder, opt_level);
+  JIT_DestroyFunctionBuilder(function_builder);
+  return code;
+}
+
+static int block_heavy(JIT_ContextRef ctx) {
+  int rc = 0;
+  for (int opt_level = 0; opt_level <= 2; opt_level++) {
+    void *code = NULL;
+    double ms = time_compiles(ctx, block_heavy_compile, opt_level, &code);
+    if (ms < 0) {
+      printf("block_heavy: compile failed at opt level %d\n", opt_level);
+      rc = 1;
+      continue;
+    }
+    typedef int32_t (*F)(int32_t);
+    int32_t result = ((F)code)(7);
+    int32_t expected = block_heavy_expected(7);
+    printf("block_heavy: %d blocks, opt level %d: %.2f ms per compile%s\n",
+           2 * BLOCK_HEAVY_DIAMONDS + 1, opt_level, ms,
+           result == expected ? "" : " (WRONG RESULT)");
+    if (result != expected)
+      rc = 1;
+  }
+  return rc;
+}
+
+/*
+Many locals: a loop over a long chain of tests, each guarding a block
+with a temporary of its own. Every temporary is a bit in the liveness and
+reaching definitions problems, so the size of the dataflow sets grows
+with the square of the length of the chain. The chain is long enough for
+liveness to size its sets lazily; compare with
+TR_Options=disableLazyDFSets.
+
+  sum = 0
+  for i in 0 .. x-1:
+    for j in 0 .. N-1:
+      if ((i & 7) == (j & 7)) { t_j = i + j; sum = sum + t_j }
+  return sum
+*/
+
+static const int MANY_LOCALS_TESTS = 2500;
+
+static bool many_locals_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  int n = *(const int *)userdata;
+  JIT_CreateBlocks(ilinjector, 2 * n + 4);
+  JIT_BlockRef header = JIT_GetBlock(ilinjector, 1);
+  JIT_BlockRef latch = JIT_GetBlock(ilinjector, 2 * n + 2);
+  JIT_BlockRef exit = JIT_GetBlock(ilinjector, 2 * n + 3);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto sum = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  auto i = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_StoreToTemporary(ilinjector, sum, JIT_ConstInt32(0));
+  JIT_StoreToTemporary(ilinjector, i, JIT_ConstInt32(0));
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 0)),
+                 JIT_BlockAsCFGNode(header));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  JIT_IfNotZeroValue(ilinjector,
+                     JIT_CreateNode2C(OP_icmpge,
+                                      JIT_LoadTemporary(ilinjector, i),
+                                      JIT_LoadParameter(ilinjector, 0)),
+                     exit);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(header),
+                 JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 2)));
+
+  for (int j = 0; j < n; j++) {
+    JIT_BlockRef test = JIT_GetBlock(ilinjector, 2 * j + 2);
+    JIT_BlockRef body = JIT_GetBlock(ilinjector, 2 * j + 3);
+    JIT_BlockRef next = JIT_GetBlock(ilinjector, 2 * j + 4);
+
+    JIT_SetCurrentBlock(ilinjector, 2 * j + 2);
+    auto low = JIT_CreateNode2C(OP_iand, JIT_LoadTemporary(ilinjector, i),
+                                JIT_ConstInt32(7));
+    JIT_IfNotZeroValue(
+        ilinjector, JIT_CreateNode2C(OP_icmpne, low, JIT_ConstInt32(j & 7)),
+        next);
+    JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(test),
+                   JIT_BlockAsCFGNode(body));
+
+    JIT_SetCurrentBlock(ilinjector, 2 * j + 3);
+    auto t = JIT_CreateTemporary(ilinjector, JIT_Int32);
+    JIT_StoreToTemporary(ilinjector, t,
+                         JIT_CreateNode2C(OP_iadd,
+                                          JIT_LoadTemporary(ilinjector, i),
+                                          JIT_ConstInt32(j)));
+    JIT_StoreToTemporary(ilinjector, sum,
+                         JIT_CreateNode2C(OP_iadd,
+                                          JIT_LoadTemporary(ilinjector, sum),
+                                          JIT_LoadTemporary(ilinjector, t)));
+    JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(body),
+                   JIT_BlockAsCFGNode(next));
+  }
+
+  JIT_SetCurrentBlock(ilinjector, 2 * n + 2);
+  JIT_StoreToTemporary(ilinjector, i,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, i),
+                                        JIT_ConstInt32(1)));
+  JIT_Goto(ilinjector, header);
+
+  JIT_SetCurrentBlock(ilinjector, 2 * n + 3);
+  JIT_ReturnValue(ilinjector, JIT_LoadTemporary(ilinjector, sum));
+  return true;
+}
+
+static int32_t many_locals_expected(int32_t x, int n) {
+  int32_t sum = 0;
+  for (int32_t i = 0; i < x; i++) {
+    for (int32_t j = 0; j < n; j++) {
+      if ((i & 7) == (j & 7))
+        sum += i + j;
+    }
+  }
+  return sum;
+}
+
+static void *many_locals_compile(JIT_ContextRef ctx, int opt_level) {
+  static const int n = MANY_LOCALS_TESTS;
+  JIT_Type params[1] = {JIT_Int32};
+  JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+      ctx, "many_locals", JIT_Int32, 1, params, many_locals_il, (void *)&n);
+  void *code = JIT_Compile(function_builder, opt_level);
+  JIT_DestroyFunctionBuilder(function_builder);
+  return code;
+}
+
+static int many_locals(JIT_ContextRef ctx) {
+  int rc = 0;
+  for (int opt_level = 1; opt_level <= 2; opt_level++) {
+    void *code = NULL;
+    double ms = time_compiles(ctx, many_locals_compile, opt_level, &code);
+    if (ms < 0) {
+      printf("many_locals: compile failed at opt level %d\n", opt_level);
+      rc = 1;
+      continue;
+    }
+    typedef int32_t (*F)(int32_t);
+    int32_t result = ((F)code)(100);
+    int32_t expected = many_locals_expected(100, MANY_LOCALS_TESTS);
+    printf("many_locals: %d temps, opt level %d: %.2f ms per compile%s\n",
+           MANY_LOCALS_TESTS + 2, opt_level, ms,
+           result == expected ? "" : " (WRONG RESULT)");
+    if (result != expected)
+      rc = 1;
+  }
+  return rc;
+}
+
+/*
+Large function: the many locals IL with a chain long enough that the hot
+compile is over its compile budget. Global value propagation is replaced
+by local value propagation and the loop optimizations are skipped, which
+TR_Options=verbose={optimizer} reports; compare with
+TR_Options=compileBudget=2147483647 for the cost of running them anyway.
+*/
+
+static const int LARGE_FUNCTION_TESTS = 6500;
+
+static void *large_function_compile(JIT_ContextRef ctx, int opt_level) {
+  static const int n = LARGE_FUNCTION_TESTS;
+  JIT_Type params[1] = {JIT_Int32};
+  JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+      ctx, "large_function", JIT_Int32, 1, params, many_locals_il, (void *)&n);
+  void *code = JIT_Compile(function_builder, opt_level);
+  JIT_DestroyFunctionBuilder(function_builder);
+  return code;
+}
+
+static int large_function(JIT_ContextRef ctx) {
+  int rc = 0;
+  for (int opt_level = 1; opt_level <= 2; opt_level++) {
+    void *code = NULL;
+    double ms = time_compiles(ctx, large_function_compile, opt_level, &code);
+    if (ms < 0) {
+      printf("large_function: compile failed at opt level %d\n", opt_level);
+      rc = 1;
+      continue;
+    }
+    typedef int32_t (*F)(int32_t);
+    int32_t result = ((F)code)(100);
+    int32_t expected = many_locals_expected(100, LARGE_FUNCTION_TESTS);
+    printf("large_function: %d blocks, opt level %d: %.2f ms per compile%s\n",
+           2 * LARGE_FUNCTION_TESTS + 4, opt_level, ms,
+           result == expected ? "" : " (WRONG RESULT)");
+    if (result != expected)
+      rc = 1;
+  }
+  return rc;
+}
+
+/*
+Node creation: IL generation through the C API creates one node per
+call, so this measures the raw cost of building 1M nodes. Only the time
+spent in the IL generator callback is reported. The sums are added up
+pairwise so that every node is reachable from the returned value.
+
+  return (x + 0) + (x + 1) + ... + (x + N/3 - 1)
+
+The second run builds the same tree of minimums with JIT_Intrinsic(),
+which has the injector and so passes the compilation to the node
+constructors instead of looking it up for each node. Every minimum
+becomes a compare and a conditional move, so this tree is kept smaller
+for the generated code to fit in the code cache.
+
+  return min(min(x, 0), min(x, 1), ... min(x, N/3 - 1))
+*/
+
+static const int NODE_CREATION_NODES = 1000000;
+static const int NODE_CREATION_INJECTOR_NODES = 250000;
+
+struct NodeCreationRun {
+  bool through_injector;
+  int nodes;
+  double ms;
+};
+
+static JIT_NodeRef node_creation_combine(JIT_ILInjectorRef ilinjector,
+                                         bool through_injector, JIT_NodeRef a,
+                                         JIT_NodeRef b) {
+  if (!through_injector)
+    return JIT_CreateNode2C(OP_iadd, a, b);
+  JIT_NodeRef args[2] = {a, b};
+  return JIT_Intrinsic(ilinjector, JIT_IntrinsicMin, 2, args);
+}
+
+static bool node_creation_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  NodeCreationRun *run = (NodeCreationRun *)userdata;
+  auto start = std::chrono::steady_clock::now();
+  JIT_CreateBlocks(ilinjector, 1);
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto x = JIT_LoadParameter(ilinjector, 0);
+  std::vector<JIT_NodeRef> values;
+  for (int i = 0; i < run->nodes / 3; i++) {
+    values.push_back(node_creation_combine(ilinjector, run->through_injector,
+                                           x, JIT_ConstInt32(i)));
+  }
+  while (values.size() > 1) {
+    size_t n = 0;
+    for (size_t i = 0; i + 1 < values.size(); i += 2)
+      values[n++] = node_creation_combine(ilinjector, run->through_injector,
+                                          values[i], values[i + 1]);
+    if (values.size() & 1)
+      values[n++] = values.back();
+    values.resize(n);
+  }
+  JIT_ReturnValue(ilinjector, values[0]);
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::milli> elapsed = end - start;
+  run->ms += elapsed.count();
+  return true;
+}
+
+static int32_t node_creation_expected(int32_t x, bool through_injector) {
+  if (through_injector)
+    return std::min(x, 0);
+  uint32_t t = 0;
+  for (int i = 0; i < NODE_CREATION_NODES / 3; i++)
+    t += (uint32_t)x + i;
+  return (int32_t)t;
+}
+
+static int node_creation(JIT_ContextRef ctx) {
+  JIT_Type params[1] = {JIT_Int32};
+  int rc = 0;
+  // Recording the code for compaction costs compile time, so this runs after
+  // the benchmarks that measure it
+  JIT_EnableCodeCacheCompaction(ctx);
+  for (bool through_injector : {false, true}) {
+    int nodes = through_injector ? NODE_CREATION_INJECTOR_NODES
+                                 : NODE_CREATION_NODES;
+    NodeCreationRun run = {through_injector, nodes, 0};
+    void *code = NULL;
+    for (int i = 0; i < iterations; i++) {
+      // Release the code of the earlier compiles; the other benchmarks leave
+      // too little code cache for several copies of these large functions
+      { int c = JIT_CompactCodeCache(ctx); fprintf(stderr, "compact %d\n", c); }
+      JIT_FunctionBuilderRef function_builder =
+          JIT_CreateFunctionBuilder(ctx, "node_creation", JIT_Int32, 1, params,
+                                    node_creation_il, &run);
+      code = JIT_Compile(function_builder, 0);
+      JIT_DestroyFunctionBuilder(function_builder);
+      if (!code) {
+        printf("node_creation: compile failed\n");
+        return 1;
+      }
+    }
+    typedef int32_t (*F)(int32_t);
+    int32_t result = ((F)code)(1);
+    int32_t expected = node_creation_expected(1, through_injector);
+    printf("node_creation: %d nodes%s: %.2f ms per IL generation%s\n",
+           run.nodes, through_injector ? " through the injector" : "",
+           run.ms / iterations, result == expected ? "" : " (WRONG RESULT)");
+    if (result != expected)
+      rc = 1;
+  }
+  return rc;
+}
+
+/*
+Dot product, as in the jitbuilder sample: the element wise product of
+two double vectors. Run time benchmark for the loop vectorizer.
+
+  for i in 0 .. n-1:
+    result[i] = v1[i] * v2[i]
+*/
+
+static const int DOT_PRODUCT_LENGTH = 10000;
+
+static bool dot_product_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, 4);
+  JIT_SetMayHaveLoops(ilinjector);
+  JIT_BlockRef entry = JIT_GetBlock(ilinjector, 0);
+  JIT_BlockRef test = JIT_GetBlock(ilinjector, 1);
+  JIT_BlockRef body = JIT_GetBlock(ilinjector, 2);
+  JIT_BlockRef exit = JIT_GetBlock(ilinjector, 3);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto i = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_StoreToTemporary(ilinjector, i, JIT_ConstInt32(0));
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(entry),
+                 JIT_BlockAsCFGNode(test));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  JIT_IfNotZeroValue(ilinjector,
+                     JIT_CreateNode2C(OP_icmpge,
+                                      JIT_LoadTemporary(ilinjector, i),
+                                      JIT_LoadParameter(ilinjector, 3)),
+                     exit);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(test),
+                 JIT_BlockAsCFGNode(body));
+
+  JIT_SetCurrentBlock(ilinjector, 2);
+  auto offset = JIT_CreateNode2C(OP_imul, JIT_LoadTemporary(ilinjector, i),
+                                 JIT_ConstInt32(8));
+  auto v1 = JIT_ArrayLoad(ilinjector, JIT_LoadParameter(ilinjector, 1),
+                          offset, JIT_Double);
+  auto v2 = JIT_ArrayLoad(ilinjector, JIT_LoadParameter(ilinjector, 2),
+                          offset, JIT_Double);
+  JIT_ArrayStore(ilinjector, JIT_LoadParameter(ilinjector, 0), offset,
+                 JIT_CreateNode2C(OP_dmul, v1, v2));
+  JIT_StoreToTemporary(ilinjector, i,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, i),
+                                        JIT_ConstInt32(1)));
+  JIT_Goto(ilinjector, test);
+
+  JIT_SetCurrentBlock(ilinjector, 3);
+  JIT_ReturnNoValue(ilinjector);
+  return true;
+}
+
+static int dot_product(JIT_ContextRef ctx) {
+  typedef void (*F)(double *, double *, double *, int32_t);
+  JIT_Type params[4] = {JIT_Address, JIT_Address, JIT_Address, JIT_Int32};
+  int n = DOT_PRODUCT_LENGTH;
+  std::vector<double> result(n), v1(n), v2(n);
+  for (int i = 0; i < n; i++) {
+    v1[i] = i + 0.5;
+    v2[i] = n - i;
+  }
+  int rc = 0;
+  for (int opt_level = 1; opt_level <= 2; opt_level++) {
+    JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+        ctx, "dot_product", JIT_NoType, 4, params, dot_product_il, NULL);
+    F f = (F)JIT_Compile(function_builder, opt_level);
+    JIT_DestroyFunctionBuilder(function_builder);
+    if (!f) {
+      printf("dot_product: compile failed at opt level %d\n", opt_level);
+      rc = 1;
+      continue;
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int k = 0; k < 100 * iterations; k++)
+      f(result.data(), v1.data(), v2.data(), n);
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::micro> elapsed = end - start;
+    bool correct = true;
+    for (int i = 0; i < n; i++)
+      correct = correct && result[i] == v1[i] * v2[i];
+    printf("dot_product: %d elements, opt level %d: %.2f us per call%s\n", n,
+           opt_level, elapsed.count() / (100 * iterations),
+           correct ? "" : " (WRONG RESULT)");
+    if (!correct)
+      rc = 1;
+  }
+  return rc;
+}
+
+/*
+Matrix multiply, as in the jitbuilder sample but with the loops in i-k-j
+order so that the innermost loop walks rows of B and C with unit stride.
+A[i][k] is loaded before the innermost loop. Run time benchmark for the
+loop vectorizer.
+
+  for i in 0 .. n-1:
+    for k in 0 .. n-1:
+      aik = A[i][k]
+      for j in 0 .. n-1:
+        C[i][j] = C[i][j] + aik * B[k][j]
+*/
+
+static const int MAT_MULT_SIZE = 200;
+
+static bool mat_mult_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, 10);
+  JIT_SetMayHaveLoops(ilinjector);
+  JIT_BlockRef blocks[10];
+  for (int b = 0; b < 10; b++)
+    blocks[b] = JIT_GetBlock(ilinjector, b);
+  auto fallthrough = [&](int from) {
+    JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(blocks[from]),
+                   JIT_BlockAsCFGNode(blocks[from + 1]));
+  };
+  auto index = [&](JIT_SymbolRef row, JIT_SymbolRef column) {
+    auto element = JIT_CreateNode2C(
+        OP_iadd,
+        JIT_CreateNode2C(OP_imul, JIT_LoadTemporary(ilinjector, row),
+                         JIT_LoadParameter(ilinjector, 3)),
+        JIT_LoadTemporary(ilinjector, column));
+    return JIT_CreateNode2C(OP_imul, element, JIT_ConstInt32(8));
+  };
+  auto count_up = [&](JIT_SymbolRef v) {
+    JIT_StoreToTemporary(ilinjector, v,
+                         JIT_CreateNode2C(OP_iadd,
+                                          JIT_LoadTemporary(ilinjector, v),
+                                          JIT_ConstInt32(1)));
+  };
+  auto exit_if_done = [&](JIT_SymbolRef v, int exit) {
+    JIT_IfNotZeroValue(ilinjector,
+                       JIT_CreateNode2C(OP_icmpge,
+                                        JIT_LoadTemporary(ilinjector, v),
+                                        JIT_LoadParameter(ilinjector, 3)),
+                       blocks[exit]);
+  };
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto i = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  auto k = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  auto j = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  auto aik = JIT_CreateTemporary(ilinjector, JIT_Double);
+  JIT_StoreToTemporary(ilinjector, i, JIT_ConstInt32(0));
+  fallthrough(0);
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  exit_if_done(i, 9);
+  fallthrough(1);
+
+  JIT_SetCurrentBlock(ilinjector, 2);
+  JIT_StoreToTemporary(ilinjector, k, JIT_ConstInt32(0));
+  fallthrough(2);
+
+  JIT_SetCurrentBlock(ilinjector, 3);
+  exit_if_done(k, 8);
+  fallthrough(3);
+
+  JIT_SetCurrentBlock(ilinjector, 4);
+  JIT_StoreToTemporary(ilinjector, aik,
+                       JIT_ArrayLoad(ilinjector,
+                                     JIT_LoadParameter(ilinjector, 1),
+                                     index(i, k), JIT_Double));
+  JIT_StoreToTemporary(ilinjector, j, JIT_ConstInt32(0));
+  fallthrough(4);
+
+  JIT_SetCurrentBlock(ilinjector, 5);
+  exit_if_done(j, 7);
+  fallthrough(5);
+
+  JIT_SetCurrentBlock(ilinjector, 6);
+  auto c = JIT_ArrayLoad(ilinjector, JIT_LoadParameter(ilinjector, 0),
+                         index(i, j), JIT_Double);
+  auto b = JIT_ArrayLoad(ilinjector, JIT_LoadParameter(ilinjector, 2),
+                         index(k, j), JIT_Double);
+  JIT_ArrayStore(ilinjector, JIT_LoadParameter(ilinjector, 0), index(i, j),
+                 JIT_CreateNode2C(
+                     OP_dadd, c,
+                     JIT_CreateNode2C(OP_dmul,
+                                      JIT_LoadTemporary(ilinjector, aik), b)));
+  count_up(j);
+  JIT_Goto(ilinjector, blocks[5]);
+
+  JIT_SetCurrentBlock(ilinjector, 7);
+  count_up(k);
+  JIT_Goto(ilinjector, blocks[3]);
+
+  JIT_SetCurrentBlock(ilinjector, 8);
+  count_up(i);
+  JIT_Goto(ilinjector, blocks[1]);
+
+  JIT_SetCurrentBlock(ilinjector, 9);
+  JIT_ReturnNoValue(ilinjector);
+  return true;
+}
+
+static int mat_mult(JIT_ContextRef ctx) {
+  typedef void (*F)(double *, double *, double *, int32_t);
+  JIT_Type params[4] = {JIT_Address, JIT_Address, JIT_Address, JIT_Int32};
+  int n = MAT_MULT_SIZE;
+  std::vector<double> a(n * n), b(n * n), c(n * n), expected(n * n);
+  for (int i = 0; i < n * n; i++) {
+    a[i] = i % 7;
+    b[i] = i % 5 - 2;
+  }
+  for (int i = 0; i < n; i++)
+    for (int k = 0; k < n; k++)
+      for (int j = 0; j < n; j++)
+        expected[i * n + j] += a[i * n + k] * b[k * n + j];
+  int rc = 0;
+  for (int opt_level = 1; opt_level <= 2; opt_level++) {
+    JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+        ctx, "mat_mult", JIT_NoType, 4, params, mat_mult_il, NULL);
+    F f = (F)JIT_Compile(function_builder, opt_level);
+    JIT_DestroyFunctionBuilder(function_builder);
+    if (!f) {
+      printf("mat_mult: compile failed at opt level %d\n", opt_level);
+      rc = 1;
+      continue;
+    }
+    double ms = 0;
+    bool correct = true;
+    for (int k = 0; k < iterations; k++) {
+      std::fill(c.begin(), c.end(), 0.0);
+      auto start = std::chrono::steady_clock::now();
+      f(c.data(), a.data(), b.data(), n);
+      auto end = std::chrono::steady_clock::now();
+      std::chrono::duration<double, std::milli> elapsed = end - start;
+      ms += elapsed.count();
+      correct = correct && c == expected;
+    }
+    printf("mat_mult: %dx%d, opt level %d: %.2f ms per call%s\n", n, n,
+           opt_level, ms / iterations, correct ? "" : " (WRONG RESULT)");
+    if (!correct)
+      rc = 1;
+  }
+  return rc;
+}
+
+/*
+Bytecode dispatch loop, the shape of an interpreter generated through the
+C API. The switch on the opcode has dense cases, so it is a run time
+benchmark for jump tables.
+
+  acc = x
+  pc = 0
+  loop:
+    op = code[pc]
+    pc = pc + 1
+    switch (op):
+      case 0: acc = acc + 1
+      case 1: acc = acc - 3
+      ...
+      case 7: acc = acc | 5
+      default: return acc
+    goto loop
+*/
+
+static const int DISPATCH_OPS = 8;
+static const int DISPATCH_LENGTH = 100000;
+
+static JIT_NodeRef dispatch_op(int op, JIT_NodeRef acc, JIT_NodeRef pc) {
+  switch (op) {
+  case 0:
+    return JIT_CreateNode2C(OP_iadd, acc, JIT_ConstInt32(1));
+  case 1:
+    return JIT_CreateNode2C(OP_isub, acc, JIT_ConstInt32(3));
+  case 2:
+    return JIT_CreateNode2C(OP_ixor, acc, pc);
+  case 3:
+    return JIT_CreateNode2C(OP_imul, acc, JIT_ConstInt32(3));
+  case 4:
+    return JIT_CreateNode2C(OP_ishr, acc, JIT_ConstInt32(1));
+  case 5:
+    return JIT_CreateNode2C(OP_iadd, acc, pc);
+  case 6:
+    return JIT_CreateNode2C(OP_iand, acc, JIT_ConstInt32(0xffff));
+  default:
+    return JIT_CreateNode2C(OP_ior, acc, JIT_ConstInt32(5));
+  }
+}
+
+static bool dispatch_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, DISPATCH_OPS + 3);
+  JIT_SetMayHaveLoops(ilinjector);
+  JIT_BlockRef loop = JIT_GetBlock(ilinjector, 1);
+  JIT_BlockRef exit = JIT_GetBlock(ilinjector, DISPATCH_OPS + 2);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto acc = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  auto pc = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_StoreToTemporary(ilinjector, acc, JIT_LoadParameter(ilinjector, 1));
+  JIT_StoreToTemporary(ilinjector, pc, JIT_ConstInt32(0));
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 0)),
+                 JIT_BlockAsCFGNode(loop));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  auto op = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_StoreToTemporary(
+      ilinjector, op,
+      JIT_ArrayLoad(ilinjector, JIT_LoadParameter(ilinjector, 0),
+                    JIT_CreateNode2C(OP_imul, JIT_LoadTemporary(ilinjector, pc),
+                                     JIT_ConstInt32(4)),
+                    JIT_Int32));
+  JIT_StoreToTemporary(ilinjector, pc,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, pc),
+                                        JIT_ConstInt32(1)));
+  JIT_BlockRef case_blocks[DISPATCH_OPS];
+  int32_t case_values[DISPATCH_OPS];
+  for (int i = 0; i < DISPATCH_OPS; i++) {
+    case_blocks[i] = JIT_GetBlock(ilinjector, i + 2);
+    case_values[i] = i;
+  }
+  JIT_Switch(ilinjector, JIT_LoadTemporary(ilinjector, op), exit, DISPATCH_OPS,
+             case_blocks, case_values);
+
+  for (int i = 0; i < DISPATCH_OPS; i++) {
+    JIT_SetCurrentBlock(ilinjector, i + 2);
+    JIT_StoreToTemporary(ilinjector, acc,
+                         dispatch_op(i, JIT_LoadTemporary(ilinjector, acc),
+                                     JIT_LoadTemporary(ilinjector, pc)));
+    JIT_Goto(ilinjector, loop);
+  }
+
+  JIT_SetCurrentBlock(ilinjector, DISPATCH_OPS + 2);
+  JIT_ReturnValue(ilinjector, JIT_LoadTemporary(ilinjector, acc));
+  return true;
+}
+
+static int32_t dispatch_expected(const int32_t *code, int32_t acc) {
+  for (int32_t pc = 0;;) {
+    int32_t op = code[pc++];
+    switch (op) {
+    case 0: acc = (int32_t)((uint32_t)acc + 1); break;
+    case 1: acc = (int32_t)((uint32_t)acc - 3); break;
+    case 2: acc = acc ^ pc; break;
+    case 3: acc = (int32_t)((uint32_t)acc * 3); break;
+    case 4: acc = acc >> 1; break;
+    case 5: acc = (int32_t)((uint32_t)acc + pc); break;
+    case 6: acc = acc & 0xffff; break;
+    case 7: acc = acc | 5; break;
+    default: return acc;
+    }
+  }
+}
+
+static int dispatch(JIT_ContextRef ctx) {
+  typedef int32_t (*F)(const int32_t *, int32_t);
+  JIT_Type params[2] = {JIT_Address, JIT_Int32};
+  std::vector<int32_t> code(DISPATCH_LENGTH + 1);
+  srand(42);
+  for (int i = 0; i < DISPATCH_LENGTH; i++)
+    code[i] = rand() % DISPATCH_OPS;
+  code[DISPATCH_LENGTH] = -1;
+  int32_t expected = dispatch_expected(code.data(), 7);
+  int rc = 0;
+  for (int opt_level = 1; opt_level <= 2; opt_level++) {
+    JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+        ctx, "dispatch", JIT_Int32, 2, params, dispatch_il, NULL);
+    F f = (F)JIT_Compile(function_builder, opt_level);
+    JIT_DestroyFunctionBuilder(function_builder);
+    if (!f) {
+      printf("dispatch: compile failed at opt level %d\n", opt_level);
+      rc = 1;
+      continue;
+    }
+    int32_t result = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int k = 0; k < 10 * iterations; k++)
+      result = f(code.data(), 7);
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::micro> elapsed = end - start;
+    printf("dispatch: %d ops, opt level %d: %.2f us per call%s\n",
+           DISPATCH_LENGTH, opt_level, elapsed.count() / (10 * iterations),
+           result == expected ? "" : " (WRONG RESULT)");
+    if (result != expected)
+      rc = 1;
+  }
+  return rc;
+}
+
+/*
+Byte copy and fill loops, as a C front end generates them for memcpy and
+memset style code. Run time benchmark for the reduction of copy and fill
+loops to arraycopy and arrayset.
+
+  for i in 0 .. n-1:
+    dst[i] = src[i]          (copy)
+    dst[i] = c               (fill)
+*/
+
+static const int BYTE_LOOP_LENGTH = 65536;
+
+static bool byte_loop_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  bool fill = userdata != NULL;
+  JIT_CreateBlocks(ilinjector, 4);
+  JIT_SetMayHaveLoops(ilinjector);
+  JIT_BlockRef entry = JIT_GetBlock(ilinjector, 0);
+  JIT_BlockRef test = JIT_GetBlock(ilinjector, 1);
+  JIT_BlockRef body = JIT_GetBlock(ilinjector, 2);
+  JIT_BlockRef exit = JIT_GetBlock(ilinjector, 3);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto i = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_StoreToTemporary(ilinjector, i, JIT_ConstInt32(0));
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(entry),
+                 JIT_BlockAsCFGNode(test));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  JIT_IfNotZeroValue(ilinjector,
+                     JIT_CreateNode2C(OP_icmpge,
+                                      JIT_LoadTemporary(ilinjector, i),
+                                      JIT_LoadParameter(ilinjector, 2)),
+                     exit);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(test),
+                 JIT_BlockAsCFGNode(body));
+
+  JIT_SetCurrentBlock(ilinjector, 2);
+  auto value = fill ? JIT_ConstInt8(0x5a)
+                    : JIT_ArrayLoad(ilinjector, JIT_LoadParameter(ilinjector, 1),
+                                    JIT_LoadTemporary(ilinjector, i), JIT_Int8);
+  JIT_ArrayStore(ilinjector, JIT_LoadParameter(ilinjector, 0),
+                 JIT_LoadTemporary(ilinjector, i), value);
+  JIT_StoreToTemporary(ilinjector, i,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, i),
+                                        JIT_ConstInt32(1)));
+  JIT_Goto(ilinjector, test);
+
+  JIT_SetCurrentBlock(ilinjector, 3);
+  JIT_ReturnNoValue(ilinjector);
+  return true;
+}
+
+static int byte_loops(JIT_ContextRef ctx) {
+  typedef void (*F)(int8_t *, const int8_t *, int32_t);
+  JIT_Type params[3] = {JIT_Address, JIT_Address, JIT_Int32};
+  int n = BYTE_LOOP_LENGTH;
+  std::vector<int8_t> dst(n), src(n);
+  for (int i = 0; i < n; i++)
+    src[i] = (int8_t)(i * 13);
+  int rc = 0;
+  for (int fill = 0; fill <= 1; fill++) {
+    const char *name = fill ? "byte_fill" : "byte_copy";
+    for (int opt_level = 1; opt_level <= 2; opt_level++) {
+      JIT_FunctionBuilderRef function_builder =
+          JIT_CreateFunctionBuilder(ctx, name, JIT_NoType, 3, params,
+                                    byte_loop_il, fill ? &dst : NULL);
+      F f = (F)JIT_Compile(function_builder, opt_level);
+      JIT_DestroyFunctionBuilder(function_builder);
+      if (!f) {
+        printf("%s: compile failed at opt level %d\n", name, opt_level);
+        rc = 1;
+        continue;
+      }
+      std::fill(dst.begin(), dst.end(), 0);
+      auto start = std::chrono::steady_clock::now();
+      for (int k = 0; k < 100 * iterations; k++)
+        f(dst.data(), src.data(), n);
+      auto end = std::chrono::steady_clock::now();
+      std::chrono::duration<double, std::micro> elapsed = end - start;
+      bool correct = true;
+      for (int i = 0; i < n; i++)
+        correct = correct && dst[i] == (fill ? 0x5a : src[i]);
+      printf("%s: %d bytes, opt level %d: %.2f us per call%s\n", name, n,
+             opt_level, elapsed.count() / (100 * iterations),
+             correct ? "" : " (WRONG RESULT)");
+      if (!correct)
+        rc = 1;
+    }
+  }
+  return rc;
+}
+
+/*
+Bit manipulation intrinsics over an array, run time benchmark for their
+lowering to LZCNT, TZCNT, POPCNT and friends. Compare with TR_DisableAVX=1
+for the sequences used without BMI.
+
+  t = 0
+  for i in 0 .. n-1:
+    t = t + intrinsic(x[i])
+  return t
+*/
+
+static const int INTRINSIC_LOOP_LENGTH = 65536;
+
+static bool intrinsic_loop_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_IntrinsicOp op = *(JIT_IntrinsicOp *)userdata;
+  JIT_CreateBlocks(ilinjector, 4);
+  JIT_SetMayHaveLoops(ilinjector);
+  JIT_BlockRef entry = JIT_GetBlock(ilinjector, 0);
+  JIT_BlockRef test = JIT_GetBlock(ilinjector, 1);
+  JIT_BlockRef body = JIT_GetBlock(ilinjector, 2);
+  JIT_BlockRef exit = JIT_GetBlock(ilinjector, 3);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto i = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  auto t = JIT_CreateTemporary(ilinjector, JIT_Int64);
+  JIT_StoreToTemporary(ilinjector, i, JIT_ConstInt32(0));
+  JIT_StoreToTemporary(ilinjector, t, JIT_ConstInt64(0));
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(entry),
+                 JIT_BlockAsCFGNode(test));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  JIT_IfNotZeroValue(ilinjector,
+                     JIT_CreateNode2C(OP_icmpge,
+                                      JIT_LoadTemporary(ilinjector, i),
+                                      JIT_LoadParameter(ilinjector, 1)),
+                     exit);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(test),
+                 JIT_BlockAsCFGNode(body));
+
+  JIT_SetCurrentBlock(ilinjector, 2);
+  JIT_NodeRef args[2] = {
+      JIT_ArrayLoad(ilinjector, JIT_LoadParameter(ilinjector, 0),
+                    JIT_CreateNode2C(OP_imul, JIT_LoadTemporary(ilinjector, i),
+                                     JIT_ConstInt32(8)),
+                    JIT_Int64),
+      JIT_LoadTemporary(ilinjector, i)};
+  int num_args = op == JIT_IntrinsicRotateLeft ? 2 : 1;
+  auto value = JIT_Intrinsic(ilinjector, op, num_args, args);
+  if (JIT_GetNodeType(value) != JIT_Int64)
+    value = JIT_ConvertTo(ilinjector, value, JIT_Int64, false);
+  JIT_StoreToTemporary(
+      ilinjector, t,
+      JIT_CreateNode2C(OP_ladd, JIT_LoadTemporary(ilinjector, t), value));
+  JIT_StoreToTemporary(ilinjector, i,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, i),
+                                        JIT_ConstInt32(1)));
+  JIT_Goto(ilinjector, test);
+
+  JIT_SetCurrentBlock(ilinjector, 3);
+  JIT_ReturnValue(ilinjector, JIT_LoadTemporary(ilinjector, t));
+  return true;
+}
+
+static int64_t intrinsic_loop_expected(JIT_IntrinsicOp op, const uint64_t *x,
+                                       int32_t n) {
+  uint64_t t = 0;
+  for (int32_t i = 0; i < n; i++) {
+    uint64_t v = x[i], r = 0;
+    int bits = 0;
+    switch (op) {
+    case JIT_IntrinsicClz:
+      while (bits < 64 && !(v & ((uint64_t)1 << (63 - bits))))
+        bits++;
+      r = bits;
+      break;
+    case JIT_IntrinsicCtz:
+      while (bits < 64 && !(v & ((uint64_t)1 << bits)))
+        bits++;
+      r = bits;
+      break;
+    case JIT_IntrinsicPopcount:
+      for (; v; v &= v - 1)
+        r++;
+      break;
+    case JIT_IntrinsicByteSwap:
+      for (int k = 0; k < 8; k++)
+        r = (r << 8) | ((v >> (8 * k)) & 0xff);
+      break;
+    default: /* JIT_IntrinsicRotateLeft */
+      bits = i & 63;
+      r = bits ? (v << bits) | (v >> (64 - bits)) : v;
+      break;
+    }
+    t += r;
+  }
+  return (int64_t)t;
+}
+
+static int intrinsic_loops(JIT_ContextRef ctx) {
+  typedef int64_t (*F)(const uint64_t *, int32_t);
+  JIT_Type params[2] = {JIT_Address, JIT_Int32};
+  static const JIT_IntrinsicOp ops[] = {
+      JIT_IntrinsicClz, JIT_IntrinsicCtz, JIT_IntrinsicPopcount,
+      JIT_IntrinsicByteSwap, JIT_IntrinsicRotateLeft};
+  static const char *names[] = {"clz", "ctz", "popcount", "byteswap",
+                                "rotate"};
+  int n = INTRINSIC_LOOP_LENGTH;
+  std::vector<uint64_t> x(n);
+  uint64_t seed = 0x9e3779b97f4a7c15;
+  for (int i = 0; i < n; i++) {
+    seed = seed * 6364136223846793005 + 1442695040888963407;
+    /* vary the number of leading and trailing zeros */
+    x[i] = (seed >> (seed & 31)) << ((seed >> 40) & 15);
+  }
+  int rc = 0;
+  for (int k = 0; k < 5; k++) {
+    JIT_IntrinsicOp op = ops[k];
+    int64_t expected = intrinsic_loop_expected(op, x.data(), n);
+    for (int opt_level = 1; opt_level <= 2; opt_level++) {
+      JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+          ctx, names[k], JIT_Int64, 2, params, intrinsic_loop_il, &op);
+      F f = (F)JIT_Compile(function_builder, opt_level);
+      JIT_DestroyFunctionBuilder(function_builder);
+      if (!f) {
+        printf("%s: compile failed at opt level %d\n", names[k], opt_level);
+        rc = 1;
+        continue;
+      }
+      int64_t result = 0;
+      auto start = std::chrono::steady_clock::now();
+      for (int j = 0; j < 10 * iterations; j++)
+        result = f(x.data(), n);
+      auto end = std::chrono::steady_clock::now();
+      std::chrono::duration<double, std::nano> elapsed = end - start;
+      printf("%s: %d elements, opt level %d: %.3f ns per element%s\n",
+             names[k], n, opt_level,
+             elapsed.count() / (10.0 * iterations * n),
+             result == expected ? "" : " (WRONG RESULT)");
+      if (result != expected)
+        rc = 1;
+    }
+  }
+  return rc;
+}
+
+/*
+Register pressure: more temporaries than there are registers, all of
+them live around a loop whose body is a chain of diamonds. Measures
+the compile time of global register allocation, which has to choose the
+temporaries that stay in registers, and the run time of the code it
+produces.
+
+  v[k] = x + k                      for k in 0 .. V-1
+  i = 0
+  loop:
+    for s in 0 .. S-1:
+      k = s % V
+      A_s: v[k] = v[k] + (v[(k+1) % V] ^ i)
+           if ((v[k] & 3) != 0) goto A_s+1
+      B_s: v[k] = v[k] * 3
+    i = i + 1
+    if (i < n) goto loop
+  return v[0] ^ v[1] ^ ... ^ v[V-1]
+*/
+
+static const int REGISTER_PRESSURE_TEMPS = 24;
+static const int REGISTER_PRESSURE_STAGES = 96;
+static const int REGISTER_PRESSURE_TRIPS = 10000;
+
+static bool register_pressure_il(JIT_ILInjectorRef ilinjector,
+                                 void *userdata) {
+  int v = REGISTER_PRESSURE_TEMPS;
+  int s = REGISTER_PRESSURE_STAGES;
+  JIT_CreateBlocks(ilinjector, 2 * s + 3);
+  JIT_SetMayHaveLoops(ilinjector);
+  JIT_BlockRef loop = JIT_GetBlock(ilinjector, 1);
+  JIT_BlockRef latch = JIT_GetBlock(ilinjector, 2 * s + 1);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  std::vector<JIT_SymbolRef> temps(v);
+  for (int k = 0; k < v; k++) {
+    temps[k] = JIT_CreateTemporary(ilinjector, JIT_Int32);
+    JIT_StoreToTemporary(ilinjector, temps[k],
+                         JIT_CreateNode2C(OP_iadd,
+                                          JIT_LoadParameter(ilinjector, 0),
+                                          JIT_ConstInt32(k)));
+  }
+  auto i = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_StoreToTemporary(ilinjector, i, JIT_ConstInt32(0));
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 0)),
+                 JIT_BlockAsCFGNode(loop));
+
+  for (int j = 0; j < s; j++) {
+    int k = j % v;
+    JIT_BlockRef a = JIT_GetBlock(ilinjector, 2 * j + 1);
+    JIT_BlockRef b = JIT_GetBlock(ilinjector, 2 * j + 2);
+    JIT_BlockRef next = JIT_GetBlock(ilinjector, 2 * j + 3);
+
+    JIT_SetCurrentBlock(ilinjector, 2 * j + 1);
+    JIT_StoreToTemporary(
+        ilinjector, temps[k],
+        JIT_CreateNode2C(
+            OP_iadd, JIT_LoadTemporary(ilinjector, temps[k]),
+            JIT_CreateNode2C(OP_ixor,
+                             JIT_LoadTemporary(ilinjector, temps[(k + 1) % v]),
+                             JIT_LoadTemporary(ilinjector, i))));
+    JIT_IfNotZeroValue(
+        ilinjector,
+        JIT_CreateNode2C(OP_iand, JIT_LoadTemporary(ilinjector, temps[k]),
+                         JIT_ConstInt32(3)),
+        next);
+    JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(a), JIT_BlockAsCFGNode(b));
+
+    JIT_SetCurrentBlock(ilinjector, 2 * j + 2);
+    JIT_StoreToTemporary(
+        ilinjector, temps[k],
+        JIT_CreateNode2C(OP_imul, JIT_LoadTemporary(ilinjector, temps[k]),
+                         JIT_ConstInt32(3)));
+    JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(b),
+                   JIT_BlockAsCFGNode(next));
+  }
+
+  JIT_SetCurrentBlock(ilinjector, 2 * s + 1);
+  JIT_StoreToTemporary(ilinjector, i,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, i),
+                                        JIT_ConstInt32(1)));
+  JIT_IfNotZeroValue(ilinjector,
+                     JIT_CreateNode2C(OP_icmplt,
+                                      JIT_LoadTemporary(ilinjector, i),
+                                      JIT_LoadParameter(ilinjector, 1)),
+                     loop);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(latch),
+                 JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 2 * s + 2)));
+
+  JIT_SetCurrentBlock(ilinjector, 2 * s + 2);
+  JIT_NodeRef result = JIT_LoadTemporary(ilinjector, temps[0]);
+  for (int k = 1; k < v; k++)
+    result = JIT_CreateNode2C(OP_ixor, result,
+                              JIT_LoadTemporary(ilinjector, temps[k]));
+  JIT_ReturnValue(ilinjector, result);
+  return true;
+}
+
+static int32_t register_pressure_expected(int32_t x, int32_t n) {
+  uint32_t v[REGISTER_PRESSURE_TEMPS];
+  for (int k = 0; k < REGISTER_PRESSURE_TEMPS; k++)
+    v[k] = (uint32_t)x + k;
+  for (int32_t i = 0; i < n; i++) {
+    for (int j = 0; j < REGISTER_PRESSURE_STAGES; j++) {
+      int k = j % REGISTER_PRESSURE_TEMPS;
+      v[k] = v[k] + (v[(k + 1) % REGISTER_PRESSURE_TEMPS] ^ (uint32_t)i);
+      if ((v[k] & 3) == 0)
+        v[k] = v[k] * 3;
+    }
+  }
+  uint32_t result = v[0];
+  for (int k = 1; k < REGISTER_PRESSURE_TEMPS; k++)
+    result ^= v[k];
+  return (int32_t)result;
+}
+
+static void *register_pressure_compile_as(JIT_ContextRef ctx, int opt_level,
+                                          const char *name) {
+  JIT_Type params[2] = {JIT_Int32, JIT_Int32};
+  JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+      ctx, name, JIT_Int32, 2, params, register_pressure_il, NULL);
+  void *code = JIT_Compile(function_builder, opt_level);
+  JIT_DestroyFunctionBuilder(function_builder);
+  return code;
+}
+
+static void *register_pressure_compile(JIT_ContextRef ctx, int opt_level) {
+  return register_pressure_compile_as(ctx, opt_level, "register_pressure");
+}
+
+/* select_allocators() turns the linear scan allocator on for these names */
+static void *register_pressure_scan_compile(JIT_ContextRef ctx,
+                                            int opt_level) {
+  return register_pressure_compile_as(ctx, opt_level, "register_pressure_scan");
+}
+
+static void *register_pressure_scan_only_compile(JIT_ContextRef ctx,
+                                                 int opt_level) {
+  return register_pressure_compile_as(ctx, opt_level,
+                                      "register_pressure_scan_only");
+}
+
+static int register_pressure(JIT_ContextRef ctx) {
+  static const struct {
+    int opt_level;
+    CompileFunction compile;
+    const char *allocator;
+  } configs[] = {{1, register_pressure_compile, "coloring"},
+                 {1, register_pressure_scan_compile, "coloring + linear scan"},
+                 {1, register_pressure_scan_only_compile, "linear scan"},
+                 {2, register_pressure_compile, "coloring"}};
+  typedef int32_t (*F)(int32_t, int32_t);
+  int32_t expected = register_pressure_expected(7, REGISTER_PRESSURE_TRIPS);
+  int rc = 0;
+  for (const auto &config : configs) {
+    int opt_level = config.opt_level;
+    void *code = NULL;
+    double ms = time_compiles(ctx, config.compile, opt_level, &code);
+    if (ms < 0) {
+      printf("register_pressure: compile failed at opt level %d, %s\n",
+             opt_level, config.allocator);
+      rc = 1;
+      continue;
+    }
+    int32_t result = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int k = 0; k < iterations; k++)
+      result = ((F)code)(7, REGISTER_PRESSURE_TRIPS);
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+    printf("register_pressure: %d temps, opt level %d, %s: %.2f ms per "
+           "compile, %.2f ms per call%s\n",
+           REGISTER_PRESSURE_TEMPS, opt_level, config.allocator, ms,
+           elapsed.count() / iterations,
+           result == expected ? "" : " (WRONG RESULT)");
+    if (result != expected)
+      rc = 1;
+  }
+  return rc;
+}
+
+static void select_allocators() {
+  std::string options = "{*_scan_only}(enableLinearScanRA,disableGRA),"
+                        "{*_scan}(enableLinearScanRA)";
+  const char *env = getenv("TR_Options");
+  if (env && *env)
+    options = std::string(env) + "," + options;
+#ifdef _WIN32
+  _putenv_s("TR_Options", options.c_str());
+#else
+  setenv("TR_Options", options.c_str(), 1);
+#endif
+}
+
+int main(int argc, const char *argv[]) {
+  if (argc > 1)
+    iterations = atoi(argv[1]) > 0 ? atoi(argv[1]) : iterations;
+  int errorcount = 0;
+  select_allocators();
+  JIT_ContextRef ctx = JIT_CreateContext();
+  if (ctx) {
+    errorcount += block_heavy(ctx);
+    errorcount += many_locals(ctx);
+    errorcount += large_function(ctx);
+    errorcount += dot_product(ctx);
+    errorcount += mat_mult(ctx);
+    errorcount += dispatch(ctx);
+    errorcount += byte_loops(ctx);
+    errorcount += intrinsic_loops(ctx);
+    errorcount += register_pressure(ctx);
+    errorcount += node_creation(ctx);
+  } else {
+    errorcount = 1;
+  }
+  JIT_DestroyContext(ctx);
+  return errorcount == 0 ? 0 : 1;
+}
@@ -1,6 +1,12 @@
 #include "nj_api.h"
 
+#include <cmath>
+#include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
 
 /*
 Define environment variable
@@ -113,13 +119,2471 @@ static int test3(JIT_ContextRef ctx) {
   return rc;
 }
 
+static int test4(JIT_ContextRef ctx) {
+  JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+      ctx, "ret4", JIT_Int32, 0, NULL, test1_il, NULL);
+  int rc = 1;
+  void *f = JIT_Compile(function_builder, 0);
+  if (f) {
+    JIT_FunctionInfo info;
+    bool found = JIT_LookupFunctionByPC((char *)f + 1, &info);
+    printf("Lookup of %p found %s\n", f, found ? info.name : "nothing");
+    if (found && strcmp(info.name, "ret4") == 0 && info.start_pc <= f &&
+        f < info.end_pc && !JIT_LookupFunctionByPC((void *)callme, &info))
+      rc = 0;
+  }
+  JIT_DestroyFunctionBuilder(function_builder);
+  return rc;
+}
+
+static bool test5_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, 1);
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto input = JIT_LoadParameter(ilinjector, 0);
+  JIT_NodeRef args[] = { input };
+  auto value = JIT_Call(ilinjector, "ret5_callee", 1, args); // JIT compiled
+  auto node = JIT_CreateNode1C(OP_ireturn, value);
+  JIT_GenerateTreeTop(ilinjector, node);
+  JIT_CFGAddEdge(ilinjector,
+                 JIT_BlockAsCFGNode(JIT_GetCurrentBlock(ilinjector)),
+                 JIT_GetCFGEnd(ilinjector));
+  return true;
+}
+
+static int test5(JIT_ContextRef ctx) {
+  JIT_Type params[1] = {
+      JIT_Int32
+  };
+  // Compaction is refused until it is enabled. The earlier tests' functions
+  // were compiled before that, so they are not moved and still run after it.
+  if (JIT_CompactCodeCache(ctx) != -1)
+    return 1;
+  JIT_EnableCodeCacheCompaction(ctx);
+  // Recompiling replaces the registered function, leaving dead code behind
+  for (int i = 0; i < 3; i++) {
+    JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+        ctx, "ret5_callee", JIT_Int32, 1, params, test3_il, NULL);
+    JIT_Compile(function_builder, 0);
+    JIT_DestroyFunctionBuilder(function_builder);
+  }
+  JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+      ctx, "ret5", JIT_Int32, 1, params, test5_il, NULL);
+  void *before = JIT_Compile(function_builder, 1);
+  JIT_DestroyFunctionBuilder(function_builder);
+  // Names handed out before compaction stay valid after it
+  JIT_FunctionInfo before_info = {NULL, NULL, NULL};
+  JIT_LookupFunctionByPC(before, &before_info);
+  int count = JIT_CompactCodeCache(ctx);
+  typedef int32_t (*F)(int32_t);
+  F f = (F)JIT_GetFunction(ctx, "ret5");
+  typedef int32_t (*F4)(void);
+  F4 f4 = (F4)JIT_GetFunction(ctx, "ret4");
+  int rc = 1;
+  if (before && f && f4 && f4() == 42) {
+    int32_t result = f(-42);
+    JIT_FunctionInfo info;
+    bool found = JIT_LookupFunctionByPC((void *)f, &info);
+    printf("Compaction changed %d functions, %p moved to %p, returned %d, "
+           "expected 0\n",
+           count, before, (void *)f, result);
+    // The dead copies of ret5_callee below ret5 are freed, and it moves down
+    if (count >= 2 && result == 0 && (char *)f < (char *)before && found &&
+        strcmp(info.name, "ret5") == 0 &&
+        before_info.name && strcmp(before_info.name, "ret5") == 0 &&
+        !JIT_LookupFunctionByPC(before, &info))
+      rc = 0;
+  }
+  return rc;
+}
+
+/*
+  void vadd(int32_t *dst, int32_t *a, int32_t *b, int32_t n) {
+    for (int32_t i = 0; i < n; i++)
+      dst[i] = a[i] + b[i];
+  }
+At opt level 2 the loop is vectorized; the scalar loop handles the trip
+counts that are not a multiple of the vector length and the calls where
+dst overlaps the inputs.
+*/
+static bool test6_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, 4);
+  JIT_SetMayHaveLoops(ilinjector);
+  JIT_BlockRef entry = JIT_GetBlock(ilinjector, 0);
+  JIT_BlockRef test = JIT_GetBlock(ilinjector, 1);
+  JIT_BlockRef body = JIT_GetBlock(ilinjector, 2);
+  JIT_BlockRef exit = JIT_GetBlock(ilinjector, 3);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto i = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_StoreToTemporary(ilinjector, i, JIT_ConstInt32(0));
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(entry),
+                 JIT_BlockAsCFGNode(test));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  auto done = JIT_CreateNode2C(OP_icmpge, JIT_LoadTemporary(ilinjector, i),
+                               JIT_LoadParameter(ilinjector, 3));
+  JIT_IfNotZeroValue(ilinjector, done, exit);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(test),
+                 JIT_BlockAsCFGNode(body));
+
+  JIT_SetCurrentBlock(ilinjector, 2);
+  auto offset = JIT_CreateNode2C(OP_imul, JIT_LoadTemporary(ilinjector, i),
+                                 JIT_ConstInt32(4));
+  auto a = JIT_ArrayLoad(ilinjector, JIT_LoadParameter(ilinjector, 1),
+                         offset, JIT_Int32);
+  auto b = JIT_ArrayLoad(ilinjector, JIT_LoadParameter(ilinjector, 2),
+                         offset, JIT_Int32);
+  JIT_ArrayStore(ilinjector, JIT_LoadParameter(ilinjector, 0), offset,
+                 JIT_CreateNode2C(OP_iadd, a, b));
+  JIT_StoreToTemporary(ilinjector, i,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, i),
+                                        JIT_ConstInt32(1)));
+  JIT_Goto(ilinjector, test);
+
+  JIT_SetCurrentBlock(ilinjector, 3);
+  JIT_ReturnNoValue(ilinjector);
+  return true;
+}
+
+static int test6(JIT_ContextRef ctx) {
+  JIT_Type params[4] = {JIT_Address, JIT_Address, JIT_Address, JIT_Int32};
+  JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+      ctx, "vadd", JIT_NoType, 4, params, test6_il, NULL);
+  typedef void (*F)(int32_t *, int32_t *, int32_t *, int32_t);
+  int64_t vectorized =
+      JIT_GetStaticDebugCounter(ctx, "loopVectorizer/vectorized");
+  F f = (F)JIT_Compile(function_builder, 2);
+  JIT_DestroyFunctionBuilder(function_builder);
+  if (!f)
+    return 1;
+  if (JIT_GetStaticDebugCounter(ctx, "loopVectorizer/vectorized") ==
+      vectorized) {
+    printf("Loop was not vectorized\n");
+    return 1;
+  }
+  // dst is placed at offsets from a that cover no overlap, an exact
+  // overlap and overlaps within a vector in both directions
+  const int dst_offsets[] = {64, 0, 1, -1, 3, -3, 4};
+  int failures = 0;
+  for (int n = 0; n <= 19; n++) {
+    for (int k = 0; k < (int)(sizeof(dst_offsets) / sizeof(dst_offsets[0]));
+         k++) {
+      int32_t data[128], expected[128], b[32];
+      for (int j = 0; j < 128; j++)
+        data[j] = expected[j] = j * 3;
+      for (int j = 0; j < 32; j++)
+        b[j] = 100 - j;
+      int32_t *a = data + 32;
+      int32_t *dst = a + dst_offsets[k];
+      int32_t *expected_a = expected + 32;
+      int32_t *expected_dst = expected_a + dst_offsets[k];
+      for (int j = 0; j < n; j++)
+        expected_dst[j] = expected_a[j] + b[j];
+      f(dst, a, b, n);
+      if (memcmp(data, expected, sizeof(data)) != 0)
+        failures++;
+    }
+  }
+  printf("Vectorized loop gave %d wrong results\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*
+  void spread(int32_t *dst, int32_t *src, int32_t n) {
+    for (int32_t i = 0; i < n; i++) {
+      dst[2 * i] = src[i] + src[i + 1];
+      dst[2 * i + 1] = src[i];
+    }
+  }
+At opt level 2 the loop is versioned on dst and src being disjoint; the
+original loop runs when they overlap.
+*/
+static bool test7_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, 4);
+  JIT_SetMayHaveLoops(ilinjector);
+  JIT_BlockRef entry = JIT_GetBlock(ilinjector, 0);
+  JIT_BlockRef test = JIT_GetBlock(ilinjector, 1);
+  JIT_BlockRef body = JIT_GetBlock(ilinjector, 2);
+  JIT_BlockRef exit = JIT_GetBlock(ilinjector, 3);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto i = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_StoreToTemporary(ilinjector, i, JIT_ConstInt32(0));
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(entry),
+                 JIT_BlockAsCFGNode(test));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  auto done = JIT_CreateNode2C(OP_icmpge, JIT_LoadTemporary(ilinjector, i),
+                               JIT_LoadParameter(ilinjector, 2));
+  JIT_IfNotZeroValue(ilinjector, done, exit);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(test),
+                 JIT_BlockAsCFGNode(body));
+
+  JIT_SetCurrentBlock(ilinjector, 2);
+  auto offset = JIT_CreateNode2C(OP_imul, JIT_LoadTemporary(ilinjector, i),
+                                 JIT_ConstInt32(4));
+  auto a = JIT_ArrayLoad(ilinjector, JIT_LoadParameter(ilinjector, 1),
+                         offset, JIT_Int32);
+  auto b = JIT_ArrayLoad(
+      ilinjector, JIT_LoadParameter(ilinjector, 1),
+      JIT_CreateNode2C(OP_iadd, offset, JIT_ConstInt32(4)), JIT_Int32);
+  JIT_ArrayStore(ilinjector, JIT_LoadParameter(ilinjector, 0),
+                 JIT_CreateNode2C(OP_imul, offset, JIT_ConstInt32(2)),
+                 JIT_CreateNode2C(OP_iadd, a, b));
+  // src[i] may only be commoned across the first store if dst and src
+  // are disjoint
+  JIT_ArrayStore(
+      ilinjector, JIT_LoadParameter(ilinjector, 0),
+      JIT_CreateNode2C(OP_iadd,
+                       JIT_CreateNode2C(OP_imul, offset, JIT_ConstInt32(2)),
+                       JIT_ConstInt32(4)),
+      JIT_ArrayLoad(ilinjector, JIT_LoadParameter(ilinjector, 1), offset,
+                    JIT_Int32));
+  JIT_StoreToTemporary(ilinjector, i,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, i),
+                                        JIT_ConstInt32(1)));
+  JIT_Goto(ilinjector, test);
+
+  JIT_SetCurrentBlock(ilinjector, 3);
+  JIT_ReturnNoValue(ilinjector);
+  return true;
+}
+
+static int test7(JIT_ContextRef ctx) {
+  JIT_Type params[3] = {JIT_Address, JIT_Address, JIT_Int32};
+  JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+      ctx, "spread", JIT_NoType, 3, params, test7_il, NULL);
+  typedef void (*F)(int32_t *, int32_t *, int32_t);
+  int64_t versioned =
+      JIT_GetStaticDebugCounter(ctx, "loopVersioner/disjointArrays");
+  F f = (F)JIT_Compile(function_builder, 2);
+  JIT_DestroyFunctionBuilder(function_builder);
+  if (!f)
+    return 1;
+  if (JIT_GetStaticDebugCounter(ctx, "loopVersioner/disjointArrays") ==
+      versioned) {
+    printf("Loop was not versioned on disjoint arrays\n");
+    return 1;
+  }
+  // dst is placed at offsets from src that cover no overlap, overlaps at
+  // either end of the accessed ranges and dst inside src
+  const int dst_offsets[] = {-64, 64, -30, 16, 0, 1, -1, 7};
+  int failures = 0;
+  for (int n = 0; n <= 16; n++) {
+    for (int k = 0; k < (int)(sizeof(dst_offsets) / sizeof(dst_offsets[0]));
+         k++) {
+      int32_t data[192], expected[192];
+      for (int j = 0; j < 192; j++)
+        data[j] = expected[j] = j * 5 - 7;
+      int32_t *src = data + 96;
+      int32_t *dst = src + dst_offsets[k];
+      int32_t *expected_src = expected + 96;
+      int32_t *expected_dst = expected_src + dst_offsets[k];
+      for (int j = 0; j < n; j++) {
+        expected_dst[2 * j] = expected_src[j] + expected_src[j + 1];
+        expected_dst[2 * j + 1] = expected_src[j];
+      }
+      f(dst, src, n);
+      if (memcmp(data, expected, sizeof(data)) != 0)
+        failures++;
+    }
+  }
+  printf("Alias versioned loop gave %d wrong results\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*
+  double sum(int32_t n) {
+    struct { int32_t count; double total; } s;
+    s.count = 0;
+    s.total = 0.0;
+    for (int32_t i = 0; i < n; i++) {
+      s.count = s.count + i;
+      s.total = s.total + 0.5;
+    }
+    return s.total + s.count;
+  }
+The address of s does not escape, so its fields are replaced by temporaries.
+*/
+static bool test8_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, 4);
+  JIT_SetMayHaveLoops(ilinjector);
+  JIT_BlockRef entry = JIT_GetBlock(ilinjector, 0);
+  JIT_BlockRef test = JIT_GetBlock(ilinjector, 1);
+  JIT_BlockRef body = JIT_GetBlock(ilinjector, 2);
+  JIT_BlockRef exit = JIT_GetBlock(ilinjector, 3);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto s = JIT_CreateLocalByteArray(ilinjector, 16);
+  auto i = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_ArrayStoreAt(ilinjector, 0, JIT_LoadAddress(ilinjector, s), 0,
+                   JIT_ConstInt32(0));
+  JIT_ArrayStoreAt(ilinjector, 0, JIT_LoadAddress(ilinjector, s), 8,
+                   JIT_ConstDouble(0.0));
+  JIT_StoreToTemporary(ilinjector, i, JIT_ConstInt32(0));
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(entry),
+                 JIT_BlockAsCFGNode(test));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  auto done = JIT_CreateNode2C(OP_icmpge, JIT_LoadTemporary(ilinjector, i),
+                               JIT_LoadParameter(ilinjector, 0));
+  JIT_IfNotZeroValue(ilinjector, done, exit);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(test),
+                 JIT_BlockAsCFGNode(body));
+
+  JIT_SetCurrentBlock(ilinjector, 2);
+  auto count = JIT_ArrayLoadAt(ilinjector, 0, JIT_LoadAddress(ilinjector, s),
+                               0, JIT_Int32);
+  JIT_ArrayStoreAt(
+      ilinjector, 0, JIT_LoadAddress(ilinjector, s), 0,
+      JIT_CreateNode2C(OP_iadd, count, JIT_LoadTemporary(ilinjector, i)));
+  auto total = JIT_ArrayLoadAt(ilinjector, 0, JIT_LoadAddress(ilinjector, s),
+                               8, JIT_Double);
+  JIT_ArrayStoreAt(ilinjector, 0, JIT_LoadAddress(ilinjector, s), 8,
+                   JIT_CreateNode2C(OP_dadd, total, JIT_ConstDouble(0.5)));
+  JIT_StoreToTemporary(ilinjector, i,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, i),
+                                        JIT_ConstInt32(1)));
+  JIT_Goto(ilinjector, test);
+
+  JIT_SetCurrentBlock(ilinjector, 3);
+  count = JIT_ArrayLoadAt(ilinjector, 0, JIT_LoadAddress(ilinjector, s), 0,
+                          JIT_Int32);
+  total = JIT_ArrayLoadAt(ilinjector, 0, JIT_LoadAddress(ilinjector, s), 8,
+                          JIT_Double);
+  JIT_ReturnValue(ilinjector,
+                  JIT_CreateNode2C(OP_dadd, total,
+                                   JIT_CreateNode1C(OP_i2d, count)));
+  return true;
+}
+
+static int test8(JIT_ContextRef ctx) {
+  JIT_Type params[1] = {JIT_Int32};
+  int failures = 0;
+  for (int opt_level = 0; opt_level <= 2; opt_level++) {
+    JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+        ctx, "sum", JIT_Double, 1, params, test8_il, NULL);
+    typedef double (*F)(int32_t);
+    int64_t scalarized = JIT_GetStaticDebugCounter(
+        ctx, "localArrayScalarization/scalarized");
+    F f = (F)JIT_Compile(function_builder, opt_level);
+    JIT_DestroyFunctionBuilder(function_builder);
+    if (!f)
+      return 1;
+    // Scalarization runs from opt level 1
+    if ((JIT_GetStaticDebugCounter(ctx, "localArrayScalarization/scalarized") >
+         scalarized) != (opt_level > 0)) {
+      printf("Local struct was %sscalarized at opt level %d\n",
+             opt_level > 0 ? "not " : "", opt_level);
+      failures++;
+    }
+    for (int n = 0; n <= 100; n += 25) {
+      if (f(n) != n * (n - 1) / 2 + 0.5 * n)
+        failures++;
+    }
+  }
+  printf("Local struct loop gave %d wrong results\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*
+  int32_t alias(int32_t n) {
+    int32_t t = 0;
+    int32_t *p = &t;
+    for (int32_t i = 0; i < n; i++) {
+      *p = i * 2;
+      t = t + 1;
+    }
+    return t;
+  }
+The store through p must be seen by the direct accesses of t.
+*/
+static bool test9_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, 4);
+  JIT_SetMayHaveLoops(ilinjector);
+  JIT_BlockRef entry = JIT_GetBlock(ilinjector, 0);
+  JIT_BlockRef test = JIT_GetBlock(ilinjector, 1);
+  JIT_BlockRef body = JIT_GetBlock(ilinjector, 2);
+  JIT_BlockRef exit = JIT_GetBlock(ilinjector, 3);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto t = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  auto p = JIT_CreateTemporary(ilinjector, JIT_Address);
+  auto i = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_StoreToTemporary(ilinjector, t, JIT_ConstInt32(0));
+  JIT_StoreToTemporary(ilinjector, p, JIT_LoadAddress(ilinjector, t));
+  JIT_StoreToTemporary(ilinjector, i, JIT_ConstInt32(0));
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(entry),
+                 JIT_BlockAsCFGNode(test));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  auto done = JIT_CreateNode2C(OP_icmpge, JIT_LoadTemporary(ilinjector, i),
+                               JIT_LoadParameter(ilinjector, 0));
+  JIT_IfNotZeroValue(ilinjector, done, exit);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(test),
+                 JIT_BlockAsCFGNode(body));
+
+  JIT_SetCurrentBlock(ilinjector, 2);
+  JIT_ArrayStoreAt(ilinjector, 0, JIT_LoadTemporary(ilinjector, p), 0,
+                   JIT_CreateNode2C(OP_imul, JIT_LoadTemporary(ilinjector, i),
+                                    JIT_ConstInt32(2)));
+  JIT_StoreToTemporary(ilinjector, t,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, t),
+                                        JIT_ConstInt32(1)));
+  JIT_StoreToTemporary(ilinjector, i,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, i),
+                                        JIT_ConstInt32(1)));
+  JIT_Goto(ilinjector, test);
+
+  JIT_SetCurrentBlock(ilinjector, 3);
+  JIT_ReturnValue(ilinjector, JIT_LoadTemporary(ilinjector, t));
+  return true;
+}
+
+static int test9(JIT_ContextRef ctx) {
+  JIT_Type params[1] = {JIT_Int32};
+  int failures = 0;
+  for (int opt_level = 0; opt_level <= 2; opt_level++) {
+    JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+        ctx, "alias", JIT_Int32, 1, params, test9_il, NULL);
+    typedef int32_t (*F)(int32_t);
+    F f = (F)JIT_Compile(function_builder, opt_level);
+    JIT_DestroyFunctionBuilder(function_builder);
+    if (!f)
+      return 1;
+    for (int n = 0; n <= 100; n += 25) {
+      if (f(n) != (n == 0 ? 0 : 2 * (n - 1) + 1))
+        failures++;
+    }
+  }
+  printf("Address taken local gave %d wrong results\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*
+  double tagged(double *a, double *b) {
+    a[0] = 1.0;    // alias class 1
+    b[0] = 2.0;    // alias class 2
+    double x = a[0];  // alias class 1
+    a[0] = 3.0;    // alias class 1
+    double y = a[0];  // untagged
+    return x + y + b[0];  // b[0] with alias class 2
+  }
+Accesses of different alias classes are independent, but the untagged load
+must still see the tagged store.
+*/
+static bool test10_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, 1);
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto a = JIT_CreateTemporary(ilinjector, JIT_Address);
+  auto b = JIT_CreateTemporary(ilinjector, JIT_Address);
+  auto x = JIT_CreateTemporary(ilinjector, JIT_Double);
+  auto y = JIT_CreateTemporary(ilinjector, JIT_Double);
+  JIT_StoreToTemporary(ilinjector, a, JIT_LoadParameter(ilinjector, 0));
+  JIT_StoreToTemporary(ilinjector, b, JIT_LoadParameter(ilinjector, 1));
+  JIT_ArrayStoreAtInAliasClass(ilinjector, 1, JIT_LoadTemporary(ilinjector, a),
+                               0, JIT_ConstDouble(1.0));
+  JIT_ArrayStoreAtInAliasClass(ilinjector, 2, JIT_LoadTemporary(ilinjector, b),
+                               0, JIT_ConstDouble(2.0));
+  JIT_StoreToTemporary(
+      ilinjector, x,
+      JIT_ArrayLoadAtInAliasClass(ilinjector, 1,
+                                  JIT_LoadTemporary(ilinjector, a), 0,
+                                  JIT_Double));
+  JIT_ArrayStoreAtInAliasClass(ilinjector, 1, JIT_LoadTemporary(ilinjector, a),
+                               0, JIT_ConstDouble(3.0));
+  JIT_StoreToTemporary(ilinjector, y,
+                       JIT_ArrayLoadAt(ilinjector, 0,
+                                       JIT_LoadTemporary(ilinjector, a), 0,
+                                       JIT_Double));
+  auto sum = JIT_CreateNode2C(OP_dadd, JIT_LoadTemporary(ilinjector, x),
+                              JIT_LoadTemporary(ilinjector, y));
+  JIT_ReturnValue(
+      ilinjector,
+      JIT_CreateNode2C(OP_dadd, sum,
+                       JIT_ArrayLoadAtInAliasClass(
+                           ilinjector, 2, JIT_LoadTemporary(ilinjector, b), 0,
+                           JIT_Double)));
+  return true;
+}
+
+static int test10(JIT_ContextRef ctx) {
+  JIT_Type params[2] = {JIT_Address, JIT_Address};
+  int failures = 0;
+  for (int opt_level = 0; opt_level <= 2; opt_level++) {
+    JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+        ctx, "tagged", JIT_Double, 2, params, test10_il, NULL);
+    typedef double (*F)(double *, double *);
+    F f = (F)JIT_Compile(function_builder, opt_level);
+    JIT_DestroyFunctionBuilder(function_builder);
+    if (!f)
+      return 1;
+    double a = 0.0, b = 0.0;
+    if (f(&a, &b) != 6.0 || a != 3.0 || b != 2.0)
+      failures++;
+  }
+  printf("Alias class accesses gave %d wrong results\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*
+  int32_t scale(int32_t *restrict dst, const int32_t *restrict nonnull src,
+                int32_t n) {
+    if (src == NULL)
+      return -1;
+    for (int32_t i = 0; i < n; i++)
+      dst[i] = src[i] * 3;
+    return 0;
+  }
+The null test folds away and the accesses through dst and src are
+independent.
+*/
+static bool test11_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, 5);
+  JIT_SetMayHaveLoops(ilinjector);
+  JIT_BlockRef entry = JIT_GetBlock(ilinjector, 0);
+  JIT_BlockRef test = JIT_GetBlock(ilinjector, 1);
+  JIT_BlockRef body = JIT_GetBlock(ilinjector, 2);
+  JIT_BlockRef exit = JIT_GetBlock(ilinjector, 3);
+  JIT_BlockRef null_src = JIT_GetBlock(ilinjector, 4);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto i = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_IfNotZeroValue(ilinjector,
+                     JIT_CreateNode2C(OP_acmpeq,
+                                      JIT_LoadParameter(ilinjector, 1),
+                                      JIT_ConstAddress(NULL)),
+                     null_src);
+  JIT_StoreToTemporary(ilinjector, i, JIT_ConstInt32(0));
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(entry),
+                 JIT_BlockAsCFGNode(test));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  auto done = JIT_CreateNode2C(OP_icmpge, JIT_LoadTemporary(ilinjector, i),
+                               JIT_LoadParameter(ilinjector, 2));
+  JIT_IfNotZeroValue(ilinjector, done, exit);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(test),
+                 JIT_BlockAsCFGNode(body));
+
+  JIT_SetCurrentBlock(ilinjector, 2);
+  auto offset = JIT_CreateNode2C(OP_imul, JIT_LoadTemporary(ilinjector, i),
+                                 JIT_ConstInt32(4));
+  auto value = JIT_ArrayLoad(ilinjector, JIT_LoadParameter(ilinjector, 1),
+                             offset, JIT_Int32);
+  JIT_ArrayStore(ilinjector, JIT_LoadParameter(ilinjector, 0), offset,
+                 JIT_CreateNode2C(OP_imul, value, JIT_ConstInt32(3)));
+  JIT_StoreToTemporary(ilinjector, i,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, i),
+                                        JIT_ConstInt32(1)));
+  JIT_Goto(ilinjector, test);
+
+  JIT_SetCurrentBlock(ilinjector, 3);
+  JIT_ReturnValue(ilinjector, JIT_ConstInt32(0));
+
+  JIT_SetCurrentBlock(ilinjector, 4);
+  JIT_ReturnValue(ilinjector, JIT_ConstInt32(-1));
+  return true;
+}
+
+/* Stores through a read only parameter must fail the compile */
+static bool test11_readonly_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, 1);
+  JIT_SetCurrentBlock(ilinjector, 0);
+  JIT_ArrayStore(ilinjector, JIT_LoadParameter(ilinjector, 0),
+                 JIT_ConstInt32(0), JIT_ConstInt32(1));
+  JIT_ReturnValue(ilinjector, JIT_ConstInt32(0));
+  return true;
+}
+
+static int test11(JIT_ContextRef ctx) {
+  JIT_Type params[3] = {JIT_Address, JIT_Address, JIT_Int32};
+  int failures = 0;
+  for (int opt_level = 0; opt_level <= 2; opt_level++) {
+    JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+        ctx, "scale", JIT_Int32, 3, params, test11_il, NULL);
+    JIT_SetParameterAttributes(function_builder, 0, JIT_ParamRestrict, 16);
+    JIT_SetParameterAttributes(
+        function_builder, 1,
+        JIT_ParamRestrict | JIT_ParamNonNull | JIT_ParamReadOnly, 16);
+    typedef int32_t (*F)(int32_t *, const int32_t *, int32_t);
+    F f = (F)JIT_Compile(function_builder, opt_level);
+    JIT_DestroyFunctionBuilder(function_builder);
+    if (!f)
+      return 1;
+    for (int n = 0; n <= 19; n++) {
+      int32_t src[32], dst[32];
+      for (int j = 0; j < 32; j++) {
+        src[j] = j - 7;
+        dst[j] = 1000;
+      }
+      if (f(dst, src, n) != 0)
+        failures++;
+      for (int j = 0; j < 32; j++) {
+        if (dst[j] != (j < n ? 3 * (j - 7) : 1000))
+          failures++;
+      }
+    }
+  }
+  for (int opt_level = 0; opt_level <= 2; opt_level++) {
+    JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+        ctx, "store_readonly", JIT_Int32, 1, params, test11_readonly_il, NULL);
+    JIT_SetParameterAttributes(function_builder, 0, JIT_ParamReadOnly, 0);
+    if (JIT_Compile(function_builder, opt_level)) {
+      printf("Store through a read only parameter compiled at opt level %d\n",
+             opt_level);
+      failures++;
+    }
+    JIT_DestroyFunctionBuilder(function_builder);
+  }
+  printf("Parameter attributes had %d failures\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+static int32_t square_calls;
+static int32_t square(int32_t x) {
+  square_calls++;
+  return x * x;
+}
+
+/*
+  int32_t sumsq(int32_t x, int32_t n) {
+    int32_t s = square(x) + square(x);
+    for (int32_t i = 0; i < n; i++)
+      s = s + square(x);
+    return s;
+  }
+square() is registered as const, so the two calls in the entry block are
+commoned and the call in the loop is hoisted. The call counter square()
+keeps breaks the promise on purpose to observe this.
+*/
+static bool test12_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, 4);
+  JIT_SetMayHaveLoops(ilinjector);
+  JIT_BlockRef entry = JIT_GetBlock(ilinjector, 0);
+  JIT_BlockRef test = JIT_GetBlock(ilinjector, 1);
+  JIT_BlockRef body = JIT_GetBlock(ilinjector, 2);
+  JIT_BlockRef exit = JIT_GetBlock(ilinjector, 3);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto s = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  auto i = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_NodeRef args[1] = {JIT_LoadParameter(ilinjector, 0)};
+  auto first = JIT_Call(ilinjector, "square", 1, args);
+  auto second = JIT_Call(ilinjector, "square", 1, args);
+  JIT_StoreToTemporary(ilinjector, s,
+                       JIT_CreateNode2C(OP_iadd, first, second));
+  JIT_StoreToTemporary(ilinjector, i, JIT_ConstInt32(0));
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(entry),
+                 JIT_BlockAsCFGNode(test));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  auto done = JIT_CreateNode2C(OP_icmpge, JIT_LoadTemporary(ilinjector, i),
+                               JIT_LoadParameter(ilinjector, 1));
+  JIT_IfNotZeroValue(ilinjector, done, exit);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(test),
+                 JIT_BlockAsCFGNode(body));
+
+  JIT_SetCurrentBlock(ilinjector, 2);
+  JIT_NodeRef loop_args[1] = {JIT_LoadParameter(ilinjector, 0)};
+  auto value = JIT_Call(ilinjector, "square", 1, loop_args);
+  JIT_StoreToTemporary(ilinjector, s,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, s),
+                                        value));
+  JIT_StoreToTemporary(ilinjector, i,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, i),
+                                        JIT_ConstInt32(1)));
+  JIT_Goto(ilinjector, test);
+
+  JIT_SetCurrentBlock(ilinjector, 3);
+  JIT_ReturnValue(ilinjector, JIT_LoadTemporary(ilinjector, s));
+  return true;
+}
+
+static int test12(JIT_ContextRef ctx) {
+  JIT_Type params[2] = {JIT_Int32, JIT_Int32};
+  JIT_RegisterFunction(ctx, "square", JIT_Int32, 1, params, (void *)square);
+  JIT_SetFunctionAttributes(ctx, "square", JIT_FunctionConst);
+  int failures = 0;
+  for (int opt_level = 0; opt_level <= 2; opt_level++) {
+    JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+        ctx, "sumsq", JIT_Int32, 2, params, test12_il, NULL);
+    typedef int32_t (*F)(int32_t, int32_t);
+    F f = (F)JIT_Compile(function_builder, opt_level);
+    JIT_DestroyFunctionBuilder(function_builder);
+    if (!f)
+      return 1;
+    square_calls = 0;
+    if (f(7, 10) != 12 * 49)
+      failures++;
+    // Unoptimized code makes every call; the optimizer makes one call in
+    // the entry block and, at opt level 2, one for the hoisted loop call
+    if (square_calls > (opt_level == 0 ? 12 : (opt_level == 1 ? 11 : 2)))
+      failures++;
+  }
+  printf("Const function calls gave %d wrong results\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*
+  int64_t countdown(int64_t n, int64_t acc, void *self) {
+    if (n == 0)
+      return acc;
+    return ((F)self)(n - 1, acc + n, self);
+  }
+The call is a tail call, so a million levels of recursion run in the
+frame of the first call rather than overflowing the stack.
+*/
+static bool test13_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, 3);
+  JIT_BlockRef entry = JIT_GetBlock(ilinjector, 0);
+  JIT_BlockRef call = JIT_GetBlock(ilinjector, 1);
+  JIT_BlockRef done = JIT_GetBlock(ilinjector, 2);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  JIT_IfNotZeroValue(ilinjector,
+                     JIT_CreateNode2C(OP_lcmpeq,
+                                      JIT_LoadParameter(ilinjector, 0),
+                                      JIT_ConstInt64(0)),
+                     done);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(entry),
+                 JIT_BlockAsCFGNode(call));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  JIT_NodeRef args[3] = {
+      JIT_CreateNode2C(OP_lsub, JIT_LoadParameter(ilinjector, 0),
+                       JIT_ConstInt64(1)),
+      JIT_CreateNode2C(OP_ladd, JIT_LoadParameter(ilinjector, 1),
+                       JIT_LoadParameter(ilinjector, 0)),
+      JIT_LoadParameter(ilinjector, 2)};
+  JIT_IndirectTailCall(ilinjector, JIT_LoadParameter(ilinjector, 2),
+                       JIT_Int64, 3, args);
+
+  JIT_SetCurrentBlock(ilinjector, 2);
+  JIT_ReturnValue(ilinjector, JIT_LoadParameter(ilinjector, 1));
+  return true;
+}
+
+/*
+  int32_t next_square(int32_t x) {
+    return square(x + 1);
+  }
+*/
+static bool test13_direct_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, 1);
+  JIT_SetCurrentBlock(ilinjector, 0);
+  JIT_NodeRef args[1] = {JIT_CreateNode2C(
+      OP_iadd, JIT_LoadParameter(ilinjector, 0), JIT_ConstInt32(1))};
+  JIT_TailCall(ilinjector, "square", 1, args);
+  return true;
+}
+
+static int test13(JIT_ContextRef ctx) {
+  JIT_Type params[3] = {JIT_Int64, JIT_Int64, JIT_Address};
+  JIT_Type direct_params[1] = {JIT_Int32};
+  int failures = 0;
+  for (int opt_level = 0; opt_level <= 2; opt_level++) {
+    JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+        ctx, "countdown", JIT_Int64, 3, params, test13_il, NULL);
+    typedef int64_t (*F)(int64_t, int64_t, void *);
+    F f = (F)JIT_Compile(function_builder, opt_level);
+    JIT_DestroyFunctionBuilder(function_builder);
+    if (!f)
+      return 1;
+    const int64_t n = 1000000;
+    if (f(n, 0, (void *)f) != n * (n + 1) / 2)
+      failures++;
+
+    function_builder = JIT_CreateFunctionBuilder(
+        ctx, "next_square", JIT_Int32, 1, direct_params, test13_direct_il,
+        NULL);
+    typedef int32_t (*G)(int32_t);
+    G g = (G)JIT_Compile(function_builder, opt_level);
+    JIT_DestroyFunctionBuilder(function_builder);
+    if (!g)
+      return 1;
+    if (g(6) != 49)
+      failures++;
+  }
+  printf("Tail calls gave %d wrong results\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+struct SwitchCases {
+  int num_cases;
+  int32_t values[12];
+};
+
+/* Case values given out of order; the dense ones have a hole at 2 */
+static SwitchCases test14_dense = {7, {3, -2, 0, 5, -1, 1, 4}};
+/* A dense cluster at 0..5 and a few outliers */
+static SwitchCases test14_sparse = {10,
+                                    {1000, 3, 0, -7, 5, 1, 100000, 4, 2, 5000}};
+
+/*
+  int32_t f(int32_t x) {
+    switch (x) {
+    case values[0]: return 100;
+    case values[1]: return 101;
+    ...
+    case values[n-2]:
+    case values[n-1]: return 99;
+    default: return -1;
+    }
+  }
+*/
+static bool test14_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  SwitchCases *cases = (SwitchCases *)userdata;
+  int n = cases->num_cases;
+  JIT_CreateBlocks(ilinjector, n + 1);
+  JIT_BlockRef case_blocks[12];
+  for (int i = 0; i < n; i++)
+    case_blocks[i] = JIT_GetBlock(ilinjector, i + 1 < n ? i + 1 : n - 1);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  JIT_Switch(ilinjector, JIT_LoadParameter(ilinjector, 0),
+             JIT_GetBlock(ilinjector, n), n, case_blocks, cases->values);
+
+  for (int i = 1; i < n; i++) {
+    JIT_SetCurrentBlock(ilinjector, i);
+    JIT_ReturnValue(ilinjector, JIT_ConstInt32(i + 1 < n ? 100 + i - 1 : 99));
+  }
+  JIT_SetCurrentBlock(ilinjector, n);
+  JIT_ReturnValue(ilinjector, JIT_ConstInt32(-1));
+  return true;
+}
+
+static int32_t test14_expected(SwitchCases *cases, int32_t x) {
+  for (int i = 0; i < cases->num_cases; i++) {
+    if (cases->values[i] == x)
+      return i + 2 < cases->num_cases ? 100 + i : 99;
+  }
+  return -1;
+}
+
+static int test14(JIT_ContextRef ctx) {
+  JIT_Type params[1] = {JIT_Int32};
+  SwitchCases *all_cases[2] = {&test14_dense, &test14_sparse};
+  int32_t extra_inputs[] = {-2147483647 - 1, 2147483647, 999,   1001,
+                            4999,          5001,         99999, 100001};
+  int failures = 0;
+  for (int opt_level = 0; opt_level <= 2; opt_level++) {
+    for (SwitchCases *cases : all_cases) {
+      JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+          ctx, "switcher", JIT_Int32, 1, params, test14_il, cases);
+      typedef int32_t (*F)(int32_t);
+      F f = (F)JIT_Compile(function_builder, opt_level);
+      JIT_DestroyFunctionBuilder(function_builder);
+      if (!f)
+        return 1;
+      for (int32_t x = -10; x <= 10; x++) {
+        if (f(x) != test14_expected(cases, x))
+          failures++;
+      }
+      for (int32_t x : extra_inputs) {
+        if (f(x) != test14_expected(cases, x))
+          failures++;
+      }
+      for (int i = 0; i < cases->num_cases; i++) {
+        int32_t x = cases->values[i];
+        if (f(x) != test14_expected(cases, x))
+          failures++;
+      }
+    }
+  }
+  printf("Switches gave %d wrong results\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*
+  void copy_bytes(int8_t *dst, const int8_t *src, int32_t n) {
+    for (int32_t i = 0; i < n; i++)
+      dst[i] = src[i];
+  }
+  void fill_ints(int32_t *dst, int32_t value, int32_t n) {
+    for (int32_t i = 0; i < n; i++)
+      dst[i] = value;
+  }
+At opt level 2 both loops are reduced to a single arraycopy or arrayset;
+the copy falls back to the loop when dst starts inside src, as copying
+element by element then repeats the start of src.
+*/
+struct Test15Loop {
+  bool fill;
+  JIT_Type type;
+  int32_t size;
+};
+
+static bool test15_loop_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  Test15Loop *loop = (Test15Loop *)userdata;
+  JIT_CreateBlocks(ilinjector, 4);
+  JIT_SetMayHaveLoops(ilinjector);
+  JIT_BlockRef test = JIT_GetBlock(ilinjector, 1);
+  JIT_BlockRef body = JIT_GetBlock(ilinjector, 2);
+  JIT_BlockRef exit = JIT_GetBlock(ilinjector, 3);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto i = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_StoreToTemporary(ilinjector, i, JIT_ConstInt32(0));
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 0)),
+                 JIT_BlockAsCFGNode(test));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  auto done = JIT_CreateNode2C(OP_icmpge, JIT_LoadTemporary(ilinjector, i),
+                               JIT_LoadParameter(ilinjector, 2));
+  JIT_IfNotZeroValue(ilinjector, done, exit);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(test),
+                 JIT_BlockAsCFGNode(body));
+
+  JIT_SetCurrentBlock(ilinjector, 2);
+  auto offset = JIT_CreateNode2C(OP_imul, JIT_LoadTemporary(ilinjector, i),
+                                 JIT_ConstInt32(loop->size));
+  auto value = loop->fill ? JIT_LoadParameter(ilinjector, 1)
+                          : JIT_ArrayLoad(ilinjector,
+                                          JIT_LoadParameter(ilinjector, 1),
+                                          offset, loop->type);
+  JIT_ArrayStore(ilinjector, JIT_LoadParameter(ilinjector, 0), offset, value);
+  JIT_StoreToTemporary(ilinjector, i,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, i),
+                                        JIT_ConstInt32(1)));
+  JIT_Goto(ilinjector, test);
+
+  JIT_SetCurrentBlock(ilinjector, 3);
+  JIT_ReturnNoValue(ilinjector);
+  return true;
+}
+
+/*
+  void move(void *dst, const void *src, int64_t n, int32_t c) {
+    memmove(dst, src, n);
+    memset((char *)dst + n, c, n);
+    memmove((char *)dst + 2 * n, src, 48);
+    memset((char *)dst + 2 * n + 48, 0, 100);
+  }
+*/
+static bool test15_mem_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, 1);
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto n = JIT_LoadParameter(ilinjector, 2);
+  auto dst = JIT_LoadParameter(ilinjector, 0);
+  auto src = JIT_LoadParameter(ilinjector, 1);
+  auto rest = JIT_CreateNode2C(OP_aladd, dst, n);
+  auto fixed = JIT_CreateNode2C(OP_aladd, rest, n);
+  JIT_MemCopy(ilinjector, dst, src, n);
+  JIT_MemSet(ilinjector, rest, JIT_LoadParameter(ilinjector, 3), n);
+  JIT_MemCopy(ilinjector, fixed, src, JIT_ConstInt64(48));
+  JIT_MemSet(ilinjector,
+             JIT_CreateNode2C(OP_aladd, fixed, JIT_ConstInt64(48)),
+             JIT_ConstInt8(0), JIT_ConstInt64(100));
+  JIT_ReturnNoValue(ilinjector);
+  return true;
+}
+
+static int test15(JIT_ContextRef ctx) {
+  int failures = 0;
+  Test15Loop copy_bytes = {false, JIT_Int8, 1};
+  Test15Loop fill_ints = {true, JIT_Int32, 4};
+  JIT_Type copy_params[3] = {JIT_Address, JIT_Address, JIT_Int32};
+  JIT_Type fill_params[3] = {JIT_Address, JIT_Int32, JIT_Int32};
+  JIT_Type mem_params[4] = {JIT_Address, JIT_Address, JIT_Int64, JIT_Int32};
+  for (int opt_level = 0; opt_level <= 2; opt_level++) {
+    int64_t copies =
+        JIT_GetStaticDebugCounter(ctx, "loopVectorizer/arraycopy");
+    int64_t fills = JIT_GetStaticDebugCounter(ctx, "loopVectorizer/arrayset");
+    JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+        ctx, "copy_bytes", JIT_NoType, 3, copy_params, test15_loop_il,
+        &copy_bytes);
+    typedef void (*Copy)(int8_t *, const int8_t *, int32_t);
+    Copy copy = (Copy)JIT_Compile(function_builder, opt_level);
+    JIT_DestroyFunctionBuilder(function_builder);
+
+    function_builder =
+        JIT_CreateFunctionBuilder(ctx, "fill_ints", JIT_NoType, 3, fill_params,
+                                  test15_loop_il, &fill_ints);
+    typedef void (*Fill)(int32_t *, int32_t, int32_t);
+    Fill fill = (Fill)JIT_Compile(function_builder, opt_level);
+    JIT_DestroyFunctionBuilder(function_builder);
+
+    function_builder = JIT_CreateFunctionBuilder(
+        ctx, "move", JIT_NoType, 4, mem_params, test15_mem_il, NULL);
+    typedef void (*Move)(void *, const void *, int64_t, int32_t);
+    Move move = (Move)JIT_Compile(function_builder, opt_level);
+    JIT_DestroyFunctionBuilder(function_builder);
+    if (!copy || !fill || !move)
+      return 1;
+    // The loops are reduced by the loop vectorizer, which runs at opt level 2
+    if ((JIT_GetStaticDebugCounter(ctx, "loopVectorizer/arraycopy") >
+         copies) != (opt_level == 2)) {
+      printf("Copy loop was %sreduced at opt level %d\n",
+             opt_level == 2 ? "not " : "", opt_level);
+      failures++;
+    }
+    if ((JIT_GetStaticDebugCounter(ctx, "loopVectorizer/arrayset") > fills) !=
+        (opt_level == 2)) {
+      printf("Fill loop was %sreduced at opt level %d\n",
+             opt_level == 2 ? "not " : "", opt_level);
+      failures++;
+    }
+
+    // Disjoint arrays, and the same array shifted either way
+    for (int shift = -5; shift <= 5; shift++) {
+      for (int n = 0; n <= 40; n++) {
+        int8_t buf[128], expected[128];
+        for (int j = 0; j < 128; j++)
+          buf[j] = expected[j] = (int8_t)(j * 7 + 1);
+        int8_t *src = buf + 10;
+        int8_t *dst = shift == 0 ? buf + 64 : buf + 10 + shift;
+        for (int j = 0; j < n; j++)
+          expected[dst - buf + j] = expected[src - buf + j];
+        copy(dst, src, n);
+        if (memcmp(buf, expected, sizeof buf) != 0)
+          failures++;
+      }
+    }
+
+    for (int n = 0; n <= 40; n++) {
+      int32_t buf[48];
+      for (int j = 0; j < 48; j++)
+        buf[j] = j;
+      fill(buf + 1, -3, n);
+      for (int j = 0; j < 48; j++) {
+        if (buf[j] != (j >= 1 && j <= n ? -3 : j))
+          failures++;
+      }
+    }
+
+    for (int n = 0; n <= 40; n++) {
+      uint8_t src[64], buf[256], expected[256];
+      for (int j = 0; j < 64; j++)
+        src[j] = (uint8_t)(j * 3 + 2);
+      for (int j = 0; j < 256; j++)
+        buf[j] = expected[j] = 0xee;
+      memmove(expected, src, n);
+      memset(expected + n, 0x1a5, n);
+      memmove(expected + 2 * n, src, 48);
+      memset(expected + 2 * n + 48, 0, 100);
+      move(buf, src, n, 0x1a5);
+      if (memcmp(buf, expected, sizeof buf) != 0)
+        failures++;
+    }
+
+    // Overlapping moves in both directions
+    for (int n = 0; n <= 40; n++) {
+      uint8_t buf[256], expected[256];
+      for (int j = 0; j < 256; j++)
+        buf[j] = expected[j] = (uint8_t)j;
+      memmove(expected + 3, expected, n);
+      memset(expected + 3 + n, 0x7f, n);
+      memmove(expected + 3 + 2 * n, expected, 48);
+      memset(expected + 3 + 2 * n + 48, 0, 100);
+      move(buf + 3, buf, n, 0x7f);
+      if (memcmp(buf, expected, sizeof buf) != 0)
+        failures++;
+    }
+  }
+  printf("Copy and fill loops gave %d wrong results\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*
+  T f(T a, T b, T c) {
+    return intrinsic(a, b, c);
+  }
+The second argument is replaced by a constant in some cases. Each
+intrinsic is checked against a plain C version at every opt level; the
+x86 lowering depends on the processor, run with TR_DisableAVX=1 to check
+the fallbacks for BMI and FMA.
+*/
+struct Test16Case {
+  JIT_IntrinsicOp op;
+  int num_args;
+  JIT_Type type;
+  bool const_second;
+  int64_t int_value;
+  double fp_value;
+};
+
+static bool test16_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  Test16Case *c = (Test16Case *)userdata;
+  JIT_CreateBlocks(ilinjector, 1);
+  JIT_SetCurrentBlock(ilinjector, 0);
+  JIT_NodeRef args[3];
+  for (int i = 0; i < c->num_args; i++)
+    args[i] = JIT_LoadParameter(ilinjector, i);
+  if (c->const_second) {
+    switch (c->type) {
+    case JIT_Int32:
+      args[1] = JIT_ConstInt32((int32_t)c->int_value);
+      break;
+    case JIT_Int64:
+      args[1] = JIT_ConstInt64(c->int_value);
+      break;
+    case JIT_Float:
+      args[1] = JIT_ConstFloat((float)c->fp_value);
+      break;
+    default:
+      args[1] = JIT_ConstDouble(c->fp_value);
+      break;
+    }
+  }
+  auto result = JIT_Intrinsic(ilinjector, c->op, c->num_args, args);
+  if (!result)
+    return false;
+  if (JIT_GetNodeType(result) != c->type)
+    result = JIT_ConvertTo(ilinjector, result, c->type, false);
+  JIT_ReturnValue(ilinjector, result);
+  return true;
+}
+
+static uint64_t test16_expected_int(JIT_IntrinsicOp op, int bits, uint64_t a,
+                                    uint64_t b) {
+  uint64_t mask = bits == 64 ? ~(uint64_t)0 : 0xffffffffu;
+  uint64_t sign = (uint64_t)1 << (bits - 1);
+  a &= mask;
+  b &= mask;
+  int64_t sa = (a & sign) ? (int64_t)(a | ~mask) : (int64_t)a;
+  int64_t sb = (b & sign) ? (int64_t)(b | ~mask) : (int64_t)b;
+  int n = 0;
+  uint64_t r = 0;
+  switch (op) {
+  case JIT_IntrinsicClz:
+    while (n < bits && !(a & (sign >> n)))
+      n++;
+    return n;
+  case JIT_IntrinsicCtz:
+    while (n < bits && !(a & ((uint64_t)1 << n)))
+      n++;
+    return n;
+  case JIT_IntrinsicPopcount:
+    for (int i = 0; i < bits; i++)
+      n += (a >> i) & 1;
+    return n;
+  case JIT_IntrinsicByteSwap:
+    for (int i = 0; i < bits; i += 8)
+      r = (r << 8) | ((a >> i) & 0xff);
+    return r;
+  case JIT_IntrinsicRotateLeft:
+    n = b & (bits - 1);
+    return n ? ((a << n) | (a >> (bits - n))) & mask : a;
+  case JIT_IntrinsicRotateRight:
+    n = b & (bits - 1);
+    return n ? ((a >> n) | (a << (bits - n))) & mask : a;
+  case JIT_IntrinsicAndNot:
+    return a & ~b & mask;
+  case JIT_IntrinsicMin:
+    return sa < sb ? a : b;
+  case JIT_IntrinsicMax:
+    return sa > sb ? a : b;
+  default: /* JIT_IntrinsicAbs */
+    return sa < 0 ? (0 - a) & mask : a;
+  }
+}
+
+template <typename T>
+static bool test16_same(T x, T y, bool check_sign) {
+  if (x != x)
+    return y != y;
+  return x == y && (!check_sign || std::signbit(x) == std::signbit(y));
+}
+
+template <typename T>
+static bool test16_check_fp(JIT_IntrinsicOp op, T result, T a, T b, T c) {
+  switch (op) {
+  case JIT_IntrinsicMin:
+    /* fmin(0.0, -0.0) may be either zero */
+    return test16_same(result, std::fmin(a, b), false);
+  case JIT_IntrinsicMax:
+    return test16_same(result, std::fmax(a, b), false);
+  case JIT_IntrinsicAbs:
+    return test16_same(result, std::fabs(a), true);
+  case JIT_IntrinsicSqrt:
+    return test16_same(result, std::sqrt(a), true);
+  case JIT_IntrinsicFma: {
+    /* Fused only if the processor supports it */
+    T product = a * b;
+    return test16_same(result, std::fma(a, b, c), true) ||
+           test16_same(result, product + c, true);
+  }
+  default: /* JIT_IntrinsicCopySign */
+    return test16_same(result, std::copysign(a, b), true);
+  }
+}
+
+template <typename T>
+static int test16_run_fp(void *code, Test16Case *c, const double *values,
+                         int num_values) {
+  typedef T (*F)(T, T, T);
+  F f = (F)code;
+  int failures = 0;
+  for (int i = 0; i < num_values; i++) {
+    for (int j = 0; j < num_values; j++) {
+      for (int k = 0; k < (c->num_args == 3 ? num_values : 1); k++) {
+        T a = (T)values[i];
+        T b = c->const_second ? (T)c->fp_value : (T)values[j];
+        T cc = (T)values[k];
+        if (!test16_check_fp<T>(c->op, f(a, (T)values[j], cc), a, b, cc))
+          failures++;
+      }
+    }
+  }
+  return failures;
+}
+
+static int test16(JIT_ContextRef ctx) {
+  static const int64_t int_values[] = {0,
+                                       1,
+                                       -1,
+                                       2,
+                                       7,
+                                       -8,
+                                       0x0f00,
+                                       0x12345678,
+                                       (int64_t)0xdeadbeef,
+                                       0x7fffffff,
+                                       -2147483647 - 1,
+                                       (int64_t)1 << 40,
+                                       0x123456789abcdef0,
+                                       (int64_t)0x8000000000000000};
+  static const double fp_values[] = {0.0,  -0.0, 1.5,      -2.25,
+                                     3.0,  0.1,  1e-310,   -1e30,
+                                     NAN,  INFINITY, -INFINITY};
+  const int num_int_values = sizeof int_values / sizeof int_values[0];
+  const int num_fp_values = sizeof fp_values / sizeof fp_values[0];
+
+  static const JIT_IntrinsicOp int_ops[] = {
+      JIT_IntrinsicClz,        JIT_IntrinsicCtz,         JIT_IntrinsicPopcount,
+      JIT_IntrinsicByteSwap,   JIT_IntrinsicRotateLeft,  JIT_IntrinsicRotateRight,
+      JIT_IntrinsicAndNot,     JIT_IntrinsicMin,         JIT_IntrinsicMax,
+      JIT_IntrinsicAbs};
+  static const JIT_IntrinsicOp fp_ops[] = {
+      JIT_IntrinsicMin,  JIT_IntrinsicMax, JIT_IntrinsicAbs,
+      JIT_IntrinsicSqrt, JIT_IntrinsicFma, JIT_IntrinsicCopySign};
+  static const int64_t const_counts[] = {1, 13, -3};
+  static const double const_fp_values[] = {1.0, NAN};
+
+  std::vector<Test16Case> cases;
+  for (JIT_Type type : {JIT_Int32, JIT_Int64}) {
+    for (JIT_IntrinsicOp op : int_ops) {
+      int num_args = op == JIT_IntrinsicClz || op == JIT_IntrinsicCtz ||
+                             op == JIT_IntrinsicPopcount ||
+                             op == JIT_IntrinsicByteSwap ||
+                             op == JIT_IntrinsicAbs
+                         ? 1
+                         : 2;
+      cases.push_back({op, num_args, type, false, 0, 0.0});
+      if (op == JIT_IntrinsicRotateLeft || op == JIT_IntrinsicRotateRight) {
+        for (int64_t count : const_counts)
+          cases.push_back({op, num_args, type, true, count, 0.0});
+      }
+    }
+  }
+  for (JIT_Type type : {JIT_Float, JIT_Double}) {
+    for (JIT_IntrinsicOp op : fp_ops) {
+      int num_args = op == JIT_IntrinsicAbs || op == JIT_IntrinsicSqrt ? 1
+                     : op == JIT_IntrinsicFma                          ? 3
+                                                                       : 2;
+      cases.push_back({op, num_args, type, false, 0, 0.0});
+      if (op == JIT_IntrinsicMin || op == JIT_IntrinsicMax) {
+        for (double value : const_fp_values)
+          cases.push_back({op, num_args, type, true, 0, value});
+      }
+    }
+  }
+
+  int failures = 0;
+  for (int opt_level = 0; opt_level <= 2; opt_level++) {
+    for (Test16Case &c : cases) {
+      JIT_Type params[3] = {c.type, c.type, c.type};
+      JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+          ctx, "intrinsic", c.type, 3, params, test16_il, &c);
+      void *code = JIT_Compile(function_builder, opt_level);
+      JIT_DestroyFunctionBuilder(function_builder);
+      if (!code)
+        return 1;
+      if (c.type == JIT_Int32 || c.type == JIT_Int64) {
+        int bits = c.type == JIT_Int32 ? 32 : 64;
+        for (int i = 0; i < num_int_values; i++) {
+          for (int j = 0; j < (c.num_args == 1 ? 1 : num_int_values); j++) {
+            int64_t a = int_values[i];
+            int64_t b = c.const_second ? c.int_value : int_values[j];
+            uint64_t expected = test16_expected_int(c.op, bits, a, b);
+            uint64_t result;
+            if (bits == 32)
+              result = (uint32_t)((int32_t(*)(int32_t, int32_t, int32_t))code)(
+                  (int32_t)a, (int32_t)int_values[j], 0);
+            else
+              result = (uint64_t)((int64_t(*)(int64_t, int64_t, int64_t))code)(
+                  a, int_values[j], 0);
+            if (result != expected) {
+              printf("Intrinsic %d on %d bits of %llx, %llx gave %llx, expected "
+                     "%llx\n",
+                     (int)c.op, bits, (unsigned long long)a,
+                     (unsigned long long)b, (unsigned long long)result,
+                     (unsigned long long)expected);
+              failures++;
+            }
+          }
+        }
+      } else if (c.type == JIT_Float) {
+        failures += test16_run_fp<float>(code, &c, fp_values, num_fp_values);
+      } else {
+        failures += test16_run_fp<double>(code, &c, fp_values, num_fp_values);
+      }
+    }
+  }
+
+  /* Invalid numbers or types of arguments give NULL, which fails the compile */
+  Test16Case invalid_cases[] = {
+      {JIT_IntrinsicFma, 2, JIT_Double, false, 0, 0.0},
+      {JIT_IntrinsicPopcount, 2, JIT_Int32, false, 0, 0.0},
+      {JIT_IntrinsicSqrt, 1, JIT_Int64, false, 0, 0.0},
+      {JIT_IntrinsicClz, 1, JIT_Float, false, 0, 0.0}};
+  for (Test16Case &c : invalid_cases) {
+    JIT_Type params[3] = {c.type, c.type, c.type};
+    JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+        ctx, "invalid_intrinsic", c.type, 3, params, test16_il, &c);
+    if (JIT_Compile(function_builder, 0)) {
+      printf("Intrinsic %d with %d arguments of type %d compiled\n", c.op,
+             c.num_args, c.type);
+      failures++;
+    }
+    JIT_DestroyFunctionBuilder(function_builder);
+  }
+  printf("Intrinsics had %d failures\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*
+  int f(T a, T b, T *out) {
+    if (__builtin_op_overflow(a, b, out))
+      return 1;
+    return 0;
+  }
+The second argument is replaced by a constant in some cases, and both are
+masked to 16 bits in others so that the optimizer can remove the check.
+*/
+struct Test17Case {
+  int op; // 0 add, 1 sub, 2 mul
+  JIT_Type type;
+  bool const_second;
+  int64_t value;
+  bool masked;
+};
+
+static bool test17_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  Test17Case *c = (Test17Case *)userdata;
+  bool is64 = c->type == JIT_Int64;
+  JIT_CreateBlocks(ilinjector, 3);
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto a = JIT_LoadParameter(ilinjector, 0);
+  auto b = c->const_second ? (is64 ? JIT_ConstInt64(c->value)
+                                   : JIT_ConstInt32((int32_t)c->value))
+                           : JIT_LoadParameter(ilinjector, 1);
+  if (c->masked) {
+    auto mask = is64 ? JIT_ConstInt64(0xffff) : JIT_ConstInt32(0xffff);
+    a = JIT_CreateNode2C(is64 ? OP_land : OP_iand, a, mask);
+    b = JIT_CreateNode2C(is64 ? OP_land : OP_iand, b, mask);
+  }
+  auto overflow = JIT_GetBlock(ilinjector, 2);
+  JIT_NodeRef result;
+  if (c->op == 0)
+    result = JIT_AddOverflow(ilinjector, a, b, overflow);
+  else if (c->op == 1)
+    result = JIT_SubOverflow(ilinjector, a, b, overflow);
+  else
+    result = JIT_MulOverflow(ilinjector, a, b, overflow);
+  if (!result)
+    return false;
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 0)),
+                 JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 1)));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  JIT_ArrayStore(ilinjector, JIT_LoadParameter(ilinjector, 2),
+                 JIT_ConstInt32(0), result);
+  JIT_ReturnValue(ilinjector, JIT_ConstInt32(0));
+
+  JIT_SetCurrentBlock(ilinjector, 2);
+  JIT_ReturnValue(ilinjector, JIT_ConstInt32(1));
+  return true;
+}
+
+template <typename T>
+static int test17_run(void *code, Test17Case *c, const int64_t *values,
+                      int num_values) {
+  int failures = 0;
+  for (int i = 0; i < num_values; i++) {
+    for (int j = 0; j < num_values; j++) {
+      T a = (T)values[i];
+      T b = c->const_second ? (T)c->value : (T)values[j];
+      T expected_result = 0, result = 0;
+      if (c->masked) {
+        a &= 0xffff;
+        b &= 0xffff;
+      }
+      bool expected =
+          c->op == 0   ? __builtin_add_overflow(a, b, &expected_result)
+          : c->op == 1 ? __builtin_sub_overflow(a, b, &expected_result)
+                       : __builtin_mul_overflow(a, b, &expected_result);
+      bool overflowed =
+          ((int32_t(*)(T, T, T *))code)((T)values[i], (T)values[j], &result);
+      if (overflowed != expected || (!expected && result != expected_result)) {
+        printf("Checked op %d on %d bits of %llx, %llx gave %d %llx, expected "
+               "%d %llx\n",
+               c->op, (int)sizeof(T) * 8, (unsigned long long)a,
+               (unsigned long long)b, (int)overflowed,
+               (unsigned long long)result, (int)expected,
+               (unsigned long long)expected_result);
+        failures++;
+      }
+    }
+  }
+  return failures;
+}
+
+static int test17(JIT_ContextRef ctx) {
+  static const int64_t values[] = {0,
+                                   1,
+                                   -1,
+                                   2,
+                                   -3,
+                                   1000,
+                                   0xffff,
+                                   46341,
+                                   0x7fffffff,
+                                   -2147483647 - 1,
+                                   (int64_t)1 << 32,
+                                   (int64_t)3037000500,
+                                   0x7fffffffffffffff,
+                                   (int64_t)0x8000000000000000};
+  const int num_values = sizeof values / sizeof values[0];
+  static const int64_t const_values[] = {0, 1, -1, 1000};
+
+  std::vector<Test17Case> cases;
+  for (JIT_Type type : {JIT_Int32, JIT_Int64}) {
+    for (int op = 0; op < 3; op++) {
+      cases.push_back({op, type, false, 0, false});
+      cases.push_back({op, type, false, 0, true});
+      for (int64_t value : const_values)
+        cases.push_back({op, type, true, value, false});
+    }
+  }
+
+  int failures = 0;
+  for (int opt_level = 0; opt_level <= 2; opt_level++) {
+    for (Test17Case &c : cases) {
+      JIT_Type params[3] = {c.type, c.type, JIT_Address};
+      JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+          ctx, "checked", JIT_Int32, 3, params, test17_il, &c);
+      void *code = JIT_Compile(function_builder, opt_level);
+      JIT_DestroyFunctionBuilder(function_builder);
+      if (!code)
+        return 1;
+      if (c.type == JIT_Int32)
+        failures += test17_run<int32_t>(code, &c, values, num_values);
+      else
+        failures += test17_run<int64_t>(code, &c, values, num_values);
+    }
+  }
+  printf("Checked arithmetic gave %d wrong results\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*
+  T f(T a, T b) {
+    T r;
+    if (a CMP b)
+      r = a;        // or -a, or a / b when the condition is b != 0
+    else
+      r = b;        // or a
+    return r;
+  }
+The small diamonds are turned into ternaries at opt levels 1 and 2, except
+for the division which must stay under its condition. Doubles are also
+selected on a float compare of the arguments, which x86 cannot turn into a
+mask with the same compare. The float compares ne and equ are left out as
+x86 evaluates them as neu and not at all.
+*/
+struct Test18Case {
+  JIT_Type type;
+  int cmp; // eq, ne, lt, ge, gt, le, then the unordered variants of these
+  int kind; // 0 a : b, 1 -a : a, 2 a / b : a, 3 (float)a cmp (float)b ? a : b
+};
+
+static bool test18_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  Test18Case *c = (Test18Case *)userdata;
+  JIT_NodeOpCode cmp_base = c->type == JIT_Int32   ? OP_icmpeq
+                            : c->type == JIT_Int64 ? OP_lcmpeq
+                            : c->type == JIT_Float ? OP_fcmpeq
+                                                   : OP_dcmpeq;
+  JIT_NodeOpCode neg = c->type == JIT_Int32   ? OP_ineg
+                       : c->type == JIT_Int64 ? OP_lneg
+                       : c->type == JIT_Float ? OP_fneg
+                                              : OP_dneg;
+  JIT_CreateBlocks(ilinjector, 4);
+  JIT_BlockRef then_block = JIT_GetBlock(ilinjector, 2);
+  JIT_BlockRef join_block = JIT_GetBlock(ilinjector, 3);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto r = JIT_CreateTemporary(ilinjector, c->type);
+  auto a = JIT_LoadParameter(ilinjector, 0);
+  auto b = JIT_LoadParameter(ilinjector, 1);
+  JIT_NodeRef cond;
+  if (c->kind == 2)
+    cond = JIT_CreateNode2C((JIT_NodeOpCode)(cmp_base + 1), b,
+                            JIT_ZeroValue(ilinjector, c->type));
+  else if (c->kind == 3)
+    cond = JIT_CreateNode2C((JIT_NodeOpCode)(OP_fcmpeq + c->cmp),
+                            JIT_CreateNode1C(OP_d2f, a),
+                            JIT_CreateNode1C(OP_d2f, b));
+  else
+    cond = JIT_CreateNode2C((JIT_NodeOpCode)(cmp_base + c->cmp), a, b);
+  JIT_IfNotZeroValue(ilinjector, cond, then_block);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 0)),
+                 JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 1)));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  JIT_StoreToTemporary(ilinjector, r,
+                       c->kind == 0 || c->kind == 3
+                           ? JIT_LoadParameter(ilinjector, 1)
+                           : JIT_LoadParameter(ilinjector, 0));
+  JIT_Goto(ilinjector, join_block);
+
+  JIT_SetCurrentBlock(ilinjector, 2);
+  a = JIT_LoadParameter(ilinjector, 0);
+  if (c->kind == 1)
+    a = JIT_CreateNode1C(neg, a);
+  else if (c->kind == 2)
+    a = JIT_CreateNode2C(c->type == JIT_Int32 ? OP_idiv : OP_ldiv, a,
+                         JIT_LoadParameter(ilinjector, 1));
+  JIT_StoreToTemporary(ilinjector, r, a);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(then_block),
+                 JIT_BlockAsCFGNode(join_block));
+
+  JIT_SetCurrentBlock(ilinjector, 3);
+  JIT_ReturnValue(ilinjector, JIT_LoadTemporary(ilinjector, r));
+  return true;
+}
+
+template <typename T> static bool test18_compare(int cmp, T a, T b) {
+  switch (cmp) {
+  case 0:
+    return a == b;
+  case 1:
+    return a == a && b == b && a != b;
+  case 2:
+    return a < b;
+  case 3:
+    return a >= b;
+  case 4:
+    return a > b;
+  case 5:
+    return a <= b;
+  case 6:
+    return !(a < b) && !(a > b);
+  case 7:
+    return a != b;
+  case 8:
+    return !(a >= b);
+  case 9:
+    return !(a < b);
+  case 10:
+    return !(a <= b);
+  default:
+    return !(a > b);
+  }
+}
+
+template <typename T>
+static int test18_run(void *code, Test18Case *c, const T *values,
+                      int num_values) {
+  int failures = 0;
+  for (int i = 0; i < num_values; i++) {
+    for (int j = 0; j < num_values; j++) {
+      T a = values[i], b = values[j];
+      T expected;
+      if (c->kind == 2)
+        expected = b != 0 ? a / b : a;
+      else if (c->kind == 3)
+        expected = test18_compare(c->cmp, (float)a, (float)b) ? a : b;
+      else if (test18_compare(c->cmp, a, b))
+        expected = c->kind == 0 ? a : -a;
+      else
+        expected = c->kind == 0 ? b : a;
+      T result = ((T(*)(T, T))code)(a, b);
+      if (memcmp(&result, &expected, sizeof(T)) != 0) {
+        printf("Select %d of kind %d on %g, %g gave %g, expected %g\n", c->cmp,
+               c->kind, (double)a, (double)b, (double)result,
+               (double)expected);
+        failures++;
+      }
+    }
+  }
+  return failures;
+}
+
+/* The CFG simplifier counts the diamonds it turns into ternaries per method */
+static const char *test18_counter = "cfgSimpCMOV/diamond/(file:line:select)";
+
+static int test18(JIT_ContextRef ctx) {
+  static const int32_t int_values[] = {0, 1, -1, 7, -7, 100, 0x7fffffff,
+                                       -0x7fffffff};
+  const int num_int_values = sizeof int_values / sizeof int_values[0];
+  static const double fp_values[] = {0.0, -0.0, 1.5, -2.0,
+                                     INFINITY, -INFINITY, NAN};
+  const int num_fp_values = sizeof fp_values / sizeof fp_values[0];
+  int64_t long_values[num_int_values];
+  float float_values[num_fp_values];
+  for (int i = 0; i < num_int_values; i++)
+    long_values[i] = (int64_t)int_values[i] * (i & 1 ? (int64_t)1 << 32 : 1);
+  for (int i = 0; i < num_fp_values; i++)
+    float_values[i] = (float)fp_values[i];
+
+  std::vector<Test18Case> cases;
+  for (JIT_Type type : {JIT_Int32, JIT_Int64, JIT_Float, JIT_Double}) {
+    bool is_fp = type == JIT_Float || type == JIT_Double;
+    for (int cmp = 0; cmp < (is_fp ? 12 : 6); cmp++) {
+      if (is_fp && (cmp == 1 || cmp == 6))
+        continue;
+      cases.push_back({type, cmp, 0});
+      cases.push_back({type, cmp, 1});
+      if (type == JIT_Double)
+        cases.push_back({type, cmp, 3});
+    }
+    if (!is_fp)
+      cases.push_back({type, 1, 2});
+  }
+
+  int failures = 0;
+  for (int opt_level = 0; opt_level <= 2; opt_level++) {
+    for (Test18Case &c : cases) {
+      JIT_Type params[2] = {c.type, c.type};
+      int64_t diamonds = JIT_GetStaticDebugCounter(ctx, test18_counter);
+      JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+          ctx, "select", c.type, 2, params, test18_il, &c);
+      void *code = JIT_Compile(function_builder, opt_level);
+      JIT_DestroyFunctionBuilder(function_builder);
+      if (!code)
+        return 1;
+      bool converted =
+          JIT_GetStaticDebugCounter(ctx, test18_counter) > diamonds;
+      if (converted != (opt_level > 0 && c.kind != 2)) {
+        printf("Select %d of kind %d on type %d was %sif-converted at opt "
+               "level %d\n",
+               c.cmp, c.kind, c.type, converted ? "" : "not ", opt_level);
+        failures++;
+      }
+      if (c.type == JIT_Int32)
+        failures += test18_run<int32_t>(code, &c, int_values, num_int_values);
+      else if (c.type == JIT_Int64)
+        failures += test18_run<int64_t>(code, &c, long_values, num_int_values);
+      else if (c.type == JIT_Float)
+        failures += test18_run<float>(code, &c, float_values, num_fp_values);
+      else
+        failures += test18_run<double>(code, &c, fp_values, num_fp_values);
+    }
+  }
+  printf("If-converted selects had %d failures\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*
+  int32_t f(int32_t *p, int32_t i, int32_t j) {
+    int32_t r = p[i] + p[j];
+    if (i < j) {
+      r += p[i] * 3;
+      p[j] = r;
+      if (r > 0)
+        r += p[j];
+    } else {
+      p[i] = r;
+    }
+    return r + p[i] + p[j];
+  }
+At opt level 2 the address of p[i] and the load of p[i] in the then block
+reuse the value of the entry block. The load of p[j] in the nested block and
+the loads after the join must not, as p[j] and p[i] are stored before them.
+*/
+static JIT_NodeRef test19_element(JIT_ILInjectorRef ilinjector, int index) {
+  return JIT_ArrayLoad(ilinjector, JIT_LoadParameter(ilinjector, 0),
+                       JIT_CreateNode2C(OP_imul,
+                                        JIT_LoadParameter(ilinjector, index),
+                                        JIT_ConstInt32(4)),
+                       JIT_Int32);
+}
+
+static void test19_store(JIT_ILInjectorRef ilinjector, int index,
+                         JIT_NodeRef value) {
+  JIT_ArrayStore(ilinjector, JIT_LoadParameter(ilinjector, 0),
+                 JIT_CreateNode2C(OP_imul,
+                                  JIT_LoadParameter(ilinjector, index),
+                                  JIT_ConstInt32(4)),
+                 value);
+}
+
+static bool test19_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, 5);
+  JIT_BlockRef then_block = JIT_GetBlock(ilinjector, 2);
+  JIT_BlockRef nested_block = JIT_GetBlock(ilinjector, 3);
+  JIT_BlockRef join_block = JIT_GetBlock(ilinjector, 4);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto r = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_StoreToTemporary(ilinjector, r,
+                       JIT_CreateNode2C(OP_iadd, test19_element(ilinjector, 1),
+                                        test19_element(ilinjector, 2)));
+  JIT_IfNotZeroValue(ilinjector,
+                     JIT_CreateNode2C(OP_icmplt,
+                                      JIT_LoadParameter(ilinjector, 1),
+                                      JIT_LoadParameter(ilinjector, 2)),
+                     then_block);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 0)),
+                 JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 1)));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  test19_store(ilinjector, 1, JIT_LoadTemporary(ilinjector, r));
+  JIT_Goto(ilinjector, join_block);
+
+  JIT_SetCurrentBlock(ilinjector, 2);
+  JIT_StoreToTemporary(
+      ilinjector, r,
+      JIT_CreateNode2C(OP_iadd, JIT_LoadTemporary(ilinjector, r),
+                       JIT_CreateNode2C(OP_imul, test19_element(ilinjector, 1),
+                                        JIT_ConstInt32(3))));
+  test19_store(ilinjector, 2, JIT_LoadTemporary(ilinjector, r));
+  JIT_IfNotZeroValue(ilinjector,
+                     JIT_CreateNode2C(OP_icmple,
+                                      JIT_LoadTemporary(ilinjector, r),
+                                      JIT_ConstInt32(0)),
+                     join_block);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(then_block),
+                 JIT_BlockAsCFGNode(nested_block));
+
+  JIT_SetCurrentBlock(ilinjector, 3);
+  JIT_StoreToTemporary(ilinjector, r,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, r),
+                                        test19_element(ilinjector, 2)));
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(nested_block),
+                 JIT_BlockAsCFGNode(join_block));
+
+  JIT_SetCurrentBlock(ilinjector, 4);
+  JIT_ReturnValue(
+      ilinjector,
+      JIT_CreateNode2C(OP_iadd,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, r),
+                                        test19_element(ilinjector, 1)),
+                       test19_element(ilinjector, 2)));
+  return true;
+}
+
+static int32_t test19_expected(int32_t *p, int32_t i, int32_t j) {
+  int32_t r = p[i] + p[j];
+  if (i < j) {
+    r += p[i] * 3;
+    p[j] = r;
+    if (r > 0)
+      r += p[j];
+  } else {
+    p[i] = r;
+  }
+  return r + p[i] + p[j];
+}
+
+static int test19(JIT_ContextRef ctx) {
+  static const int32_t values[] = {5, -3, 0, 12, -40, 7};
+  const int num_values = sizeof values / sizeof values[0];
+  JIT_Type params[3] = {JIT_Address, JIT_Int32, JIT_Int32};
+  int failures = 0;
+  for (int opt_level = 0; opt_level <= 2; opt_level++) {
+    int64_t replaced =
+        JIT_GetStaticDebugCounter(ctx, "globalValueNumbering/replaced");
+    JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+        ctx, "redundant", JIT_Int32, 3, params, test19_il, NULL);
+    typedef int32_t (*Redundant)(int32_t *, int32_t, int32_t);
+    Redundant redundant = (Redundant)JIT_Compile(function_builder, opt_level);
+    JIT_DestroyFunctionBuilder(function_builder);
+    if (!redundant)
+      return 1;
+    if ((JIT_GetStaticDebugCounter(ctx, "globalValueNumbering/replaced") >
+         replaced) != (opt_level == 2)) {
+      printf("Redundant values were %sreplaced at opt level %d\n",
+             opt_level == 2 ? "not " : "", opt_level);
+      failures++;
+    }
+    for (int i = 0; i < num_values; i++) {
+      for (int j = 0; j < num_values; j++) {
+        int32_t actual[num_values], expected[num_values];
+        memcpy(actual, values, sizeof values);
+        memcpy(expected, values, sizeof values);
+        if (redundant(actual, i, j) != test19_expected(expected, i, j) ||
+            memcmp(actual, expected, sizeof actual) != 0)
+          failures++;
+      }
+    }
+  }
+  printf("Global value numbering had %d failures\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*
+  struct Test20Value { int32_t tag; int64_t i; double d; };
+  int64_t f(Test20Value *v, int32_t n) {
+    int32_t k = n * 3;
+    guard (v->tag == TEST20_INT) else deoptimize(v, k);
+    return v->i + k;
+  }
+The code after the guard assumes v holds an integer; other values are
+handled by test20_deopt() from the saved state.
+*/
+enum { TEST20_INT, TEST20_DOUBLE };
+struct Test20Value {
+  int32_t tag;
+  int64_t i;
+  double d;
+};
+
+static int test20_deopts;
+
+static int64_t test20_deopt(JIT_DeoptRecord *record) {
+  test20_deopts++;
+  if (record->deopt_id != 42 || record->num_values != 2)
+    return -1;
+  Test20Value *v = (Test20Value *)record->values[0].ptr;
+  return (int64_t)v->d + record->values[1].i32;
+}
+
+static bool test20_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, 2);
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto k = JIT_CreateNode2C(OP_imul, JIT_LoadParameter(ilinjector, 1),
+                            JIT_ConstInt32(3));
+  auto tag = JIT_ArrayLoadAt(ilinjector, 0, JIT_LoadParameter(ilinjector, 0),
+                             offsetof(Test20Value, tag), JIT_Int32);
+  JIT_NodeRef values[2] = {JIT_LoadParameter(ilinjector, 0), k};
+  JIT_Guard(ilinjector,
+            JIT_CreateNode2C(OP_icmpeq, tag, JIT_ConstInt32(TEST20_INT)), 42,
+            2, values);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 0)),
+                 JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 1)));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  auto i = JIT_ArrayLoadAt(ilinjector, 0, JIT_LoadParameter(ilinjector, 0),
+                           offsetof(Test20Value, i), JIT_Int64);
+  k = JIT_CreateNode2C(OP_imul, JIT_LoadParameter(ilinjector, 1),
+                       JIT_ConstInt32(3));
+  JIT_ReturnValue(ilinjector,
+                  JIT_CreateNode2C(OP_ladd, i, JIT_CreateNode1C(OP_i2l, k)));
+  return true;
+}
+
+static int test20(JIT_ContextRef ctx) {
+  JIT_Type deopt_params[1] = {JIT_Address};
+  JIT_RegisterFunction(ctx, "test20_deopt", JIT_Int64, 1, deopt_params,
+                       (void *)test20_deopt);
+  JIT_Type params[2] = {JIT_Address, JIT_Int32};
+  int failures = 0;
+  for (int opt_level = 0; opt_level <= 2; opt_level++) {
+    JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+        ctx, "speculate", JIT_Int64, 2, params, test20_il, NULL);
+    JIT_SetDeoptHandler(function_builder, "test20_deopt");
+    typedef int64_t (*Speculate)(Test20Value *, int32_t);
+    Speculate speculate = (Speculate)JIT_Compile(function_builder, opt_level);
+    JIT_DestroyFunctionBuilder(function_builder);
+    if (!speculate)
+      return 1;
+    test20_deopts = 0;
+    for (int32_t n = -2; n <= 2; n++) {
+      Test20Value int_value = {TEST20_INT, (int64_t)1 << 40, 0.0};
+      Test20Value double_value = {TEST20_DOUBLE, 0, -7.5};
+      if (speculate(&int_value, n) != ((int64_t)1 << 40) + n * 3)
+        failures++;
+      if (speculate(&double_value, n) != -7 + n * 3)
+        failures++;
+    }
+    if (test20_deopts != 5)
+      failures++;
+  }
+  printf("Guards gave %d wrong results\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*
+  int32_t f(int32_t n) {
+    int32_t sum = 0;
+    for (int32_t i = 0; i < n; i++) {
+      if (!assumption holds)
+        return 1000 + sum;
+      sum += i;
+    }
+    return sum;
+  }
+The guard in the loop is patched by JIT_InvalidateAssumption().
+*/
+static bool test21_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  uint64_t assumption_id = *(uint64_t *)userdata;
+  JIT_CreateBlocks(ilinjector, 6);
+  JIT_BlockRef loop_block = JIT_GetBlock(ilinjector, 1);
+  JIT_BlockRef exit_block = JIT_GetBlock(ilinjector, 4);
+  JIT_BlockRef slow_block = JIT_GetBlock(ilinjector, 5);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto sum = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  auto i = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_StoreToTemporary(ilinjector, sum, JIT_ConstInt32(0));
+  JIT_StoreToTemporary(ilinjector, i, JIT_ConstInt32(0));
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 0)),
+                 JIT_BlockAsCFGNode(loop_block));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  JIT_IfNotZeroValue(ilinjector,
+                     JIT_CreateNode2C(OP_icmpge,
+                                      JIT_LoadTemporary(ilinjector, i),
+                                      JIT_LoadParameter(ilinjector, 0)),
+                     exit_block);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(loop_block),
+                 JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 2)));
+
+  JIT_SetCurrentBlock(ilinjector, 2);
+  JIT_CreatePatchableGuard(ilinjector, assumption_id, slow_block);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 2)),
+                 JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 3)));
+
+  JIT_SetCurrentBlock(ilinjector, 3);
+  JIT_StoreToTemporary(ilinjector, sum,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, sum),
+                                        JIT_LoadTemporary(ilinjector, i)));
+  JIT_StoreToTemporary(ilinjector, i,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, i),
+                                        JIT_ConstInt32(1)));
+  JIT_Goto(ilinjector, loop_block);
+
+  JIT_SetCurrentBlock(ilinjector, 4);
+  JIT_ReturnValue(ilinjector, JIT_LoadTemporary(ilinjector, sum));
+
+  JIT_SetCurrentBlock(ilinjector, 5);
+  JIT_ReturnValue(ilinjector,
+                  JIT_CreateNode2C(OP_iadd, JIT_LoadTemporary(ilinjector, sum),
+                                   JIT_ConstInt32(1000)));
+  return true;
+}
+
+typedef int32_t (*Test21Function)(int32_t);
+
+static Test21Function test21_compile(JIT_ContextRef ctx, int opt_level,
+                                     uint64_t *assumption_id) {
+  JIT_Type params[1] = {JIT_Int32};
+  JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+      ctx, "assume", JIT_Int32, 1, params, test21_il, assumption_id);
+  Test21Function function =
+      (Test21Function)JIT_Compile(function_builder, opt_level);
+  JIT_DestroyFunctionBuilder(function_builder);
+  return function;
+}
+
+static int test21(JIT_ContextRef ctx) {
+  int failures = 0;
+  for (int opt_level = 0; opt_level <= 2; opt_level++) {
+    uint64_t assumption_id = 0x2100 + opt_level;
+    Test21Function assume = test21_compile(ctx, opt_level, &assumption_id);
+    if (!assume)
+      return 1;
+    for (int32_t n = 0; n <= 10; n++) {
+      if (assume(n) != n * (n - 1) / 2)
+        failures++;
+    }
+    int patched = JIT_InvalidateAssumption(ctx, assumption_id);
+#if defined(__x86_64__)
+    if (patched != 1)
+      failures++;
+#endif
+    if (JIT_InvalidateAssumption(ctx, assumption_id) != 0)
+      failures++;
+    if (assume(0) != 0 || assume(10) != 1000)
+      failures++;
+
+    /* Compiled after the invalidation */
+    assume = test21_compile(ctx, opt_level, &assumption_id);
+    if (!assume)
+      return 1;
+    if (assume(0) != 0 || assume(10) != 1000)
+      failures++;
+  }
+  printf("Patchable guards gave %d wrong results\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*
+  int32_t f(int32_t n, int32_t (*fp)(int32_t)) {
+    int32_t sum = 0;
+    for (int32_t i = 0; i < n; i++) {
+      switch (i & 3) {
+      case 0: sum += fp(i); break;
+      case 1: sum += 1; break;
+      default: sum += 2; break;
+      }
+    }
+    return sum;
+  }
+Compiled warm with profiling enabled, and then hot using the profile.
+*/
+struct Test22Data {
+  void *dominant_target;
+};
+
+static int32_t test22_callee(int32_t x) { return x * 3; }
+
+static bool test22_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  Test22Data *data = (Test22Data *)userdata;
+  JIT_CreateBlocks(ilinjector, 8);
+  JIT_BlockRef loop_block = JIT_GetBlock(ilinjector, 1);
+  JIT_BlockRef latch_block = JIT_GetBlock(ilinjector, 6);
+  JIT_BlockRef exit_block = JIT_GetBlock(ilinjector, 7);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto sum = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  auto i = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_StoreToTemporary(ilinjector, sum, JIT_ConstInt32(0));
+  JIT_StoreToTemporary(ilinjector, i, JIT_ConstInt32(0));
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 0)),
+                 JIT_BlockAsCFGNode(loop_block));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  JIT_IfNotZeroValue(ilinjector,
+                     JIT_CreateNode2C(OP_icmpge,
+                                      JIT_LoadTemporary(ilinjector, i),
+                                      JIT_LoadParameter(ilinjector, 0)),
+                     exit_block);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(loop_block),
+                 JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 2)));
+
+  JIT_SetCurrentBlock(ilinjector, 2);
+  JIT_BlockRef case_blocks[2] = {JIT_GetBlock(ilinjector, 3),
+                                 JIT_GetBlock(ilinjector, 4)};
+  int32_t case_values[2] = {0, 1};
+  JIT_Switch(ilinjector,
+             JIT_CreateNode2C(OP_iand, JIT_LoadTemporary(ilinjector, i),
+                              JIT_ConstInt32(3)),
+             JIT_GetBlock(ilinjector, 5), 2, case_blocks, case_values);
+
+  JIT_SetCurrentBlock(ilinjector, 3);
+  data->dominant_target = JIT_GetDominantCallTarget(ilinjector, 90);
+  JIT_NodeRef args[1] = {JIT_LoadTemporary(ilinjector, i)};
+  auto value = JIT_IndirectCall(ilinjector, JIT_LoadParameter(ilinjector, 1),
+                                JIT_Int32, 1, args);
+  JIT_StoreToTemporary(
+      ilinjector, sum,
+      JIT_CreateNode2C(OP_iadd, JIT_LoadTemporary(ilinjector, sum), value));
+  JIT_Goto(ilinjector, latch_block);
+
+  for (int b = 4; b <= 5; b++) {
+    JIT_SetCurrentBlock(ilinjector, b);
+    JIT_StoreToTemporary(ilinjector, sum,
+                         JIT_CreateNode2C(OP_iadd,
+                                          JIT_LoadTemporary(ilinjector, sum),
+                                          JIT_ConstInt32(b == 4 ? 1 : 2)));
+    JIT_Goto(ilinjector, latch_block);
+  }
+
+  JIT_SetCurrentBlock(ilinjector, 6);
+  JIT_StoreToTemporary(ilinjector, i,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, i),
+                                        JIT_ConstInt32(1)));
+  JIT_Goto(ilinjector, loop_block);
+
+  JIT_SetCurrentBlock(ilinjector, 7);
+  JIT_ReturnValue(ilinjector, JIT_LoadTemporary(ilinjector, sum));
+  return true;
+}
+
+static int32_t test22_expected(int32_t n) {
+  int32_t sum = 0;
+  for (int32_t i = 0; i < n; i++)
+    sum += (i & 3) == 0 ? test22_callee(i) : (i & 3) == 1 ? 1 : 2;
+  return sum;
+}
+
+static int test22(JIT_ContextRef ctx) {
+  typedef int32_t (*F)(int32_t, int32_t (*)(int32_t));
+  JIT_Type params[2] = {JIT_Int32, JIT_Address};
+  Test22Data data = {NULL};
+  int failures = 0;
+  for (int opt_level = 1; opt_level <= 2; opt_level++) {
+    JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+        ctx, "profiled", JIT_Int32, 2, params, test22_il, &data);
+    JIT_EnableProfiling(function_builder);
+    F f = (F)JIT_Compile(function_builder, opt_level);
+    JIT_DestroyFunctionBuilder(function_builder);
+    if (!f)
+      return 1;
+    for (int32_t n = 0; n < 100; n++) {
+      if (f(n, test22_callee) != test22_expected(n))
+        failures++;
+    }
+  }
+  /* Only the warm code counts */
+  if (JIT_GetProfiledEntryCount(ctx, "profiled") != 100)
+    failures++;
+  if (data.dominant_target != (void *)test22_callee)
+    failures++;
+  printf("Profiled compiles gave %d wrong results\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*
+  int32_t f(int32_t n, int32_t (*fp)(int32_t)) {
+    int32_t t[20] = {0, 1, ..., 19};
+    for (int32_t i = 0; i < n; i++) {
+      for (int k = 0; k < 20; k++)
+        t[k] = t[k] * 3 + i + k;
+      t[0] += fp(i);
+    }
+    return t[0] ^ t[1] ^ ... ^ t[19];
+  }
+More values are live across the loop than there are registers, and
+the call clobbers the volatile ones.
+*/
+enum { TEST23_TEMPS = 20 };
+
+static int32_t test23_callee(int32_t x) { return x - 7; }
+
+static bool test23_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, 4);
+  JIT_BlockRef loop_block = JIT_GetBlock(ilinjector, 1);
+  JIT_BlockRef exit_block = JIT_GetBlock(ilinjector, 3);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  JIT_SymbolRef t[TEST23_TEMPS];
+  for (int k = 0; k < TEST23_TEMPS; k++) {
+    t[k] = JIT_CreateTemporary(ilinjector, JIT_Int32);
+    JIT_StoreToTemporary(ilinjector, t[k], JIT_ConstInt32(k));
+  }
+  auto i = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_StoreToTemporary(ilinjector, i, JIT_ConstInt32(0));
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 0)),
+                 JIT_BlockAsCFGNode(loop_block));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  JIT_IfNotZeroValue(ilinjector,
+                     JIT_CreateNode2C(OP_icmpge,
+                                      JIT_LoadTemporary(ilinjector, i),
+                                      JIT_LoadParameter(ilinjector, 0)),
+                     exit_block);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(loop_block),
+                 JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 2)));
+
+  JIT_SetCurrentBlock(ilinjector, 2);
+  for (int k = 0; k < TEST23_TEMPS; k++) {
+    auto scaled = JIT_CreateNode2C(OP_imul, JIT_LoadTemporary(ilinjector, t[k]),
+                                   JIT_ConstInt32(3));
+    auto value = JIT_CreateNode2C(
+        OP_iadd,
+        JIT_CreateNode2C(OP_iadd, scaled, JIT_LoadTemporary(ilinjector, i)),
+        JIT_ConstInt32(k));
+    JIT_StoreToTemporary(ilinjector, t[k], value);
+  }
+  JIT_NodeRef args[1] = {JIT_LoadTemporary(ilinjector, i)};
+  auto result = JIT_IndirectCall(ilinjector, JIT_LoadParameter(ilinjector, 1),
+                                 JIT_Int32, 1, args);
+  JIT_StoreToTemporary(
+      ilinjector, t[0],
+      JIT_CreateNode2C(OP_iadd, JIT_LoadTemporary(ilinjector, t[0]), result));
+  JIT_StoreToTemporary(ilinjector, i,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, i),
+                                        JIT_ConstInt32(1)));
+  JIT_Goto(ilinjector, loop_block);
+
+  JIT_SetCurrentBlock(ilinjector, 3);
+  auto folded = JIT_LoadTemporary(ilinjector, t[0]);
+  for (int k = 1; k < TEST23_TEMPS; k++)
+    folded = JIT_CreateNode2C(OP_ixor, folded,
+                              JIT_LoadTemporary(ilinjector, t[k]));
+  JIT_ReturnValue(ilinjector, folded);
+  return true;
+}
+
+static int32_t test23_expected(int32_t n) {
+  uint32_t t[TEST23_TEMPS];
+  for (int k = 0; k < TEST23_TEMPS; k++)
+    t[k] = k;
+  for (int32_t i = 0; i < n; i++) {
+    for (int k = 0; k < TEST23_TEMPS; k++)
+      t[k] = t[k] * 3 + (uint32_t)i + k;
+    t[0] += (uint32_t)test23_callee(i);
+  }
+  uint32_t folded = t[0];
+  for (int k = 1; k < TEST23_TEMPS; k++)
+    folded ^= t[k];
+  return (int32_t)folded;
+}
+
+static int test23(JIT_ContextRef ctx) {
+  typedef int32_t (*F)(int32_t, int32_t (*)(int32_t));
+  JIT_Type params[2] = {JIT_Int32, JIT_Address};
+  /* enable_debug_counters() turns on the linear scan allocator for the
+     _scan names, and drops global register allocation for _scan_only */
+  static const char *names[] = {"pressure", "pressure_scan",
+                                "pressure_scan_only"};
+  int failures = 0;
+  for (const char *name : names) {
+    for (int opt_level = 1; opt_level <= 2; opt_level++) {
+      JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+          ctx, name, JIT_Int32, 2, params, test23_il, NULL);
+      F f = (F)JIT_Compile(function_builder, opt_level);
+      JIT_DestroyFunctionBuilder(function_builder);
+      if (!f)
+        return 1;
+      for (int32_t n = 0; n < 50; n++) {
+        if (f(n, test23_callee) != test23_expected(n))
+          failures++;
+      }
+    }
+  }
+  printf("Linear scan register allocation gave %d wrong results\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*
+Some tests check that an optimization happened by reading the static debug
+counter it bumps. The counters must be enabled before the JIT starts; any
+options already given in TR_Options are kept.
+*/
+/*
+  int32_t f(int32_t n) {
+    int32_t sum = 0;
+    for (int32_t i = 0; i < n; i++) {
+      if ((i & 7) == 0) { int32_t t0 = i + 0; sum += t0; }
+      ...
+      if ((i & 7) == 7) { int32_t t63 = i + 63; sum += t63; }
+    }
+    return sum;
+  }
+The same method is compiled hot within the default compile budget and, as
+over_budget, with compileBudget=2000 set for it by enable_debug_counters(),
+which is far below what global value propagation and the unroller would
+cost on it.
+*/
+enum { TEST24_DIAMONDS = 64 };
+
+static bool test24_il(JIT_ILInjectorRef ilinjector, void *userdata) {
+  JIT_CreateBlocks(ilinjector, 4 + 2 * TEST24_DIAMONDS);
+  JIT_BlockRef loop_block = JIT_GetBlock(ilinjector, 1);
+  JIT_BlockRef exit_block = JIT_GetBlock(ilinjector, 3 + 2 * TEST24_DIAMONDS);
+
+  JIT_SetCurrentBlock(ilinjector, 0);
+  auto sum = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  auto i = JIT_CreateTemporary(ilinjector, JIT_Int32);
+  JIT_StoreToTemporary(ilinjector, sum, JIT_ConstInt32(0));
+  JIT_StoreToTemporary(ilinjector, i, JIT_ConstInt32(0));
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 0)),
+                 JIT_BlockAsCFGNode(loop_block));
+
+  JIT_SetCurrentBlock(ilinjector, 1);
+  JIT_IfNotZeroValue(ilinjector,
+                     JIT_CreateNode2C(OP_icmpge,
+                                      JIT_LoadTemporary(ilinjector, i),
+                                      JIT_LoadParameter(ilinjector, 0)),
+                     exit_block);
+  JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(loop_block),
+                 JIT_BlockAsCFGNode(JIT_GetBlock(ilinjector, 2)));
+
+  for (int k = 0; k < TEST24_DIAMONDS; k++) {
+    JIT_BlockRef test_block = JIT_GetBlock(ilinjector, 2 + 2 * k);
+    JIT_BlockRef then_block = JIT_GetBlock(ilinjector, 3 + 2 * k);
+    JIT_BlockRef next_block = JIT_GetBlock(ilinjector, 4 + 2 * k);
+    JIT_SetCurrentBlock(ilinjector, 2 + 2 * k);
+    auto low_bits = JIT_CreateNode2C(OP_iand, JIT_LoadTemporary(ilinjector, i),
+                                     JIT_ConstInt32(7));
+    JIT_IfNotZeroValue(
+        ilinjector,
+        JIT_CreateNode2C(OP_icmpne, low_bits, JIT_ConstInt32(k & 7)),
+        next_block);
+    JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(test_block),
+                   JIT_BlockAsCFGNode(then_block));
+
+    JIT_SetCurrentBlock(ilinjector, 3 + 2 * k);
+    auto t = JIT_CreateTemporary(ilinjector, JIT_Int32);
+    JIT_StoreToTemporary(ilinjector, t,
+                         JIT_CreateNode2C(OP_iadd,
+                                          JIT_LoadTemporary(ilinjector, i),
+                                          JIT_ConstInt32(k)));
+    JIT_StoreToTemporary(ilinjector, sum,
+                         JIT_CreateNode2C(OP_iadd,
+                                          JIT_LoadTemporary(ilinjector, sum),
+                                          JIT_LoadTemporary(ilinjector, t)));
+    JIT_CFGAddEdge(ilinjector, JIT_BlockAsCFGNode(then_block),
+                   JIT_BlockAsCFGNode(next_block));
+  }
+
+  JIT_SetCurrentBlock(ilinjector, 2 + 2 * TEST24_DIAMONDS);
+  JIT_StoreToTemporary(ilinjector, i,
+                       JIT_CreateNode2C(OP_iadd,
+                                        JIT_LoadTemporary(ilinjector, i),
+                                        JIT_ConstInt32(1)));
+  JIT_Goto(ilinjector, loop_block);
+
+  JIT_SetCurrentBlock(ilinjector, 3 + 2 * TEST24_DIAMONDS);
+  JIT_ReturnValue(ilinjector, JIT_LoadTemporary(ilinjector, sum));
+  return true;
+}
+
+static int32_t test24_expected(int32_t n) {
+  int32_t sum = 0;
+  for (int32_t i = 0; i < n; i++) {
+    for (int k = 0; k < TEST24_DIAMONDS; k++) {
+      if ((i & 7) == (k & 7))
+        sum += i + k;
+    }
+  }
+  return sum;
+}
+
+static const char *test24_counters[] = {
+    "compileBudget/globalValuePropagationDowngraded",
+    "compileBudget/loopDuplicationSkipped"};
+
+static int test24(JIT_ContextRef ctx) {
+  static const char *names[] = {"within_budget", "over_budget"};
+  const int num_counters = sizeof test24_counters / sizeof test24_counters[0];
+  JIT_Type params[1] = {JIT_Int32};
+  int failures = 0;
+  for (int over = 0; over <= 1; over++) {
+    int64_t before[num_counters];
+    for (int c = 0; c < num_counters; c++)
+      before[c] = JIT_GetStaticDebugCounter(ctx, test24_counters[c]);
+    JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+        ctx, names[over], JIT_Int32, 1, params, test24_il, NULL);
+    typedef int32_t (*F)(int32_t);
+    F f = (F)JIT_Compile(function_builder, 2);
+    JIT_DestroyFunctionBuilder(function_builder);
+    if (!f)
+      return 1;
+    for (int c = 0; c < num_counters; c++) {
+      if ((JIT_GetStaticDebugCounter(ctx, test24_counters[c]) > before[c]) !=
+          (over == 1)) {
+        printf("%s: %s%s\n", names[over], over ? "no " : "",
+               test24_counters[c]);
+        failures++;
+      }
+    }
+    for (int32_t n = 0; n < 40; n++) {
+      if (f(n) != test24_expected(n))
+        failures++;
+    }
+  }
+  printf("Compile budget had %d failures\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*
+The diamonds of test24 collapse and their blocks are merged back
+into the loop body while the dominator tree is cached. Hot compiles then
+reuse the tree updated in place for global value numbering. main() sets
+TR_VerifyDominators, which checks every reuse in the suite against a
+tree built from scratch.
+*/
+static const struct {
+  const char *name;
+  int min_opt_level;
+} test25_counters[] = {{"dominators/mergeBlocks", 1},
+                       {"dominators/reusedAfterEdits", 2}};
+
+static int test25(JIT_ContextRef ctx) {
+  const int num_counters = sizeof test25_counters / sizeof test25_counters[0];
+  JIT_Type params[1] = {JIT_Int32};
+  int failures = 0;
+  for (int opt_level = 0; opt_level <= 2; opt_level++) {
+    int64_t before[num_counters];
+    for (int c = 0; c < num_counters; c++)
+      before[c] = JIT_GetStaticDebugCounter(ctx, test25_counters[c].name);
+    JIT_FunctionBuilderRef function_builder = JIT_CreateFunctionBuilder(
+        ctx, "merged_blocks", JIT_Int32, 1, params, test24_il, NULL);
+    typedef int32_t (*F)(int32_t);
+    F f = (F)JIT_Compile(function_builder, opt_level);
+    JIT_DestroyFunctionBuilder(function_builder);
+    if (!f)
+      return 1;
+    for (int c = 0; c < num_counters; c++) {
+      bool expected = opt_level >= test25_counters[c].min_opt_level;
+      if ((JIT_GetStaticDebugCounter(ctx, test25_counters[c].name) >
+           before[c]) != expected) {
+        printf("%s %sat opt level %d\n", test25_counters[c].name,
+               expected ? "not " : "", opt_level);
+        failures++;
+      }
+    }
+    for (int32_t n = 0; n < 40; n++) {
+      if (f(n) != test24_expected(n))
+        failures++;
+    }
+  }
+  printf("Dominator reuse had %d failures\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+static void enable_debug_counters() {
+  std::string options =
+      "staticDebugCounters={loopVectorizer/*|loopVersioner/*|"
+      "localArrayScalarization/*|cfgSimpCMOV/*|"
+      "globalValueNumbering/*|compileBudget/*|dominators/*},"
+      "{*over_budget}(compileBudget=2000),"
+      "{*_scan_only}(enableLinearScanRA,disableGRA),"
+      "{*_scan}(enableLinearScanRA)";
+  const char *env = getenv("TR_Options");
+  if (env && *env)
+    options = std::string(env) + "," + options;
+  /* Check every reuse of a cached dominator tree against a rebuilt one */
+#ifdef _WIN32
+  _putenv_s("TR_Options", options.c_str());
+  _putenv_s("TR_VerifyDominators", "1");
+#else
+  setenv("TR_Options", options.c_str(), 1);
+  setenv("TR_VerifyDominators", "1", 1);
+#endif
+}
+
 int main(int argc, const char *argv[]) {
   int errorcount = 0;
+  enable_debug_counters();
   JIT_ContextRef ctx = JIT_CreateContext();
   if (ctx) {
     errorcount += test1(ctx);
     errorcount += test2(ctx);
     errorcount += test3(ctx);
+    errorcount += test4(ctx);
+    errorcount += test5(ctx);
+    errorcount += test6(ctx);
+    errorcount += test7(ctx);
+    errorcount += test8(ctx);
+    errorcount += test9(ctx);
+    errorcount += test10(ctx);
+    errorcount += test11(ctx);
+    errorcount += test12(ctx);
+    errorcount += test13(ctx);
+    errorcount += test14(ctx);
+    errorcount += test15(ctx);
+    errorcount += test16(ctx);
+    errorcount += test17(ctx);
+    errorcount += test18(ctx);
+    errorcount += test19(ctx);
+    errorcount += test20(ctx);
+    errorcount += test21(ctx);
+    errorcount += test22(ctx);
+    errorcount += test23(ctx);
+    errorcount += test24(ctx);
+    errorcount += test25(ctx);
   } else {
     errorcount = 1;
   }
@@ -33,6 +33,9 @@
 #include "ilgen/MethodBuilder.hpp"
 #include "runtime/CodeCache.hpp"
 #include "runtime/Runtime.hpp"
+#include "runtime/NJCodeCacheCompactor.hpp"
+#include "runtime/NJRuntimeAssumptions.hpp"
+#include "runtime/NJCodeMetaDataManager.hpp"
 #include "runtime/NJJitConfig.hpp"
 
 #if defined(TR_TARGET_S390)
@@ -157,6 +160,15 @@ static bool initializeNJJit(TR_RuntimeHelper* helperIDs, void** helperAddresses,
 
     initializeCodeCache(fe.codeCacheManager());
 
+    if (!NJCompiler::CodeMetaDataManager::initialize())
+        return false;
+
+    if (!NJCompiler::CodeCacheCompactor::initialize())
+        return false;
+
+    if (!NJCompiler::RuntimeAssumptionTable::initialize())
+        return false;
+
     return true;
 }
 
@@ -174,6 +186,11 @@ void shutdownJit()
 {
     auto fe = NJCompiler::FrontEnd::instance();
 
+    // The code described by the metadata is about to go away
+    NJCompiler::CodeMetaDataManager::instance()->removeAllMetaData();
+    NJCompiler::CodeCacheCompactor::instance()->releaseAll();
+    NJCompiler::RuntimeAssumptionTable::instance()->releaseAll();
+
     TR::CodeCacheManager& codeCacheManager = fe->codeCacheManager();
     codeCacheManager.destroy();
 }
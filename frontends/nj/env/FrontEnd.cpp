@@ -36,6 +36,9 @@
 #include "env/jittypes.h"
 #include "il/DataTypes.hpp"
 #include "il/ILOps.hpp"
+#include "runtime/NJCodeCacheCompactor.hpp"
+#include "runtime/NJCodeMetaDataManager.hpp"
+#include "runtime/NJRuntimeAssumptions.hpp"
 
 //#include "util_api.h"
 
@@ -76,4 +79,27 @@ FrontEnd::methodTrampolineLookup(TR::Compilation *comp, TR::SymbolReference *sym
    return 0;
    }
 
+OMR::MethodMetaDataPOD *
+FrontEnd::createMethodMetaData(TR::Compilation *comp)
+   {
+   CodeMetaDataManager *manager = CodeMetaDataManager::instance();
+   if (!manager)
+      return NULL;
+
+   uintptr_t startPC = (uintptr_t)comp->cg()->getCodeStart();
+   uintptr_t endPC = (uintptr_t)comp->cg()->getCodeEnd();
+   if (startPC >= endPC)
+      return NULL;
+
+   const MethodMetaData *metaData = manager->insertMetaData(comp->getCurrentMethod()->nameChars(), startPC, endPC);
+
+   if (CodeCacheCompactor::instance())
+      CodeCacheCompactor::instance()->recordCompiledMethod(comp, metaData);
+
+   if (RuntimeAssumptionTable::instance())
+      RuntimeAssumptionTable::instance()->recordCompiledMethod(comp);
+
+   return const_cast<MethodMetaData *>(metaData);
+   }
+
 } //namespace NJCompiler
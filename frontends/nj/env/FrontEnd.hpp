@@ -65,6 +65,8 @@ class FrontEnd : public TR::FEBase<FrontEnd>
 
    virtual intptrj_t methodTrampolineLookup(TR::Compilation *comp, TR::SymbolReference *symRef,  void *currentCodeCache);
 
+   virtual OMR::MethodMetaDataPOD *createMethodMetaData(TR::Compilation *comp);
+
    TR_ResolvedMethod * createResolvedMethod(TR_Memory * trMemory, TR_OpaqueMethodBlock * aMethod,
                                             TR_ResolvedMethod * owningMethod, TR_OpaqueClassBlock *classForNewInstance);
 
@@ -26,6 +26,9 @@
 #include "compile/Method.hpp"
 #include "compile/SymbolReferenceTable.hpp"
 #include "control/CompileMethod.hpp"
+#include "control/Options.hpp"
+#include "env/FrontEnd.hpp"
+#include "env/PersistentInfo.hpp"
 #include "env/jittypes.h"
 #include "il/Block.hpp"
 #include "il/DataTypes.hpp"
@@ -34,16 +37,25 @@
 #include "il/Node_inlines.hpp"
 #include "il/TreeTop.hpp"
 #include "il/TreeTop_inlines.hpp"
+#include "il/symbol/ParameterSymbol.hpp"
 #include "ilgen/IlGeneratorMethodDetails_inlines.hpp"
 #include "ilgen/NJIlGenerator.hpp"
 #include "infra/Cfg.hpp"
-
+#include "ras/DebugCounter.hpp"
+#include "runtime/NJCodeCacheCompactor.hpp"
+#include "runtime/NJCodeMetaDataManager.hpp"
+#include "runtime/NJFunctionProfile.hpp"
+#include "runtime/NJRuntimeAssumptions.hpp"
+
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
 #include <stdarg.h>
+#include <stddef.h>
 
 #define TraceEnabled (injector->comp()->getOption(TR_TraceILGen))
 #define TraceIL(m, ...)                                   \
@@ -72,6 +84,7 @@ struct ResolvedMethodWrapper {
     std::string name_;
     std::vector<TR::DataType> params_;
     TR::ResolvedMethod resolvedMethod_;
+    uint32_t attributes_; /* JIT_FunctionAttribute mask */
 
     ResolvedMethodWrapper(const char* fileName, const char* lineNumber, const char* name,
         std::vector<TR::DataType>& params, TR::DataType returnType, void* entryPoint)
@@ -83,28 +96,51 @@ struct ResolvedMethodWrapper {
         // FIXME
         resolvedMethod_((char*)file_.data(), (char*)line_.data(), (char*)name_.data(), (int32_t)params_.size(),
             params_.data(), returnType, entryPoint, NULL)
+        , attributes_(0)
     {}
 };
 
+/* Called by instrumented code before each indirect call */
+static const char* PROFILE_CALL_TARGET_HELPER = "nj_profile_call_target";
+
 struct Context {
     Context()
         : function_id_(0)
-    {}
+    {
+        std::vector<TR::DataType> args(2, TR::Address);
+        registerFunction(PROFILE_CALL_TARGET_HELPER, TR::NoType, args,
+            (void*)&NJCompiler::FunctionProfile::recordCallTarget);
+    }
+    ~Context()
+    {
+        for (auto& profile : profiles_) {
+            profile.second->~FunctionProfile();
+            NJCompiler::FunctionProfile::jitPersistentFree(profile.second);
+        }
+    }
     FunctionBuilder* newFunctionBuilder(
         const char* name, JIT_Type return_type, JIT_ILBuilder ilbuilder, void* userdata);
     FunctionBuilder* newFunctionBuilder(const char* name, JIT_Type return_type, int argc, const JIT_Type* args,
         JIT_ILBuilder ilbuilder, void* userdata);
     void registerFunction(const char* name, TR::DataType return_type, std::vector<TR::DataType>& args, void* ptr);
     TR::ResolvedMethod* getFunction(const char* name);
+    uint32_t getFunctionAttributes(const char* name);
+    NJCompiler::FunctionProfile* getProfile(const char* name, bool create);
 
     /* Functions by name - include both JITed and external functions */
     typedef std::map<std::string, std::shared_ptr<ResolvedMethodWrapper> > FunctionMap;
     FunctionMap functions_;
     unsigned int function_id_; /* For generating names for indirect calls TODO needs to be atomic */
+    /* Profiles by function name, kept while the instrumented code may run */
+    typedef std::map<std::string, NJCompiler::FunctionProfile*> ProfileMap;
+    ProfileMap profiles_;
+    /* Guard words by assumption id, zero while the assumption holds; guarded by s_jitlock */
+    std::map<uint64_t, int32_t> assumptions_;
 };
 
 static std::mutex s_jitlock;
 static volatile int s_ctxcount;
+static std::vector<Context*> s_contexts; /* All live contexts, guarded by s_jitlock */
 
 struct ShadowSymInfo {
     ShadowSymInfo* next;
@@ -115,6 +151,12 @@ struct ShadowSymInfo {
     TR::SymbolReference* shadowSymbol;
 };
 
+struct FunctionSymInfo {
+    FunctionSymInfo* next;
+    TR::ResolvedMethod* resolvedMethod;
+    TR::SymbolReference* methodSymbol;
+};
+
 /*
 This is a cutdown version of JitBuilder's ILInjector
 class.
@@ -126,7 +168,13 @@ struct SimpleILInjector : public TR::IlGenerator {
         , _numBlocks(0)
         , _blocks(nullptr)
         , function_builder_(function_builder)
+        , profile_(nullptr)
+        , instrument_(false)
+        , indirect_calls_(0)
+        , readonly_stores_(0)
         , shadow_symbols_(nullptr)
+        , alias_class_shadows_(nullptr)
+        , function_symbols_(nullptr)
     {}
 
     bool injectIL() override; /* override */
@@ -176,6 +224,70 @@ struct SimpleILInjector : public TR::IlGenerator {
         return info->shadowSymbol;
     }
 
+    /*
+    Returns the array shadow for accesses of the given type tagged with
+    the given alias class, or made through the given restrict parameter
+    if aliasClass is 0. Shadows of different alias classes are made
+    independent of each other, but still alias the untagged array shadow
+    of the same type.
+    */
+    TR::SymbolReference* findOrCreateAliasClassShadowSymRef(
+        uint64_t aliasClass, int32_t restrictParm, TR::DataType type)
+    {
+        for (ShadowSymInfo* syminfo = alias_class_shadows_; syminfo != nullptr; syminfo = syminfo->next) {
+            if (syminfo->typeSymbol == aliasClass && syminfo->offset == restrictParm && syminfo->type == type) {
+                return syminfo->shadowSymbol;
+            }
+        }
+        auto symRefTab = _comp->getSymRefTab();
+        symRefTab->findOrCreateArrayShadowSymbolRef(type, nullptr);
+        TR::SymbolReference* symRef = symRefTab->createRefinedArrayShadowSymbolRef(type);
+        for (ShadowSymInfo* syminfo = alias_class_shadows_; syminfo != nullptr; syminfo = syminfo->next) {
+            if (syminfo->type == type) {
+                symRef->makeIndependent(symRefTab, syminfo->shadowSymbol);
+            }
+        }
+        ShadowSymInfo* info = new (_comp->trHeapMemory()) ShadowSymInfo();
+        info->type = type;
+        info->offset = restrictParm;
+        info->shadowSymbol = symRef;
+        info->typeSymbol = aliasClass;
+        info->next = alias_class_shadows_;
+        alias_class_shadows_ = info;
+        return symRef;
+    }
+
+    /*
+    Returns the one method symbol used by all calls to the given function,
+    so that calls with the same arguments can be commoned.
+    */
+    TR::SymbolReference* findOrCreateFunctionSymRef(TR::ResolvedMethod* resolvedMethod)
+    {
+        for (FunctionSymInfo* syminfo = function_symbols_; syminfo != nullptr; syminfo = syminfo->next) {
+            if (syminfo->resolvedMethod == resolvedMethod) {
+                return syminfo->methodSymbol;
+            }
+        }
+        FunctionSymInfo* info = new (_comp->trHeapMemory()) FunctionSymInfo();
+        info->resolvedMethod = resolvedMethod;
+        info->methodSymbol
+            = _comp->getSymRefTab()->findOrCreateComputedStaticMethodSymbol(JITTED_METHOD_INDEX, -1, resolvedMethod);
+        info->next = function_symbols_;
+        function_symbols_ = info;
+        return info->methodSymbol;
+    }
+
+    /*
+    Creates a block after all the others, for code that is out of line.
+    */
+    TR::Block* appendBlock()
+    {
+        TR::Block* block = newBlock();
+        cfg()->addNode(block);
+        _methodSymbol->getLastTreeTop()->join(block->getEntry());
+        return block;
+    }
+
     void generateToBlock(int32_t b)
     {
         _currentBlockNumber = b;
@@ -205,7 +317,13 @@ struct SimpleILInjector : public TR::IlGenerator {
     TR::Block** _blocks;
 
     FunctionBuilder* function_builder_;
+    NJCompiler::FunctionProfile* profile_; /* profile of the function, if any */
+    bool instrument_; /* insert the counters of the profile */
+    int32_t indirect_calls_; /* indirect calls generated so far */
+    int32_t readonly_stores_; /* stores through read only parameters, which fail the compile */
     ShadowSymInfo* shadow_symbols_;
+    ShadowSymInfo* alias_class_shadows_;
+    FunctionSymInfo* function_symbols_;
 };
 
 struct FunctionBuilder {
@@ -214,6 +332,9 @@ struct FunctionBuilder {
     char name_[128];
     TR::DataTypes return_type_;
     std::vector<TR::DataTypes> args_;
+    std::vector<uint32_t> arg_attributes_;
+    std::string deopt_handler_; /* called when a guard fails */
+    bool profiling_; /* warm compiles are instrumented */
     JIT_ILBuilder ilbuilder_;
     void* userdata_;
     char file_[30];
@@ -224,6 +345,7 @@ struct FunctionBuilder {
         : context_(ctx)
         , ilgenerator_(this)
         , return_type_((TR::DataTypes)return_type)
+        , profiling_(false)
         , ilbuilder_(ilbuilder)
         , userdata_(userdata)
     {
@@ -234,6 +356,22 @@ struct FunctionBuilder {
         for (int i = 0; i < argc; i++) {
             args_.push_back((TR::DataTypes)args[i]);
         }
+        arg_attributes_.resize(argc, 0);
+    }
+
+    /*
+    Returns the attributes of the parameter loaded by the given node,
+    or 0 if the node is not a parameter load.
+    */
+    uint32_t parameterAttributes(TR::Node* node, int32_t& slot)
+    {
+        slot = -1;
+        if (node->getOpCodeValue() != TR::aload || !node->getSymbol()->isParm())
+            return 0;
+        slot = node->getSymbol()->getParmSymbol()->getOrdinal();
+        if (slot < 0 || slot >= arg_attributes_.size())
+            return 0;
+        return arg_attributes_[slot];
     }
 
     void* compile(int opt_level)
@@ -249,6 +387,9 @@ struct FunctionBuilder {
         TR::IlGeneratorMethodDetails methodDetails(&resolvedMethod);
         int32_t rc = 0;
         auto hotness = opt_level == 0 ? TR_Hotness::noOpt : (opt_level == 1 ? TR_Hotness::warm : TR_Hotness::hot);
+        /* Warm compiles gather the profile that hot compiles use */
+        ilgenerator_.instrument_ = profiling_ && hotness == TR_Hotness::warm;
+        ilgenerator_.profile_ = context_->getProfile(name_, ilgenerator_.instrument_);
         uint8_t* entry_point = compileMethodFromDetails(NULL, methodDetails, hotness, rc);
         if (entry_point) {
             context_->registerFunction(name_, return_type_, argIlTypes, entry_point);
@@ -277,8 +418,7 @@ void Context::registerFunction(
 {
     std::shared_ptr<ResolvedMethodWrapper> resolvedMethod
         = std::make_shared<ResolvedMethodWrapper>("file", "line", name, argIlTypes, return_type, ptr);
-    functions_.insert(
-        std::pair<std::string, std::shared_ptr<ResolvedMethodWrapper> >(std::string(name), resolvedMethod));
+    functions_[std::string(name)] = resolvedMethod;
 }
 
 TR::ResolvedMethod* Context::getFunction(const char* name)
@@ -289,6 +429,26 @@ TR::ResolvedMethod* Context::getFunction(const char* name)
     return &opcode->second->resolvedMethod_;
 }
 
+NJCompiler::FunctionProfile* Context::getProfile(const char* name, bool create)
+{
+    auto profile = profiles_.find(name);
+    if (profile != profiles_.end())
+        return profile->second;
+    if (!create)
+        return nullptr;
+    NJCompiler::FunctionProfile* newProfile = new (PERSISTENT_NEW) NJCompiler::FunctionProfile();
+    profiles_[std::string(name)] = newProfile;
+    return newProfile;
+}
+
+uint32_t Context::getFunctionAttributes(const char* name)
+{
+    auto function = functions_.find(name);
+    if (function == functions_.cend())
+        return 0;
+    return function->second->attributes_;
+}
+
 static inline JIT_ContextRef wrap_context(Context* p) { return reinterpret_cast<JIT_ContextRef>(p); }
 
 static inline Context* unwrap_context(JIT_ContextRef p) { return reinterpret_cast<Context*>(p); }
@@ -335,7 +495,19 @@ static inline TR::SymbolReference* unwrap_symbolref(JIT_SymbolRef p)
 
 bool SimpleILInjector::injectIL()
 {
-    return (function_builder_->ilbuilder_(wrap_ilinjector(this), function_builder_->userdata_));
+    indirect_calls_ = 0;
+    readonly_stores_ = 0;
+    if (!function_builder_->ilbuilder_(wrap_ilinjector(this), function_builder_->userdata_))
+        return false;
+    if (readonly_stores_ > 0)
+        return false;
+    if (profile_) {
+        if (instrument_)
+            profile_->instrument(comp());
+        else if (comp()->getMethodHotness() >= hot)
+            profile_->apply(comp());
+    }
+    return true;
 }
 
 } // namespace nj
@@ -355,6 +527,10 @@ JIT_ContextRef JIT_CreateContext()
     }
 
     Context* context = new Context();
+    {
+        std::lock_guard<std::mutex> g(s_jitlock);
+        s_contexts.push_back(context);
+    }
 
     return wrap_context(context);
 }
@@ -365,8 +541,9 @@ void JIT_DestroyContext(JIT_ContextRef ctx)
     if (!context)
         return;
     {
-        delete context;
         std::lock_guard<std::mutex> g(s_jitlock);
+        s_contexts.erase(std::find(s_contexts.begin(), s_contexts.end(), context));
+        delete context;
         s_ctxcount--;
         if (s_ctxcount == 0)
             NJCompiler::shutdownJit();
@@ -384,6 +561,14 @@ void JIT_RegisterFunction(JIT_ContextRef ctx, const char* name, enum JIT_Type re
     context->registerFunction(name, TR::DataType((TR::DataTypes)return_type), argIlTypes, ptr);
 }
 
+void JIT_SetFunctionAttributes(JIT_ContextRef ctx, const char* name, uint32_t attributes)
+{
+    Context* context = unwrap_context(ctx);
+    auto function = context->functions_.find(name);
+    if (function != context->functions_.cend())
+        function->second->attributes_ = attributes;
+}
+
 void* JIT_GetFunction(JIT_ContextRef ctx, const char* name)
 {
     Context* context = unwrap_context(ctx);
@@ -407,12 +592,95 @@ void JIT_DestroyFunctionBuilder(JIT_FunctionBuilderRef fb)
     delete function_builder;
 }
 
+void JIT_SetParameterAttributes(JIT_FunctionBuilderRef fb, int32_t slot, uint32_t attributes, int32_t alignment)
+{
+    FunctionBuilder* function_builder = unwrap_function_builder(fb);
+    if (slot < 0 || slot >= function_builder->args_.size())
+        return;
+    if (function_builder->args_[slot] != TR::Address)
+        attributes = 0;
+    function_builder->arg_attributes_[slot] = attributes;
+}
+
+void JIT_SetDeoptHandler(JIT_FunctionBuilderRef fb, const char* handler_name)
+{
+    FunctionBuilder* function_builder = unwrap_function_builder(fb);
+    function_builder->deopt_handler_ = handler_name ? handler_name : "";
+}
+
+void JIT_EnableProfiling(JIT_FunctionBuilderRef fb)
+{
+    FunctionBuilder* function_builder = unwrap_function_builder(fb);
+    function_builder->profiling_ = true;
+}
+
+uint64_t JIT_GetProfiledEntryCount(JIT_ContextRef ctx, const char* name)
+{
+    Context* context = unwrap_context(ctx);
+    NJCompiler::FunctionProfile* profile = context->getProfile(name, false);
+    return profile ? profile->getEntryCount() : 0;
+}
+
+int64_t JIT_GetStaticDebugCounter(JIT_ContextRef ctx, const char* name)
+{
+    auto counters = NJCompiler::FrontEnd::instance()->getPersistentInfo()->getStaticCounters();
+    TR::DebugCounter* counter = counters->findCounter(name);
+    return counter ? counter->getCount() : 0;
+}
+
+void* JIT_GetDominantCallTarget(JIT_ILInjectorRef ilinjector, int32_t min_percent)
+{
+    auto injector = unwrap_ilinjector(ilinjector);
+    if (!injector->profile_)
+        return nullptr;
+    return injector->profile_->getDominantCallTarget(injector->indirect_calls_, min_percent);
+}
+
 void* JIT_Compile(JIT_FunctionBuilderRef fb, int opt_level)
 {
     FunctionBuilder* function_builder = unwrap_function_builder(fb);
     return function_builder->compile(opt_level);
 }
 
+bool JIT_LookupFunctionByPC(void* pc, JIT_FunctionInfo* info)
+{
+    auto manager = NJCompiler::CodeMetaDataManager::instance();
+    NJCompiler::MethodMetaData metaData;
+    if (!manager || !pc || !manager->lookup((uintptr_t)pc, metaData))
+        return false;
+    info->name = metaData.name;
+    info->start_pc = (void*)metaData.startPC;
+    info->end_pc = (void*)metaData.endPC;
+    return true;
+}
+
+void JIT_EnableCodeCacheCompaction(JIT_ContextRef ctx)
+{
+    NJCompiler::CodeCacheCompactor::instance()->enable();
+}
+
+int JIT_CompactCodeCache(JIT_ContextRef ctx)
+{
+    std::lock_guard<std::mutex> g(s_jitlock);
+    // The code caches are shared so every context's functions are roots
+    std::vector<TR::ResolvedMethod*> functions;
+    std::vector<void*> entryPoints;
+    for (Context* context : s_contexts) {
+        for (auto& function : context->functions_) {
+            TR::ResolvedMethod* resolvedMethod = &function.second->resolvedMethod_;
+            if (resolvedMethod->getEntryPoint()) {
+                functions.push_back(resolvedMethod);
+                entryPoints.push_back(resolvedMethod->getEntryPoint());
+            }
+        }
+    }
+    int count = NJCompiler::CodeCacheCompactor::instance()->compact(entryPoints.data(), (int32_t)entryPoints.size());
+    for (size_t i = 0; i < functions.size(); i++) {
+        functions[i]->setEntryPoint(entryPoints[i]);
+    }
+    return count;
+}
+
 void JIT_CreateBlocks(JIT_ILInjectorRef ilinjector, int32_t num)
 {
     auto injector = unwrap_ilinjector(ilinjector);
@@ -559,7 +827,7 @@ void JIT_SetAutoAddressTaken(JIT_ILInjectorRef ilinjector, JIT_SymbolRef symbol)
 {
     auto injector = unwrap_ilinjector(ilinjector);
     auto symref = unwrap_symbolref(symbol);
-    if (symref->isTemporary(injector->comp())) {
+    if (symref->getSymbol()->isAutoOrParm()) {
         injector->comp()->getSymRefTab()->aliasBuilder.addressTakenAutos().set(symref->getReferenceNumber());
     }
 }
@@ -580,7 +848,25 @@ JIT_NodeRef JIT_LoadAddress(JIT_ILInjectorRef ilinjector, JIT_SymbolRef symbol)
         }
         TR_ASSERT(false, "Function Symbol must resolve to a static address");
     }
-    return wrap_node(TR::Node::createWithSymRef(TR::loadaddr, 0, symref));
+    return wrap_node(TR::Node::createWithSymRefWithComp(injector->comp(), TR::loadaddr, 0, symref));
+}
+
+/**
+ * Integer constants for functions that have the injector, and so the
+ * compilation, at hand
+ */
+static TR::Node* create_iconst(TR::Compilation* comp, int32_t value)
+{
+    TR::Node* node = TR::Node::createWithComp(comp, TR::iconst);
+    node->setInt(value);
+    return node;
+}
+
+static TR::Node* create_lconst(TR::Compilation* comp, int64_t value)
+{
+    TR::Node* node = TR::Node::createWithComp(comp, TR::lconst);
+    node->setLongInt(value);
+    return node;
 }
 
 /**
@@ -591,26 +877,46 @@ static TR::Node* get_array_element_address(
 {
     TR_ASSERT(baseNode->getDataType() == TR::Address, "IndexAt must be called with a pointer base");
     TR_ASSERT(elemType != TR::NoType, "Cannot use IndexAt with pointer to NoType.");
+    TR::Compilation* comp = injector->comp();
     TR::ILOpCodes addOp;
     TR::DataType indexType = indexNode->getDataType();
     if (TR::Compiler->target.is64Bit()) {
         if (indexType != TR::Int64) {
             TR::ILOpCodes op = TR::DataType::getDataTypeConversion(indexType, TR::Int64);
-            indexNode = TR::Node::create(op, 1, indexNode);
+            indexNode = TR::Node::createWithComp(comp, op, 1, indexNode);
         }
         addOp = TR::aladd;
     } else {
         TR::DataType targetType = TR::Int32;
         if (indexType != targetType) {
             TR::ILOpCodes op = TR::DataType::getDataTypeConversion(indexType, targetType);
-            indexNode = TR::Node::create(op, 1, indexNode);
+            indexNode = TR::Node::createWithComp(comp, op, 1, indexNode);
         }
         addOp = TR::aiadd;
     }
-    TR::Node* addrNode = TR::Node::create(addOp, 2, baseNode, indexNode);
+    TR::Node* addrNode = TR::Node::createWithComp(comp, addOp, 2, baseNode, indexNode);
     return addrNode;
 }
 
+/**
+ * Returns the shadow for an indirect access of given type through base;
+ * accesses through a restrict parameter, or tagged with an alias class,
+ * get a shadow of their own
+ */
+static TR::SymbolReference* get_array_shadow(
+    SimpleILInjector* injector, uint64_t aliasClass, TR::DataType type, TR::Node* baseNode, bool isStore)
+{
+    int32_t slot;
+    uint32_t attributes = injector->function_builder_->parameterAttributes(baseNode, slot);
+    if (isStore && (attributes & JIT_ParamReadOnly))
+        injector->readonly_stores_++;
+    if (attributes & JIT_ParamRestrict)
+        return injector->findOrCreateAliasClassShadowSymRef(0, slot, type);
+    if (aliasClass)
+        return injector->findOrCreateAliasClassShadowSymRef(aliasClass, -1, type);
+    return injector->symRefTab()->findOrCreateArrayShadowSymbolRef(type, baseNode);
+}
+
 JIT_NodeRef JIT_ArrayLoad(JIT_ILInjectorRef ilinjector, JIT_NodeRef basenode, JIT_NodeRef indexnode, JIT_Type dt)
 {
     auto injector = unwrap_ilinjector(ilinjector);
@@ -620,8 +926,8 @@ JIT_NodeRef JIT_ArrayLoad(JIT_ILInjectorRef ilinjector, JIT_NodeRef basenode, JI
     auto array_offset = get_array_element_address(injector, type, base, index);
     auto loadOp = TR::ILOpCode::indirectLoadOpCode(type);
 #if 1
-    TR::SymbolReference* symRef = injector->symRefTab()->findOrCreateArrayShadowSymbolRef(type, base);
-    TR::Node* load = TR::Node::createWithSymRef(loadOp, 1, array_offset, 0, symRef);
+    TR::SymbolReference* symRef = get_array_shadow(injector, 0, type, base, false);
+    TR::Node* load = TR::Node::createWithSymRefWithComp(injector->comp(), loadOp, 1, array_offset, symRef);
 #else
     TR::Symbol* sym = TR::Symbol::createShadow(injector->comp()->trHeapMemory(), type, TR::DataType::getSize(type));
     TR::SymbolReference* symRef = new (injector->comp()->trHeapMemory()) TR::SymbolReference(
@@ -642,22 +948,21 @@ JIT_NodeRef JIT_ArrayLoad(JIT_ILInjectorRef ilinjector, JIT_NodeRef basenode, JI
 
 JIT_NodeRef JIT_ArrayLoadAt(
     JIT_ILInjectorRef ilinjector, uint64_t symbolId, JIT_NodeRef basenode, int64_t idx, JIT_Type dt)
+{
+    return JIT_ArrayLoadAtInAliasClass(ilinjector, 0, basenode, idx, dt);
+}
+
+JIT_NodeRef JIT_ArrayLoadAtInAliasClass(
+    JIT_ILInjectorRef ilinjector, uint64_t alias_class, JIT_NodeRef basenode, int64_t idx, JIT_Type dt)
 {
     auto injector = unwrap_ilinjector(ilinjector);
     auto base = unwrap_node(basenode);
-    auto index = TR::Node::lconst(idx);
+    auto index = create_lconst(injector->comp(), idx);
     auto type = TR::DataType((TR::DataTypes)dt);
     auto aoffset = get_array_element_address(injector, type, base, index);
     auto loadOp = TR::ILOpCode::indirectLoadOpCode(type);
-    TR::SymbolReference* symRef = nullptr;
-#if 0
-  if (symbolId) {
-    symRef = injector->findOrCreateShadowSymRef(symbolId, type, (int32_t)idx);
-  }
-#endif
-    if (!symRef)
-        symRef = injector->symRefTab()->findOrCreateArrayShadowSymbolRef(type, base);
-    TR::Node* load = TR::Node::createWithSymRef(loadOp, 1, aoffset, 0, symRef);
+    TR::SymbolReference* symRef = get_array_shadow(injector, alias_class, type, base, false);
+    TR::Node* load = TR::Node::createWithSymRefWithComp(injector->comp(), loadOp, 1, aoffset, symRef);
     return wrap_node(load);
 }
 
@@ -672,8 +977,8 @@ void JIT_ArrayStore(JIT_ILInjectorRef ilinjector, JIT_NodeRef basenode, JIT_Node
     TR::ILOpCodes storeOp = injector->comp()->il.opCodeForIndirectArrayStore(type);
     auto array_offset = get_array_element_address(injector, type, base, index);
 #if 1
-    TR::SymbolReference* symRef = injector->symRefTab()->findOrCreateArrayShadowSymbolRef(type, base);
-    TR::Node* store = TR::Node::createWithSymRef(storeOp, 2, array_offset, value, 0, symRef);
+    TR::SymbolReference* symRef = get_array_shadow(injector, 0, type, base, true);
+    TR::Node* store = TR::Node::createWithSymRefWithComp(injector->comp(), storeOp, 2, array_offset, value, symRef);
 #else
     TR::Symbol* sym = TR::Symbol::createShadow(injector->comp()->trHeapMemory(), type, TR::DataType::getSize(type));
     TR::SymbolReference* symRef = new (injector->comp()->trHeapMemory()) TR::SymbolReference(
@@ -695,23 +1000,22 @@ void JIT_ArrayStore(JIT_ILInjectorRef ilinjector, JIT_NodeRef basenode, JIT_Node
 
 void JIT_ArrayStoreAt(
     JIT_ILInjectorRef ilinjector, uint64_t symbolId, JIT_NodeRef basenode, int64_t idx, JIT_NodeRef valuenode)
+{
+    JIT_ArrayStoreAtInAliasClass(ilinjector, 0, basenode, idx, valuenode);
+}
+
+void JIT_ArrayStoreAtInAliasClass(
+    JIT_ILInjectorRef ilinjector, uint64_t alias_class, JIT_NodeRef basenode, int64_t idx, JIT_NodeRef valuenode)
 {
     auto injector = unwrap_ilinjector(ilinjector);
     auto base = unwrap_node(basenode);
-    auto index = TR::Node::lconst(idx);
+    auto index = create_lconst(injector->comp(), idx);
     auto value = unwrap_node(valuenode);
     auto type = value->getDataType();
-    TR::SymbolReference* symRef = nullptr;
     TR::ILOpCodes storeOp = injector->comp()->il.opCodeForIndirectArrayStore(type);
     auto aoffset = get_array_element_address(injector, type, base, index);
-#if 0
-  if (symbolId) {
-    symRef = injector->findOrCreateShadowSymRef(symbolId, type, (int32_t)idx);
-  }
-#endif
-    if (!symRef)
-        symRef = injector->symRefTab()->findOrCreateArrayShadowSymbolRef(type, base);
-    TR::Node* store = TR::Node::createWithSymRef(storeOp, 2, aoffset, value, 0, symRef);
+    TR::SymbolReference* symRef = get_array_shadow(injector, alias_class, type, base, true);
+    TR::Node* store = TR::Node::createWithSymRefWithComp(injector->comp(), storeOp, 2, aoffset, value, symRef);
     injector->genTreeTop(store);
 }
 
@@ -727,7 +1031,9 @@ JIT_NodeRef JIT_LoadParameter(JIT_ILInjectorRef ilinjector, int32_t slot)
     auto symbol
         = injector->symRefTab()->findOrCreateAutoSymbol(injector->methodSymbol(), slot, type, true, false, true);
     symbol->getSymbol()->setNotCollected();
-    auto node = TR::Node::createLoad(symbol);
+    auto node = TR::Node::createLoadWithComp(injector->comp(), symbol);
+    if (function_builder->arg_attributes_[slot] & JIT_ParamNonNull)
+        node->setIsNonNull(true);
     return wrap_node(node);
 }
 
@@ -741,7 +1047,7 @@ static TR::Node* convertTo(TR::IlGenerator* injector, TR::DataType typeTo, TR::N
         (int)typeFrom, (int)typeTo);
     if (convertOp == TR::BadILOp)
         return nullptr;
-    TR::Node* result = TR::Node::create(convertOp, 1, v);
+    TR::Node* result = TR::Node::createWithComp(injector->comp(), convertOp, 1, v);
     return result;
 }
 
@@ -751,6 +1057,162 @@ JIT_NodeRef JIT_ConvertTo(JIT_ILInjectorRef ilinjector, JIT_NodeRef value, JIT_T
         unwrap_ilinjector(ilinjector), TR::DataType((TR::DataTypes)targetType), unwrap_node(value), needUnsigned));
 }
 
+void JIT_MemCopy(JIT_ILInjectorRef ilinjector, JIT_NodeRef dest, JIT_NodeRef src, JIT_NodeRef size)
+{
+    auto injector = unwrap_ilinjector(ilinjector);
+    TR::Node* copy = TR::Node::createArraycopy(unwrap_node(src), unwrap_node(dest), unwrap_node(size));
+    copy->setSymbolReference(injector->symRefTab()->findOrCreateArrayCopySymbol());
+    copy->setArrayCopyElementType(TR::Int8);
+    injector->genTreeTop(copy);
+}
+
+void JIT_MemSet(JIT_ILInjectorRef ilinjector, JIT_NodeRef dest, JIT_NodeRef value, JIT_NodeRef size)
+{
+    auto injector = unwrap_ilinjector(ilinjector);
+    TR::Node* byte = convertTo(injector, TR::Int8, unwrap_node(value));
+    TR::Node* set
+        = TR::Node::createWithComp(injector->comp(), TR::arrayset, 3, unwrap_node(dest), byte, unwrap_node(size));
+    set->setSymbolReference(injector->symRefTab()->findOrCreateArraySetSymbol());
+    injector->genTreeTop(set);
+}
+
+static int32_t intrinsic_arg_count(JIT_IntrinsicOp op)
+{
+    switch (op) {
+    case JIT_IntrinsicClz:
+    case JIT_IntrinsicCtz:
+    case JIT_IntrinsicPopcount:
+    case JIT_IntrinsicByteSwap:
+    case JIT_IntrinsicAbs:
+    case JIT_IntrinsicSqrt:
+        return 1;
+    case JIT_IntrinsicFma:
+        return 3;
+    default:
+        return 2;
+    }
+}
+
+JIT_NodeRef JIT_Intrinsic(JIT_ILInjectorRef ilinjector, JIT_IntrinsicOp op, int32_t numArgs, JIT_NodeRef* args)
+{
+    auto injector = unwrap_ilinjector(ilinjector);
+    auto comp = injector->comp();
+    if (numArgs != intrinsic_arg_count(op))
+        return nullptr;
+    TR::Node* a = unwrap_node(args[0]);
+    TR::Node* b = numArgs > 1 ? unwrap_node(args[1]) : nullptr;
+    TR::Node* c = numArgs > 2 ? unwrap_node(args[2]) : nullptr;
+    TR::DataType type = a->getDataType();
+    bool typesAgree = true;
+    if (op == JIT_IntrinsicRotateLeft || op == JIT_IntrinsicRotateRight) {
+        b = convertTo(injector, TR::Int32, b);
+        typesAgree = b != nullptr;
+    } else {
+        typesAgree = (!b || b->getDataType() == type) && (!c || c->getDataType() == type);
+    }
+    bool isInt = typesAgree && (type == TR::Int32 || type == TR::Int64);
+    bool isFloat = typesAgree && (type == TR::Float || type == TR::Double);
+    bool is64Bit = type == TR::Int64 || type == TR::Double;
+
+    TR::Node* result = nullptr;
+    if (isInt) {
+        switch (op) {
+        case JIT_IntrinsicClz:
+            result = TR::Node::createWithComp(comp, is64Bit ? TR::lnolz : TR::inolz, 1, a);
+            break;
+        case JIT_IntrinsicCtz:
+            result = TR::Node::createWithComp(comp, is64Bit ? TR::lnotz : TR::inotz, 1, a);
+            break;
+        case JIT_IntrinsicPopcount:
+            result = TR::Node::createWithComp(comp, is64Bit ? TR::lpopcnt : TR::ipopcnt, 1, a);
+            break;
+        case JIT_IntrinsicByteSwap:
+            if (!is64Bit) {
+                result = TR::Node::createWithComp(comp, TR::ibyteswap, 1, a);
+            } else {
+                // There is no lbyteswap; swap the bytes of each half and then the halves
+                TR::Node* low = TR::Node::createWithComp(
+                    comp, TR::ibyteswap, 1, TR::Node::createWithComp(comp, TR::l2i, 1, a));
+                TR::Node* high = TR::Node::createWithComp(comp, TR::ibyteswap, 1,
+                    TR::Node::createWithComp(comp, TR::l2i, 1,
+                        TR::Node::createWithComp(comp, TR::lushr, 2, a, create_iconst(comp, 32))));
+                result = TR::Node::createWithComp(comp, TR::lor, 2,
+                    TR::Node::createWithComp(
+                        comp, TR::lshl, 2, TR::Node::createWithComp(comp, TR::iu2l, 1, low), create_iconst(comp, 32)),
+                    TR::Node::createWithComp(comp, TR::iu2l, 1, high));
+            }
+            break;
+        case JIT_IntrinsicRotateLeft:
+            result = TR::Node::createWithComp(comp, is64Bit ? TR::lrol : TR::irol, 2, a, b);
+            break;
+        case JIT_IntrinsicRotateRight:
+            result = TR::Node::createWithComp(
+                comp, is64Bit ? TR::lrol : TR::irol, 2, a, TR::Node::createWithComp(comp, TR::ineg, 1, b));
+            break;
+        case JIT_IntrinsicAndNot:
+            result = TR::Node::createWithComp(comp, is64Bit ? TR::land : TR::iand, 2, a,
+                is64Bit ? TR::Node::createWithComp(comp, TR::lxor, 2, b, create_lconst(comp, -1))
+                        : TR::Node::createWithComp(comp, TR::ixor, 2, b, create_iconst(comp, -1)));
+            break;
+        case JIT_IntrinsicMin:
+            result = TR::Node::createWithComp(comp, is64Bit ? TR::lmin : TR::imin, 2, a, b);
+            break;
+        case JIT_IntrinsicMax:
+            result = TR::Node::createWithComp(comp, is64Bit ? TR::lmax : TR::imax, 2, a, b);
+            break;
+        case JIT_IntrinsicAbs:
+            result = TR::Node::createWithComp(comp, is64Bit ? TR::labs : TR::iabs, 1, a);
+            break;
+        default:
+            break;
+        }
+    } else if (isFloat) {
+        switch (op) {
+        case JIT_IntrinsicMin:
+            result = TR::Node::createWithComp(comp, is64Bit ? TR::dmin : TR::fmin, 2, a, b);
+            break;
+        case JIT_IntrinsicMax:
+            result = TR::Node::createWithComp(comp, is64Bit ? TR::dmax : TR::fmax, 2, a, b);
+            break;
+        case JIT_IntrinsicAbs:
+            result = TR::Node::createWithComp(comp, is64Bit ? TR::dabs : TR::fabs, 1, a);
+            break;
+        case JIT_IntrinsicSqrt:
+            result = TR::Node::createWithComp(comp, is64Bit ? TR::dsqrt : TR::fsqrt, 1, a);
+            break;
+        case JIT_IntrinsicFma: {
+            // The code generator fuses a multiply flagged FP strict compliant
+            // with the add that uses it, if the processor supports it and the
+            // multiply has not been commoned with another use
+            TR::Node* mul = TR::Node::createWithComp(comp, is64Bit ? TR::dmul : TR::fmul, 2, a, b);
+            mul->setIsFPStrictCompliant(true);
+            result = TR::Node::createWithComp(comp, is64Bit ? TR::dadd : TR::fadd, 2, mul, c);
+            break;
+        }
+        case JIT_IntrinsicCopySign:
+            if (is64Bit) {
+                TR::Node* magnitude = TR::Node::createWithComp(comp, TR::land, 2,
+                    TR::Node::createWithComp(comp, TR::dbits2l, 1, a), create_lconst(comp, INT64_MAX));
+                TR::Node* sign = TR::Node::createWithComp(comp, TR::land, 2,
+                    TR::Node::createWithComp(comp, TR::dbits2l, 1, b), create_lconst(comp, INT64_MIN));
+                result = TR::Node::createWithComp(
+                    comp, TR::lbits2d, 1, TR::Node::createWithComp(comp, TR::lor, 2, magnitude, sign));
+            } else {
+                TR::Node* magnitude = TR::Node::createWithComp(comp, TR::iand, 2,
+                    TR::Node::createWithComp(comp, TR::fbits2i, 1, a), create_iconst(comp, INT32_MAX));
+                TR::Node* sign = TR::Node::createWithComp(comp, TR::iand, 2,
+                    TR::Node::createWithComp(comp, TR::fbits2i, 1, b), create_iconst(comp, INT32_MIN));
+                result = TR::Node::createWithComp(
+                    comp, TR::ibits2f, 1, TR::Node::createWithComp(comp, TR::ior, 2, magnitude, sign));
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return wrap_node(result);
+}
+
 JIT_NodeRef JIT_Call(JIT_ILInjectorRef ilinjector, const char* functionName, int32_t numArgs, JIT_NodeRef* args)
 {
     auto injector = unwrap_ilinjector(ilinjector);
@@ -759,10 +1221,14 @@ JIT_NodeRef JIT_Call(JIT_ILInjectorRef ilinjector, const char* functionName, int
     TR_ASSERT(resolvedMethod, "Could not identify function %s\n", functionName);
     if (resolvedMethod == nullptr)
         return nullptr;
-    TR::SymbolReference* methodSymRef
-        = injector->symRefTab()->findOrCreateComputedStaticMethodSymbol(JITTED_METHOD_INDEX, -1, resolvedMethod);
-    TR::DataType returnType = methodSymRef->getSymbol()->castToMethodSymbol()->getMethod()->returnType();
-    TR::Node* callNode = TR::Node::createWithSymRef(TR::ILOpCode::getDirectCall(returnType), numArgs, methodSymRef);
+    TR::SymbolReference* methodSymRef = injector->findOrCreateFunctionSymRef(resolvedMethod);
+    TR::MethodSymbol* methodSymbol = methodSymRef->getSymbol()->castToMethodSymbol();
+    uint32_t attributes = function_builder->context_->getFunctionAttributes(functionName);
+    methodSymbol->setIsPureFunction((attributes & JIT_FunctionConst) != 0);
+    methodSymbol->setIsReadOnlyFunction((attributes & JIT_FunctionPure) != 0);
+    TR::DataType returnType = methodSymbol->getMethod()->returnType();
+    TR::Node* callNode = TR::Node::createWithSymRefWithComp(
+        injector->comp(), TR::ILOpCode::getDirectCall(returnType), numArgs, methodSymRef);
     // TODO: should really verify argument types here
     int32_t childIndex = 0;
     TR::DataType targetType = TR::Int32;
@@ -786,8 +1252,7 @@ JIT_SymbolRef JIT_GetFunctionSymbol(JIT_ILInjectorRef ilinjector, const char* na
     auto injector = unwrap_ilinjector(ilinjector);
     auto resolvedMethod = injector->function_builder_->context_->getFunction(name);
     if (resolvedMethod) {
-        auto symref
-            = injector->symRefTab()->findOrCreateComputedStaticMethodSymbol(JITTED_METHOD_INDEX, -1, resolvedMethod);
+        auto symref = injector->findOrCreateFunctionSymRef(resolvedMethod);
         return wrap_symbolref(symref);
     }
     return nullptr;
@@ -818,11 +1283,20 @@ JIT_NodeRef JIT_IndirectCall(
         function_builder->context_->function_id_++); // FIXME increment must be atomic
     function_builder->context_->registerFunction(function_name, returnType, argtypes, nullptr);
 
+    /* Instrumented code records the targets of each call site */
+    if (injector->instrument_) {
+        JIT_NodeRef helperArgs[2]
+            = { JIT_ConstAddress(injector->profile_->getCallTargetHistogram(injector->indirect_calls_, true)),
+                  funcptr };
+        JIT_Call(ilinjector, PROFILE_CALL_TARGET_HELPER, 2, helperArgs);
+    }
+    injector->indirect_calls_++;
+
     TR::ResolvedMethod* resolvedMethod = function_builder->context_->getFunction(function_name);
     TR::SymbolReference* methodSymRef
         = injector->symRefTab()->findOrCreateComputedStaticMethodSymbol(JITTED_METHOD_INDEX, -1, resolvedMethod);
-    TR::Node* callNode
-        = TR::Node::createWithSymRef(TR::ILOpCode::getIndirectCall(returnType), numArgs + 1, methodSymRef);
+    TR::Node* callNode = TR::Node::createWithSymRefWithComp(
+        injector->comp(), TR::ILOpCode::getIndirectCall(returnType), numArgs + 1, methodSymRef);
     int32_t childIndex = 0;
     callNode->setAndIncChild(childIndex++, function_pointer);
     for (int32_t a = 0; a < numArgs; a++) {
@@ -842,18 +1316,41 @@ JIT_NodeRef JIT_Goto(JIT_ILInjectorRef ilinjector, JIT_BlockRef block)
 {
     auto injector = unwrap_ilinjector(ilinjector);
     auto target_block = unwrap_block(block);
-    TR::Node* gotoNode = TR::Node::create(NULL, TR::Goto);
+    TR::Node* gotoNode = TR::Node::createWithComp(injector->comp(), TR::Goto);
     gotoNode->setBranchDestination(target_block->getEntry());
     injector->genTreeTop(gotoNode);
     injector->cfg()->addEdge(injector->getCurrentBlock(), target_block);
     return wrap_node(gotoNode);
 }
 
+static JIT_NodeRef return_tail_call(JIT_ILInjectorRef ilinjector, JIT_NodeRef call)
+{
+    if (call == nullptr)
+        return nullptr;
+    auto callNode = unwrap_node(call);
+    callNode->setIsTailCall(true);
+    if (callNode->getDataType() == TR::NoType)
+        return JIT_ReturnNoValue(ilinjector);
+    return JIT_ReturnValue(ilinjector, call);
+}
+
+JIT_NodeRef JIT_TailCall(JIT_ILInjectorRef ilinjector, const char* functionName, int32_t numArgs, JIT_NodeRef* args)
+{
+    return return_tail_call(ilinjector, JIT_Call(ilinjector, functionName, numArgs, args));
+}
+
+JIT_NodeRef JIT_IndirectTailCall(
+    JIT_ILInjectorRef ilinjector, JIT_NodeRef funcptr, JIT_Type return_type, int32_t numArgs, JIT_NodeRef* args)
+{
+    return return_tail_call(ilinjector, JIT_IndirectCall(ilinjector, funcptr, return_type, numArgs, args));
+}
+
 JIT_NodeRef JIT_ReturnValue(JIT_ILInjectorRef ilinjector, JIT_NodeRef value)
 {
     auto injector = unwrap_ilinjector(ilinjector);
     auto valueNode = unwrap_node(value);
-    TR::Node* returnNode = TR::Node::create(TR::ILOpCode::returnOpCode(valueNode->getDataType()), 1, valueNode);
+    TR::Node* returnNode = TR::Node::createWithComp(
+        injector->comp(), TR::ILOpCode::returnOpCode(valueNode->getDataType()), 1, valueNode);
     injector->genTreeTop(returnNode);
     injector->cfg()->addEdge(injector->getCurrentBlock(), injector->cfg()->getEnd());
     return wrap_node(returnNode);
@@ -862,7 +1359,7 @@ JIT_NodeRef JIT_ReturnValue(JIT_ILInjectorRef ilinjector, JIT_NodeRef value)
 JIT_NodeRef JIT_ReturnNoValue(JIT_ILInjectorRef ilinjector)
 {
     auto injector = unwrap_ilinjector(ilinjector);
-    TR::Node* returnNode = TR::Node::create(TR::ILOpCode::returnOpCode(TR::NoType));
+    TR::Node* returnNode = TR::Node::createWithComp(injector->comp(), TR::ILOpCode::returnOpCode(TR::NoType));
     injector->genTreeTop(returnNode);
     injector->cfg()->addEdge(injector->getCurrentBlock(), injector->cfg()->getEnd());
     return wrap_node(returnNode);
@@ -871,6 +1368,7 @@ JIT_NodeRef JIT_ReturnNoValue(JIT_ILInjectorRef ilinjector)
 JIT_NodeRef JIT_ZeroValue(JIT_ILInjectorRef ilinjector, JIT_Type type)
 {
     auto injector = unwrap_ilinjector(ilinjector);
+    auto comp = injector->comp();
     TR::DataTypes t = (TR::DataTypes)type;
     TR::Node* n = NULL;
     switch (t) {
@@ -881,17 +1379,17 @@ JIT_NodeRef JIT_ZeroValue(JIT_ILInjectorRef ilinjector, JIT_Type type)
         n = TR::Node::sconst(0);
         break;
     case TR::DataTypes::Int32:
-        n = TR::Node::iconst(0);
+        n = create_iconst(comp, 0);
         break;
     case TR::DataTypes::Int64:
-        n = TR::Node::lconst(0);
+        n = create_lconst(comp, 0);
         break;
     case TR::DataTypes::Float:
-        n = TR::Node::create(0, TR::fconst, 0);
+        n = TR::Node::createWithComp(comp, TR::fconst, 0);
         n->setFloat(0.0);
         break;
     case TR::DataTypes::Double:
-        n = TR::Node::create(0, TR::dconst, 0);
+        n = TR::Node::createWithComp(comp, TR::dconst, 0);
         n->setDouble(0.0);
         break;
     case TR::DataTypes::Address:
@@ -944,31 +1442,238 @@ JIT_NodeRef JIT_IfZeroValue(JIT_ILInjectorRef ilinjector, JIT_NodeRef value, JIT
     return wrap_node(ifNode);
 }
 
+/*
+ * Compute a op b, where op is iadd, isub or imul (or their 64-bit versions
+ * for Int64 operands), and branch to blockOnOverflow if it overflows. The
+ * result is stored in a temporary as it is used in the next block.
+ */
+static JIT_NodeRef overflow_checked_op(
+    JIT_ILInjectorRef ilinjector, TR::ILOpCodes op, JIT_NodeRef a, JIT_NodeRef b, JIT_BlockRef blockOnOverflow)
+{
+    auto injector = unwrap_ilinjector(ilinjector);
+    auto comp = injector->comp();
+    auto left = unwrap_node(a);
+    auto right = unwrap_node(b);
+    auto targetBlock = unwrap_block(blockOnOverflow);
+    TR::DataType type = left->getDataType();
+    if (right->getDataType() != type || (type != TR::Int32 && type != TR::Int64))
+        return NULL;
+    bool is64Bit = type == TR::Int64;
+
+    TR::Node* result = NULL;
+    TR::Node* ifNode = NULL;
+    switch (op) {
+    case TR::iadd:
+        result = TR::Node::createWithComp(comp, is64Bit ? TR::ladd : TR::iadd, 2, left, right);
+        ifNode = TR::Node::createif(is64Bit ? TR::iflcmno : TR::ificmno, left, right, targetBlock->getEntry());
+        break;
+    case TR::isub:
+        result = TR::Node::createWithComp(comp, is64Bit ? TR::lsub : TR::isub, 2, left, right);
+        ifNode = TR::Node::createif(is64Bit ? TR::iflcmpo : TR::ificmpo, left, right, targetBlock->getEntry());
+        break;
+    default: {
+        /* The product overflows if its high half is not the sign extension of the low half */
+        result = TR::Node::createWithComp(comp, is64Bit ? TR::lmul : TR::imul, 2, left, right);
+        TR::Node* high = TR::Node::createWithComp(comp, is64Bit ? TR::lmulh : TR::imulh, 2, left, right);
+        TR::Node* sign = TR::Node::createWithComp(
+            comp, is64Bit ? TR::lshr : TR::ishr, 2, result, create_iconst(comp, is64Bit ? 63 : 31));
+        ifNode = TR::Node::createif(is64Bit ? TR::iflcmpne : TR::ificmpne, high, sign, targetBlock->getEntry());
+        break;
+    }
+    }
+
+    auto temp = injector->symRefTab()->createTemporary(injector->methodSymbol(), type);
+    injector->storeToTemp(temp, result);
+    injector->genTreeTop(ifNode);
+    injector->cfg()->addEdge(injector->getCurrentBlock(), targetBlock);
+    return wrap_node(injector->loadTemp(temp));
+}
+
+JIT_NodeRef JIT_AddOverflow(JIT_ILInjectorRef ilinjector, JIT_NodeRef a, JIT_NodeRef b, JIT_BlockRef blockOnOverflow)
+{
+    return overflow_checked_op(ilinjector, TR::iadd, a, b, blockOnOverflow);
+}
+
+JIT_NodeRef JIT_SubOverflow(JIT_ILInjectorRef ilinjector, JIT_NodeRef a, JIT_NodeRef b, JIT_BlockRef blockOnOverflow)
+{
+    return overflow_checked_op(ilinjector, TR::isub, a, b, blockOnOverflow);
+}
+
+JIT_NodeRef JIT_MulOverflow(JIT_ILInjectorRef ilinjector, JIT_NodeRef a, JIT_NodeRef b, JIT_BlockRef blockOnOverflow)
+{
+    return overflow_checked_op(ilinjector, TR::imul, a, b, blockOnOverflow);
+}
+
+/*
+ * Returns a node computing the same value as the given one in another
+ * block entered only from the current one. A constant or a load of a local
+ * that has not been evaluated yet is just recreated there, as its value is
+ * the same anywhere up to the end of the current block; anything else is
+ * stored in a temporary here.
+ */
+static TR::Node* value_for_side_exit(SimpleILInjector* injector, TR::Node* value)
+{
+    if (value->getReferenceCount() == 0 && value->getNumChildren() == 0
+        && (value->getOpCode().isLoadConst()
+            || (value->getOpCode().isLoadVarDirect() && value->getSymbol()->isAutoOrParm())))
+        return value->duplicateTree();
+    auto temp = injector->symRefTab()->createTemporary(injector->methodSymbol(), value->getDataType());
+    if (value->getDataType() == TR::Address)
+        temp->getSymbol()->setNotCollected();
+    injector->storeToTemp(temp, value);
+    return injector->loadTemp(temp);
+}
+
+JIT_NodeRef JIT_Guard(
+    JIT_ILInjectorRef ilinjector, JIT_NodeRef condition, int32_t deopt_id, int32_t num_values, JIT_NodeRef* values)
+{
+    auto injector = unwrap_ilinjector(ilinjector);
+    auto function_builder = injector->function_builder_;
+    auto context = function_builder->context_;
+    auto cond = unwrap_node(condition);
+    TR::ResolvedMethod* handler = context->getFunction(function_builder->deopt_handler_.c_str());
+    TR_ASSERT(handler, "Guard needs a deoptimization handler\n");
+    if (!handler || num_values < 0)
+        return NULL;
+    TR::DataType condType = cond->getDataType();
+    if (condType != TR::Int32 && condType != TR::Int64 && condType != TR::Address && condType != TR::Int8
+        && condType != TR::Int16)
+        return NULL;
+
+    /* The values are computed on the fast path, and saved out of line */
+    std::vector<TR::Node*> saved(num_values);
+    for (int32_t i = 0; i < num_values; i++)
+        saved[i] = value_for_side_exit(injector, unwrap_node(values[i]));
+
+    TR::Block* guardBlock = injector->getCurrentBlock();
+    TR::Block* deoptBlock = injector->appendBlock();
+    deoptBlock->setIsCold();
+    deoptBlock->setFrequency(UNKNOWN_COLD_BLOCK_COUNT);
+    JIT_NodeRef ifNode = JIT_IfZeroValue(ilinjector, condition, wrap_block(deoptBlock));
+
+    /* Fill in the JIT_DeoptRecord and return what the handler returns */
+    injector->_currentBlock = deoptBlock;
+    auto record = JIT_CreateLocalByteArray(
+        ilinjector, offsetof(JIT_DeoptRecord, values) + std::max(num_values, 1) * sizeof(JIT_DeoptValue));
+    JIT_ArrayStoreAt(ilinjector, 0, JIT_LoadAddress(ilinjector, record), offsetof(JIT_DeoptRecord, deopt_id),
+        JIT_ConstInt32(deopt_id));
+    JIT_ArrayStoreAt(ilinjector, 0, JIT_LoadAddress(ilinjector, record), offsetof(JIT_DeoptRecord, num_values),
+        JIT_ConstInt32(num_values));
+    for (int32_t i = 0; i < num_values; i++)
+        JIT_ArrayStoreAt(ilinjector, 0, JIT_LoadAddress(ilinjector, record),
+            offsetof(JIT_DeoptRecord, values) + i * sizeof(JIT_DeoptValue), wrap_node(saved[i]));
+    JIT_NodeRef recordAddress = JIT_LoadAddress(ilinjector, record);
+    JIT_NodeRef result = JIT_Call(ilinjector, function_builder->deopt_handler_.c_str(), 1, &recordAddress);
+    TR_ASSERT(unwrap_node(result)->getDataType() == TR::DataType(function_builder->return_type_),
+        "Deoptimization handler must return the type of the function\n");
+    if (unwrap_node(result)->getDataType() == TR::NoType)
+        JIT_ReturnNoValue(ilinjector);
+    else
+        JIT_ReturnValue(ilinjector, result);
+    injector->_currentBlock = guardBlock;
+    return ifNode;
+}
+
+JIT_NodeRef JIT_CreatePatchableGuard(JIT_ILInjectorRef ilinjector, uint64_t assumption_id, JIT_BlockRef slowBlock)
+{
+    auto injector = unwrap_ilinjector(ilinjector);
+    auto context = injector->function_builder_->context_;
+    auto targetBlock = unwrap_block(slowBlock);
+    int32_t* guardWord;
+    {
+        std::lock_guard<std::mutex> g(s_jitlock);
+        guardWord = &context->assumptions_[assumption_id];
+    }
+
+    /* The code generator turns a test of a volatile guard word, whose load
+     * must not be commoned or moved, into a NOP that
+     * JIT_InvalidateAssumption() patches */
+    TR::SymbolReference* symRef = injector->symRefTab()->createKnownStaticDataSymbolRef(guardWord, TR::Int32);
+    symRef->setSideEffectInfo();
+    symRef->getSymbol()->setVolatile();
+    TR::Node* ifNode = TR::Node::createif(TR::ificmpne, TR::Node::createWithSymRef(TR::iload, 0, symRef),
+        TR::Node::iconst(0), targetBlock->getEntry());
+    targetBlock->setIsCold();
+    targetBlock->setFrequency(UNKNOWN_COLD_BLOCK_COUNT);
+    injector->genTreeTop(ifNode);
+    injector->cfg()->addEdge(injector->getCurrentBlock(), targetBlock);
+    return wrap_node(ifNode);
+}
+
+int JIT_InvalidateAssumption(JIT_ContextRef ctx, uint64_t assumption_id)
+{
+    Context* context = unwrap_context(ctx);
+    int32_t* guardWord;
+    {
+        std::lock_guard<std::mutex> g(s_jitlock);
+        guardWord = &context->assumptions_[assumption_id];
+    }
+    return NJCompiler::RuntimeAssumptionTable::instance()->invalidate(guardWord);
+}
+
+/* A switch needs at least this many cases before a jump table pays off */
+static const int MIN_CASES_FOR_TABLE = 4;
+
+/* A jump table may have at most this many entries per case */
+static const int MAX_TABLE_ENTRIES_PER_CASE = 2;
+
 JIT_NodeRef JIT_Switch(JIT_ILInjectorRef ilinjector, JIT_NodeRef expr, JIT_BlockRef default_branch, int num_cases,
     JIT_BlockRef* case_branches, int32_t* case_values)
 {
 
     auto injector = unwrap_ilinjector(ilinjector);
+    auto comp = injector->comp();
     auto exprNode = unwrap_node(expr);
     auto defaultBlock = unwrap_block(default_branch);
 
     auto switchBlock = injector->getCurrentBlock();
 
-    TR::Node* defaultNode = TR::Node::createCase(0, defaultBlock->getEntry());
-    TR::Node* lookupNode = TR::Node::create(TR::lookup, num_cases + 2, exprNode, defaultNode);
-    injector->genTreeTop(lookupNode);
-    for (int i = 0; i < num_cases; i++) {
-        JIT_BlockRef block = case_branches[i];
-        int32_t value = case_values[i];
-
-        TR::Block* caseBlock = unwrap_block(block);
-        injector->cfg()->addEdge(switchBlock, caseBlock);
+    /* Both lookup and table need the cases sorted by value */
+    std::vector<std::pair<int32_t, TR::Block*> > cases;
+    for (int i = 0; i < num_cases; i++)
+        cases.push_back(std::make_pair(case_values[i], unwrap_block(case_branches[i])));
+    std::stable_sort(cases.begin(), cases.end(),
+        [](const std::pair<int32_t, TR::Block*>& a, const std::pair<int32_t, TR::Block*>& b) { return a.first < b.first; });
+
+    /* Cases that cover most of the range between the smallest and the largest
+     * value become a jump table indexed by the value less the smallest one.
+     * The code generator sends values outside the table to the default.
+     * Sparser switches stay lookups, which the switch analyzer splits
+     * into tables for their dense clusters and compares for the rest.
+     */
+    TR::Node* switchNode;
+    int64_t range = cases.empty() ? 0 : (int64_t)cases.back().first - cases.front().first + 1;
+    if (exprNode->getDataType() == TR::Int32 && num_cases >= MIN_CASES_FOR_TABLE
+        && range <= (int64_t)num_cases * MAX_TABLE_ENTRIES_PER_CASE) {
+        int32_t low = cases.front().first;
+        TR::Node* selector
+            = low == 0 ? exprNode : TR::Node::createWithComp(comp, TR::isub, 2, exprNode, create_iconst(comp, low));
+        switchNode = TR::Node::createWithComp(
+            comp, TR::table, range + 2, selector, TR::Node::createCase(0, defaultBlock->getEntry()));
+        auto it = cases.begin();
+        for (int32_t index = 0; index < range; index++) {
+            while (it != cases.end() && it->first < low + index)
+                it++; /* duplicate value, the first case wins */
+            TR::Block* caseBlock = it->first == low + index ? it->second : defaultBlock;
+            switchNode->setAndIncChild(index + 2, TR::Node::createCase(0, caseBlock->getEntry(), index));
+        }
+    } else {
+        switchNode = TR::Node::createWithComp(
+            comp, TR::lookup, num_cases + 2, exprNode, TR::Node::createCase(0, defaultBlock->getEntry()));
+        for (int i = 0; i < num_cases; i++) {
+            TR::Node* caseNode = TR::Node::createCase(0, cases[i].second->getEntry(), cases[i].first);
+            switchNode->setAndIncChild(i + 2, caseNode);
+        }
+    }
+    injector->genTreeTop(switchNode);
 
-        TR::Node* caseNode = TR::Node::createCase(0, caseBlock->getEntry(), value);
-        lookupNode->setAndIncChild(i + 2, caseNode);
+    for (int i = 0; i < num_cases; i++) {
+        if (!switchBlock->hasSuccessor(cases[i].second))
+            injector->cfg()->addEdge(switchBlock, cases[i].second);
     }
-    injector->cfg()->addEdge(switchBlock, defaultBlock);
-    return wrap_node(lookupNode);
+    if (!switchBlock->hasSuccessor(defaultBlock))
+        injector->cfg()->addEdge(switchBlock, defaultBlock);
+    return wrap_node(switchNode);
 }
 
 JIT_Type JIT_GetSymbolType(JIT_SymbolRef sym)
@@ -119,6 +119,35 @@ typedef struct JIT_FunctionBuilder* JIT_FunctionBuilderRef;
 extern JIT_FunctionBuilderRef JIT_CreateFunctionBuilder(JIT_ContextRef context, const char* name, JIT_Type return_type,
     int param_count, const JIT_Type* parameters, JIT_ILBuilder ilbuilder, void* userdata);
 
+/**
+ * Attributes of a function parameter, see JIT_SetParameterAttributes().
+ */
+enum JIT_ParameterAttribute {
+    JIT_ParamRestrict = 1, /* memory accessed through the pointer is not accessed through any other pointer */
+    JIT_ParamNonNull = 2, /* the pointer is never NULL */
+    JIT_ParamReadOnly = 4, /* the function never writes through the pointer; only checked */
+};
+typedef enum JIT_ParameterAttribute JIT_ParameterAttribute;
+
+/**
+ * Sets the attributes of the given parameter, slots start at 0. The
+ * attributes are a mask of JIT_ParameterAttribute values and, like the C
+ * qualifiers they mirror, are promises made by the caller; the generated
+ * code is undefined if they do not hold. Loads and stores via
+ * JIT_ArrayLoad() and friends whose base is the parameter itself, as
+ * returned by JIT_LoadParameter(), benefit from restrict, and null tests of
+ * the parameter fold away if it is nonnull. Read only is only checked, not
+ * used by the optimizer: JIT_Compile() fails if the function stores via
+ * JIT_ArrayStore() and friends through the parameter itself, but stores
+ * through copies of the pointer or derived pointers go unnoticed. The
+ * alignment in bytes of the memory the pointer refers to may be given, or 0
+ * if unknown; it is ignored at present as unaligned vector moves are as fast
+ * as aligned ones on the supported targets. Must be called before
+ * JIT_Compile().
+ */
+extern void JIT_SetParameterAttributes(
+    JIT_FunctionBuilderRef fb, int32_t slot, uint32_t attributes, int32_t alignment);
+
 /**
  * Register an external function (not managed by JIT). Note that
  * any exsiting function regsitered by the same name will be
@@ -127,6 +156,26 @@ extern JIT_FunctionBuilderRef JIT_CreateFunctionBuilder(JIT_ContextRef context,
 extern void JIT_RegisterFunction(JIT_ContextRef context, const char* name, enum JIT_Type return_type, int param_count,
     const JIT_Type* parameters, void* functionptr);
 
+/**
+ * Attributes of a function, see JIT_SetFunctionAttributes().
+ */
+enum JIT_FunctionAttribute {
+    JIT_FunctionConst = 1, /* result depends only on the arguments; reads and writes no memory */
+    JIT_FunctionPure = 2, /* may read memory but writes none */
+};
+typedef enum JIT_FunctionAttribute JIT_FunctionAttribute;
+
+/**
+ * Sets the attributes of a registered function, a mask of
+ * JIT_FunctionAttribute values with the meaning of the GCC attributes of
+ * the same names. Calls to a const function with the same arguments may be
+ * commoned and hoisted out of loops, and calls to a const or pure function
+ * do not invalidate values loaded from memory. The attributes apply to
+ * calls generated afterwards and are reset if the function is registered
+ * again.
+ */
+extern void JIT_SetFunctionAttributes(JIT_ContextRef context, const char* name, uint32_t attributes);
+
 /**
  * Get a registered function by name. This will return
  * NULL if no function exists by that name.
@@ -140,6 +189,55 @@ void* JIT_GetFunction(JIT_ContextRef ctx, const char* name);
  */
 extern void JIT_DestroyFunctionBuilder(JIT_FunctionBuilderRef);
 
+/**
+ * Describes a compiled function; see JIT_LookupFunctionByPC().
+ */
+typedef struct JIT_FunctionInfo {
+    const char* name; /* name given to JIT_CreateFunctionBuilder() */
+    void* start_pc;   /* first byte of the function's code */
+    void* end_pc;     /* one past the last byte of the function's code */
+} JIT_FunctionInfo;
+
+/**
+ * Finds the compiled function whose code contains the given address,
+ * for instance a return address found by a profiler or an unwinder.
+ * Returns true and fills in info if the address is in JIT compiled code,
+ * false otherwise. The name remains valid until the last context is
+ * destroyed, even if the function is later moved or released by
+ * JIT_CompactCodeCache().
+ *
+ * The lookup takes no locks and does not allocate memory, so it may be
+ * called from a signal handler and concurrently with compilations.
+ */
+extern bool JIT_LookupFunctionByPC(void* pc, JIT_FunctionInfo* info);
+
+/**
+ * Enables code cache compaction; see JIT_CompactCodeCache(). Functions
+ * compiled from now on record what is needed to move them, which costs some
+ * compile time and memory. Functions compiled earlier are left where they
+ * are. No compilation may be in progress during this call. The setting is
+ * shared by all contexts as they share the code caches.
+ */
+extern void JIT_EnableCodeCacheCompaction(JIT_ContextRef ctx);
+
+/**
+ * Compacts the code caches. Of the functions compiled since compaction was
+ * enabled, those still registered in a context, or called directly by such
+ * functions, are kept; the rest are released. Functions whose code does not
+ * depend on its address are then moved down into the space freed below them
+ * in their code cache, and the calls to them and the registered entry
+ * points are updated. The code never leaves the code caches.
+ *
+ * Must be called at a safepoint: no compiled code may be running and no
+ * compilation may be in progress. Function pointers obtained earlier must
+ * be refreshed using JIT_GetFunction() afterwards.
+ *
+ * Returns the number of functions moved or released, or -1 if compaction
+ * has not been enabled or some compiled code could not be recorded, in
+ * which case nothing is changed.
+ */
+extern int JIT_CompactCodeCache(JIT_ContextRef ctx);
+
 /*
 IMPORTANT Notes:
 
@@ -180,6 +278,36 @@ typedef struct JIT_Symbol* JIT_SymbolRef;
  */
 extern void* JIT_Compile(JIT_FunctionBuilderRef fb, int opt_level);
 
+/**
+ * Makes warm (opt_level 1) compiles of the function gather a profile of it:
+ * how often each block runs, how often each conditional branch is taken,
+ * where each switch goes and which functions each indirect call calls.
+ * Hot (opt_level 2) compiles of a function of the same name in the same
+ * context, by this builder or another, then lay out its blocks, branches
+ * and switches for the paths the profile found hot. The IL builder must
+ * generate the same blocks and branches each time for the profile to apply.
+ * Must be called before JIT_Compile().
+ */
+extern void JIT_EnableProfiling(JIT_FunctionBuilderRef fb);
+
+/**
+ * Returns the number of times the first block of the named function has
+ * run in profiling code, which may be used to decide when to compile it
+ * hot, or 0 if it has no profile.
+ */
+extern uint64_t JIT_GetProfiledEntryCount(JIT_ContextRef ctx, const char* name);
+
+/**
+ * Returns the value of the named static debug counter, summed over all
+ * compilations so far, or 0 if it has not been counted. Optimizations
+ * count compile time events in these counters, for instance
+ * "loopVectorizer/vectorized" for each loop vectorized. Counters are only
+ * kept for names matching the JIT option staticDebugCounters={regex},
+ * which may be given in the TR_Options environment variable. Meant for
+ * tests and tuning.
+ */
+extern int64_t JIT_GetStaticDebugCounter(JIT_ContextRef ctx, const char* name);
+
 /**
  * Allocates given number of blocks, and leaves the current block pointer
  * at 0. The CFG starting edge is made to point to Node 0.
@@ -1254,6 +1382,15 @@ extern JIT_NodeRef JIT_ArrayLoad(
     JIT_ILInjectorRef ilinjector, JIT_NodeRef address, JIT_NodeRef byte_offset, JIT_Type value_type);
 extern JIT_NodeRef JIT_ArrayLoadAt(
     JIT_ILInjectorRef ilinjector, uint64_t symbolId, JIT_NodeRef basenode, int64_t idx, JIT_Type dt);
+/**
+ * Load a value from a constant byte offset within array, tagged with an
+ * alias class in the spirit of C's type based aliasing rules: accesses
+ * tagged with different non-zero alias classes are assumed never to overlap,
+ * whereas an access with alias class 0 may overlap any access of the same
+ * value type, as do the accesses of JIT_ArrayLoad() and JIT_ArrayLoadAt().
+ */
+extern JIT_NodeRef JIT_ArrayLoadAtInAliasClass(
+    JIT_ILInjectorRef ilinjector, uint64_t alias_class, JIT_NodeRef basenode, int64_t idx, JIT_Type dt);
 
 /**
  * Store a value at specific array offset; note offset must be exact byte
@@ -1263,6 +1400,63 @@ extern void JIT_ArrayStore(
     JIT_ILInjectorRef ilinjector, JIT_NodeRef address, JIT_NodeRef byte_offset, JIT_NodeRef valuenode);
 extern void JIT_ArrayStoreAt(
     JIT_ILInjectorRef ilinjector, uint64_t symbolId, JIT_NodeRef basenode, int64_t idx, JIT_NodeRef valuenode);
+/**
+ * Store a value at a constant byte offset within array, tagged with an alias
+ * class as described for JIT_ArrayLoadAtInAliasClass()
+ */
+extern void JIT_ArrayStoreAtInAliasClass(
+    JIT_ILInjectorRef ilinjector, uint64_t alias_class, JIT_NodeRef basenode, int64_t idx, JIT_NodeRef valuenode);
+
+/**
+ * Copy size bytes from the src address to the dest address, like C's
+ * memmove() the two regions may overlap. Constant sizes up to a few hundred
+ * bytes are copied with unrolled SSE moves, larger ones with string
+ * instructions.
+ */
+extern void JIT_MemCopy(JIT_ILInjectorRef ilinjector, JIT_NodeRef dest, JIT_NodeRef src, JIT_NodeRef size);
+/**
+ * Set size bytes at the dest address to value, like C's memset(); value is
+ * converted to a byte.
+ */
+extern void JIT_MemSet(JIT_ILInjectorRef ilinjector, JIT_NodeRef dest, JIT_NodeRef value, JIT_NodeRef size);
+
+/**
+ * Operations of JIT_Intrinsic(), with the number and types of their arguments.
+ */
+enum JIT_IntrinsicOp {
+    JIT_IntrinsicClz = 1, /* (x) leading zero bits of Int32 or Int64 x, as Int32; the width of x if x is 0 */
+    JIT_IntrinsicCtz, /* (x) trailing zero bits of Int32 or Int64 x, as Int32; the width of x if x is 0 */
+    JIT_IntrinsicPopcount, /* (x) set bits of Int32 or Int64 x, as Int32 */
+    JIT_IntrinsicByteSwap, /* (x) x of type Int32 or Int64 with its bytes reversed */
+    JIT_IntrinsicRotateLeft, /* (x, n) Int32 or Int64 x rotated left by n modulo its width */
+    JIT_IntrinsicRotateRight, /* (x, n) Int32 or Int64 x rotated right by n modulo its width */
+    JIT_IntrinsicAndNot, /* (a, b) a & ~b */
+    JIT_IntrinsicMin, /* (a, b) signed or floating point minimum, with the NaN rules of C's fmin() */
+    JIT_IntrinsicMax, /* (a, b) signed or floating point maximum, with the NaN rules of C's fmax() */
+    JIT_IntrinsicAbs, /* (x) absolute value */
+    JIT_IntrinsicSqrt, /* (x) square root of Float or Double x */
+    JIT_IntrinsicFma, /* (a, b, c) a * b + c for Float or Double */
+    JIT_IntrinsicCopySign, /* (a, b) Float or Double a with the sign of b */
+};
+typedef enum JIT_IntrinsicOp JIT_IntrinsicOp;
+
+/**
+ * Compute a bit manipulation or math intrinsic of the given arguments,
+ * which must all have the same type (but for the rotate count, which is
+ * converted to Int32). Returns NULL if the number or types of arguments
+ * are not valid for the operation.
+ *
+ * On x86 the operations map to LZCNT, TZCNT, POPCNT, BSWAP, RORX, ANDN,
+ * MINSD/MAXSD, SQRTSD and VFMADD231SD where the processor has them, and
+ * to equivalent sequences of older instructions where it does not. Fma
+ * is a multiply followed by an add that the code generator may fuse, not
+ * a fused operation of its own: it is fused only if the processor
+ * supports FMA and the product is not also used elsewhere, which happens
+ * when the optimizer commons it with the same a * b computed nearby.
+ * Otherwise the product is rounded before the addition, so the result may
+ * differ from C's fma() in the last bit.
+ */
+extern JIT_NodeRef JIT_Intrinsic(JIT_ILInjectorRef ilinjector, JIT_IntrinsicOp op, int32_t numArgs, JIT_NodeRef* args);
 
 /**
  * Load the specified parameter, slots start at 0.
@@ -1292,6 +1486,21 @@ extern JIT_NodeRef JIT_Call(JIT_ILInjectorRef ilinjector, const char* functionNa
 extern JIT_NodeRef JIT_IndirectCall(
     JIT_ILInjectorRef ilinjector, JIT_NodeRef funcptr, JIT_Type return_type, int32_t numArgs, JIT_NodeRef* args);
 
+/**
+ * Call a function in tail position and return its result; the return
+ * instruction is generated as by JIT_ReturnValue or JIT_ReturnNoValue, and
+ * the caller must update current block as after a return.
+ *
+ * If all the arguments are passed in registers the callee reuses the frame
+ * of the caller, and is entered with a jump, so that a chain of tail calls
+ * does not grow the stack. Otherwise a normal call is made. The callee must
+ * not be passed the address of a local of the caller.
+ */
+extern JIT_NodeRef JIT_TailCall(
+    JIT_ILInjectorRef ilinjector, const char* functionName, int32_t numArgs, JIT_NodeRef* args);
+extern JIT_NodeRef JIT_IndirectTailCall(
+    JIT_ILInjectorRef ilinjector, JIT_NodeRef funcptr, JIT_Type return_type, int32_t numArgs, JIT_NodeRef* args);
+
 /**
  * Generate unconditional jump to given block; CFG will be updated to add an
  * edge from current block to target block; the jump instruction will be
@@ -1345,9 +1554,126 @@ extern JIT_NodeRef JIT_IfNotZeroValue(JIT_ILInjectorRef ilinjector, JIT_NodeRef
  */
 extern JIT_NodeRef JIT_IfZeroValue(JIT_ILInjectorRef ilinjector, JIT_NodeRef value, JIT_BlockRef blockOnZero);
 
+/**
+ * Compute a + b, a - b or a * b, and jump to blockOnOverflow if the
+ * signed result overflows. a and b must both be Int32 or both be Int64.
+ * CFG will be updated to add edge from current block to blockOnOverflow.
+ *
+ * Returns the result, which may only be used in the new block that the
+ * caller must start next, as for JIT_IfNotZeroValue() above. Returns NULL
+ * if the operand types are not valid.
+ *
+ * On x86 the branch is a JO on the flags of the ADD, SUB or IMUL that
+ * computes the result. Checks that cannot fail given what is known about
+ * the operands are removed by the optimizer.
+ */
+extern JIT_NodeRef JIT_AddOverflow(
+    JIT_ILInjectorRef ilinjector, JIT_NodeRef a, JIT_NodeRef b, JIT_BlockRef blockOnOverflow);
+extern JIT_NodeRef JIT_SubOverflow(
+    JIT_ILInjectorRef ilinjector, JIT_NodeRef a, JIT_NodeRef b, JIT_BlockRef blockOnOverflow);
+extern JIT_NodeRef JIT_MulOverflow(
+    JIT_ILInjectorRef ilinjector, JIT_NodeRef a, JIT_NodeRef b, JIT_BlockRef blockOnOverflow);
+
+/**
+ * A value saved at a deoptimization point, see JIT_Guard(). Each value
+ * is stored in the member matching its type.
+ */
+typedef union JIT_DeoptValue {
+    int8_t i8;
+    int16_t i16;
+    int32_t i32;
+    int64_t i64;
+    float f32;
+    double f64;
+    void* ptr;
+} JIT_DeoptValue;
+
+/**
+ * The interpreter state passed to the deoptimization handler when a
+ * guard fails: the id given to JIT_Guard() and the values it was given,
+ * in the same order. The record lives in the frame of the compiled
+ * function and is only valid until the handler returns.
+ */
+typedef struct JIT_DeoptRecord {
+    int32_t deopt_id;
+    int32_t num_values;
+    JIT_DeoptValue values[1]; /* num_values entries */
+} JIT_DeoptRecord;
+
+/**
+ * Sets the function called when a guard of the function fails, see
+ * JIT_Guard(). The handler must be registered with JIT_RegisterFunction(),
+ * take a single Address parameter, which points to a JIT_DeoptRecord,
+ * and return the same type as the function. It is expected to resume
+ * execution in an interpreter, or in less specialized code, from the
+ * state in the record; its result is returned by the compiled function.
+ * Must be called before JIT_Compile().
+ */
+extern void JIT_SetDeoptHandler(JIT_FunctionBuilderRef fb, const char* handler_name);
+
+/**
+ * Speculates that condition, an integer or address, is nonzero. If it is
+ * zero the compiled function deoptimizes: the given values, which describe
+ * the state the interpreter needs to resume at this point, are saved in a
+ * JIT_DeoptRecord tagged with deopt_id, and the result of the deoptimization
+ * handler called with it is returned. So the code after the guard may
+ * assume the condition holds, for instance that a dynamically typed value
+ * has the type seen so far, and needs no further checks.
+ *
+ * The code that saves the values and calls the handler is placed in a
+ * block of its own, out of line and marked cold, and the values are only
+ * kept alive for it.
+ *
+ * Like JIT_IfNotZeroValue() above, the guard ends the current block; the
+ * caller must start the next block, which is where execution continues
+ * when the condition holds, and add the edge to it. Returns NULL if no
+ * handler is set or the condition is not valid.
+ */
+extern JIT_NodeRef JIT_Guard(
+    JIT_ILInjectorRef ilinjector, JIT_NodeRef condition, int32_t deopt_id, int32_t num_values, JIT_NodeRef* values);
+
+/**
+ * Assumes that a condition of the embedder, identified by assumption_id,
+ * holds: for instance that a metatable or a global is unchanged, or that no
+ * debug hook is set. Execution continues in the next block until
+ * JIT_InvalidateAssumption() is called for the id, and in slowBlock after.
+ *
+ * Where the code generator supports it the guard is a NOP, so it costs
+ * nothing while the assumption holds, which invalidation patches into a jump
+ * to slowBlock; elsewhere the guard tests a flag. slowBlock is marked cold.
+ *
+ * Like JIT_IfNotZeroValue() above, the guard ends the current block; the
+ * caller must start the next block and add the edge to it.
+ */
+extern JIT_NodeRef JIT_CreatePatchableGuard(
+    JIT_ILInjectorRef ilinjector, uint64_t assumption_id, JIT_BlockRef slowBlock);
+
+/**
+ * Invalidates the assumption identified by assumption_id, see
+ * JIT_CreatePatchableGuard(). Every guard on it, in functions compiled
+ * already or later, goes to its slow block from now on; invalidation cannot
+ * be undone. May be called while compiled functions run, but the caller must
+ * ensure that no thread relies on the assumption past the guard it last
+ * passed. Returns the number of guards patched.
+ */
+extern int JIT_InvalidateAssumption(JIT_ContextRef ctx, uint64_t assumption_id);
+
+/**
+ * Returns the function that the profile of the function being built, see
+ * JIT_EnableProfiling(), found the next JIT_IndirectCall() to call in at
+ * least min_percent of the calls, or NULL if there is none. The caller may
+ * then test for it and call it directly, so that it can be inlined or
+ * specialized. Indirect calls are identified by the order they are
+ * generated in.
+ */
+extern void* JIT_GetDominantCallTarget(JIT_ILInjectorRef ilinjector, int32_t min_percent);
+
 /**
  * C style switch; CFG will be updated to add edge from current block
  * to each of the case blocks, and the default block.
+ * The cases may be given in any order. When the expression is an Int32 and
+ * the case values are dense the switch is compiled to a jump table,
+ * otherwise to a search of the case values.
  */
 extern JIT_NodeRef JIT_Switch(JIT_ILInjectorRef ilinjector, JIT_NodeRef expr, JIT_BlockRef default_branch,
     int num_cases, JIT_BlockRef* case_branches, int32_t* case_values);
@@ -1375,9 +1701,11 @@ extern void JIT_SetMayHaveLoops(JIT_ILInjectorRef ilinjector);
 extern void JIT_SetMayHaveNestedLoops(JIT_ILInjectorRef ilinjector);
 
 /**
- * Inform the compiler that the automatic variable had its
+ * Inform the compiler that the automatic variable or parameter had its
  * address taken, hence the variable should be considered as aliased
- * when calling functions etc.
+ * when calling functions etc. Variables whose address is taken by
+ * JIT_LoadAddress are detected automatically, so this is only needed
+ * when the address is obtained some other way.
  */
 extern void JIT_SetAutoAddressTaken(JIT_ILInjectorRef ilinjector, JIT_SymbolRef symbol);
 
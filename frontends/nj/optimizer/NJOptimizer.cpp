@@ -22,12 +22,20 @@
 
 #include "optimizer/Optimizer.hpp"
 
+#include <algorithm>
 #include <stddef.h>
 #include <stdint.h>
 #include "compile/Compilation.hpp"
 #include "compile/Method.hpp"
+#include "compile/SymbolReferenceTable.hpp"
 #include "control/Options.hpp"
 #include "control/Options_inlines.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "env/VerboseLog.hpp"
+#include "il/Block.hpp"
+#include "infra/BitVector.hpp"
+#include "infra/Cfg.hpp"
+#include "infra/CfgEdge.hpp"
 #include "il/symbol/ResolvedMethodSymbol.hpp"
 
 #include "optimizer/Optimization.hpp"
@@ -47,7 +55,9 @@
 #include "optimizer/ExpressionsSimplification.hpp"
 #include "optimizer/GeneralLoopUnroller.hpp"
 #include "optimizer/GlobalRegisterAllocator.hpp"
+#include "optimizer/GlobalValueNumbering.hpp"
 #include "optimizer/LocalCSE.hpp"
+#include "optimizer/LocalArrayScalarization.hpp"
 #include "optimizer/LocalDeadStoreElimination.hpp"
 #include "optimizer/LocalLiveRangeReducer.hpp"
 #include "optimizer/LocalOpts.hpp"
@@ -55,6 +65,7 @@
 #include "optimizer/LoopCanonicalizer.hpp"
 #include "optimizer/LoopReducer.hpp"
 #include "optimizer/LoopReplicator.hpp"
+#include "optimizer/LoopVectorizer.hpp"
 #include "optimizer/LoopVersioner.hpp"
 #include "optimizer/OrderBlocks.hpp"
 #include "optimizer/PartialRedundancy.hpp"
@@ -66,6 +77,7 @@
 #include "optimizer/LocalValuePropagation.hpp"
 #include "optimizer/Inliner.hpp"
 #include "optimizer/SwitchAnalyzer.hpp"
+#include "ras/DebugCounter.hpp"
 
 
 static const OptimizationStrategy tacticalGlobalRegisterAllocatorOpts[] =
@@ -110,7 +122,10 @@ static const OptimizationStrategy coldStrategyOpts[] =
 
 static const OptimizationStrategy warmStrategyOpts[] =
    {
+   { OMR::switchAnalyzer                                                           }, // jump tables for the dense clusters of sparse switches
+   { OMR::CFGSimplification,                         OMR::IfMoreThanOneBlock       }, // if-convert small diamonds into ternaries
    { OMR::basicBlockExtension                                                      },
+   { OMR::localArrayScalarization                                                  }, // give the fields of local structs to GRA
    { OMR::localCSE                                                                 },
    { OMR::treeSimplification                                                       },
    { OMR::localCSE                             },
@@ -123,7 +138,9 @@ static const OptimizationStrategy warmStrategyOpts[] =
 static const OptimizationStrategy hotStrategyOpts[] =
    {
    { OMR::treeSimplification                                                       },
+   { OMR::localArrayScalarization                                                  }, // after constant offsets are folded
    { OMR::localCSE                                                                 },
+   { OMR::CFGSimplification,                         OMR::IfMoreThanOneBlock       }, // if-convert small diamonds before ordering duplicates their join
    { OMR::basicBlockOrdering                                                       }, // straighten goto's
    { OMR::globalCopyPropagation                                                    },
    { OMR::globalDeadStoreElimination,                OMR::IfMoreThanOneBlock       },
@@ -136,12 +153,19 @@ static const OptimizationStrategy hotStrategyOpts[] =
    { OMR::localValuePropagation,                     OMR::IfOneBlock               },
    { OMR::switchAnalyzer,                                                          },
    { OMR::localCSE                                                                 },
+   { OMR::globalValueNumbering,                      OMR::IfMoreThanOneBlock       }, // common expressions and loads repeated in dominated blocks
    { OMR::treeSimplification                                                       },
    { OMR::trivialDeadTreeRemoval,                    OMR::IfEnabled                },
 
    { OMR::basicBlockOrdering,                        OMR::IfLoops                  }, // clean up block order for loop canonicalization, if it will run
    { OMR::loopCanonicalization,                      OMR::IfLoops                  }, // canonicalization must run before inductionVariableAnalysis else indvar data gets messed up
+   { OMR::partialRedundancyElimination,              OMR::IfLoops                  }, // hoist loop invariant expressions, including pure calls
+   { OMR::localCSE                                                                 },
    { OMR::inductionVariableAnalysis,                 OMR::IfLoops                  }, // needed for loop unroller
+   { OMR::loopAliasRefiner,                          OMR::IfLoops                  }, // version loops on disjointness of the arrays they access
+   { OMR::inductionVariableAnalysis,                 OMR::IfEnabled                }, // recompute induction variables of the versioned loops
+   { OMR::SPMDKernelParallelization,                 OMR::IfLoops                  }, // vectorize counted loops, reduce copy and fill loops
+   { OMR::inductionVariableAnalysis,                 OMR::IfEnabled                }, // recompute induction variables of the vectorized loops
    { OMR::generalLoopUnroller,                       OMR::IfLoops                  },
    { OMR::basicBlockExtension,                       OMR::MarkLastRun              }, // clean up order and extend blocks now
    { OMR::treeSimplification                                                       },
@@ -158,6 +182,71 @@ static const OptimizationStrategy hotStrategyOpts[] =
    { OMR::endOpts                                                                  },
    };
 
+// The costs of the expensive hot passes are estimated in units of about one
+// visit of a node.  A method gets a budget that grows with its loops, as the
+// code that runs repeatedly is what these passes speed up, and a pass whose
+// estimate is over budget is downgraded or skipped.  The budget of a method
+// without loops is the compileBudget= option; each loop adds a quarter of it.
+//
+static const int64_t maxBudgetedLoops     = 32;
+
+struct MethodShape
+   {
+   int64_t _nodes;
+   int64_t _blocks;
+   int64_t _symRefs;
+   int64_t _loops;
+   };
+
+// Loops are counted as the edges to a block at or before their source in
+// tree order, which needs no structural analysis.
+//
+static void measureMethod(TR::Compilation *comp, MethodShape &shape)
+   {
+   TR::CFG *cfg = comp->getFlowGraph();
+   shape._nodes = comp->getNodeCount();
+   shape._blocks = cfg->getNextNodeNumber();
+   shape._symRefs = comp->getSymRefTab()->getNumSymRefs();
+   shape._loops = 0;
+
+   TR::StackMemoryRegion stackMemoryRegion(*comp->trMemory());
+   TR_BitVector seen(cfg->getNextNodeNumber(), comp->trMemory(), stackAlloc);
+   for (TR::Block *block = comp->getStartBlock(); block; block = block->getNextBlock())
+      {
+      seen.set(block->getNumber());
+      for (auto edge = block->getSuccessors().begin(); edge != block->getSuccessors().end(); ++edge)
+         {
+         if (seen.isSet((*edge)->getTo()->getNumber()))
+            shape._loops++;
+         }
+      }
+   }
+
+// Value propagation walks each loop until its constraints settle, and merges
+// the constraints on each symbol where blocks join.
+//
+static int64_t globalValuePropagationCost(const MethodShape &shape)
+   {
+   return shape._nodes * (2 + std::min<int64_t>(shape._loops, 8)) + shape._blocks * shape._symRefs / 16;
+   }
+
+// Canonicalization needs structure, and partial redundancy elimination solves
+// bit vector problems of an expression per node over all the blocks.
+//
+static int64_t loopOptimizationCost(const MethodShape &shape)
+   {
+   return shape._blocks * shape._nodes / 32 + shape._nodes * std::min<int64_t>(shape._loops, 8);
+   }
+
+// Unrolling and versioning copy loop bodies, which every later pass then
+// visits, and grow the blocks that register allocation's liveness covers.
+//
+static int64_t loopDuplicationCost(const MethodShape &shape)
+   {
+   return shape._nodes * std::min<int64_t>(shape._loops, 16) * 4 + shape._blocks * shape._symRefs / 16;
+   }
+
+
 
 namespace NJCompiler
 {
@@ -199,6 +288,8 @@ Optimizer::Optimizer(TR::Compilation *comp, TR::ResolvedMethodSymbol *methodSymb
       new (comp->allocator()) TR::OptimizationManager(self(), TR_Rematerialization::create, OMR::rematerialization);
    _opts[OMR::loopCanonicalization] =
       new (comp->allocator()) TR::OptimizationManager(self(), TR_LoopCanonicalizer::create, OMR::loopCanonicalization);
+   _opts[OMR::partialRedundancyElimination] =
+      new (comp->allocator()) TR::OptimizationManager(self(), TR_PartialRedundancy::create, OMR::partialRedundancyElimination);
    _opts[OMR::inductionVariableAnalysis] =
       new (comp->allocator()) TR::OptimizationManager(self(), TR_InductionVariableAnalysis::create, OMR::inductionVariableAnalysis);
    _opts[OMR::liveRangeSplitter] =
@@ -209,6 +300,16 @@ Optimizer::Optimizer(TR::Compilation *comp, TR::ResolvedMethodSymbol *methodSymb
       new (comp->allocator()) TR::OptimizationManager(self(), TR::RegDepCopyRemoval::create, OMR::regDepCopyRemoval);
    _opts[OMR::switchAnalyzer] =
       new (comp->allocator()) TR::OptimizationManager(self(), TR::SwitchAnalyzer::create, OMR::switchAnalyzer);
+   _opts[OMR::SPMDKernelParallelization] =
+      new (comp->allocator()) TR::OptimizationManager(self(), TR_LoopVectorizer::create, OMR::SPMDKernelParallelization);
+   _opts[OMR::localArrayScalarization] =
+      new (comp->allocator()) TR::OptimizationManager(self(), TR_LocalArrayScalarization::create, OMR::localArrayScalarization);
+   _opts[OMR::globalValueNumbering] =
+      new (comp->allocator()) TR::OptimizationManager(self(), TR_GlobalValueNumbering::create, OMR::globalValueNumbering);
+   _opts[OMR::CFGSimplification] =
+      new (comp->allocator()) TR::OptimizationManager(self(), TR::CFGSimplifier::create, OMR::CFGSimplification);
+   _opts[OMR::loopAliasRefiner] =
+      new (comp->allocator()) TR::OptimizationManager(self(), TR_LoopAliasRefiner::create, OMR::loopAliasRefiner);
 
    // Initialize optimization groups
    _opts[OMR::cheapTacticalGlobalRegisterAllocatorGroup] =
@@ -229,6 +330,68 @@ Optimizer::Optimizer(TR::Compilation *comp, TR::ResolvedMethodSymbol *methodSymb
 
    }
 
+const OptimizationStrategy *
+Optimizer::optimizationStrategy(TR::Compilation *c)
+   {
+   const OptimizationStrategy *strategy = OMR::Optimizer::optimizationStrategy(c);
+   if (strategy != hotStrategyOpts || !c->getFlowGraph())
+      return strategy;
+
+   MethodShape shape;
+   measureMethod(c, shape);
+   int64_t baseBudget = c->getOptions()->getCompileBudget();
+   int64_t budget = baseBudget + baseBudget / 4 * std::min(shape._loops, maxBudgetedLoops);
+   int64_t gvpCost = globalValuePropagationCost(shape);
+   int64_t loopCost = loopOptimizationCost(shape);
+   int64_t duplicationCost = loopDuplicationCost(shape);
+   bool downgradeGVP = gvpCost > budget;
+   bool skipLoopOpts = loopCost > budget;
+   bool skipLoopDuplication = skipLoopOpts || duplicationCost > budget;
+
+   if (TR::Options::getVerboseOption(TR_VerboseOptimizer))
+      {
+      TR_VerboseLog::writeLineLocked(TR_Vlog_INFO,
+         "%s nodes=%lld blocks=%lld symrefs=%lld loops=%lld budget=%lld"
+         " globalValuePropagation=%lld%s loopOpts=%lld%s loopDuplication=%lld%s",
+         c->signature(), (long long)shape._nodes, (long long)shape._blocks, (long long)shape._symRefs,
+         (long long)shape._loops, (long long)budget,
+         (long long)gvpCost, downgradeGVP ? "(localValuePropagation)" : "",
+         (long long)loopCost, skipLoopOpts ? "(skipped)" : "",
+         (long long)duplicationCost, skipLoopDuplication ? "(skipped)" : "");
+      }
+
+   if (!downgradeGVP && !skipLoopDuplication)
+      return strategy;
+
+   if (downgradeGVP)
+      TR::DebugCounter::incStaticDebugCounter(c, "compileBudget/globalValuePropagationDowngraded");
+   if (skipLoopOpts)
+      TR::DebugCounter::incStaticDebugCounter(c, "compileBudget/loopOptsSkipped");
+   if (skipLoopDuplication)
+      TR::DebugCounter::incStaticDebugCounter(c, "compileBudget/loopDuplicationSkipped");
+
+   if (c->getOption(TR_TraceOptDetails) || c->getOption(TR_TraceOptTrees))
+      traceMsg(c, "Using hot optimization strategy cut down to compile time budget %lld\n", (long long)budget);
+
+   int32_t size = 0;
+   while (strategy[size]._num != OMR::endOpts)
+      size++;
+   OptimizationStrategy *budgeted = (OptimizationStrategy *)c->trMemory()->allocateHeapMemory((size + 1) * sizeof(budgeted[0]));
+   int32_t count = 0;
+   for (int32_t i = 0; i <= size; i++)
+      {
+      OptimizationStrategy o = strategy[i];
+      if (skipLoopOpts && o._options == OMR::IfLoops)
+         continue;
+      if (skipLoopDuplication && (o._num == OMR::generalLoopUnroller || o._num == OMR::loopAliasRefiner))
+         continue;
+      if (downgradeGVP && o._num == OMR::globalValuePropagation)
+         o._num = OMR::localValuePropagation; // the one block localValuePropagation entry follows
+      budgeted[count++] = o;
+      }
+   return budgeted;
+   }
+
 inline
 TR::Optimizer *Optimizer::self()
    {
@@ -0,0 +1,354 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "runtime/NJCodeCacheCompactor.hpp"
+
+#include <algorithm>
+#include <string.h>
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/StaticRelocation.hpp"
+#include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "env/TRMemory.hpp"
+#include "infra/Assert.hpp"
+#include "infra/CriticalSection.hpp"
+#include "infra/Monitor.hpp"
+#include "runtime/CodeCache.hpp"
+#include "runtime/CodeCacheManager.hpp"
+#include "runtime/CodeCacheTypes.hpp"
+#include "runtime/NJCodeMetaDataManager.hpp"
+#include "runtime/NJRuntimeAssumptions.hpp"
+
+NJCompiler::CodeCacheCompactor *NJCompiler::CodeCacheCompactor::_instance = NULL;
+
+NJCompiler::CodeCacheCompactor *
+NJCompiler::CodeCacheCompactor::initialize()
+   {
+   if (!_instance)
+      _instance = new (PERSISTENT_NEW) CodeCacheCompactor();
+   return _instance;
+   }
+
+NJCompiler::CodeCacheCompactor::CodeCacheCompactor()
+   : _monitor(TR::Monitor::create("JIT-CodeCacheCompactorMonitor")),
+     _methods(NULL),
+     _numUnrecordedMethods(0),
+     _isEnabled(false)
+   {
+   }
+
+void
+NJCompiler::CodeCacheCompactor::enable()
+   {
+   OMR::CriticalSection enabling(_monitor);
+   if (_isEnabled)
+      return;
+
+   // Reporting the call sites costs compile time and memory, so only the
+   // compilations from now on pay for it
+   //
+   TR::Options::setOptionInAllOptionSets(TR_EnableCodeCacheCompaction);
+   _isEnabled = true;
+   }
+
+static bool
+isCallSite(const TR::StaticRelocation &relocation, uint8_t *code, uint8_t *codeEnd)
+   {
+   return relocation.size() == TR::StaticRelocationSize::word64
+      && relocation.type() == TR::StaticRelocationType::Absolute
+      && relocation.location() >= code
+      && relocation.location() + sizeof(uint64_t) <= codeEnd;
+   }
+
+void
+NJCompiler::CodeCacheCompactor::recordCompiledMethod(TR::Compilation *comp, const MethodMetaData *metaData)
+   {
+   TR::CodeGenerator *cg = comp->cg();
+   uint8_t *code = cg->getBinaryBufferStart();
+   uint8_t *codeEnd = cg->getCodeEnd();
+
+   // Without the option the method was compiled before compaction was
+   // enabled.  It stays where it is, and as it can only call methods compiled
+   // before it, none of which are recorded, it never calls one that moves.
+   //
+   if (!comp->getOption(TR_EnableCodeCacheCompaction))
+      return;
+
+   // Only code in a code cache block of its own can be moved or given back.
+   // Code that is not recorded may call any other method, so nothing can be
+   // moved or released any more.
+   //
+   OMR::CodeCacheMethodHeader *header = (OMR::CodeCacheMethodHeader *)(code - sizeof(OMR::CodeCacheMethodHeader));
+   TR::CodeCacheConfig &config = TR::CodeCacheManager::instance()->codeCacheConfig();
+   if (memcmp(header->_eyeCatcher, config.warmEyeCatcher(), sizeof(header->_eyeCatcher)) != 0)
+      {
+      OMR::CriticalSection recordingMethod(_monitor);
+      _numUnrecordedMethods++;
+      return;
+      }
+
+   auto &relocations = cg->getStaticRelocations();
+   int32_t numCallSites = 0;
+   for (auto it = relocations.begin(); it != relocations.end(); ++it)
+      {
+      if (isCallSite(*it, code, codeEnd))
+         numCallSites++;
+      }
+
+   size_t size = sizeof(Method) + (numCallSites > 0 ? numCallSites - 1 : 0) * sizeof(uint32_t);
+   Method *method = (Method *)TR_Memory::jitPersistentAlloc(size, TR_Memory::CodeMetaData);
+   method->_metaData = metaData;
+   method->_code = code;
+   method->_newCode = NULL;
+   method->_codeSize = (uint32_t)(codeEnd - code);
+   method->_entryOffset = (uint32_t)(cg->getCodeStart() - code);
+   method->_isLive = true;
+   method->_numCallSites = 0;
+   for (auto it = relocations.begin(); it != relocations.end(); ++it)
+      {
+      if (isCallSite(*it, code, codeEnd))
+         method->_callSites[method->_numCallSites++] = (uint32_t)(it->location() - code);
+      }
+
+#if defined(TR_HOST_X86) && defined(TR_HOST_64BIT)
+   // Patchable guards are recorded by address, and are patched in place
+   //
+   method->_isMovable = !cg->hasPositionDependentCode() && cg->getPatchableGuardSites().empty();
+#else
+   // Other code generators have not been checked to report every position
+   // dependent reference
+   //
+   method->_isMovable = false;
+#endif
+
+   OMR::CriticalSection recordingMethod(_monitor);
+   method->_next = _methods;
+   _methods = method;
+   }
+
+NJCompiler::CodeCacheCompactor::Method *
+NJCompiler::CodeCacheCompactor::findMethod(Method **sortedMethods, int32_t numMethods, uintptr_t entry)
+   {
+   int32_t low = 0;
+   int32_t high = numMethods - 1;
+   while (low <= high)
+      {
+      int32_t middle = low + (high - low) / 2;
+      uintptr_t middleEntry = (uintptr_t)entryPoint(sortedMethods[middle]);
+      if (middleEntry == entry)
+         return sortedMethods[middle];
+      else if (middleEntry < entry)
+         low = middle + 1;
+      else
+         high = middle - 1;
+      }
+   return NULL;
+   }
+
+// Moves the code cache block holding the method's code down into the lowest
+// free block of its code cache that holds it, and gives the block it vacates
+// back.  Returns where the code now starts, or NULL if there is no free block
+// below it.
+//
+uint8_t *
+NJCompiler::CodeCacheCompactor::moveCode(Method *method)
+   {
+   OMR::CodeCacheMethodHeader *header = (OMR::CodeCacheMethodHeader *)(method->_code - sizeof(OMR::CodeCacheMethodHeader));
+   TR::CodeCache *codeCache = TR::CodeCacheManager::instance()->findCodeCacheFromPC(header);
+   if (!codeCache)
+      return NULL;
+
+   TR::CodeCache::CacheCriticalSection movingCode(codeCache);
+   size_t size = header->_size;
+   size_t blockSize = 0;
+   uint8_t *block = codeCache->findFreeBlockBelow(size, (uint8_t *)header, blockSize);
+   if (!block)
+      return NULL;
+
+   // The blocks are aligned alike, so the code keeps the alignment of the
+   // loops and constants within it
+   //
+   memcpy(block, header, size);
+   ((OMR::CodeCacheMethodHeader *)block)->_size = blockSize;
+   codeCache->addFreeBlock2((uint8_t *)header, (uint8_t *)header + size);
+   return block + sizeof(OMR::CodeCacheMethodHeader);
+   }
+
+void
+NJCompiler::CodeCacheCompactor::releaseCode(uint8_t *code, uint32_t codeSize)
+   {
+   if (RuntimeAssumptionTable::instance())
+      RuntimeAssumptionTable::instance()->removeSites(code, code + codeSize);
+
+   OMR::CodeCacheMethodHeader *header = (OMR::CodeCacheMethodHeader *)(code - sizeof(OMR::CodeCacheMethodHeader));
+   TR::CodeCache *codeCache = TR::CodeCacheManager::instance()->findCodeCacheFromPC(header);
+   if (codeCache)
+      {
+      TR::CodeCache::CacheCriticalSection freeingBlock(codeCache);
+      codeCache->addFreeBlock2((uint8_t *)header, (uint8_t *)header + header->_size);
+      }
+   }
+
+int32_t
+NJCompiler::CodeCacheCompactor::compact(void **entryPoints, int32_t numEntryPoints)
+   {
+   OMR::CriticalSection compacting(_monitor);
+
+   if (!_isEnabled || _numUnrecordedMethods > 0)
+      return -1;
+
+   int32_t numMethods = 0;
+   for (Method *method = _methods; method; method = method->_next)
+      numMethods++;
+   if (numMethods == 0)
+      return 0;
+
+   Method **sortedMethods = (Method **)TR_Memory::jitPersistentAlloc(2 * numMethods * sizeof(Method *), TR_Memory::CodeMetaData);
+   Method **worklist = sortedMethods + numMethods;
+   int32_t i = 0;
+   for (Method *method = _methods; method; method = method->_next)
+      {
+      method->_isLive = false;
+      method->_newCode = NULL;
+      sortedMethods[i++] = method;
+      }
+   std::sort(sortedMethods, sortedMethods + numMethods,
+             [this](Method *a, Method *b) { return entryPoint(a) < entryPoint(b); });
+
+   // Everything reachable from the entry points through direct calls stays
+   //
+   int32_t worklistSize = 0;
+   for (i = 0; i < numEntryPoints; i++)
+      {
+      Method *method = findMethod(sortedMethods, numMethods, (uintptr_t)entryPoints[i]);
+      if (method && !method->_isLive)
+         {
+         method->_isLive = true;
+         worklist[worklistSize++] = method;
+         }
+      }
+   while (worklistSize > 0)
+      {
+      Method *method = worklist[--worklistSize];
+      for (int32_t c = 0; c < method->_numCallSites; c++)
+         {
+         uintptr_t target = *(uintptr_t *)(method->_code + method->_callSites[c]);
+         Method *callee = findMethod(sortedMethods, numMethods, target);
+         if (callee && !callee->_isLive)
+            {
+            callee->_isLive = true;
+            worklist[worklistSize++] = callee;
+            }
+         }
+      }
+
+   // Give the unreachable methods back first, so that the live ones can move
+   // into the space they leave.  Their records are kept until the call sites
+   // have been repointed, as those are looked up by the old entry points.
+   //
+   for (i = 0; i < numMethods; i++)
+      {
+      Method *method = sortedMethods[i];
+      if (!method->_isLive)
+         releaseCode(method->_code, method->_codeSize);
+      }
+
+   // Methods below the lowest free block of their code cache have nowhere
+   // lower to go and stay put.  The ones above it move down in address order,
+   // each into the lowest free block that holds it, so the free space ends up
+   // above them.
+   //
+   for (i = 0; i < numMethods; i++)
+      {
+      Method *method = sortedMethods[i];
+      if (method->_isLive && method->_isMovable)
+         method->_newCode = moveCode(method);
+      }
+
+   // Repoint the calls to moved methods, wherever their callers now are
+   //
+   for (i = 0; i < numMethods; i++)
+      {
+      Method *method = sortedMethods[i];
+      if (!method->_isLive)
+         continue;
+      uint8_t *code = method->_newCode ? method->_newCode : method->_code;
+      for (int32_t c = 0; c < method->_numCallSites; c++)
+         {
+         uintptr_t *callSite = (uintptr_t *)(code + method->_callSites[c]);
+         Method *callee = findMethod(sortedMethods, numMethods, *callSite);
+         if (callee && callee->_newCode)
+            *callSite = (uintptr_t)(callee->_newCode + callee->_entryOffset);
+         }
+      }
+
+   for (i = 0; i < numEntryPoints; i++)
+      {
+      Method *method = findMethod(sortedMethods, numMethods, (uintptr_t)entryPoints[i]);
+      if (method && method->_newCode)
+         entryPoints[i] = method->_newCode + method->_entryOffset;
+      }
+
+   TR_Memory::jitPersistentFree(sortedMethods);
+
+   // Describe the methods at their new addresses and forget the released ones
+   //
+   CodeMetaDataManager *metaDataManager = CodeMetaDataManager::instance();
+   int32_t numChanged = 0;
+   Method **link = &_methods;
+   while (*link)
+      {
+      Method *method = *link;
+      if (method->_newCode)
+         {
+         method->_metaData = metaDataManager->moveMetaData(method->_metaData, method->_newCode - method->_code);
+         method->_code = method->_newCode;
+         method->_newCode = NULL;
+         numChanged++;
+         }
+      else if (!method->_isLive)
+         {
+         metaDataManager->removeMetaData(method->_metaData);
+         *link = method->_next;
+         TR_Memory::jitPersistentFree(method);
+         numChanged++;
+         continue;
+         }
+      link = &method->_next;
+      }
+
+   return numChanged;
+   }
+
+void
+NJCompiler::CodeCacheCompactor::releaseAll()
+   {
+   OMR::CriticalSection releasing(_monitor);
+
+   _numUnrecordedMethods = 0;
+   while (_methods)
+      {
+      Method *method = _methods;
+      _methods = method->_next;
+      TR_Memory::jitPersistentFree(method);
+      }
+   _isEnabled = false;
+   }
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef NJ_CODECACHECOMPACTOR_INCL
+#define NJ_CODECACHECOMPACTOR_INCL
+
+#include <stddef.h>
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+
+namespace TR { class Compilation; }
+namespace TR { class Monitor; }
+
+namespace NJCompiler
+{
+
+struct MethodMetaData;
+
+/**
+ * Compacts the code of NJ compiled methods.
+ *
+ * Once compaction is enabled every method compiled is recorded here along with
+ * the locations of the absolute call targets it embeds, which the
+ * enableCodeCacheCompaction option, set for all compilations from then on,
+ * makes the code generator report.  Methods compiled earlier are not recorded
+ * and stay where they are: their calls can only be to other methods compiled
+ * before them, none of which are moved.  A method compiled later that could
+ * not be recorded could call any other, so once there is one compaction is
+ * refused.
+ * At a safepoint compact() finds the recorded methods still reachable from a
+ * set of entry points and gives the unreachable ones back to their code
+ * caches as free blocks.  The movable methods above the lowest free block of
+ * their code cache are then moved down, in address order, into the lowest
+ * free block that holds them, and the call sites and the metadata are
+ * repointed at the new copies.  The code never leaves the code caches it was
+ * compiled into.
+ */
+class CodeCacheCompactor
+   {
+   public:
+
+   TR_PERSISTENT_ALLOC(TR_Memory::CodeMetaData);
+
+   static CodeCacheCompactor *instance() { return _instance; }
+   static CodeCacheCompactor *initialize();
+
+   /**
+    * @brief Records the code just generated by comp, described by metaData.
+    */
+   void recordCompiledMethod(TR::Compilation *comp, const MethodMetaData *metaData);
+
+   /**
+    * @brief Starts recording the methods compiled from now on and allows
+    * compact() to run; until then it refuses.  No compilation may be in
+    * progress while this executes.
+    */
+   void enable();
+
+   /**
+    * @brief Compacts the recorded methods.
+    *
+    * Only methods reachable from entryPoints, directly or through the calls
+    * they make, are kept.  On return each entry point has been replaced by
+    * the new address of the method if it was moved.  No compiled code may
+    * run, and no compilation may be in progress, while this executes.
+    *
+    * @return the number of methods moved or released, or -1 if compaction
+    * has not been enabled or some compiled code was not recorded
+    */
+   int32_t compact(void **entryPoints, int32_t numEntryPoints);
+
+   /**
+    * @brief Forgets all recorded methods and disables compaction, e.g. when
+    * the code caches are destroyed.
+    */
+   void releaseAll();
+
+   private:
+
+   CodeCacheCompactor();
+
+   struct Method
+      {
+      Method *_next;
+      const MethodMetaData *_metaData;
+      uint8_t *_code;          // start of the method's code (the binary buffer)
+      uint8_t *_newCode;       // where compact() copied the code to, if anywhere
+      uint32_t _codeSize;
+      uint32_t _entryOffset;   // offset of the entry point from _code
+      bool _isMovable;
+      bool _isLive;
+      int32_t _numCallSites;
+      uint32_t _callSites[1];  // offsets from _code of 64-bit absolute call targets
+      };
+
+   uint8_t *entryPoint(Method *method) { return method->_code + method->_entryOffset; }
+   Method *findMethod(Method **sortedMethods, int32_t numMethods, uintptr_t entry);
+   uint8_t *moveCode(Method *method);
+   void releaseCode(uint8_t *code, uint32_t codeSize);
+
+   static CodeCacheCompactor *_instance;
+
+   TR::Monitor *_monitor;
+   Method *_methods;
+   int32_t _numUnrecordedMethods;
+   bool _isEnabled;
+   };
+
+} // namespace NJCompiler
+
+#endif // NJ_CODECACHECOMPACTOR_INCL
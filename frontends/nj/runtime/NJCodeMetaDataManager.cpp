@@ -0,0 +1,244 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "runtime/NJCodeMetaDataManager.hpp"
+
+#include <string.h>
+#include "env/TRMemory.hpp"
+#include "infra/Assert.hpp"
+#include "infra/CriticalSection.hpp"
+#include "infra/Monitor.hpp"
+
+NJCompiler::CodeMetaDataManager *NJCompiler::CodeMetaDataManager::_instance = NULL;
+
+NJCompiler::CodeMetaDataManager *
+NJCompiler::CodeMetaDataManager::initialize()
+   {
+   if (!_instance)
+      _instance = new (PERSISTENT_NEW) CodeMetaDataManager();
+   return _instance;
+   }
+
+NJCompiler::CodeMetaDataManager::CodeMetaDataManager()
+   : _monitor(TR::Monitor::create("JIT-CodeMetaDataManagerMonitor")),
+     _index(NULL),
+     _activeReaders(0),
+     _retiredBlocks(NULL),
+     _names(NULL)
+   {
+   _index.store(allocateIndex(0));
+   }
+
+NJCompiler::CodeMetaDataManager::Index *
+NJCompiler::CodeMetaDataManager::allocateIndex(int32_t size)
+   {
+   size_t bytes = sizeof(Index) + (size > 0 ? size - 1 : 0) * sizeof(MethodMetaData *);
+   Index *index = (Index *)TR_Memory::jitPersistentAlloc(bytes, TR_Memory::CodeMetaData);
+   index->_size = size;
+   return index;
+   }
+
+const NJCompiler::MethodMetaData *
+NJCompiler::CodeMetaDataManager::insertMetaData(const char *name, uintptr_t startPC, uintptr_t endPC)
+   {
+   // The name outlives the metadata; it is recorded on the list of names
+   // that removeAllMetaData() frees
+   //
+   size_t nameLength = strlen(name);
+   char *nameCopy = (char *)TR_Memory::jitPersistentAlloc(nameLength + 1, TR_Memory::CodeMetaData);
+   memcpy(nameCopy, name, nameLength + 1);
+   RetiredBlock *nameBlock = (RetiredBlock *)TR_Memory::jitPersistentAlloc(sizeof(RetiredBlock), TR_Memory::CodeMetaData);
+   nameBlock->_memory = nameCopy;
+
+      {
+      OMR::CriticalSection recordingName(_monitor);
+      nameBlock->_next = _names;
+      _names = nameBlock;
+      }
+
+   return insertMetaDataWithName(nameCopy, startPC, endPC);
+   }
+
+const NJCompiler::MethodMetaData *
+NJCompiler::CodeMetaDataManager::moveMetaData(const MethodMetaData *metaData, intptr_t delta)
+   {
+   const MethodMetaData *movedMetaData = insertMetaDataWithName(metaData->name, metaData->startPC + delta, metaData->endPC + delta);
+   removeMetaData(metaData);
+   return movedMetaData;
+   }
+
+const NJCompiler::MethodMetaData *
+NJCompiler::CodeMetaDataManager::insertMetaDataWithName(const char *name, uintptr_t startPC, uintptr_t endPC)
+   {
+   TR_ASSERT(startPC < endPC, "Inserting a zero width metadata range will make lookups fail");
+
+   MethodMetaData *metaData = (MethodMetaData *)TR_Memory::jitPersistentAlloc(sizeof(MethodMetaData), TR_Memory::CodeMetaData);
+   metaData->startPC = startPC;
+   metaData->endPC = endPC;
+   metaData->name = name;
+
+   OMR::CriticalSection insertingMetaData(_monitor);
+
+   Index *oldIndex = _index.load();
+   Index *newIndex = allocateIndex(oldIndex->_size + 1);
+
+   // Ranges never overlap since they describe code actually in the code cache,
+   // so ordering by startPC is enough for the lookup's binary search
+   //
+   int32_t i = 0;
+   for (; i < oldIndex->_size && oldIndex->_entries[i]->startPC < startPC; i++)
+      newIndex->_entries[i] = oldIndex->_entries[i];
+   newIndex->_entries[i] = metaData;
+   for (; i < oldIndex->_size; i++)
+      newIndex->_entries[i + 1] = oldIndex->_entries[i];
+
+   publish(newIndex);
+   return metaData;
+   }
+
+bool
+NJCompiler::CodeMetaDataManager::removeMetaData(const MethodMetaData *metaData)
+   {
+   OMR::CriticalSection removingMetaData(_monitor);
+
+   Index *oldIndex = _index.load();
+   int32_t position = -1;
+   for (int32_t i = 0; i < oldIndex->_size && position < 0; i++)
+      {
+      if (oldIndex->_entries[i] == metaData)
+         position = i;
+      }
+
+   if (position < 0)
+      return false;
+
+   Index *newIndex = allocateIndex(oldIndex->_size - 1);
+   for (int32_t i = 0, j = 0; i < oldIndex->_size; i++)
+      {
+      if (i != position)
+         newIndex->_entries[j++] = oldIndex->_entries[i];
+      }
+
+   retire(const_cast<MethodMetaData *>(metaData));
+   publish(newIndex);
+   return true;
+   }
+
+void
+NJCompiler::CodeMetaDataManager::removeAllMetaData()
+   {
+   OMR::CriticalSection removingMetaData(_monitor);
+
+   Index *oldIndex = _index.load();
+   for (int32_t i = 0; i < oldIndex->_size; i++)
+      retire(oldIndex->_entries[i]);
+   while (_names)
+      {
+      RetiredBlock *nameBlock = _names;
+      _names = nameBlock->_next;
+      retire(nameBlock->_memory);
+      TR_Memory::jitPersistentFree(nameBlock);
+      }
+   publish(allocateIndex(0));
+   }
+
+// Must be called with the monitor held
+//
+void
+NJCompiler::CodeMetaDataManager::publish(Index *newIndex)
+   {
+   retire(_index.load());
+   _index.store(newIndex);
+
+   // Every lookup that could have loaded a retired index registered itself
+   // before doing so; any lookup registering after this point will see the
+   // new index.  With no lookups in flight nothing retired is reachable.
+   //
+   if (_activeReaders.load() == 0)
+      reclaimRetiredBlocks();
+   }
+
+void
+NJCompiler::CodeMetaDataManager::retire(void *memory)
+   {
+   RetiredBlock *block = (RetiredBlock *)TR_Memory::jitPersistentAlloc(sizeof(RetiredBlock), TR_Memory::CodeMetaData);
+   block->_memory = memory;
+   block->_next = _retiredBlocks;
+   _retiredBlocks = block;
+   }
+
+void
+NJCompiler::CodeMetaDataManager::reclaimRetiredBlocks()
+   {
+   while (_retiredBlocks)
+      {
+      RetiredBlock *block = _retiredBlocks;
+      _retiredBlocks = block->_next;
+      TR_Memory::jitPersistentFree(block->_memory);
+      TR_Memory::jitPersistentFree(block);
+      }
+   }
+
+NJCompiler::MethodMetaData *
+NJCompiler::CodeMetaDataManager::search(Index *index, uintptr_t pc)
+   {
+   // Find the last entry starting at or before pc
+   //
+   int32_t low = 0;
+   int32_t high = index->_size - 1;
+   MethodMetaData *candidate = NULL;
+   while (low <= high)
+      {
+      int32_t middle = low + (high - low) / 2;
+      MethodMetaData *entry = index->_entries[middle];
+      if (entry->startPC <= pc)
+         {
+         candidate = entry;
+         low = middle + 1;
+         }
+      else
+         {
+         high = middle - 1;
+         }
+      }
+
+   return (candidate && pc < candidate->endPC) ? candidate : NULL;
+   }
+
+const NJCompiler::MethodMetaData *
+NJCompiler::CodeMetaDataManager::findMetaDataForPC(uintptr_t pc)
+   {
+   _activeReaders.fetch_add(1);
+   MethodMetaData *metaData = search(_index.load(), pc);
+   _activeReaders.fetch_sub(1);
+   return metaData;
+   }
+
+bool
+NJCompiler::CodeMetaDataManager::lookup(uintptr_t pc, MethodMetaData &result)
+   {
+   _activeReaders.fetch_add(1);
+   MethodMetaData *metaData = search(_index.load(), pc);
+   if (metaData)
+      result = *metaData;
+   _activeReaders.fetch_sub(1);
+   return metaData != NULL;
+   }
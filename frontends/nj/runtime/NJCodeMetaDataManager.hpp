@@ -0,0 +1,143 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef NJ_CODEMETADATAMANAGER_INCL
+#define NJ_CODEMETADATAMANAGER_INCL
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+#include "runtime/CodeMetaDataPOD.hpp"
+
+namespace TR { class Monitor; }
+
+namespace NJCompiler
+{
+
+/**
+ * Metadata recorded for every method compiled by NJ.
+ */
+struct MethodMetaData : public TR::MethodMetaDataPOD
+   {
+   const char *name;
+   };
+
+/**
+ * Maps code addresses back to the NJ compiled method containing them.
+ *
+ * Lookups take no locks and allocate nothing, so that a sampling profiler's
+ * signal handler or an unwinder can resolve return addresses at a high rate.
+ * The index is an immutable array of metadata sorted by startPC and published
+ * through a single atomic pointer.  Updates are serialized on a monitor; each
+ * one builds a new array with the change applied and swaps it in.  Arrays and
+ * metadata that have been replaced are retired and only freed once no lookup
+ * is in flight.
+ *
+ * Method names are kept apart from the metadata and are only freed by
+ * removeAllMetaData(), so a name handed out by lookup() stays valid when the
+ * method is moved or released, until the JIT shuts down.
+ */
+class CodeMetaDataManager
+   {
+   public:
+
+   TR_PERSISTENT_ALLOC(TR_Memory::CodeMetaData);
+
+   static CodeMetaDataManager *instance() { return _instance; }
+   static CodeMetaDataManager *initialize();
+
+   /**
+    * @brief Creates the metadata for a method that occupies [startPC, endPC)
+    * and makes it visible to lookups.
+    */
+   const MethodMetaData *insertMetaData(const char *name, uintptr_t startPC, uintptr_t endPC);
+
+   /**
+    * @brief Replaces the metadata of a method whose code has been moved by
+    * delta bytes.  The method keeps its name.
+    */
+   const MethodMetaData *moveMetaData(const MethodMetaData *metaData, intptr_t delta);
+
+   /**
+    * @brief Removes the metadata from the index; it is freed once no lookup
+    * can still be using it.
+    */
+   bool removeMetaData(const MethodMetaData *metaData);
+
+   /**
+    * @brief Removes all metadata and the method names, e.g. when the code
+    * caches are destroyed.
+    */
+   void removeAllMetaData();
+
+   /**
+    * @brief Finds the metadata of the method whose code contains pc.
+    *
+    * Safe to call concurrently with updates, including from a signal handler.
+    * The returned metadata remains valid until it is removed; callers that can
+    * race with removal should use lookup() instead.
+    */
+   const MethodMetaData *findMetaDataForPC(uintptr_t pc);
+
+   /**
+    * @brief Copies the metadata of the method whose code contains pc into
+    * result.  Returns false if pc is not in any NJ compiled method.
+    *
+    * The name in the copy remains valid until removeAllMetaData().
+    */
+   bool lookup(uintptr_t pc, MethodMetaData &result);
+
+   private:
+
+   CodeMetaDataManager();
+
+   struct Index
+      {
+      int32_t _size;
+      MethodMetaData *_entries[1];
+      };
+
+   struct RetiredBlock
+      {
+      RetiredBlock *_next;
+      void *_memory;
+      };
+
+   Index *allocateIndex(int32_t size);
+   const MethodMetaData *insertMetaDataWithName(const char *name, uintptr_t startPC, uintptr_t endPC);
+   MethodMetaData *search(Index *index, uintptr_t pc);
+   void publish(Index *newIndex);
+   void retire(void *memory);
+   void reclaimRetiredBlocks();
+
+   static CodeMetaDataManager *_instance;
+
+   TR::Monitor *_monitor;
+   std::atomic<Index *> _index;
+   std::atomic<int32_t> _activeReaders;
+   RetiredBlock *_retiredBlocks;
+   RetiredBlock *_names;
+   };
+
+} // namespace NJCompiler
+
+#endif // NJ_CODEMETADATAMANAGER_INCL
@@ -0,0 +1,413 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "runtime/NJFunctionProfile.hpp"
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+#include "compile/Compilation.hpp"
+#include "compile/SymbolReferenceTable.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "env/TRMemory.hpp"
+#include "il/Block.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "il/symbol/ResolvedMethodSymbol.hpp"
+#include "infra/Cfg.hpp"
+#include "infra/CfgEdge.hpp"
+#include "ras/DebugCounter.hpp"
+
+namespace
+{
+
+// A count of a function profile.  The trees that bump it are built by the
+// debug counter machinery, but it is not a debug counter: the count lives in
+// the profile and is never accumulated.
+//
+class ProfileCounter : public TR::DebugCounterBase
+   {
+   public:
+
+   TR_ALLOC(TR_Memory::DebugCounter)
+
+   ProfileCounter(const char *name, uintptr_t *count) : TR::DebugCounterBase(name), _count(count) {}
+
+   virtual intptrj_t getBumpCountAddress() { return (intptrj_t)_count; }
+
+   virtual TR::SymbolReference *getBumpCountSymRef(TR::Compilation *comp)
+      {
+      return comp->getSymRefTab()->findOrCreateCounterSymRef(const_cast<char *>(_name), TR::Compiler->target.is64Bit() ? TR::Int64 : TR::Int32, _count);
+      }
+
+   virtual void accumulate() {}
+
+   private:
+
+   uintptr_t *_count;
+   };
+
+}
+
+static ProfileCounter *
+createCounter(TR::Compilation *comp, uintptr_t *counts, int32_t slot)
+   {
+   char *name = (char *)comp->trMemory()->allocateHeapMemory(32);
+   snprintf(name, 32, "profile.%d", slot);
+   return new (comp->trHeapMemory()) ProfileCounter(name, counts + slot);
+   }
+
+// Counts are scaled so that the most frequent block gets MAX_BLOCK_COUNT, and
+// any block that ran at all is above the cold block counts
+//
+static int32_t
+frequencyOf(uintptr_t count, uintptr_t maxCount)
+   {
+   if (count == 0)
+      return UNKNOWN_COLD_BLOCK_COUNT;
+   return MAX_COLD_BLOCK_COUNT + 1 + (int32_t)((double)count * (MAX_BLOCK_COUNT - MAX_COLD_BLOCK_COUNT - 1) / maxCount);
+   }
+
+NJCompiler::FunctionProfile::FunctionProfile()
+   : _counts(NULL),
+     _numCounts(0),
+     _callTargets(NULL),
+     _numCallTargets(0)
+   {
+   }
+
+NJCompiler::FunctionProfile::~FunctionProfile()
+   {
+   if (_counts)
+      TR_Memory::jitPersistentFree(_counts);
+   for (int32_t i = 0; i < _numCallTargets; i++)
+      {
+      if (_callTargets[i])
+         TR_Memory::jitPersistentFree(_callTargets[i]);
+      }
+   if (_callTargets)
+      TR_Memory::jitPersistentFree(_callTargets);
+   }
+
+bool
+NJCompiler::FunctionProfile::isCountableBranch(TR::Node *node)
+   {
+   if (!node->getOpCode().isIf() || node->getNumChildren() != 2 ||
+       node->getOpCode().convertIfCmpToCmp() == TR::BadILOp)
+      return false;
+
+   // A patchable guard must stay the only use of the guard word
+   //
+   TR::Node *firstChild = node->getFirstChild();
+   return !(firstChild->getOpCode().hasSymbolReference() && firstChild->getSymbolReference()->isSideEffectInfo());
+   }
+
+void
+NJCompiler::FunctionProfile::collectSwitchTargets(TR::Node *switchNode, TR::Block **targets, int32_t &numTargets)
+   {
+   numTargets = 0;
+   for (int32_t i = 1; i < switchNode->getNumChildren(); i++)
+      {
+      TR::Block *target = switchNode->getChild(i)->getBranchDestination()->getNode()->getBlock();
+      int32_t t = 0;
+      while (t < numTargets && targets[t] != target)
+         t++;
+      if (t == numTargets)
+         {
+         if (numTargets == MAX_SWITCH_TARGETS)
+            {
+            numTargets = MAX_SWITCH_TARGETS + 1;
+            return;
+            }
+         targets[numTargets++] = target;
+         }
+      }
+   }
+
+int32_t
+NJCompiler::FunctionProfile::findSites(TR::Compilation *comp, BlockSite *&sites, int32_t &numSlots)
+   {
+   int32_t numBlocks = 0;
+   for (TR::TreeTop *tt = comp->getStartTree(); tt; tt = tt->getNode()->getBlock()->getExit()->getNextTreeTop())
+      numBlocks++;
+
+   sites = (BlockSite *)comp->trMemory()->allocateStackMemory(numBlocks * sizeof(BlockSite));
+   TR::Block **targets = (TR::Block **)comp->trMemory()->allocateStackMemory((MAX_SWITCH_TARGETS + 1) * sizeof(TR::Block *));
+   numSlots = 0;
+   int32_t b = 0;
+   for (TR::TreeTop *tt = comp->getStartTree(); tt; tt = tt->getNode()->getBlock()->getExit()->getNextTreeTop())
+      {
+      BlockSite &site = sites[b++];
+      site._block = tt->getNode()->getBlock();
+      site._slot = numSlots++;
+      site._branchSlot = -1;
+      site._switchSlot = -1;
+      site._numSwitchTargets = 0;
+
+      TR::Node *lastNode = site._block->getLastRealTreeTop()->getNode();
+      if (isCountableBranch(lastNode))
+         {
+         site._branchSlot = numSlots++;
+         }
+      else if (lastNode->getOpCode().isSwitch())
+         {
+         collectSwitchTargets(lastNode, targets, site._numSwitchTargets);
+         if (site._numSwitchTargets <= MAX_SWITCH_TARGETS)
+            {
+            site._switchSlot = numSlots;
+            numSlots += site._numSwitchTargets;
+            }
+         }
+      }
+   return numBlocks;
+   }
+
+bool
+NJCompiler::FunctionProfile::instrument(TR::Compilation *comp)
+   {
+   TR::StackMemoryRegion stackMemoryRegion(*comp->trMemory());
+
+   BlockSite *sites;
+   int32_t numSlots;
+   int32_t numBlocks = findSites(comp, sites, numSlots);
+   if (!_counts)
+      {
+      _counts = (uintptr_t *)TR_Memory::jitPersistentAlloc(numSlots * sizeof(uintptr_t), TR_Memory::BlockFrequencyInfo);
+      memset(_counts, 0, numSlots * sizeof(uintptr_t));
+      _numCounts = numSlots;
+      }
+   else if (_numCounts != numSlots)
+      {
+      return false;
+      }
+
+   TR::CFG *cfg = comp->getFlowGraph();
+   TR::Block **targets = (TR::Block **)comp->trMemory()->allocateStackMemory((MAX_SWITCH_TARGETS + 1) * sizeof(TR::Block *));
+   for (int32_t b = 0; b < numBlocks; b++)
+      {
+      BlockSite &site = sites[b];
+      TR::Block *block = site._block;
+      TR::TreeTop *lastTree = block->getLastRealTreeTop();
+      TR::Node *lastNode = lastTree->getNode();
+
+      TR::DebugCounter::prependDebugCounterBump(comp, block->getEntry()->getNextTreeTop(), createCounter(comp, _counts, site._slot), 1);
+
+      // The comparison of the branch, which is 1 when it is taken, is added
+      // to the count
+      //
+      if (site._branchSlot >= 0)
+         {
+         TR::Node *compare = TR::Node::create(lastNode, lastNode->getOpCode().convertIfCmpToCmp(), 2,
+                                              lastNode->getFirstChild(), lastNode->getSecondChild());
+         TR::Node *delta = TR::Compiler->target.is64Bit() ? TR::Node::create(lastNode, TR::iu2l, 1, compare) : compare;
+         TR::DebugCounter::prependDebugCounterBump(comp, lastTree, createCounter(comp, _counts, site._branchSlot), delta);
+         }
+
+      // Each destination of the switch is counted in a block of its own on
+      // the edge to it
+      //
+      if (site._switchSlot >= 0)
+         {
+         int32_t numTargets;
+         collectSwitchTargets(lastNode, targets, numTargets);
+         for (int32_t t = 0; t < numTargets; t++)
+            {
+            TR::Block *countBlock = TR::Block::createEmptyBlock(lastNode, comp, -1, block);
+            cfg->addNode(countBlock);
+            comp->getMethodSymbol()->getLastTreeTop()->join(countBlock->getEntry());
+            TR::TreeTop *gotoTree = countBlock->append(TR::TreeTop::create(comp, TR::Node::create(lastNode, TR::Goto, 0, targets[t]->getEntry())));
+            TR::DebugCounter::prependDebugCounterBump(comp, gotoTree, createCounter(comp, _counts, site._switchSlot + t), 1);
+
+            for (int32_t i = 1; i < lastNode->getNumChildren(); i++)
+               {
+               TR::Node *caseNode = lastNode->getChild(i);
+               if (caseNode->getBranchDestination() == targets[t]->getEntry())
+                  caseNode->setBranchDestination(countBlock->getEntry());
+               }
+            cfg->addEdge(block, countBlock);
+            cfg->addEdge(countBlock, targets[t]);
+            }
+         for (int32_t t = 0; t < numTargets; t++)
+            cfg->removeEdge(block, targets[t]);
+         }
+      }
+   return true;
+   }
+
+bool
+NJCompiler::FunctionProfile::apply(TR::Compilation *comp)
+   {
+   TR::StackMemoryRegion stackMemoryRegion(*comp->trMemory());
+
+   BlockSite *sites;
+   int32_t numSlots;
+   int32_t numBlocks = findSites(comp, sites, numSlots);
+   if (!_counts || _numCounts != numSlots)
+      return false;
+
+   uintptr_t maxCount = 0;
+   for (int32_t b = 0; b < numBlocks; b++)
+      maxCount = std::max(maxCount, _counts[sites[b]._slot]);
+   if (maxCount == 0)
+      return false;
+
+   TR::CFG *cfg = comp->getFlowGraph();
+   int32_t *slotOfBlock = (int32_t *)comp->trMemory()->allocateStackMemory(cfg->getNextNodeNumber() * sizeof(int32_t));
+   for (int32_t i = 0; i < cfg->getNextNodeNumber(); i++)
+      slotOfBlock[i] = -1;
+   for (int32_t b = 0; b < numBlocks; b++)
+      slotOfBlock[sites[b]._block->getNumber()] = sites[b]._slot;
+
+   TR::Block **targets = (TR::Block **)comp->trMemory()->allocateStackMemory((MAX_SWITCH_TARGETS + 1) * sizeof(TR::Block *));
+   int32_t maxEdgeFrequency = 0;
+   for (int32_t b = 0; b < numBlocks; b++)
+      {
+      BlockSite &site = sites[b];
+      TR::Block *block = site._block;
+      TR::Node *lastNode = block->getLastRealTreeTop()->getNode();
+      uintptr_t count = _counts[site._slot];
+      block->setFrequency(frequencyOf(count, maxCount));
+      if (count == 0)
+         block->setIsCold();
+
+      int32_t numTargets = 0;
+      if (site._switchSlot >= 0)
+         collectSwitchTargets(lastNode, targets, numTargets);
+
+      for (auto e = block->getSuccessors().begin(); e != block->getSuccessors().end(); ++e)
+         {
+         TR::Block *to = (*e)->getTo()->asBlock();
+         uintptr_t edgeCount = count;
+         if (site._branchSlot >= 0)
+            {
+            uintptr_t taken = std::min(_counts[site._branchSlot], count);
+            bool isTarget = to->getEntry() == lastNode->getBranchDestination();
+            bool isFallThrough = to == block->getNextBlock();
+            if (isTarget && !isFallThrough)
+               edgeCount = taken;
+            else if (isFallThrough && !isTarget)
+               edgeCount = count - taken;
+            }
+         else if (site._switchSlot >= 0)
+            {
+            for (int32_t t = 0; t < numTargets; t++)
+               {
+               if (targets[t] == to)
+                  edgeCount = _counts[site._switchSlot + t];
+               }
+            }
+         else if (block->getSuccessors().size() > 1 && slotOfBlock[to->getNumber()] >= 0)
+            {
+            edgeCount = std::min(count, _counts[slotOfBlock[to->getNumber()]]);
+            }
+
+         int32_t edgeFrequency = frequencyOf(edgeCount, maxCount);
+         (*e)->setFrequency(edgeFrequency);
+         maxEdgeFrequency = std::max(maxEdgeFrequency, edgeFrequency);
+         }
+      }
+
+   cfg->setMaxFrequency(frequencyOf(maxCount, maxCount));
+   cfg->setMaxEdgeFrequency(maxEdgeFrequency);
+   comp->setHasBlockFrequencyInfo();
+   return true;
+   }
+
+uint64_t
+NJCompiler::FunctionProfile::getEntryCount()
+   {
+   return _counts ? _counts[0] : 0;
+   }
+
+NJCompiler::FunctionProfile::CallTargetHistogram *
+NJCompiler::FunctionProfile::getCallTargetHistogram(int32_t callIndex, bool create)
+   {
+   if (callIndex >= _numCallTargets)
+      {
+      if (!create)
+         return NULL;
+
+      int32_t numCallTargets = std::max(callIndex + 1, 2 * _numCallTargets);
+      CallTargetHistogram **callTargets = (CallTargetHistogram **)TR_Memory::jitPersistentAlloc(numCallTargets * sizeof(CallTargetHistogram *), TR_Memory::BlockFrequencyInfo);
+      memset(callTargets, 0, numCallTargets * sizeof(CallTargetHistogram *));
+      if (_callTargets)
+         {
+         memcpy(callTargets, _callTargets, _numCallTargets * sizeof(CallTargetHistogram *));
+         TR_Memory::jitPersistentFree(_callTargets);
+         }
+      _callTargets = callTargets;
+      _numCallTargets = numCallTargets;
+      }
+
+   if (!_callTargets[callIndex] && create)
+      {
+      CallTargetHistogram *histogram = (CallTargetHistogram *)TR_Memory::jitPersistentAlloc(sizeof(CallTargetHistogram), TR_Memory::BlockFrequencyInfo);
+      memset(histogram, 0, sizeof(CallTargetHistogram));
+      _callTargets[callIndex] = histogram;
+      }
+   return _callTargets[callIndex];
+   }
+
+void *
+NJCompiler::FunctionProfile::getDominantCallTarget(int32_t callIndex, int32_t minPercent)
+   {
+   CallTargetHistogram *histogram = getCallTargetHistogram(callIndex, false);
+   if (!histogram)
+      return NULL;
+
+   uintptr_t total = histogram->_otherCount;
+   int32_t best = 0;
+   for (int32_t i = 0; i < NUM_CALL_TARGETS; i++)
+      {
+      total += histogram->_counts[i];
+      if (histogram->_counts[i] > histogram->_counts[best])
+         best = i;
+      }
+   if (total == 0 || (double)histogram->_counts[best] * 100 < (double)minPercent * total)
+      return NULL;
+   return histogram->_targets[best];
+   }
+
+void
+NJCompiler::FunctionProfile::recordCallTarget(CallTargetHistogram *histogram, void *target)
+   {
+   // Races between threads only lose counts
+   //
+   for (int32_t i = 0; i < NUM_CALL_TARGETS; i++)
+      {
+      if (histogram->_targets[i] == target)
+         {
+         histogram->_counts[i]++;
+         return;
+         }
+      if (!histogram->_targets[i])
+         {
+         histogram->_targets[i] = target;
+         histogram->_counts[i]++;
+         return;
+         }
+      }
+   histogram->_otherCount++;
+   }
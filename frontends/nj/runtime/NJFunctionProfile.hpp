@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#ifndef NJ_FUNCTIONPROFILE_INCL
+#define NJ_FUNCTIONPROFILE_INCL
+
+#include <stddef.h>
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+
+namespace TR { class Block; }
+namespace TR { class Compilation; }
+namespace TR { class Node; }
+
+namespace NJCompiler
+{
+
+/**
+ * The profile of a function, gathered by instrumented compilations of it
+ * and used by its hot compilations.
+ *
+ * An instrumented compilation bumps a counter on entry to each block that
+ * IL generation created, counts how often each conditional branch is taken,
+ * and counts each distinct destination of a switch in a block of its own on
+ * the edge to it.  The counters are found again in later compilations by
+ * walking the IL the same way, so IL generation must produce the same
+ * blocks each time.  Indirect calls record their targets in a histogram per
+ * call site as IL generation creates them.
+ *
+ * A hot compilation sets the block and edge frequencies from the counts,
+ * which block ordering and the switch analyzer then use, and marks blocks
+ * that never ran as cold.
+ */
+class FunctionProfile
+   {
+   public:
+
+   TR_PERSISTENT_ALLOC(TR_Memory::BlockFrequencyInfo);
+
+   enum
+      {
+      NUM_CALL_TARGETS = 4,      // targets of an indirect call tracked by its histogram
+      MAX_SWITCH_TARGETS = 64,   // switches with more distinct destinations are not instrumented
+      };
+
+   struct CallTargetHistogram
+      {
+      void *_targets[NUM_CALL_TARGETS];
+      uintptr_t _counts[NUM_CALL_TARGETS];
+      uintptr_t _otherCount;     // calls to targets that did not fit
+      };
+
+   FunctionProfile();
+   ~FunctionProfile();
+
+   /**
+    * @brief Inserts the counters into the trees just generated for comp.
+    * @return false if the blocks differ from those of earlier instrumented
+    * compilations, in which case nothing is inserted
+    */
+   bool instrument(TR::Compilation *comp);
+
+   /**
+    * @brief Sets the frequencies of the blocks just generated for comp and
+    * of the edges between them from the counts.
+    * @return false if there are no counts for these blocks
+    */
+   bool apply(TR::Compilation *comp);
+
+   /**
+    * @brief Returns the number of times the function has been entered by
+    * instrumented code.
+    */
+   uint64_t getEntryCount();
+
+   /**
+    * @brief Returns the histogram of the callIndex'th indirect call created
+    * by IL generation, creating it if create is set, else NULL if there is
+    * none.
+    */
+   CallTargetHistogram *getCallTargetHistogram(int32_t callIndex, bool create);
+
+   /**
+    * @brief Returns the target of at least minPercent of the calls recorded
+    * for the callIndex'th indirect call, or NULL.
+    */
+   void *getDominantCallTarget(int32_t callIndex, int32_t minPercent);
+
+   /**
+    * @brief Called by instrumented code before an indirect call.
+    */
+   static void recordCallTarget(CallTargetHistogram *histogram, void *target);
+
+   private:
+
+   // What a walk of the blocks generated by IL generation found in one block
+   //
+   struct BlockSite
+      {
+      TR::Block *_block;
+      int32_t _slot;           // the block's count
+      int32_t _branchSlot;     // times its conditional branch was taken, or -1
+      int32_t _switchSlot;     // first count of its switch's destinations, or -1
+      int32_t _numSwitchTargets;
+      };
+
+   int32_t findSites(TR::Compilation *comp, BlockSite *&sites, int32_t &numSlots);
+   void collectSwitchTargets(TR::Node *switchNode, TR::Block **targets, int32_t &numTargets);
+   bool isCountableBranch(TR::Node *node);
+
+   uintptr_t *_counts;
+   int32_t _numCounts;
+   CallTargetHistogram **_callTargets;
+   int32_t _numCallTargets;
+   };
+
+} // namespace NJCompiler
+
+#endif // NJ_FUNCTIONPROFILE_INCL
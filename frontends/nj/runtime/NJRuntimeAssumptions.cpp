@@ -0,0 +1,155 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "runtime/NJRuntimeAssumptions.hpp"
+
+#include <string.h>
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/Instruction.hpp"
+#include "compile/Compilation.hpp"
+#include "env/TRMemory.hpp"
+#include "il/symbol/LabelSymbol.hpp"
+#include "infra/Assert.hpp"
+#include "infra/CriticalSection.hpp"
+#include "infra/Monitor.hpp"
+
+NJCompiler::RuntimeAssumptionTable *NJCompiler::RuntimeAssumptionTable::_instance = NULL;
+
+NJCompiler::RuntimeAssumptionTable *
+NJCompiler::RuntimeAssumptionTable::initialize()
+   {
+   if (!_instance)
+      _instance = new (PERSISTENT_NEW) RuntimeAssumptionTable();
+   return _instance;
+   }
+
+NJCompiler::RuntimeAssumptionTable::RuntimeAssumptionTable()
+   : _monitor(TR::Monitor::create("JIT-RuntimeAssumptionTableMonitor")),
+     _sites(NULL)
+   {
+   }
+
+void
+NJCompiler::RuntimeAssumptionTable::patch(Site *site)
+   {
+#if defined(TR_HOST_X86)
+   // The code generator keeps the NOP within an aligned 8 byte word, so the
+   // JMP4 replacing it is written with a single store
+   //
+   uint8_t *word = (uint8_t *)((uintptr_t)site->_location & ~(uintptr_t)7);
+   size_t offset = site->_location - word;
+   TR_ASSERT_FATAL(offset + 5 <= 8, "Patchable guard at %p crosses an 8 byte boundary", site->_location);
+
+   int32_t displacement = (int32_t)(site->_destination - (site->_location + 5));
+   uint8_t bytes[8];
+   memcpy(bytes, word, sizeof(bytes));
+   bytes[offset] = 0xe9;
+   memcpy(bytes + offset + 1, &displacement, sizeof(displacement));
+   uint64_t value;
+   memcpy(&value, bytes, sizeof(value));
+   __atomic_store_n((uint64_t *)word, value, __ATOMIC_SEQ_CST);
+#else
+   TR_ASSERT_FATAL(false, "Patchable guards are not supported on this platform");
+#endif
+   }
+
+void
+NJCompiler::RuntimeAssumptionTable::recordCompiledMethod(TR::Compilation *comp)
+   {
+   auto &guardSites = comp->cg()->getPatchableGuardSites();
+   if (guardSites.empty())
+      return;
+
+   OMR::CriticalSection recordingSites(_monitor);
+   for (auto it = guardSites.begin(); it != guardSites.end(); ++it)
+      {
+      Site *site = (Site *)TR_Memory::jitPersistentAlloc(sizeof(Site), TR_Memory::CodeMetaData);
+      site->_guardWord = (int32_t *)it->_guardWord;
+      site->_location = it->_instruction->getBinaryEncoding();
+      site->_destination = it->_destination->getCodeLocation();
+
+      // The assumption may have been invalidated during the compilation
+      //
+      if (*site->_guardWord != 0)
+         {
+         patch(site);
+         TR_Memory::jitPersistentFree(site);
+         continue;
+         }
+      site->_next = _sites;
+      _sites = site;
+      }
+   }
+
+int32_t
+NJCompiler::RuntimeAssumptionTable::invalidate(int32_t *guardWord)
+   {
+   OMR::CriticalSection invalidating(_monitor);
+   __atomic_store_n(guardWord, 1, __ATOMIC_SEQ_CST);
+
+   int32_t numPatched = 0;
+   Site **link = &_sites;
+   while (*link)
+      {
+      Site *site = *link;
+      if (site->_guardWord == guardWord)
+         {
+         patch(site);
+         *link = site->_next;
+         TR_Memory::jitPersistentFree(site);
+         numPatched++;
+         continue;
+         }
+      link = &site->_next;
+      }
+   return numPatched;
+   }
+
+void
+NJCompiler::RuntimeAssumptionTable::removeSites(uint8_t *start, uint8_t *end)
+   {
+   OMR::CriticalSection removingSites(_monitor);
+   Site **link = &_sites;
+   while (*link)
+      {
+      Site *site = *link;
+      if (site->_location >= start && site->_location < end)
+         {
+         *link = site->_next;
+         TR_Memory::jitPersistentFree(site);
+         continue;
+         }
+      link = &site->_next;
+      }
+   }
+
+void
+NJCompiler::RuntimeAssumptionTable::releaseAll()
+   {
+   OMR::CriticalSection releasing(_monitor);
+   while (_sites)
+      {
+      Site *site = _sites;
+      _sites = site->_next;
+      TR_Memory::jitPersistentFree(site);
+      }
+   }
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#ifndef NJ_RUNTIMEASSUMPTIONS_INCL
+#define NJ_RUNTIMEASSUMPTIONS_INCL
+
+#include <stddef.h>
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+
+namespace TR { class Compilation; }
+namespace TR { class Monitor; }
+
+namespace NJCompiler
+{
+
+/**
+ * Tracks the code that assumes a front end condition holds.
+ *
+ * Each assumption has a guard word, which is zero while the assumption
+ * holds.  Guards on the word are compiled to NOPs where the code generator
+ * supports it, and the NOPs of every compiled method are recorded here
+ * against the word.  invalidate() sets the word and patches each recorded
+ * NOP into a jump to the code for when the assumption does not hold; guards
+ * that are not NOPed test the word instead.
+ */
+class RuntimeAssumptionTable
+   {
+   public:
+
+   TR_PERSISTENT_ALLOC(TR_Memory::CodeMetaData);
+
+   static RuntimeAssumptionTable *instance() { return _instance; }
+   static RuntimeAssumptionTable *initialize();
+
+   /**
+    * @brief Records the patchable guards in the code just generated by comp.
+    * Guards on words already set are patched straight away.
+    */
+   void recordCompiledMethod(TR::Compilation *comp);
+
+   /**
+    * @brief Sets the guard word and patches every guard recorded on it.
+    *
+    * May be called while code containing the guards runs: each NOP is
+    * replaced by a single atomic store.
+    *
+    * @return the number of guards patched
+    */
+   int32_t invalidate(int32_t *guardWord);
+
+   /**
+    * @brief Forgets the guards in code that is being released.
+    */
+   void removeSites(uint8_t *start, uint8_t *end);
+
+   /**
+    * @brief Forgets all the guards, e.g. when the code caches are destroyed.
+    */
+   void releaseAll();
+
+   private:
+
+   RuntimeAssumptionTable();
+
+   struct Site
+      {
+      Site *_next;
+      int32_t *_guardWord;
+      uint8_t *_location;    // the NOP
+      uint8_t *_destination; // where the guard jumps once patched
+      };
+
+   static void patch(Site *site);
+
+   static RuntimeAssumptionTable *_instance;
+
+   TR::Monitor *_monitor;
+   Site *_sites;
+   };
+
+} // namespace NJCompiler
+
+#endif // NJ_RUNTIMEASSUMPTIONS_INCL